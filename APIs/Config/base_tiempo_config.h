@@ -0,0 +1,81 @@
+/*
+ * Nombre del archivo: base_tiempo_config.h
+ * Descripción: Resincronización de la hora cacheada (base_tiempo.c) con el DS3231
+ * Autor: lgomez
+ * Creado en: 17-10-2026
+ * Derechos de Autor: (C) 2023 Luis Gómez CESE FiUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+#ifndef CONFIG_BASE_TIEMPO_CONFIG_H_
+#define CONFIG_BASE_TIEMPO_CONFIG_H_
+/** @file
+ ** @brief Cada cuánto se vuelve a leer el DS3231 y uso opcional de su salida SQW de 1 Hz.
+ **/
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/** @defgroup BASE_TIEMPO_CONFIG Hora cacheada */
+/** @{ */
+#ifndef BASE_TIEMPO_RESINCRONIZAR_MS
+/**
+ * Lectura del DS3231 por I2C para corregir el SysTick. El cristal del HSE se aparta unas decenas
+ * de ppm: en un minuto son milisegundos, lejos del segundo de resolución de la hora.
+ */
+#define BASE_TIEMPO_RESINCRONIZAR_MS 60000u
+#endif
+
+#ifndef BASE_TIEMPO_REINTENTO_MS
+/** Espera antes de volver a leer un DS3231 que no respondió (cada lectura fallida bloquea) */
+#define BASE_TIEMPO_REINTENTO_MS 1000u
+#endif
+
+#ifndef BASE_TIEMPO_USAR_SQW
+/**
+ * 1: rtc_auto_init() configura la salida SQW del DS3231 a 1 Hz y cada flanco, informado con
+ * base_tiempo_pulso_sqw() desde HAL_GPIO_EXTI_Callback() (main.c), avanza la hora un segundo con
+ * la fase del DS3231. Requiere SQW cableado a una entrada EXTI (con pull-up: es drenador abierto).
+ */
+#define BASE_TIEMPO_USAR_SQW 0
+#endif
+
+#ifndef BASE_TIEMPO_SQW_PIN
+/** Pin EXTI (GPIO_PIN_x) al que llega SQW; se configura en CubeMX con flanco descendente */
+#define BASE_TIEMPO_SQW_PIN GPIO_PIN_0
+#endif
+/** @} */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CONFIG_BASE_TIEMPO_CONFIG_H_ */
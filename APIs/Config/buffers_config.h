@@ -41,8 +41,7 @@ extern "C" {
 #define BUFFER_HIGH_FREQ_SIZE 100 /**< 60 muestras = 10 minutos con frecuencia 10s */
 #define BUFFER_HOURLY_SIZE    24  /**< 24 muestras = 1 por cada 10 minutos en una hora */
 #define BUFFER_DAILY_SIZE     30  /**< 30 muestras = 1 cada hora durante 30 horas (aprox. 1 día) */
-#define CSV_LINE_BUFFER_SIZE  128 /**< Tamaño máximo para formatear una línea CSV */
-#define BUFFER_10MIN_SIZE     100
+#define CSV_LINE_BUFFER_SIZE  192 /**< Tamaño máximo para formatear una línea CSV */
 
 // Conteo de ciclos para promedios (obsoletos, mantenidos por compatibilidad)
 #define CYCLES_AVG_10MIN 60   /**< 60 ciclos equivalen a 10 minutos */
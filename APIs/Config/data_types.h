@@ -11,8 +11,10 @@
 #include "config_sistema.h"
 */
 #include "rtc_ds3231_for_stm32_hal.h"
+#include "base_tiempo.h" // epoca_t
 #include "buffers_config.h"
 #include "shdlc.h" // ConcentracionesPM
+#include "estadistica_online.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,13 +22,14 @@ extern "C" {
 
 /** Estructura principal de datos adquiridos por sensor */
 typedef struct {
-    ds3231_time_t timestamp; /**< Timestamp completo con hora y fecha */
-    uint8_t bloque_10min;    /**< Índice del bloque de 10 minutos del día */
-    uint8_t sensor_id;       /**< ID lógico del sensor */
+    epoca_t timestamp;    /**< Segundos desde BASE_TIEMPO_ANIO_EPOCA */
+    uint8_t bloque_10min; /**< Índice del bloque de 10 minutos de la hora */
+    uint8_t sensor_id;    /**< ID lógico del sensor */
     float pm1_0;
     float pm2_5;
     float pm4_0;
     float pm10;
+    ConcentracionesNumero numero; /**< Concentraciones en número y tamaño típico del SPS30 */
     float temp_amb;
     float hum_amb;
     float temp_cam;
@@ -35,7 +38,7 @@ typedef struct {
 
 /** Estructura para estadísticas de PM2.5 en ventanas sincronizadas */
 typedef struct {
-    ds3231_time_t timestamp;
+    epoca_t timestamp; /**< Inicio de la ventana */
     float pm2_5_avg;
     uint16_t sample_count;
     float pm2_5_min;
@@ -46,14 +49,13 @@ typedef struct {
 /** Estructura para estadísticas completas del bloque de 10 minutos */
 typedef struct {
     uint8_t sensor_id;
-    uint16_t year;
-    uint8_t month, day, hour, min, sec;
     uint8_t bloque_10min;
+    epoca_t timestamp; /**< Fecha de la última medición del bloque */
     float pm2_5_promedio;
     float pm2_5_min;
     float pm2_5_max;
     float pm2_5_std;
-    uint8_t num_validos;
+    uint16_t num_validos;
 } EstadisticaPM25;
 
 /** Estructura para buffer circular de datos */
@@ -64,11 +66,12 @@ typedef struct {
     uint16_t cantidad;
 } BufferCircular;
 
+/** Bloque de 10 minutos de un sensor: estadística en línea en lugar de las mediciones */
 typedef struct {
-    MedicionMP buffer[BUFFER_10MIN_SIZE];
-    uint8_t head;
-    uint8_t count;
-} BufferCircularSensor;
+    AcumuladorMP pm2_5; /**< PM2.5 de todas las mediciones del bloque */
+    MedicionMP ultima;  /**< Última medición recibida: fecha y bloque del resultado */
+    uint16_t count;     /**< Mediciones recibidas en el bloque */
+} AcumuladorSensor;
 
 /** Alias para facilitar compatibilidad */
 typedef EstadisticaPM25 PMDataAveraged;
@@ -78,9 +81,9 @@ typedef EstadisticaPM25 PMDataAveraged;
 #endif
 
 typedef struct {
-    ds3231_time_t start_time;
-    float samples[MAX_SAMPLES_PER_10MIN];
-    uint16_t count;
+    epoca_t start_time;
+    AcumuladorMP pm2_5; /**< Estadística de las muestras válidas de la ventana */
+    uint16_t count;     /**< Muestras recibidas desde start_time */
 } TimeWindow;
 
 typedef struct {
@@ -43,6 +43,30 @@ extern "C" {
 #define DHT22_ERROR_PIN_LOW  99902 // Error: No hay respuesta del sensor (pin en estado bajo)
 #define DHT22_ERROR_CHECKSUM 99903 // Error: Checksum incorrecto
 #define DHT22_ERROR_RESPONSE 99904 // Error: Respuesta incorrecta del sensor
+
+/** @defgroup DHT22_CAPTURA_CONFIG Lectura por interrupción */
+/** @{ */
+#ifndef DHT22_CAPTURA_TIMEOUT_US
+/**
+ * Espera máxima a los 42 flancos después de soltar la línea. Una trama de puros unos dura
+ * 40 + 160 + 40 x 130 µs, unos 5.4 ms.
+ */
+#define DHT22_CAPTURA_TIMEOUT_US 8000u
+#endif
+
+#ifndef DHT22_MAX_SENSORES
+/** Sensores que pueden estar capturando a la vez (ambiente y cámara) */
+#define DHT22_MAX_SENSORES 2u
+#endif
+
+#ifndef DHT22_EXTI_PRIORIDAD
+/**
+ * Prioridad de la EXTI de los pines. Por encima de UART (5) y SPI (6): un flanco atendido tarde
+ * alarga un período y puede convertir un 0 en un 1.
+ */
+#define DHT22_EXTI_PRIORIDAD 1u
+#endif
+/** @} */
 /* === Public data type declarations =========================================================== */
 
 /* === Public variable declarations ============================================================ */
@@ -0,0 +1,66 @@
+/*
+ * Nombre del archivo: fatfs_sd_config.h
+ * Descripción: Configuración del bus SPI de la microSD (fatfs_sd.c)
+ * Autor: lgomez
+ * Creado en: 16-10-2026
+ * Derechos de Autor: (C) 2023 Luis Gómez CESE FiUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+#ifndef CONFIG_FATFS_SD_CONFIG_H_
+#define CONFIG_FATFS_SD_CONFIG_H_
+/** @file
+ ** @brief Velocidades del bus SPI que prueba la negociación de fatfs_sd.c (SD_NEGOCIAR_VELOCIDAD)
+ ** y tamaño de la prueba.
+ **/
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/** @defgroup FATFS_SD_CONFIG Velocidad del bus de la microSD */
+/** @{ */
+#ifndef SD_SPI_PRESCALER_SEGURO
+/** Prescaler de la inicialización y del montaje: la negociación parte de aquí y nunca baja de él */
+#define SD_SPI_PRESCALER_SEGURO SPI_BAUDRATEPRESCALER_8
+#endif
+#ifndef SD_SPI_PRESCALER_RAPIDO
+#define SD_SPI_PRESCALER_RAPIDO SPI_BAUDRATEPRESCALER_2 /**< Prescaler más rápido que se prueba */
+#endif
+#ifndef SD_VELOCIDAD_REPETICIONES
+#define SD_VELOCIDAD_REPETICIONES 4 /**< Lecturas y reescrituras del sector de prueba por paso */
+#endif
+/** @} */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CONFIG_FATFS_SD_CONFIG_H_ */
@@ -0,0 +1,89 @@
+/*
+ * Nombre del archivo: log_config.h
+ * Descripción: Niveles de log por módulo, resueltos en tiempo de compilación
+ * Autor: lgomez
+ * Creado en: 16-10-2026
+ * Derechos de Autor: (C) 2023 Luis Gómez CESE FiUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+#ifndef CONFIG_LOG_CONFIG_H_
+#define CONFIG_LOG_CONFIG_H_
+/** @file
+ ** @brief Umbrales de los niveles de log (ver log.h).
+ **
+ ** Cada módulo imprime los mensajes de nivel menor o igual a su umbral; el resto no se compila.
+ ** Los umbrales se pueden redefinir desde la línea de compilación (-DLOG_NIVEL_SENSOR=...).
+ **/
+
+/* === Headers files inclusions ================================================================ */
+
+#include "config_sistema.h" // DEBUG_MODE
+
+/* === Cabecera C++ ============================================================================ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/** @defgroup LOG_CONFIG Niveles de log por módulo */
+/** @{ */
+#ifndef LOG_NIVEL_GLOBAL
+#if DEBUG_MODE
+#define LOG_NIVEL_GLOBAL LOG_NIVEL_DEBUG /**< Compilación de depuración */
+#else
+#define LOG_NIVEL_GLOBAL LOG_NIVEL_ERROR /**< Producción: sólo errores */
+#endif
+#endif
+
+#ifndef LOG_NIVEL_SENSOR
+#define LOG_NIVEL_SENSOR LOG_NIVEL_GLOBAL /**< sensor.c */
+#endif
+#ifndef LOG_NIVEL_MEF
+#define LOG_NIVEL_MEF LOG_NIVEL_GLOBAL /**< observador_MEF.c */
+#endif
+#ifndef LOG_NIVEL_DATA_LOGGER
+#define LOG_NIVEL_DATA_LOGGER LOG_NIVEL_GLOBAL /**< data_logger.c */
+#endif
+#ifndef LOG_NIVEL_OBSERVADOR
+#define LOG_NIVEL_OBSERVADOR LOG_NIVEL_GLOBAL /**< proceso_observador.c */
+#endif
+/** @} */
+
+/** @defgroup LOG_TOKEN_CONFIG Registros binarios del log (ver log_token.h) */
+/** @{ */
+#ifndef LOG_TOKENIZADO
+#define LOG_TOKENIZADO 0 /**< 1 = los mensajes salen como registros binarios, no como texto */
+#endif
+#define LOG_TOKEN_REGISTRO_MAX 64 /**< Bytes de argumentos por registro (el resto se trunca) */
+#define LOG_TOKEN_CADENA_MAX   32 /**< Caracteres que se copian de cada argumento %s */
+/** @} */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CONFIG_LOG_CONFIG_H_ */
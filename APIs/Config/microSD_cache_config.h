@@ -0,0 +1,66 @@
+/*
+ * Nombre del archivo: microSD_cache_config.h
+ * Descripción: Configuración de la caché de archivos abiertos de la microSD
+ * Autor: lgomez
+ * Creado en: 16-10-2026
+ * Derechos de Autor: (C) 2023 Luis Gómez CESE FiUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+#ifndef CONFIG_MICROSD_CACHE_CONFIG_H_
+#define CONFIG_MICROSD_CACHE_CONFIG_H_
+/** @file
+ ** @brief Parámetros de la caché de archivos abiertos y la política de sincronización
+ ** (ver microSD_cache.h).
+ **/
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/** @defgroup MICROSD_CACHE_CONFIG Caché de archivos de la microSD */
+/** @{ */
+#ifndef MICROSD_CACHE_ARCHIVOS
+#define MICROSD_CACHE_ARCHIVOS 4 /**< Archivos abiertos a la vez (3 RAW + AVG10 del día) */
+#endif
+#ifndef MICROSD_CACHE_BUFFER
+#define MICROSD_CACHE_BUFFER 2048 /**< Bytes en RAM por archivo; múltiplo de 512 (4 sectores) */
+#endif
+#define MICROSD_CACHE_RUTA_MAX 64 /**< Largo máximo de la ruta, con el '\0' */
+#ifndef MICROSD_CACHE_SYNC_MS
+#define MICROSD_CACHE_SYNC_MS 300000 /**< Máximo tiempo de una línea en RAM antes de escribirla */
+#endif
+/** @} */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CONFIG_MICROSD_CACHE_CONFIG_H_ */
@@ -0,0 +1,60 @@
+/*
+ * Nombre del archivo: registro_raw_config.h
+ * Descripción: Configuración del formato de los archivos RAW
+ * Autor: lgomez
+ * Creado en: 16-10-2026
+ * Derechos de Autor: (C) 2023 Luis Gómez CESE FiUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+#ifndef CONFIG_REGISTRO_RAW_CONFIG_H_
+#define CONFIG_REGISTRO_RAW_CONFIG_H_
+/** @file
+ ** @brief Formato de los archivos de mediciones sin procesar (ver registro_raw.h).
+ **/
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/** @defgroup REGISTRO_RAW_CONFIG Formato de los archivos RAW */
+/** @{ */
+#ifndef REGISTRO_RAW_BINARIO
+/** 1: registros binarios en RAW_<ID>_YYYYMMDD.BIN (tools/raw_bin_a_csv.py genera el CSV);
+ *  0: líneas de texto en RAW_<ID>_YYYYMMDD.CSV, como antes */
+#define REGISTRO_RAW_BINARIO 1
+#endif
+/** @} */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CONFIG_REGISTRO_RAW_CONFIG_H_ */
@@ -60,10 +60,14 @@ extern "C" {
  */
 #define SPS30_ERR_STATE(state) (SPS30_ERR_STATE_MASK | (state))
 
-/** @brief Frame de inicio de medición para comunicación SHDLC. */
+/** @brief Frame de inicio de medición para comunicación SHDLC (salida float IEEE754). */
 #define SPS30_FRAME_START_MEASUREMENT                                                              \
     { 0x7E, 0x00, 0x00, 0x02, 0x01, 0x03, 0xF9, 0x7E }
 
+/** @brief Frame de inicio de medición con salida uint16 big-endian. */
+#define SPS30_FRAME_START_MEASUREMENT_UINT16                                                       \
+    { 0x7E, 0x00, 0x00, 0x02, 0x01, 0x05, 0xF7, 0x7E }
+
 /** @brief Frame para solicitar la lectura de medición al SPS30. */
 #define SPS30_FRAME_READ_MEASUREMENT                                                               \
     { 0x7E, 0x00, 0x03, 0x00, 0xFC, 0x7E }
@@ -89,6 +93,47 @@ extern "C" {
 
 #define SERIAL_BUFFER_LEN   33
 
+/** @brief Dirección SHDLC del SPS30 (fija). */
+#define SPS30_ADDRESS              0x00
+
+/** @brief Bytes de datos de READ_MEASUREMENT en formato float (10 valores IEEE754). */
+#define SPS30_MEASUREMENT_FLOAT_LEN 40
+
+/** @brief Bytes de datos de READ_MEASUREMENT en formato uint16 (10 valores enteros). */
+#define SPS30_MEASUREMENT_UINT16_LEN 20
+
+/** @brief Mayor respuesta posible con stuffing: cabecera, datos float y chk duplicados y 2 0x7E. */
+#define SPS30_RX_FRAME_MAX (2 * (4 + SPS30_MEASUREMENT_FLOAT_LEN + 1) + 2)
+
+/** @defgroup SPS30_FORMATO Formato de salida de START_MEASUREMENT */
+/** @{ */
+#define SPS30_FORMATO_FLOAT  0x03 /**< Float IEEE754 big-endian, 47 bytes por frame sin stuffing */
+#define SPS30_FORMATO_UINT16 0x05 /**< uint16 big-endian, 27 bytes por frame sin stuffing */
+#define SPS30_FORMATO_SALIDA SPS30_FORMATO_FLOAT /**< Formato usado por inicializar_sensores_sps30 */
+/** @} */
+
+/** @brief Relecturas inmediatas ante un error transitorio de la respuesta. */
+#define SPS30_RELECTURAS           2
+
+/** @brief Espera tras START_MEASUREMENT antes de la primera lectura [ms]. */
+#define SPS30_WARMUP_MS       2000
+
+/** @defgroup SPS30_CONTINUO Medición continua */
+/** @{ */
+#define SPS30_MODO_CONTINUO       1    /**< 1 = los sensores quedan midiendo entre ciclos */
+#define SPS30_PERIODO_MEDICION_MS 1000 /**< El SPS30 entrega un dato nuevo por segundo */
+/** @} */
+
+/** @brief Tiempo máximo de espera de una respuesta SHDLC [ms]. */
+#define SPS30_UART_TIMEOUT_MS 100
+
+/** @defgroup SPS30_RX_DMA Recepción por DMA + línea ociosa */
+/** @{ */
+#define SPS30_RX_DMA_HABILITADO  1   /**< 0 = recepción bloqueante con HAL_UART_Receive */
+#define SPS30_RX_DMA_BUFFER_SIZE 64  /**< Buffer circular del DMA por UART [bytes] */
+#define SPS30_RX_RING_SIZE       128 /**< Ring buffer por sensor; debe ser potencia de 2 */
+/** @} */
+
 /* === Public data type declarations =========================================================== */
 
 /* === Public variable declarations ============================================================ */
@@ -0,0 +1,60 @@
+/*
+ * Nombre del archivo: uart_log_config.h
+ * Descripción: Configuración del log de depuración con cola y envío por DMA
+ * Autor: lgomez
+ * Creado en: 16-10-2026
+ * Derechos de Autor: (C) 2023 Luis Gómez CESE FiUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+#ifndef CONFIG_UART_LOG_CONFIG_H_
+#define CONFIG_UART_LOG_CONFIG_H_
+/** @file
+ ** @brief Parámetros del log de depuración asíncrono (ver uart_log.h).
+ **/
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/** @defgroup UART_LOG_CONFIG Log de depuración por DMA */
+/** @{ */
+#define UART_LOG_HABILITADO       1    /**< 0 = uart_print transmite bloqueando, como antes */
+#define UART_LOG_BUFFER_SIZE      2048 /**< Cola de bytes pendientes; debe ser potencia de 2 */
+#define UART_LOG_TRAMO_DMA        128  /**< Bytes por transferencia DMA (buffer propio del DMA) */
+#define UART_LOG_POLITICA         UART_LOG_DESCARTAR_NUEVOS /**< Qué se pierde con la cola llena */
+#define UART_LOG_FLUSH_ESPERA_MAX 100000 /**< Tope de vueltas de cada espera de uart_log_flush() */
+/** @} */
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CONFIG_UART_LOG_CONFIG_H_ */
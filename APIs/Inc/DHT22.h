@@ -79,6 +79,21 @@ void DHT22_Init(DHT22_HandleTypeDef * dht, GPIO_TypeDef * GPIOx, uint16_t GPIO_P
  */
 int DHT22_Read(DHT22_HandleTypeDef * dht, DHT22_Data * data);
 
+/**
+ * @brief Lee varios sensores DHT22 con un mismo pulso de inicio.
+ *
+ * Las tramas llegan en paralelo y las guardan las interrupciones de cada pin, así que leer los
+ * dos sensores tarda lo mismo que leer uno (unos 6 ms).
+ *
+ * @param dhts Sensores a leer (hasta DHT22_MAX_SENSORES).
+ * @param datos Lectura de cada sensor; sólo es válida si su estado es DHT22_OK.
+ * @param estados Estado de cada sensor: DHT22_OK o el código de error.
+ * @param cantidad Cantidad de sensores.
+ * @return int DHT22_OK si todos se leyeron bien, DHT22_ERROR si alguno falló.
+ */
+int DHT22_ReadMultiple(DHT22_HandleTypeDef * const dhts[], DHT22_Data datos[], int estados[],
+                       uint8_t cantidad);
+
 /**
  * @brief Lee temperatura y humedad con validación de rangos.
  *
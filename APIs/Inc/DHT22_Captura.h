@@ -0,0 +1,116 @@
+/**
+ * @file DHT22_Captura.h
+ * @brief Decodificación de una trama del DHT22 a partir de las marcas de tiempo de sus flancos.
+ *
+ * La interrupción EXTI del pin sólo guarda DWT->CYCCNT en cada flanco descendente
+ * (DHT22_CapturaFlanco()); la trama se arma después, en el lazo principal, con la distancia entre
+ * flancos. Después de la señal de inicio el DHT22 baja la línea 42 veces:
+ *
+ *   F0 -> F1   respuesta: 80 µs bajo + 80 µs alto (~160 µs)
+ *   Fn -> Fn+1 bit n-1 (MSB primero): 50 µs bajo + 26 µs alto (~76 µs, un 0)
+ *                                   o 50 µs bajo + 70 µs alto (~120 µs, un 1)
+ *
+ * El último flanco (F41) es el bajo de 50 µs que cierra el bit 39. Como cada período va de un
+ * flanco descendente al siguiente, la latencia fija de la interrupción se cancela y sólo importa
+ * su variación, muy por debajo de los ~44 µs que separan un 0 de un 1.
+ *
+ * No usa la HAL: se prueba en la PC con flancos sintetizados.
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_DHT22_CAPTURA_H_
+#define INC_DHT22_CAPTURA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "dht22_config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Definiciones públicas de macros
+ * ======================================================== */
+
+#define DHT22_CAPTURA_BYTES   5u  /**< Humedad (2), temperatura (2) y checksum */
+#define DHT22_CAPTURA_FLANCOS 42u /**< Respuesta, 40 bits y el cierre del último bit */
+
+/* === Declaraciones públicas de tipos de datos
+ * =============================================== */
+
+/**
+ * Flancos descendentes de una lectura. Lo escribe sólo la interrupción entre
+ * DHT22_CapturaReiniciar() y el final de la lectura.
+ */
+typedef struct {
+    volatile uint32_t marcas[DHT22_CAPTURA_FLANCOS]; /**< DWT->CYCCNT de cada flanco */
+    volatile uint8_t cantidad; /**< Flancos recibidos (puede pasar de DHT22_CAPTURA_FLANCOS) */
+} DHT22_Captura;
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Descarta los flancos de la lectura anterior; se llama antes de soltar la línea.
+ */
+void DHT22_CapturaReiniciar(DHT22_Captura * cap);
+
+/**
+ * @brief Guarda un flanco descendente; se llama desde la interrupción EXTI del pin.
+ *
+ * Los flancos que sobran (ruido en la línea) sólo se cuentan, así la trama se descarta.
+ *
+ * @param marca Valor de DWT->CYCCNT leído en la interrupción.
+ */
+void DHT22_CapturaFlanco(DHT22_Captura * cap, uint32_t marca);
+
+/**
+ * @brief true cuando ya llegaron los 42 flancos de una trama.
+ */
+bool DHT22_CapturaCompleta(const DHT22_Captura * cap);
+
+/**
+ * @brief Arma los 5 bytes de la trama con los períodos entre flancos.
+ *
+ * @param ciclos_por_us Frecuencia del contador de ciclos en MHz (SystemCoreClock / 1000000).
+ * @param[out] datos Humedad alta, humedad baja, temperatura alta, temperatura baja y checksum.
+ *
+ * @retval DHT22_OK             Trama completa y checksum correcto.
+ * @retval DHT22_ERROR_PIN_HIGH El sensor no respondió (ningún flanco).
+ * @retval DHT22_ERROR_RESPONSE Faltan o sobran flancos, o un período está fuera de rango.
+ * @retval DHT22_ERROR_CHECKSUM Los bytes no suman el checksum.
+ */
+int DHT22_CapturaDecodificar(const DHT22_Captura * cap, uint32_t ciclos_por_us,
+                             uint8_t datos[DHT22_CAPTURA_BYTES]);
+
+/**
+ * @brief Temperatura (°C) y humedad (%) de una trama ya decodificada.
+ *
+ * El bit 15 de la temperatura es el signo y los 15 restantes el módulo en décimas de grado.
+ */
+void DHT22_CapturaConvertir(const uint8_t datos[DHT22_CAPTURA_BYTES], float * temperatura,
+                            float * humedad);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DHT22_CAPTURA_H_ */
@@ -29,6 +29,7 @@
  **/
 #include "stm32f4xx_hal.h"
 #include "dht22_config.h"
+#include "DHT22_Captura.h"
 // #include "DHT22.h"  // Asegúrate de incluir DHT22.h para que se conozcan los
 // tipos
 
@@ -54,8 +55,10 @@ extern "C" {
  * conectado el sensor DHT22.
  */
 typedef struct {
-    GPIO_TypeDef * GPIOx; /**< Puerto GPIO donde está conectado el DHT22. */
-    uint16_t GPIO_Pin;    /**< Pin GPIO donde está conectado el DHT22. */
+    GPIO_TypeDef * GPIOx;     /**< Puerto GPIO donde está conectado el DHT22. */
+    uint16_t GPIO_Pin;        /**< Pin GPIO donde está conectado el DHT22. */
+    DHT22_Captura captura;    /**< Flancos de la lectura en curso. */
+    volatile bool capturando; /**< La EXTI del pin guarda flancos en captura. */
 } DHT22_HandleTypeDef;
 /* === Public variable declarations
  * ============================================================ */
@@ -105,42 +108,41 @@ void DHT22_SetPinOutput(DHT22_HandleTypeDef * dht);
 void DHT22_SetPinInput(DHT22_HandleTypeDef * dht);
 
 /**
- * @brief Envía la señal de inicio al sensor DHT22.
+ * @brief Suelta la línea y empieza a guardar los flancos descendentes del sensor.
  *
- * Esta función configura el pin GPIO como salida, envía la señal de inicio
- * y luego lo configura como entrada para recibir datos del sensor.
+ * Configura el pin como entrada con pull-up e interrupción por flanco descendente, descarta los
+ * flancos de la lectura anterior y habilita la EXTI del pin con DHT22_EXTI_PRIORIDAD. Se llama
+ * al terminar el pulso bajo de inicio.
  *
  * @param[in] dht Puntero a la estructura DHT22_HandleTypeDef que contiene la
  * configuración del puerto y pin GPIO.
  *
  * @retval None
  */
-void DHT22_StartSignal(DHT22_HandleTypeDef * dht);
+void DHT22_IniciarCaptura(DHT22_HandleTypeDef * dht);
 
 /**
- * @brief Lee un byte de datos del sensor DHT22.
- *
- * Esta función lee 8 bits de datos del sensor DHT22 y los devuelve como un
- * byte.
+ * @brief Deja de guardar flancos y vuelve el pin a salida en alto (línea en reposo).
  *
  * @param[in] dht Puntero a la estructura DHT22_HandleTypeDef que contiene la
  * configuración del puerto y pin GPIO.
  *
- * @retval uint8_t El byte leído del sensor.
+ * @retval None
  */
-uint8_t DHT22_ReadByte(DHT22_HandleTypeDef * dht);
+void DHT22_DetenerCaptura(DHT22_HandleTypeDef * dht);
 
 /**
- * @brief Lee un bit de datos del sensor DHT22.
+ * @brief Guarda el flanco de un pin DHT22; se llama desde HAL_GPIO_EXTI_Callback().
  *
- * Esta función lee un bit de datos del sensor DHT22.
+ * Lee DWT->CYCCNT y lo agrega a la captura del sensor que está capturando en ese pin. Los pines
+ * que no son de un DHT22, o de uno que no está leyendo, se ignoran.
  *
- * @param[in] dht Puntero a la estructura DHT22_HandleTypeDef que contiene la
- * configuración del puerto y pin GPIO.
+ * @param[in] GPIO_Pin Pin que generó la interrupción.
  *
- * @retval uint8_t El bit leído del sensor (0 o 1).
+ * @retval None
  */
-uint8_t DHT22_ReadBit(DHT22_HandleTypeDef * dht);
+void DHT22_FlancoEXTI(uint16_t GPIO_Pin);
+
 /* === End of documentation
  * ==================================================================== */
 
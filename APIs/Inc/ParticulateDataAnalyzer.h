@@ -40,12 +40,14 @@
  * - findMaxValue: Identifica el valor máximo en los datos.
  * - findMinValue: Identifica el valor mínimo en los datos.
  * - calculateStandardDeviation: Calcula la desviación estándar.
+ * - calculateStatistics: Calcula las cuatro en una sola pasada sobre los datos.
  *
  * Adecuado para sistemas de monitoreo de calidad del aire.
  */
 
 #include <stdint.h>
 #include <stddef.h> // ⬅️ Esto es obligatorio para usar size_t
+#include "shdlc.h"  // ConcentracionesNumero
 
 /* === Headers files inclusions ================================================================ */
 /**
@@ -89,6 +91,7 @@ typedef struct {
     float pm2_5;
     float pm4_0;
     float pm10;
+    ConcentracionesNumero numero; // Número de partículas y tamaño típico (mismo frame SPS30)
 
     float temp_amb; // Temperatura ambiente
     float hum_amb;  // Humedad ambiente
@@ -104,6 +107,18 @@ typedef struct {
     uint8_t sec;
 } ParticulateData;
 
+/**
+ * @brief Resultado de calculateStatistics: los mismos valores (y códigos de error) que las
+ * funciones individuales.
+ */
+typedef struct {
+    float average;  /**< Promedio de los valores válidos */
+    float max;      /**< Valor máximo válido */
+    float min;      /**< Valor mínimo válido */
+    float std;      /**< Desviación estándar muestral */
+    int validCount; /**< Cantidad de valores válidos */
+} MPStatistics;
+
 /* === Public variable declarations ============================================================ */
 
 /* === Public function declarations ============================================================ */
@@ -159,11 +174,26 @@ float findMinValue(float data[], int n_data);
  *
  * @param data Un array de datos flotantes.
  * @param n El número de elementos en el array.
- * @return La desviación estándar calculada de los datos válidos. Retorna 0 si el número de
- *         elementos válidos es menor o igual a 1 o si el array está vacío.
+ * @return La desviación estándar calculada de los datos válidos. Retorna MSN_VOID_ARRAY_VALUE si
+ *         el array está vacío, MSN_DS_NOTDEFINI si n <= 1 y MSN_NOT_DATA si hay menos de dos
+ *         datos válidos.
  */
 float calculateStandardDeviation(float data[], int n);
 
+/**
+ * @brief Calcula promedio, máximo, mínimo y desviación estándar en una sola pasada.
+ *
+ * Equivale a llamar a las cuatro funciones anteriores, pero recorre los datos una vez y evalúa
+ * la validez de cada uno una sola vez. Todo el cálculo es en float y la raíz cuadrada usa la
+ * instrucción de la FPU.
+ *
+ * @param data Un array de datos flotantes.
+ * @param n_data El número de elementos en el array.
+ * @param stats Resultado. Sin datos válidos, los cuatro valores son MSN_VOID_ARRAY_VALUE; la
+ *              desviación sigue las reglas de calculateStandardDeviation.
+ */
+void calculateStatistics(float data[], int n_data, MPStatistics * stats);
+
 void build_iso8601_timestamp(char * buffer, size_t len, const ParticulateData * data);
 
 /* === End of documentation ==================================================================== */
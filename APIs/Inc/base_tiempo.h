@@ -0,0 +1,126 @@
+/**
+ * @file base_tiempo.h
+ * @brief Hora del sistema con una lectura del DS3231 por I2C y el SysTick en el medio.
+ *
+ * base_tiempo_ahora() devuelve la última hora leída del DS3231 más los segundos que contó
+ * HAL_GetTick() desde esa lectura. El DS3231 se vuelve a leer cada BASE_TIEMPO_RESINCRONIZAR_MS,
+ * cuando se pide con base_tiempo_resincronizar() (después de poner en hora el RTC) o, con
+ * BASE_TIEMPO_USAR_SQW, la fase la marca el pulso de 1 Hz del DS3231.
+ *
+ * La hora entregada nunca retrocede: si el SysTick adelanta y la lectura siguiente da un segundo
+ * menos, la hora se queda quieta hasta alcanzarla. Como leer el DS3231 directamente, queda hasta
+ * un segundo atrás de la hora exacta (la lectura descarta la fracción de segundo), más la deriva
+ * del SysTick desde la última lectura; con SQW coincide con el segundo del DS3231.
+ *
+ * Los segundos se cuentan desde BASE_TIEMPO_ANIO_EPOCA (el DS3231 guarda el año en dos cifras).
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_BASE_TIEMPO_H_
+#define INC_BASE_TIEMPO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "base_tiempo_config.h"
+#include "rtc_ds3231_for_stm32_hal.h" // ds3231_time_t y ds3231_get_datetime()
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Definiciones públicas de macros
+ * ======================================================== */
+
+#define BASE_TIEMPO_ANIO_EPOCA 2000u /**< Segundo 0: 2000-01-01 00:00:00 */
+
+/** Bloque de 10 minutos de la hora (0 a 5) de una marca de tiempo */
+#define BASE_TIEMPO_BLOQUE_10MIN(t) ((uint8_t)((t) % 3600u / 600u))
+
+/* === Declaraciones públicas de tipos de datos
+ * =============================================== */
+
+/**
+ * Marca de tiempo interna: segundos desde BASE_TIEMPO_ANIO_EPOCA. Las mediciones y los promedios
+ * la guardan así (la diferencia entre dos es una resta, aun entre días distintos) y se pasa a
+ * año/mes/día sólo al armar rutas y líneas de texto.
+ */
+typedef uint32_t epoca_t;
+
+/** Contadores para diagnóstico y pruebas */
+typedef struct {
+    uint32_t lecturas_rtc; /**< Lecturas del DS3231 (I2C) */
+    uint32_t fallas_rtc;   /**< Lecturas que fallaron o dieron una fecha inválida */
+    uint32_t pulsos_sqw;   /**< Flancos de SQW recibidos */
+    int32_t ultimo_ajuste; /**< Diferencia (s) entre la lectura y la hora interpolada */
+} BaseTiempoEstadisticas;
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Hora actual; lee el DS3231 sólo si corresponde resincronizar.
+ * @return false si nunca se pudo leer el DS3231. Si una resincronización falla se sigue con el
+ *         SysTick y se reintenta a los BASE_TIEMPO_REINTENTO_MS.
+ */
+bool base_tiempo_ahora(ds3231_time_t * dt);
+
+/**
+ * @brief Igual que base_tiempo_ahora(), en segundos desde BASE_TIEMPO_ANIO_EPOCA.
+ */
+bool base_tiempo_segundos(epoca_t * segundos);
+
+/**
+ * @brief La próxima consulta vuelve a leer el DS3231 (por ejemplo, después de ponerlo en hora).
+ *
+ * La hora puede retroceder una sola vez, hasta la que se haya cargado.
+ */
+void base_tiempo_resincronizar(void);
+
+/**
+ * @brief true si la última lectura del DS3231 fue válida.
+ */
+bool base_tiempo_rtc_ok(void);
+
+/**
+ * @brief Flanco de SQW (1 Hz) del DS3231; se llama desde HAL_GPIO_EXTI_Callback().
+ */
+void base_tiempo_pulso_sqw(void);
+
+/**
+ * @brief Contadores de lecturas, fallas y pulsos.
+ */
+BaseTiempoEstadisticas base_tiempo_estadisticas(void);
+
+/**
+ * @brief Segundos desde BASE_TIEMPO_ANIO_EPOCA de una fecha del calendario gregoriano.
+ */
+epoca_t base_tiempo_a_segundos(const ds3231_time_t * dt);
+
+/**
+ * @brief Fecha y hora de una cantidad de segundos desde BASE_TIEMPO_ANIO_EPOCA.
+ */
+void base_tiempo_desde_segundos(epoca_t segundos, ds3231_time_t * dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_BASE_TIEMPO_H_ */
@@ -54,6 +54,7 @@
 #include <stdint.h>
 
 #include "ParticulateDataAnalyzer.h"
+#include "registro_raw.h" // format_csv_line()
 #include <rtc_ds3231_for_stm32_hal.h>
 /* === Cabecera C++
  * ============================================================================
@@ -151,14 +152,6 @@ uint8_t data_logger_get_count(uint8_t sensor_id);
  */
 const MedicionMP * data_logger_get_medicion(uint8_t sensor_id, uint8_t index);
 
-/**
- * @brief Formatea una línea CSV a partir de los datos
- * @param data Estructura con los datos
- * @param csv_line Cadena de salida
- * @param max_len Longitud máxima permitida
- */
-bool format_csv_line(const ParticulateData * data, char * csv_line, size_t max_len);
-
 /** @brief Escribe línea CSV en ruta basada en timestamp. */
 bool data_logger_write_csv_line(const ParticulateData * data);
 
@@ -252,26 +245,26 @@ void data_logger_print_value(void);
 bool buffer_guardar(BufferCircular * buffer);
 
 /**
- * @brief Guarda múltiples mediciones desde un arreglo temporal en los buffers circulares.
+ * @brief Acumula múltiples mediciones desde un arreglo temporal en los bloques por sensor.
  *
  * @param temp_data Arreglo de datos de sensores (uno por sensor).
  * @param num_mediciones Número de elementos en el arreglo.
- * @param buffers_destino Arreglo de buffers circulares, uno por sensor.
+ * @param buffers_destino Arreglo de acumuladores de 10 minutos, uno por sensor.
  * @return true si todas las mediciones se guardaron correctamente, false si alguna falló.
  */
 
 bool data_logger_store_sensor_data(const MedicionMP * temp_data, size_t num_mediciones,
-                                   BufferCircularSensor * buffers_destino);
+                                   AcumuladorSensor * buffers_destino);
 
 /**
- * @brief Calcula estadísticas de PM2.5 sobre un buffer de datos.
+ * @brief Calcula estadísticas de PM2.5 combinando los acumuladores de todos los sensores.
  *
- * @param buffer Puntero al buffer circular con datos recientes.
+ * @param buffers Arreglo de acumuladores de 10 minutos, uno por sensor.
  * @param resultado Puntero a la estructura donde se guardará la estadística calculada.
  * @return true si se pudo calcular la estadística, false si no había datos suficientes.
  */
 
-bool data_logger_estadistica_10min_pm25(const BufferCircularSensor * buffers,
+bool data_logger_estadistica_10min_pm25(const AcumuladorSensor * buffers,
                                         EstadisticaPM25 * resultado);
 
 /**
@@ -283,14 +276,13 @@ bool data_logger_estadistica_10min_pm25(const BufferCircularSensor * buffers,
 bool data_logger_store_avg10_csv(const EstadisticaPM25 * data);
 
 /**
- * @brief Limpia todos los buffers circulares asignados a sensores.
+ * @brief Reinicia los acumuladores de 10 minutos de todos los sensores.
  *
- * @param buffers Arreglo de buffers circulares, uno por sensor.
+ * @param buffers Arreglo de acumuladores, uno por sensor.
  */
-// void data_logger_buffer_limpiar_todos(BufferCircular * buffers);
-void data_logger_buffer_limpiar_todos(BufferCircularSensor * buffers);
+void data_logger_buffer_limpiar_todos(AcumuladorSensor * buffers);
 
-void registrar_promedio_24h(const ds3231_time_t * dt);
+void registrar_promedio_24h(epoca_t ahora);
 
 /* === End of documentation
  * ==================================================================== */
@@ -300,8 +292,8 @@ BufferCircular * get_buffer_high_freq(void);
 BufferCircular * get_buffer_hourly(void);
 BufferCircular * get_buffer_daily(void);
 TimeWindow * get_time_window(void);
-float * get_avg1h_buffer(void);
-float * get_avg24h_buffer(void);
+AcumuladorMP * get_acumulador_1h(void);
+AcumuladorMP * get_acumulador_24h(void);
 int get_hourly_index(void);
 int get_daily_index(void);
 #endif
@@ -0,0 +1,121 @@
+/**
+ * @file estadistica_online.h
+ * @brief Estadística en línea de PM2.5: promedio, desviación, mínimo y máximo sin guardar muestras.
+ *
+ * Un AcumuladorMP ocupa 20 bytes y se actualiza en O(1) con cada muestra (algoritmo de Welford):
+ * guarda la cantidad de datos, la media, la suma de los cuadrados de las desviaciones (M2) y los
+ * extremos. Dos acumuladores se combinan en uno que describe la unión de sus muestras (Chan et
+ * al.), así que el promedio general de 10 minutos se arma con los de cada sensor sin volver a
+ * recorrer datos. Las ventanas de 1 h y 24 h acumulan un promedio por ventana más corta.
+ *
+ * acumulador_agregar() sólo acumula los valores que acepta maskIsDataTrue()
+ * (ParticulateDataAnalyzer): mayores que MP_MIN_VALUE y hasta MP_MAX_VALUE.
+ * acumulador_agregar_sin_rango() acumula todas las mediciones, como el promedio combinado de los
+ * bloques de 10 minutos por sensor. Los resultados sin datos suficientes devuelven los mismos
+ * códigos que las funciones del analizador.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_ESTADISTICA_ONLINE_H_
+#define INC_ESTADISTICA_ONLINE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "ParticulateDataAnalyzer.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Definiciones públicas de macros
+ * ======================================================== */
+
+/** Rango válido de acumulador_agregar(): el mismo de maskIsDataTrue() */
+#define ESTADISTICA_MIN_VALIDO ((float)MP_MIN_VALUE)
+#define ESTADISTICA_MAX_VALIDO ((float)MP_MAX_VALUE)
+
+/** Códigos de error: MSN_VOID_ARRAY_VALUE y MSN_NOT_DATA del analizador */
+#define ESTADISTICA_SIN_DATOS   -999.0f /**< Ninguna muestra válida */
+#define ESTADISTICA_DS_SIN_DATO -777.0f /**< Desviación con menos de dos muestras */
+
+/* === Declaraciones públicas de tipos de datos
+ * =============================================== */
+
+/** Estadística de una ventana o de un grupo de sensores. Todo en cero es un acumulador vacío. */
+typedef struct {
+    uint32_t n;  /**< Muestras válidas acumuladas */
+    float media; /**< Promedio de las muestras */
+    float m2;    /**< Suma de (x - media)^2 */
+    float min;   /**< Menor valor (válido sólo si n > 0) */
+    float max;   /**< Mayor valor (válido sólo si n > 0) */
+} AcumuladorMP;
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Deja el acumulador vacío.
+ */
+void acumulador_reiniciar(AcumuladorMP * acc);
+
+/**
+ * @brief Agrega una muestra si está dentro del rango válido.
+ * @return true si la muestra se acumuló.
+ */
+bool acumulador_agregar(AcumuladorMP * acc, float valor);
+
+/**
+ * @brief Agrega una muestra sin aplicar el rango válido.
+ * @return true si la muestra se acumuló.
+ */
+bool acumulador_agregar_sin_rango(AcumuladorMP * acc, float valor);
+
+/**
+ * @brief Suma a @p destino las muestras de @p origen, como si se hubieran agregado una a una.
+ */
+void acumulador_combinar(AcumuladorMP * destino, const AcumuladorMP * origen);
+
+/**
+ * @brief Promedio de las muestras, o ESTADISTICA_SIN_DATOS.
+ */
+float acumulador_promedio(const AcumuladorMP * acc);
+
+/**
+ * @brief Menor muestra, o ESTADISTICA_SIN_DATOS.
+ */
+float acumulador_minimo(const AcumuladorMP * acc);
+
+/**
+ * @brief Mayor muestra, o ESTADISTICA_SIN_DATOS.
+ */
+float acumulador_maximo(const AcumuladorMP * acc);
+
+/**
+ * @brief Desviación estándar muestral (divide por n - 1).
+ * @return ESTADISTICA_SIN_DATOS sin muestras, ESTADISTICA_DS_SIN_DATO con una sola.
+ */
+float acumulador_desvio(const AcumuladorMP * acc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ESTADISTICA_ONLINE_H_ */
@@ -12,6 +12,38 @@
 
 /* Includes ------------------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
+/* Contadores de la microSD (SD_GET_ESTADISTICAS): throughput = sectores * 512 / ms */
+typedef struct {
+    DWORD sectores_leidos;
+    DWORD sectores_escritos;
+    DWORD ms_lectura;   /* Tiempo dentro de SD_disk_read(), comandos y esperas incluidos */
+    DWORD ms_escritura; /* Tiempo dentro de SD_disk_write(), ocupado de la tarjeta incluido */
+    DWORD bloques_dma;  /* Bloques de 512 bytes movidos por DMA */
+    DWORD errores_dma;  /* Transferencias DMA con error o sin fin dentro de SPI_TIMEOUT */
+    DWORD errores;      /* Lecturas o escrituras que devolvieron RES_ERROR */
+} SD_Estadisticas;
+
+/* Velocidad del bus (SD_NEGOCIAR_VELOCIDAD, SD_GET_VELOCIDAD) */
+typedef struct {
+    BYTE * buffer;   /* Entrada: 1024 bytes de trabajo (el sector original y la relectura) */
+    DWORD sector;    /* Entrada: sector de prueba, se reescribe con su contenido (0: el último) */
+    DWORD prescaler; /* SPI_BAUDRATEPRESCALER_x en uso */
+    DWORD sck_hz;    /* Frecuencia de SCK en uso */
+    BYTE pasos;      /* Pasos de prescaler verificados sobre SD_SPI_PRESCALER_SEGURO */
+    BYTE fallas;     /* Pasos descartados por CRC, timeout o datos distintos */
+    BYTE bajadas;    /* Pasos perdidos por errores de lectura o escritura en uso */
+} SD_Velocidad;
+
+/* Throughput secuencial (SD_BENCHMARK): lee y reescribe los sectores con su propio contenido */
+typedef struct {
+    BYTE * buffer;         /* Entrada: buffer de sectores_buffer * 512 bytes */
+    UINT sectores_buffer;  /* Entrada: sectores por transferencia múltiple */
+    DWORD sector;          /* Entrada: primer sector */
+    DWORD sectores;        /* Entrada: sectores a medir */
+    DWORD kbs_lectura;     /* Salida: KB/s de lectura secuencial */
+    DWORD kbs_escritura;   /* Salida: KB/s de escritura secuencial */
+} SD_Benchmark;
+
 /* Exported constants --------------------------------------------------------*/
 /* Definitions for MMC/SDC command */
 #define CMD0  (0x40 + 0)  /* GO_IDLE_STATE */
@@ -39,6 +71,13 @@
 
 #define SPI_TIMEOUT 100
 
+/* Comandos de SD_disk_ioctl() propios de este driver (los de FatFs llegan hasta 13) */
+#define SD_GET_ESTADISTICAS   60 /* Copia un SD_Estadisticas en buff */
+#define SD_RESET_ESTADISTICAS 61 /* Pone los contadores en cero */
+#define SD_NEGOCIAR_VELOCIDAD 62 /* Sube el reloj SPI mientras el sector de prueba se verifique */
+#define SD_GET_VELOCIDAD      63 /* Copia en buff el SD_Velocidad en uso (sin buffer ni sector) */
+#define SD_BENCHMARK          64 /* Mide con el SD_Benchmark de buff */
+
 /* Exported macros -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 /* Variables-----------------------------------------------------------------*/
@@ -0,0 +1,81 @@
+/**
+ * @file formato_csv.h
+ * @brief Emisores de campos CSV sin snprintf: enteros con ceros a la izquierda, decimales y fechas.
+ *
+ * Cada emisor escribe en @p p, deja el texto terminado en '\0' y devuelve el puntero al '\0', para
+ * encadenar los campos de una línea. Si el campo no entra antes de @p fin (fin = inicio del buffer
+ * + su tamaño) devuelven NULL, y un NULL recibido pasa de largo: basta con revisar el final.
+ *
+ * El texto es idéntico al de printf: "%0Nu" para los enteros, "%.Nf" para los decimales (mismo
+ * redondeo al par, "-0.0" incluido) y "%04u-%02u-%02u" para la fecha.
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_FORMATO_CSV_H_
+#define INC_FORMATO_CSV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include <stddef.h>
+#include <stdint.h>
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Copia un carácter.
+ */
+char * formato_csv_caracter(char * p, const char * fin, char c);
+
+/**
+ * @brief Copia una cadena terminada en '\0'.
+ */
+char * formato_csv_texto(char * p, const char * fin, const char * texto);
+
+/**
+ * @brief Entero sin signo con al menos @p ancho cifras (ceros a la izquierda), como "%0Nu".
+ */
+char * formato_csv_entero(char * p, const char * fin, uint32_t valor, uint8_t ancho);
+
+/**
+ * @brief Número con @p decimales cifras decimales, igual que "%.Nf".
+ *
+ * Los valores que no entran en un int32 escalado (NaN, infinito, enormes) se escriben con
+ * snprintf.
+ */
+char * formato_csv_decimal(char * p, const char * fin, float x, uint8_t decimales);
+
+/**
+ * @brief Fecha y hora "YYYY-MM-DD?HH:MM:SS", con @p separador entre la fecha y la hora.
+ *
+ * La fecha se arma una vez por día: se guarda la última y sólo se copia mientras no cambie
+ * (no es reentrante; se llama desde el lazo principal).
+ */
+char * formato_csv_fecha_hora(char * p, const char * fin, uint16_t anio, uint8_t mes, uint8_t dia,
+                              uint8_t hora, uint8_t minuto, uint8_t segundo, char separador);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_FORMATO_CSV_H_ */
@@ -0,0 +1,125 @@
+/**
+ * @file log.h
+ * @brief Mensajes de log con nivel y umbral por módulo, filtrados en tiempo de compilación.
+ *
+ * Cada archivo fuente elige su umbral antes de incluir este header:
+ *
+ * @code
+ * #define LOG_NIVEL_MODULO LOG_NIVEL_SENSOR
+ * #include "log.h"
+ * @endcode
+ *
+ * Los mensajes de nivel mayor que el umbral quedan dentro de un `if (0)`: el compilador sigue
+ * verificando formato y argumentos, pero no genera código, no evalúa los argumentos y la cadena de
+ * formato no llega a la flash (también con -O0). Sólo los mensajes habilitados pasan por
+ * uart_print() y su vsnprintf, o por un registro binario con LOG_TOKENIZADO.
+ *
+ * Este header se incluye únicamente desde archivos .c, después de definir LOG_NIVEL_MODULO.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_LOG_H_
+#define INC_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Definiciones públicas de macros
+ * ======================================================== */
+
+/** @defgroup LOG_NIVELES Niveles de log (de mayor a menor severidad) */
+/** @{ */
+#define LOG_NIVEL_NINGUNO 0 /**< Umbral que silencia el módulo por completo */
+#define LOG_NIVEL_ERROR   1 /**< Fallas que pierden datos o requieren intervención */
+#define LOG_NIVEL_WARN    2 /**< Condiciones anómalas de las que el sistema se recupera */
+#define LOG_NIVEL_INFO    3 /**< Eventos normales de la operación (promedios, montaje) */
+#define LOG_NIVEL_DEBUG   4 /**< Detalle de mediciones y estados para depuración */
+#define LOG_NIVEL_TRACE   5 /**< Entrada a funciones y pasos intermedios */
+/** @} */
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "log_config.h"
+#include "uart.h"
+
+#ifndef LOG_NIVEL_MODULO
+#define LOG_NIVEL_MODULO LOG_NIVEL_GLOBAL
+#endif
+
+/**
+ * @brief Salida de los mensajes habilitados: texto con uart_print() o, con LOG_TOKENIZADO,
+ * registro binario sin vsnprintf (ver log_token.h). En modo binario el formato debe ser un literal.
+ */
+#if LOG_TOKENIZADO
+#include "log_token.h"
+#define LOG_EMITIR(...) LOG_TOKEN(__VA_ARGS__)
+#else
+#define LOG_EMITIR(...) uart_print(__VA_ARGS__)
+#endif
+
+/**
+ * @brief Verdadero si el módulo imprime mensajes de @p nivel. Vale en `#if` y en expresiones,
+ * para omitir trabajo previo a un mensaje (armar buffers, recorrer tablas).
+ */
+#define LOG_ACTIVO(nivel) (LOG_NIVEL_MODULO >= (nivel))
+
+/** @brief Mensaje deshabilitado: se compila para verificar el formato pero no genera código. */
+#define LOG_DESCARTAR(...)                                                                         \
+    do {                                                                                           \
+        if (0) {                                                                                   \
+            uart_print(__VA_ARGS__);                                                               \
+        }                                                                                          \
+    } while (0)
+
+#if LOG_ACTIVO(LOG_NIVEL_ERROR)
+#define LOG_ERROR(...) LOG_EMITIR(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOG_DESCARTAR(__VA_ARGS__)
+#endif
+
+#if LOG_ACTIVO(LOG_NIVEL_WARN)
+#define LOG_WARN(...) LOG_EMITIR(__VA_ARGS__)
+#else
+#define LOG_WARN(...) LOG_DESCARTAR(__VA_ARGS__)
+#endif
+
+#if LOG_ACTIVO(LOG_NIVEL_INFO)
+#define LOG_INFO(...) LOG_EMITIR(__VA_ARGS__)
+#else
+#define LOG_INFO(...) LOG_DESCARTAR(__VA_ARGS__)
+#endif
+
+#if LOG_ACTIVO(LOG_NIVEL_DEBUG)
+#define LOG_DEBUG(...) LOG_EMITIR(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOG_DESCARTAR(__VA_ARGS__)
+#endif
+
+#if LOG_ACTIVO(LOG_NIVEL_TRACE)
+#define LOG_TRACE(...) LOG_EMITIR(__VA_ARGS__)
+#else
+#define LOG_TRACE(...) LOG_DESCARTAR(__VA_ARGS__)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LOG_H_ */
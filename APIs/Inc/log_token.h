@@ -0,0 +1,156 @@
+/**
+ * @file log_token.h
+ * @brief Registros binarios del log: identificador del formato más los argumentos sin formatear.
+ *
+ * Con LOG_TOKENIZADO cada mensaje de log.h deja de pasar por vsnprintf. La cadena de formato se
+ * guarda en la sección `log_fmt` y el mensaje viaja como su desplazamiento dentro de esa sección
+ * seguido de los argumentos en binario. En el host, tools/log_tokens.py arma la tabla de
+ * formatos desde el ELF y reconstruye el texto.
+ *
+ * Registro en la línea serie:
+ *
+ * | Byte | Contenido                                                    |
+ * |------|--------------------------------------------------------------|
+ * | 0    | LOG_TOKEN_MARCA (0xFF, nunca aparece en texto UTF-8)         |
+ * | 1    | Largo de los argumentos en bytes                             |
+ * | 2-3  | Identificador del formato, little endian                     |
+ * | 4..  | Argumentos en el orden de la llamada                         |
+ * | fin  | '\n', para que la cola (uart_log) descarte líneas enteras    |
+ *
+ * Argumentos: enteros como varint zigzag de 32 bits (1 byte hasta ±63), float y double como
+ * float IEEE-754 de 4 bytes, cadenas copiadas hasta LOG_TOKEN_CADENA_MAX caracteres y terminadas
+ * en '\0'. El tipo sale del argumento (_Generic), no del formato: el decodificador recorre los
+ * especificadores del formato para leerlos. Hasta 8 argumentos por mensaje.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_LOG_TOKEN_H_
+#define INC_LOG_TOKEN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "log_config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Definiciones públicas de macros
+ * ======================================================== */
+
+#define LOG_TOKEN_MARCA 0xFFu /**< Primer byte de cada registro */
+#define LOG_TOKEN_FIN   '\n'  /**< Último byte de cada registro */
+
+/** @brief Sección de las cadenas de formato; su desplazamiento es el identificador. */
+#define LOG_TOKEN_SECCION __attribute__((section("log_fmt"), used))
+
+/**
+ * @brief Emite un registro binario. El primer argumento debe ser un literal de cadena.
+ */
+#define LOG_TOKEN(...)                                                                             \
+    do {                                                                                           \
+        static const char LOG_TOKEN_SECCION log_token_fmt[] = LOG_TOKEN_PRIMERO(__VA_ARGS__, ~);   \
+        LogToken_Registro log_token_reg;                                                           \
+        log_token_inicio(&log_token_reg, log_token_fmt);                                           \
+        LOG_TOKEN_ARGS(&log_token_reg, __VA_ARGS__)                                                \
+        log_token_enviar(&log_token_reg);                                                          \
+    } while (0)
+
+/** @brief Codifica un argumento según su tipo. */
+#define LOG_TOKEN_ARG(reg, x)                                                                      \
+    _Generic((x),                                                                                  \
+        float: log_token_real,                                                                     \
+        double: log_token_real,                                                                    \
+        char *: log_token_cadena,                                                                  \
+        const char *: log_token_cadena,                                                            \
+        default: log_token_entero)((reg), (x));
+
+/* Recorrido de los argumentos que siguen al formato (hasta 8) */
+#define LOG_TOKEN_PRIMERO(fmt, ...) fmt
+#define LOG_TOKEN_CONTAR(...)       LOG_TOKEN_CONTAR_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#define LOG_TOKEN_CONTAR_(fmt, a1, a2, a3, a4, a5, a6, a7, a8, n, ...) n
+#define LOG_TOKEN_UNIR(a, b)        LOG_TOKEN_UNIR_(a, b)
+#define LOG_TOKEN_UNIR_(a, b)       a##b
+#define LOG_TOKEN_ARGS(reg, ...)                                                                   \
+    LOG_TOKEN_UNIR(LOG_TOKEN_ARGS_, LOG_TOKEN_CONTAR(__VA_ARGS__))(reg, __VA_ARGS__)
+
+#define LOG_TOKEN_ARGS_0(r, f)
+#define LOG_TOKEN_ARGS_1(r, f, a)          LOG_TOKEN_ARG(r, a)
+#define LOG_TOKEN_ARGS_2(r, f, a, b)       LOG_TOKEN_ARGS_1(r, f, a) LOG_TOKEN_ARG(r, b)
+#define LOG_TOKEN_ARGS_3(r, f, a, b, c)    LOG_TOKEN_ARGS_2(r, f, a, b) LOG_TOKEN_ARG(r, c)
+#define LOG_TOKEN_ARGS_4(r, f, a, b, c, d) LOG_TOKEN_ARGS_3(r, f, a, b, c) LOG_TOKEN_ARG(r, d)
+#define LOG_TOKEN_ARGS_5(r, f, a, b, c, d, e)                                                      \
+    LOG_TOKEN_ARGS_4(r, f, a, b, c, d) LOG_TOKEN_ARG(r, e)
+#define LOG_TOKEN_ARGS_6(r, f, a, b, c, d, e, g)                                                   \
+    LOG_TOKEN_ARGS_5(r, f, a, b, c, d, e) LOG_TOKEN_ARG(r, g)
+#define LOG_TOKEN_ARGS_7(r, f, a, b, c, d, e, g, h)                                                \
+    LOG_TOKEN_ARGS_6(r, f, a, b, c, d, e, g) LOG_TOKEN_ARG(r, h)
+#define LOG_TOKEN_ARGS_8(r, f, a, b, c, d, e, g, h, i)                                             \
+    LOG_TOKEN_ARGS_7(r, f, a, b, c, d, e, g, h) LOG_TOKEN_ARG(r, i)
+
+/* === Declaraciones públicas de tipos de datos
+ * ============================================== */
+
+/**
+ * @brief Registro en construcción, en la pila del llamador.
+ */
+typedef struct {
+    uint8_t datos[4 + LOG_TOKEN_REGISTRO_MAX + 1]; /**< Cabecera, argumentos y fin */
+    uint8_t largo;                                 /**< Bytes de argumentos escritos */
+    bool truncado;                                 /**< Algún argumento no entró */
+} LogToken_Registro;
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Arranca un registro para el formato dado (que debe estar en la sección log_fmt).
+ */
+void log_token_inicio(LogToken_Registro * reg, const char * formato);
+
+/**
+ * @brief Agrega un entero (cualquier tipo entero, hasta 32 bits).
+ */
+void log_token_entero(LogToken_Registro * reg, int32_t valor);
+
+/**
+ * @brief Agrega un real; los double se envían con precisión simple.
+ */
+void log_token_real(LogToken_Registro * reg, float valor);
+
+/**
+ * @brief Agrega una cadena (NULL se envía como cadena vacía).
+ */
+void log_token_cadena(LogToken_Registro * reg, const char * cadena);
+
+/**
+ * @brief Cierra el registro y lo envía por la UART de depuración con uart_write_bytes().
+ *
+ * Si un argumento no entró se envían los anteriores completos; el decodificador marca el resto
+ * como truncado.
+ */
+void log_token_enviar(LogToken_Registro * reg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LOG_TOKEN_H_ */
@@ -53,6 +53,7 @@ extern "C" {
 
 #define RESERVED_CLUSTERS 2   /**< Número de clústeres reservados */
 #define BYTES_PER_SECTOR  512 /**< Tamaño de un sector en bytes */
+#define BENCHMARK_SECTORES_BUFFER 4 /**< Sectores por transferencia en microSD_benchmark() */
 #define SECTORS_TO_KILOBYTES_CONVERSION_FACTOR                                                     \
     0.5 /**< Factor de conversión de sectores a kilobytes */
 
@@ -117,6 +118,17 @@ void microSD_destroy(MicroSD * sd);
  */
 void microSD_getSize(MicroSD * sd);
 
+/**
+ * @brief Mide la lectura y escritura secuencial de la tarjeta y envía los KB/s por UART.
+ *
+ * Relee y reescribe con su propio contenido los últimos @p sectores de la tarjeta, de a
+ * BENCHMARK_SECTORES_BUFFER por transferencia (ver SD_BENCHMARK en fatfs_sd.h).
+ *
+ * @param sd Puntero a la estructura MicroSD.
+ * @param sectores Sectores a medir.
+ */
+void microSD_benchmark(MicroSD * sd, DWORD sectores);
+
 /**
  * @brief Escribe datos en el archivo especificado en la tarjeta microSD.
  *
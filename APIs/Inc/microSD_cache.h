@@ -0,0 +1,134 @@
+/**
+ * @file microSD_cache.h
+ * @brief Caché de archivos abiertos para los registros que crecen por el final (RAW y AVG10).
+ *
+ * Abrir y cerrar el archivo en cada línea obliga a FatFs a recorrer los directorios de la ruta,
+ * releer el sector de datos parcial y reescribir la entrada de directorio: varios sectores por
+ * SPI para agregar unos 100 bytes. La caché mantiene abiertos los archivos del día y acumula las
+ * líneas en RAM. Al llenarse el buffer escribe sólo sectores completos, alineados con la posición
+ * del archivo, en un único f_write: FatFs los pasa directo al disco (CMD25 si son varios) sin leer
+ * ni reescribir sectores parciales. Después hace f_sync, y el resto parcial queda en RAM.
+ *
+ * Las líneas pendientes se escriben completas (aunque dejen un sector parcial) cuando la más vieja
+ * supera MICROSD_CACHE_SYNC_MS (microSD_cache_procesar(), desde el lazo principal), al cerrar el
+ * archivo o con microSD_cache_sincronizar(). Ante un corte de energía se pierden como máximo
+ * MICROSD_CACHE_BUFFER bytes o MICROSD_CACHE_SYNC_MS de cada archivo. Con la tabla llena se
+ * cierra el archivo usado hace más tiempo, así que el cambio de día no requiere manejo aparte.
+ *
+ * También recuerda si ya existe el directorio `/YYYY/MM/DD` del día: cada f_mkdir o f_stat recorre
+ * las tablas de directorio por SPI, y con la fecha en caché una muestra no hace ninguno. La fecha
+ * se invalida al cambiar, al cerrar todo (cambio de tarjeta) y si un f_open devuelve FR_NO_PATH.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_MICROSD_CACHE_H_
+#define INC_MICROSD_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "ff.h"
+#include "microSD_cache_config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* El lock de FatFs cuenta los archivos abiertos: debe quedar lugar para los que abren otros
+ * módulos (lecturas, listados de directorio) */
+#if defined(_FS_LOCK) && (_FS_LOCK != 0) && (MICROSD_CACHE_ARCHIVOS >= _FS_LOCK)
+#error "MICROSD_CACHE_ARCHIVOS debe ser menor que _FS_LOCK (ffconf.h)"
+#endif
+
+#if (MICROSD_CACHE_BUFFER % _MAX_SS) != 0 || MICROSD_CACHE_BUFFER < 2 * _MAX_SS
+#error "MICROSD_CACHE_BUFFER debe ser múltiplo de _MAX_SS y de al menos dos sectores"
+#endif
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Agrega bytes al final de un archivo, abriéndolo si no está en la caché.
+ *
+ * Al abrir un archivo vacío escribe primero los @p largo_encabezado bytes de @p encabezado. Los
+ * datos quedan en RAM hasta que completan sectores o vence MICROSD_CACHE_SYNC_MS. Si FatFs falla,
+ * el archivo se cierra y lo pendiente se pierde; la próxima llamada lo vuelve a abrir.
+ *
+ * @param ruta Ruta absoluta (menos de MICROSD_CACHE_RUTA_MAX caracteres).
+ * @param datos Bytes a agregar (p. ej. un registro binario de registro_raw.h).
+ * @param largo Cantidad de bytes.
+ * @param encabezado Contenido inicial de un archivo nuevo.
+ * @param largo_encabezado Bytes del encabezado, o 0 si no lleva.
+ * @return FR_OK, o el error de FatFs (FR_INVALID_NAME si la ruta es demasiado larga).
+ */
+FRESULT microSD_cache_agregar(const char * ruta, const void * datos, size_t largo,
+                              const void * encabezado, size_t largo_encabezado);
+
+/**
+ * @brief Agrega una línea de texto al final de un archivo (ver microSD_cache_agregar()).
+ *
+ * @param ruta Ruta absoluta (menos de MICROSD_CACHE_RUTA_MAX caracteres).
+ * @param linea Texto a agregar, con su fin de línea.
+ * @param encabezado Texto para un archivo nuevo, o NULL.
+ * @return FR_OK, o el error de FatFs (FR_INVALID_NAME si la ruta es demasiado larga).
+ */
+FRESULT microSD_cache_agregar_linea(const char * ruta, const char * linea,
+                                    const char * encabezado);
+
+/**
+ * @brief Asegura que exista `/YYYY/MM/DD`, sin tocar la tarjeta si es el día de la llamada anterior.
+ *
+ * Al cambiar la fecha crea sólo los niveles que cambiaron (FR_EXIST cuenta como éxito).
+ *
+ * @return FR_OK, o el error de f_mkdir (la fecha no queda en caché).
+ */
+FRESULT microSD_cache_directorio_dia(uint16_t anio, uint8_t mes, uint8_t dia);
+
+/**
+ * @brief Indica si el archivo está abierto en la caché.
+ *
+ * Permite omitir el armado de un encabezado costoso, que sólo se usa al abrir.
+ */
+bool microSD_cache_abierto(const char * ruta);
+
+/**
+ * @brief Aplica la política por tiempo: escribe y sincroniza los archivos cuya línea más vieja en
+ * RAM supera MICROSD_CACHE_SYNC_MS. Llamar periódicamente desde el lazo principal.
+ */
+void microSD_cache_procesar(void);
+
+/**
+ * @brief Escribe y sincroniza todo lo pendiente, sin cerrar los archivos.
+ * @return FR_OK, o el primer error encontrado.
+ */
+FRESULT microSD_cache_sincronizar(void);
+
+/**
+ * @brief Escribe lo pendiente y cierra todos los archivos. Llamar antes de desmontar la tarjeta.
+ * @return FR_OK, o el primer error encontrado.
+ */
+FRESULT microSD_cache_cerrar_todos(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MICROSD_CACHE_H_ */
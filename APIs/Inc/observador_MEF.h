@@ -39,7 +39,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "pm25_buffer.h"    // Aquí está definido BufferCircularSensor
+#include "pm25_buffer.h"
 #include "config_sistema.h" // Aquí debe estar MAX_SENSORES_SPS30
 
 /* === Cabecera C++ ============================================================================ */
@@ -67,7 +67,7 @@ typedef enum {
 
 /* === Public variable declarations ============================================================ */
 
-extern BufferCircularSensor buffers_10min[MAX_SENSORES_SPS30];
+extern AcumuladorSensor buffers_10min[MAX_SENSORES_SPS30];
 
 /* === Public function declarations ============================================================ */
 /**
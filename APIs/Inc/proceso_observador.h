@@ -35,6 +35,7 @@
  **/
 
 #include "sps30_comm.h"
+#include "sps30_multi.h"
 #include "time_rtc.h"
 #include "uart.h"
 #include "observador_MEF.h"
@@ -92,6 +93,25 @@ bool proceso_observador_3PM_2TH(SPS30 * sensor, uint8_t sensor_id, const char *
 bool proceso_observador_with_time(SPS30 * sensor, uint8_t sensor_id, const char * datetime_str,
                                   float temp_amb, float hum_amb);
 
+/**
+ * @brief Ejecuta un ciclo de adquisición concurrente sobre todos los sensores SPS30.
+ *
+ * Inicia todos los sensores, espera el tiempo de estabilización una sola vez, los lee en paralelo
+ * y reintenta (hasta NUM_REINT rondas) sólo los que fallaron. Cada lectura válida se registra en
+ * el CSV RAW igual que en proceso_observador_3PM_2TH().
+ *
+ * @param datetime_str Timestamp formateado como cadena
+ * @param temp_amb Temperatura ambiente (°C)
+ * @param hum_amb Humedad relativa ambiente (%)
+ * @param temp_cam Temperatura de cámara (°C)
+ * @param hum_cam Humedad de cámara (%)
+ * @param resultados Arreglo de NUM_SENSORES_SPS30 resultados (índice = posición en
+ * sensores_sps30)
+ * @return Cantidad de lecturas válidas registradas
+ */
+int proceso_observador_ciclo(const char * datetime_str, float temp_amb, float hum_amb,
+                             float temp_cam, float hum_cam, SPS30_Adquisicion resultados[]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,80 @@
+/**
+ * @file punto_fijo.h
+ * @brief Conversión exacta de float a enteros escalados (centésimas, décimas...) y su texto.
+ *
+ * punto_fijo_desde_float() redondea el valor binario exacto del float a la cantidad de decimales
+ * pedida, al par más cercano, con aritmética entera: es la misma regla que usa printf("%.Nf"), así
+ * que punto_fijo_escribir() arma exactamente el mismo texto que snprintf("%.Nf") sin llamar a
+ * printf. El rango es el de un int32 escalado: hasta ±21474836,47 con dos decimales.
+ *
+ * formato_csv lo usa para los campos decimales de las líneas RAW y de promedios; las concentraciones
+ * se escriben en centésimas de µg/m³ (PUNTO_FIJO_DECIMALES_MP).
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_PUNTO_FIJO_H_
+#define INC_PUNTO_FIJO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* === Definiciones públicas de macros
+ * ======================================================== */
+
+#define PUNTO_FIJO_DECIMALES_MP 2  /**< Centésimas de µg/m³ */
+#define PUNTO_FIJO_DECIMALES_MAX 3 /**< Máximo de decimales que se convierten */
+#define PUNTO_FIJO_TEXTO_MAX    16 /**< "-2147483.648" y el '\0', con margen */
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Convierte un float a entero escalado por 10^decimales, redondeando al par más cercano.
+ * @param decimales 0 a PUNTO_FIJO_DECIMALES_MAX.
+ * @param valor Resultado (con signo). Un negativo que redondea a cero queda en 0.
+ * @return false si x es NaN, infinito o no entra en un int32.
+ */
+bool punto_fijo_desde_float(float x, uint8_t decimales, int32_t * valor);
+
+/**
+ * @brief Escribe un entero escalado como número con @p decimales cifras decimales ("-12.05").
+ * @param destino Al menos PUNTO_FIJO_TEXTO_MAX bytes.
+ * @return Caracteres escritos, sin contar el '\0'.
+ */
+size_t punto_fijo_formatear(char * destino, int32_t valor, uint8_t decimales);
+
+/**
+ * @brief Escribe @p x como snprintf("%.Nf"), con la conversión entera.
+ * @param destino Al menos PUNTO_FIJO_TEXTO_MAX bytes.
+ * @return Caracteres escritos, o 0 (sin escribir nada) si punto_fijo_desde_float() falla.
+ */
+size_t punto_fijo_escribir(char * destino, float x, uint8_t decimales);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_PUNTO_FIJO_H_ */
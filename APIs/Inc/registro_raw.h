@@ -0,0 +1,130 @@
+/**
+ * @file registro_raw.h
+ * @brief Formatos de los archivos de mediciones sin procesar: línea CSV y registro binario.
+ *
+ * Cada muestra ocupa unos 110 bytes como línea CSV. El formato binario guarda la misma muestra
+ * en un registro fijo de REGISTRO_RAW_TAM_REGISTRO bytes dentro de un archivo por sensor y día
+ * (`/YYYY/MM/DD/RAW_<ID>_YYYYMMDD.BIN`). El archivo empieza con un encabezado de un sector que
+ * lleva la fecha, el serial y la ubicación del sensor y el esquema de los campos; los registros
+ * quedan alineados con los sectores (16 por sector). tools/raw_bin_a_csv.py regenera el CSV
+ * anterior, encabezado `#` incluido, byte por byte.
+ *
+ * Encabezado (little endian):
+ *
+ * | Byte    | Contenido                                                          |
+ * |---------|--------------------------------------------------------------------|
+ * | 0-7     | REGISTRO_RAW_MAGIA ("SPS30RAW")                                    |
+ * | 8-9     | Versión del formato (REGISTRO_RAW_VERSION)                         |
+ * | 10-11   | Tamaño del encabezado                                              |
+ * | 12-13   | Tamaño de cada registro                                            |
+ * | 14      | Cantidad de campos del esquema                                     |
+ * | 15      | sensor_id                                                          |
+ * | 16-19   | Año (2 bytes), mes, día                                            |
+ * | 20-59   | Serial del sensor, terminado en '\0'                               |
+ * | 60-123  | Ubicación, terminada en '\0'                                       |
+ * | 124-155 | Coordenadas, terminadas en '\0'                                    |
+ * | 160..   | Esquema: por campo nombre[13], tipo, decimales, desplazamiento     |
+ *
+ * Los valores se guardan como enteros en unidades de la última cifra que imprime la línea CSV
+ * (0,1 o 0,001). La conversión redondea el valor exacto del float al par más cercano, igual que
+ * printf("%.1f"), así que el texto regenerado coincide con el que escribía el equipo. Dos códigos
+ * reservados cubren lo que un entero no representa: REGISTRO_RAW_MENOS_CERO para los negativos que
+ * printf muestra como "-0.0" y REGISTRO_RAW_INVALIDO_* para NaN o valores fuera de rango (o
+ * negativos en campos sin signo), que se exportan como "nan".
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_REGISTRO_RAW_H_
+#define INC_REGISTRO_RAW_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "ParticulateDataAnalyzer.h"
+#include "registro_raw_config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* === Definiciones públicas de macros
+ * ======================================================== */
+
+#define REGISTRO_RAW_MAGIA             "SPS30RAW"
+#define REGISTRO_RAW_VERSION           1
+#define REGISTRO_RAW_TAM_ENCABEZADO    512 /**< Un sector: los registros quedan alineados */
+#define REGISTRO_RAW_TAM_REGISTRO      32
+#define REGISTRO_RAW_TAM_SERIAL        40
+#define REGISTRO_RAW_TAM_UBICACION     64
+#define REGISTRO_RAW_TAM_COORDENADAS   32
+#define REGISTRO_RAW_TAM_NOMBRE_CAMPO  13
+#define REGISTRO_RAW_INICIO_ESQUEMA    160
+#define REGISTRO_RAW_TAM_CAMPO         16
+
+/** Tipos de campo del esquema */
+#define REGISTRO_RAW_TIPO_U8  1
+#define REGISTRO_RAW_TIPO_U16 2
+#define REGISTRO_RAW_TIPO_I16 3
+
+/** Códigos reservados */
+#define REGISTRO_RAW_INVALIDO_U16 0xFFFFu /**< NaN, negativo o mayor que 6553,4 */
+#define REGISTRO_RAW_INVALIDO_I16 INT16_MAX /**< NaN o fuera de ±3276,6 */
+#define REGISTRO_RAW_MENOS_CERO   INT16_MIN /**< Negativo que se redondea a cero: "-0.0" */
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Formatea una línea CSV a partir de los datos
+ * @param data Estructura con los datos
+ * @param csv_line Cadena de salida
+ * @param max_len Longitud máxima permitida
+ * @return true si la línea entró completa en el buffer
+ */
+bool format_csv_line(const ParticulateData * data, char * csv_line, size_t max_len);
+
+/**
+ * @brief Arma el encabezado `#` de un archivo RAW en formato CSV.
+ * @return Largo del texto (truncado a max_len - 1, como snprintf).
+ */
+size_t registro_raw_encabezado_csv(char * destino, size_t max_len, uint8_t sensor_id,
+                                   const char * serial, const char * ubicacion,
+                                   const char * coordenadas);
+
+/**
+ * @brief Arma el encabezado de un archivo RAW binario con la fecha de @p data.
+ * @param destino Buffer de REGISTRO_RAW_TAM_ENCABEZADO bytes.
+ */
+void registro_raw_encabezado_bin(uint8_t * destino, const ParticulateData * data,
+                                 const char * serial, const char * ubicacion,
+                                 const char * coordenadas);
+
+/**
+ * @brief Codifica una muestra como registro binario.
+ * @param destino Buffer de REGISTRO_RAW_TAM_REGISTRO bytes.
+ */
+void registro_raw_codificar(const ParticulateData * data, uint8_t * destino);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_REGISTRO_RAW_H_ */
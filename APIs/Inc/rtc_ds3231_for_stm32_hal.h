@@ -53,9 +53,13 @@ extern "C" {
 #define DS3231_REG_DATE     0x04
 #define DS3231_REG_MONTH    0x05
 #define DS3231_REG_YEAR     0x06
+#define DS3231_REG_CONTROL  0x0E
 #define DS3231_REG_TEMP_MSB 0x11
 #define DS3231_REG_TEMP_LSB 0x12
 #define DS3231_TIMEOUT      100
+
+/** Control: oscilador encendido, INTCN = 0 y RS = 00 (SQW de 1 Hz) */
+#define DS3231_CONTROL_SQW_1HZ 0x00
 /* === Public data type declarations =========================================================== */
 /* === Estructura de fecha y hora ============================================================= */
 
@@ -104,6 +108,11 @@ bool DS3231_GetDateTime(DS3231_DateTime * dt);
  */
 bool DS3231_SetDateTime(const DS3231_DateTime * dt);
 
+/**
+ * @brief Configura la salida SQW/INT como onda cuadrada de 1 Hz (base_tiempo.c con SQW).
+ */
+bool DS3231_EnableSQW1Hz(void);
+
 /**
  * @brief Obtiene la temperatura interna del DS3231.
  * @return Temperatura en grados Celsius.
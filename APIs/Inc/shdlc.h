@@ -31,6 +31,7 @@
  **/
 
 /* === Inclusión de archivos de cabecera ======================================================== */
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -39,8 +40,58 @@
 #define FRAME_DATA_VECTOR_SIZE_MISO 60
 #define SPS30_ERR_STATE_MASK        0x8000
 
+#define SHDLC_FRAME_DELIMITER       0x7E // Delimitador de inicio y fin de frame
+#define SHDLC_ESCAPE_BYTE           0x7D // Indicador de byte-stuffing
+#define SHDLC_ESCAPE_XOR            0x20 // Máscara para recuperar el byte original
+#define SHDLC_MISO_HEADER_SIZE      4    // adr + cmd + state + len
+#define SHDLC_MISO_OVERHEAD         7    // 2 delimitadores + cabecera + chk
+#define SHDLC_STATE_ERROR_MASK      0x7F // Código de error dentro del byte de estado
+
 /* === Declaraciones de tipos de datos públicos ================================================= */
 
+#define SPS30_NUM_VALORES_MEDICION  10 // 4 de masa + 5 de número + tamaño típico
+
+/**
+ * @struct ConcentracionesNumero
+ * @brief Concentraciones en número y tamaño típico de partícula informados por el SPS30.
+ *
+ * Llegan en el mismo frame de READ_MEASUREMENT que las concentraciones de masa (bytes 16 a 39).
+ *
+ * @param nc0_5  Concentración en número PM0.5 [#/cm³]
+ * @param nc1_0  Concentración en número PM1.0 [#/cm³]
+ * @param nc2_5  Concentración en número PM2.5 [#/cm³]
+ * @param nc4_0  Concentración en número PM4.0 [#/cm³]
+ * @param nc10   Concentración en número PM10 [#/cm³]
+ * @param tamano_tipico Tamaño típico de partícula [µm]
+ */
+typedef struct {
+    float nc0_5;
+    float nc1_0;
+    float nc2_5;
+    float nc4_0;
+    float nc10;
+    float tamano_tipico;
+} ConcentracionesNumero;
+
+/**
+ * @struct ConcentracionesPMU16
+ * @brief Registro de medición del SPS30 en formato de salida uint16 (enteros, sin float).
+ *
+ * Mismo orden que el payload: masa [µg/m³], número [#/cm³] y tamaño típico [nm].
+ */
+typedef struct {
+    uint16_t pm1_0;
+    uint16_t pm2_5;
+    uint16_t pm4_0;
+    uint16_t pm10;
+    uint16_t nc0_5;
+    uint16_t nc1_0;
+    uint16_t nc2_5;
+    uint16_t nc4_0;
+    uint16_t nc10;
+    uint16_t tamano_tipico_nm;
+} ConcentracionesPMU16;
+
 // Definición de la estructura para las concentraciones
 /**
  * @struct ConcentracionesPM
@@ -50,12 +101,15 @@
  * @param pm2_5  Concentración de partículas PM2.5 [µg/m³]
  * @param pm4_0  Concentración de partículas PM4.0 [µg/m³]
  * @param pm10   Concentración de partículas PM10 [µg/m³]
+ * @param numero Resto del registro: concentraciones en número y tamaño típico (cero si el frame
+ *               sólo trae masa).
  */
 typedef struct {
     float pm1_0;
     float pm2_5;
     float pm4_0;
     float pm10;
+    ConcentracionesNumero numero;
 } ConcentracionesPM;
 
 /**
@@ -95,6 +149,7 @@ typedef struct Shdlc_FrameMosi {
  * @param adr Dirección del dispositivo origen. Indica de qué dispositivo esclavo proviene el frame.
  * @param cmd Comando ejecutado o respuesta proporcionada por el dispositivo esclavo. Puede ser una
  * confirmación de un comando previo del maestro o una solicitud de información.
+ * @param state Byte de estado informado por el esclavo (0x00 si la ejecución fue correcta).
  * @param lon Longitud de los datos útiles en el frame. Este campo especifica cuántos bytes del
  * arreglo myVector contienen datos significativos.
  * @param myVector Arreglo que contiene los datos recibidos en respuesta al comando del maestro. Su
@@ -107,32 +162,171 @@ typedef struct Shdlc_FrameMosi {
 typedef struct Shdlc_FrameMiso {
     uint8_t adr;
     uint8_t cmd;
+    uint8_t state;
     uint8_t lon;
     uint8_t myVector[FRAME_DATA_VECTOR_SIZE_MISO];
     uint8_t chk;
     uint8_t longframe;
 } Shdlc_FrameMiso;
 
+/**
+ * @enum Shdlc_Error
+ * @brief Resultado de la recepción y validación de un frame MISO.
+ */
+typedef enum {
+    SHDLC_OK = 0,          /**< Frame válido */
+    SHDLC_ERROR_TIMEOUT,   /**< No llegó un frame completo a tiempo */
+    SHDLC_ERROR_FRAME,     /**< Delimitadores o byte-stuffing inválidos */
+    SHDLC_ERROR_LENGTH,    /**< Longitud distinta de la declarada o de la esperada */
+    SHDLC_ERROR_CHECKSUM,  /**< Checksum no coincide */
+    SHDLC_ERROR_ADDRESS,   /**< Dirección de esclavo inesperada */
+    SHDLC_ERROR_COMMAND,   /**< El comando no es eco del enviado */
+    SHDLC_ERROR_STATE,     /**< El esclavo informó un error en el byte de estado */
+    SHDLC_ERROR_NO_DATA,   /**< Frame válido sin datos: el esclavo aún no tiene respuesta nueva */
+} Shdlc_Error;
+
+/**
+ * @enum Shdlc_StreamStatus
+ * @brief Resultado de entregar bytes al decodificador incremental SHDLC.
+ */
+typedef enum {
+    SHDLC_STREAM_INCOMPLETE = 0, /**< El frame aún no termina; se esperan más bytes */
+    SHDLC_STREAM_COMPLETE,       /**< Se recibió un frame completo y con checksum válido */
+    SHDLC_STREAM_ERROR,          /**< Frame descartado (checksum, longitud o escape inválido) */
+} Shdlc_StreamStatus;
+
+/**
+ * @enum Shdlc_StreamState
+ * @brief Estados internos del decodificador incremental SHDLC.
+ */
+typedef enum {
+    SHDLC_STREAM_WAIT_START = 0, /**< Descartando bytes hasta encontrar 0x7E */
+    SHDLC_STREAM_IN_FRAME,       /**< Recibiendo cabecera, datos y checksum */
+} Shdlc_StreamState;
+
+/**
+ * @struct Shdlc_StreamDecoder
+ * @brief Contexto del decodificador SHDLC de una sola pasada.
+ *
+ * Revierte el byte-stuffing, ubica cada byte en su campo de @ref Shdlc_FrameMiso y acumula el
+ * checksum a medida que llegan los bytes, de modo que el frame queda validado al recibir el 0x7E
+ * de cierre. Cada UART debe tener su propio contexto.
+ *
+ * @param state Estado actual de la máquina.
+ * @param escape Indica que el byte anterior fue 0x7D.
+ * @param index Cantidad de bytes (sin stuffing) recibidos dentro del frame actual.
+ * @param sum Suma acumulada de adr + cmd + state + len + datos.
+ * @param error Motivo del último @ref SHDLC_STREAM_ERROR.
+ * @param frame Frame en construcción; es válido sólo tras @ref SHDLC_STREAM_COMPLETE.
+ */
+typedef struct {
+    Shdlc_StreamState state;
+    uint8_t escape;
+    uint8_t index;
+    uint8_t sum;
+    Shdlc_Error error;
+    Shdlc_FrameMiso frame;
+} Shdlc_StreamDecoder;
+
 /* === Declaraciones de funciones públicas ====================================================== */
 
 // Función para convertir 4 bytes en un valor float IEEE754
 float SHDLC_bytesToFloat(uint8_t * bytes);
 
-// Función para llenar la estructura con los datos de concentración
+// Función para llenar la estructura con los datos de concentración (sólo masa, 16 bytes)
 void SHDLC_llenarConcentraciones(ConcentracionesPM * concentraciones, uint8_t * data);
 
+/**
+ * @brief Decodifica el registro completo de READ_MEASUREMENT (formato float).
+ *
+ * Convierte hasta SPS30_NUM_VALORES_MEDICION floats big-endian: masa, número y tamaño típico. Los
+ * valores que no alcanzan a estar en @p lon quedan en cero.
+ *
+ * @param concentraciones Registro de salida.
+ * @param data Datos del frame sin stuffing (myVector).
+ * @param lon Bytes de datos del frame.
+ */
+void SHDLC_llenarMedicion(ConcentracionesPM * concentraciones, const uint8_t * data, uint8_t lon);
+
+/**
+ * @brief Decodifica el registro de READ_MEASUREMENT en formato uint16, sin aritmética float.
+ *
+ * @param concentraciones Registro entero de salida; los valores ausentes en @p lon quedan en cero.
+ * @param data Datos del frame sin stuffing (myVector).
+ * @param lon Bytes de datos del frame.
+ */
+void SHDLC_llenarMedicionU16(ConcentracionesPMU16 * concentraciones, const uint8_t * data,
+                             uint8_t lon);
+
+/**
+ * @brief Convierte un registro uint16 a ConcentracionesPM (tamaño típico de nm a µm).
+ */
+void SHDLC_ConcentracionesDesdeU16(ConcentracionesPM * destino, const ConcentracionesPMU16 * origen);
+
+/**
+ * @brief Revierte el byte-stuffing de un frame MISO sobre el mismo buffer y verifica su checksum.
+ *
+ * Recorre el buffer una sola vez, desde el primer 0x7E hasta el de cierre, y compacta el contenido
+ * al comienzo del buffer: buf[0..len) queda como adr, cmd, state, lon, datos y chk. No requiere
+ * un segundo buffer ni un Shdlc_FrameMiso.
+ *
+ * @param buf Bytes recibidos con stuffing; se sobrescriben.
+ * @param len Entrada: bytes válidos en buf. Salida: bytes del contenido sin stuffing.
+ * @return SHDLC_OK, SHDLC_ERROR_FRAME (sin delimitadores o escape inválido), SHDLC_ERROR_LENGTH
+ *         o SHDLC_ERROR_CHECKSUM. Ante un error buf queda parcialmente modificado.
+ */
+Shdlc_Error SHDLC_UnstuffFrameInPlace(uint8_t * buf, size_t * len);
+
+/**
+ * @brief Desarma un frame MISO en el mismo buffer y lo valida como SHDLC_ValidateFrame().
+ *
+ * Tras un SHDLC_OK buf[0..len) queda como adr, cmd, state, lon, datos y chk, y los datos se
+ * decodifican directamente desde &buf[SHDLC_MISO_HEADER_SIZE].
+ *
+ * @param buf Frame recibido con stuffing; se sobrescribe.
+ * @param len Entrada: bytes válidos en buf. Salida: bytes del contenido si el frame está íntegro
+ *        (checksum correcto), aunque falle otra verificación; 0 ante un error de framing.
+ * @param adr Dirección esperada del esclavo.
+ * @param cmd Comando esperado.
+ * @param lon_esperada Bytes de datos esperados, o -1 para aceptar cualquier longitud.
+ * @return SHDLC_OK o el motivo del rechazo, en el orden de SHDLC_ValidateFrame().
+ */
+Shdlc_Error SHDLC_ValidateFrameInPlace(uint8_t * buf, size_t * len, uint8_t adr, uint8_t cmd,
+                                       int lon_esperada);
+
+/**
+ * @brief Decodifica una respuesta a READ_MEASUREMENT (formato float) directo a ConcentracionesPM.
+ *
+ * Desarma y valida el frame en el mismo buffer con SHDLC_ValidateFrameInPlace() y convierte los
+ * float big-endian con un intercambio de bytes (__REV en el target). Se decodifica el registro
+ * completo presente en el frame (ver SHDLC_llenarMedicion()).
+ *
+ * @param buf Frame recibido con stuffing; se sobrescribe.
+ * @param len Bytes válidos en buf.
+ * @param adr Dirección esperada del esclavo.
+ * @param cmd Comando esperado.
+ * @param conc Concentraciones decodificadas (sin cambios si hubo error).
+ * @return SHDLC_OK o el motivo del rechazo.
+ */
+Shdlc_Error SHDLC_DecodeConcentracionesInPlace(uint8_t * buf, size_t len, uint8_t adr,
+                                               uint8_t cmd, ConcentracionesPM * conc);
+
 /**
  * @brief Carga el vector de datos myVector de una estructura Shdlc_FrameMiso basado
  * 		  en los datos contenidos en un arreglo DataFrame.
  *
+ * Además de copiar los datos, completa adr, cmd, state y chk, y verifica el checksum.
+ *
  * @param frame Un puntero a una estructura Shdlc_FrameMiso donde se cargará myVector.
- * @param DataFrame Un arreglo de bytes que contiene los datos a copiar en myVector.
- * @param DataFrameSize El tamaño total del arreglo DataFrame para evitar
- *        desbordamientos de búfer.
- * @return void
+ * @param DataFrame Un arreglo de bytes (sin byte-stuffing, comenzando en 0x7E) que contiene los
+ *        datos a copiar en myVector.
+ * @param DataFrameSize Cantidad de bytes entre los delimitadores, tal como la devuelve
+ *        SHDLC_CalculateDataSize(); DataFrame debe contener además el 0x7E inicial.
+ * @return SHDLC_OK, SHDLC_ERROR_FRAME, SHDLC_ERROR_LENGTH o SHDLC_ERROR_CHECKSUM.
  */
 
-void SHDLC_LoadMyVector(Shdlc_FrameMiso * frame, const uint8_t * DataFrame, size_t DataFrameSize);
+Shdlc_Error SHDLC_LoadMyVector(Shdlc_FrameMiso * frame, const uint8_t * DataFrame,
+                               size_t DataFrameSize);
 
 /**
  * @brief Obtiene un frame MISO (Master In Slave Out) de ejemplo o de respuesta de una operación
@@ -176,4 +370,70 @@ int SHDLC_CalculateDataSize(const uint8_t * input, size_t inputSize);
 size_t SHDLC_revertByteStuffing(const uint8_t * stuffedData, size_t stuffedSize,
                                 uint8_t * originalData);
 
+/**
+ * @brief Reinicia el decodificador incremental para esperar un nuevo frame.
+ *
+ * @param decoder Contexto del decodificador.
+ */
+void SHDLC_StreamInit(Shdlc_StreamDecoder * decoder);
+
+/**
+ * @brief Entrega un byte recibido al decodificador incremental.
+ *
+ * @param decoder Contexto del decodificador.
+ * @param byte Byte tal como llega por la UART (con byte-stuffing).
+ * @return SHDLC_STREAM_COMPLETE cuando el byte cierra un frame válido (disponible en
+ * decoder->frame), SHDLC_STREAM_ERROR si el frame en curso fue descartado, o
+ * SHDLC_STREAM_INCOMPLETE en otro caso.
+ */
+Shdlc_StreamStatus SHDLC_StreamFeedByte(Shdlc_StreamDecoder * decoder, uint8_t byte);
+
+/**
+ * @brief Entrega un bloque de bytes (por ejemplo, desde una ISR o DMA) al decodificador.
+ *
+ * Se detiene en cuanto se completa o descarta un frame, para que el llamador pueda consumir el
+ * resultado antes de continuar con el resto del bloque.
+ *
+ * @param decoder Contexto del decodificador.
+ * @param data Bytes recibidos.
+ * @param size Cantidad de bytes en @p data.
+ * @param consumed Si no es NULL, recibe la cantidad de bytes procesados.
+ * @return Igual que @ref SHDLC_StreamFeedByte para el último byte procesado.
+ */
+Shdlc_StreamStatus SHDLC_StreamFeed(Shdlc_StreamDecoder * decoder, const uint8_t * data,
+                                    size_t size, size_t * consumed);
+
+/**
+ * @brief Valida un frame MISO antes de decodificar sus datos.
+ *
+ * Verifica, en este orden, checksum, dirección, eco del comando, byte de estado y longitud. Un
+ * frame con estado de error suele traer longitud 0, por eso el estado se revisa antes.
+ *
+ * @param frame Frame recibido.
+ * @param adr Dirección esperada del esclavo.
+ * @param cmd Comando enviado.
+ * @param lon_esperada Cantidad exacta de bytes de datos esperados, o -1 para no verificarla.
+ * @return SHDLC_OK si el frame es utilizable; en otro caso, el primer error encontrado.
+ */
+Shdlc_Error SHDLC_ValidateFrame(const Shdlc_FrameMiso * frame, uint8_t adr, uint8_t cmd,
+                                int lon_esperada);
+
+/**
+ * @brief Indica si conviene repetir inmediatamente la lectura ante un error.
+ *
+ * Los errores de transporte (timeout, stuffing, checksum, longitud, o una respuesta atrasada a
+ * otro comando) se resuelven con una relectura breve. Un error de estado lo informa el propio
+ * esclavo y requiere otra acción (por ejemplo, iniciar la medición). Tampoco se repite ante
+ * SHDLC_ERROR_NO_DATA: el dato nuevo no llega antes del próximo período de medición.
+ *
+ * @param error Error obtenido.
+ * @return true si el error es transitorio.
+ */
+bool SHDLC_IsTransientError(Shdlc_Error error);
+
+/**
+ * @brief Texto descriptivo de un error, para mensajes por UART.
+ */
+const char * SHDLC_ErrorString(Shdlc_Error error);
+
 #endif /* INC_SHDLC_H_ */
@@ -59,11 +59,16 @@ typedef struct SPS30 SPS30;
 typedef struct SPS30 {
     UART_HandleTypeDef * huart;
     char serial_buf[SERIAL_BUFFER_LEN]; // Buffer para guardar número de serie
+    uint8_t formato; // SPS30_FORMATO_FLOAT o SPS30_FORMATO_UINT16 (aplicado en start_measurement)
+    bool midiendo;   // Desde un start_measurement aceptado hasta stop_measurement
 
     // Métodos
     void (*send_command)(struct SPS30 * self, const uint8_t * command, uint16_t commandSize);
     void (*receive_async)(struct SPS30 * self, uint8_t * dataBuffer, uint16_t bufferSize);
 
+    // Recepción de un frame SHDLC crudo, con stuffing, hasta el 0x7E de cierre
+    Shdlc_Error (*receive_frame)(struct SPS30 * self, uint8_t * buf, size_t size, size_t * len);
+
     // Cambiado de void a bool
     bool (*send_receive)(struct SPS30 * self, const uint8_t * command, uint16_t commandSize,
                          uint8_t * dataBuffer, uint16_t bufferSize);
@@ -71,13 +76,21 @@ typedef struct SPS30 {
     void (*start_measurement)(struct SPS30 * self);
     void (*stop_measurement)(struct SPS30 * self);
     void (*sleep)(struct SPS30 * self);
-    void (*read_data)(struct SPS30 * self);
 
     // También declarada correctamente como bool
     bool (*serial_number)(struct SPS30 * self, char * out_serial);
 
     void (*wake_up)(struct SPS30 * self);
     ConcentracionesPM (*get_concentrations)(struct SPS30 * self);
+
+    // Lectura validada (checksum, dirección, comando, estado y longitud) con relecturas breves
+    Shdlc_Error (*read_concentrations)(struct SPS30 * self, ConcentracionesPM * conc);
+
+    // Lectura entera, sin float; requiere formato SPS30_FORMATO_UINT16
+    Shdlc_Error (*read_concentrations_u16)(struct SPS30 * self, ConcentracionesPMU16 * conc);
+
+    // Un solo READ, sin relecturas, para medición continua (SHDLC_ERROR_NO_DATA sin dato nuevo)
+    Shdlc_Error (*poll_concentrations)(struct SPS30 * self, ConcentracionesPM * conc);
 } SPS30;
 /* === Public variable declarations
  * ============================================================ */
@@ -85,8 +98,43 @@ typedef struct SPS30 {
 /* === Public function declarations
  * ============================================================ */
 
-// Prototipos de funciones para inicializar el objeto SPS30
-void SPS30_init(SPS30 * self, UART_HandleTypeDef * huart);
+/**
+ * @brief Inicializa el objeto SPS30.
+ *
+ * @param self Instancia a inicializar.
+ * @param huart UART conectada al sensor.
+ * @param formato Formato de salida pedido en START_MEASUREMENT: SPS30_FORMATO_FLOAT o
+ *        SPS30_FORMATO_UINT16. El formato uint16 reduce el frame de 47 a 27 bytes y evita float
+ *        en la decodificación, con resolución de 1 µg/m³.
+ */
+void SPS30_init(SPS30 * self, UART_HandleTypeDef * huart, uint8_t formato);
+
+/**
+ * @brief Bytes de datos que debe traer READ_MEASUREMENT según el formato configurado.
+ */
+uint8_t sps30_longitud_medicion(const SPS30 * self);
+
+/**
+ * @brief Desarma en el mismo buffer y valida una respuesta a READ_MEASUREMENT.
+ *
+ * Sobre UART el SPS30 no tiene comando de dato disponible: si no hay una medición nueva desde la
+ * última lectura responde READ con lon = 0, que aquí se informa como SHDLC_ERROR_NO_DATA.
+ *
+ * @param self Instancia del sensor (define el formato).
+ * @param buf Frame recibido con stuffing; queda con el contenido sin stuffing.
+ * @param len Bytes recibidos en @p buf.
+ * @return SHDLC_OK, SHDLC_ERROR_NO_DATA o el error de SHDLC_ValidateFrameInPlace().
+ */
+Shdlc_Error sps30_validar_medicion(const SPS30 * self, uint8_t * buf, size_t len);
+
+/**
+ * @brief Decodifica a ConcentracionesPM una respuesta ya validada, sin copiarla.
+ *
+ * @param self Instancia del sensor (define el formato).
+ * @param buf Contenido dejado por sps30_validar_medicion() con SHDLC_OK.
+ * @param conc Registro de salida.
+ */
+void sps30_decodificar_medicion(const SPS30 * self, const uint8_t * buf, ConcentracionesPM * conc);
 
 bool sps30_serial_number(SPS30 * self, char * out_serial);
 
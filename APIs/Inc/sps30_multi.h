@@ -43,15 +43,62 @@ extern "C" {
 /* === Declaraciones públicas de tipos de datos
  * ============================================== */
 
+typedef struct SensorSPS30 SensorSPS30;
+
+/**
+ * @brief Callback de recepción por sensor.
+ *
+ * Se invoca desde la interrupción de la UART (línea ociosa, medio o fin de buffer DMA) después de
+ * copiar los bytes nuevos al ring buffer del sensor. Debe ser breve.
+ *
+ * @param sensor Sensor que recibió datos.
+ * @param nuevos Cantidad de bytes agregados al ring buffer.
+ */
+typedef void (*SPS30_RxCallback)(SensorSPS30 * sensor, uint16_t nuevos);
+
+/**
+ * @brief Ring buffer de bytes crudos recibidos por un sensor.
+ *
+ * Un solo productor (ISR) avanza @c head y un solo consumidor (lazo principal) avanza @c tail,
+ * por lo que no requiere deshabilitar interrupciones.
+ */
+typedef struct {
+  uint8_t datos[SPS30_RX_RING_SIZE];
+  volatile uint16_t head;        /**< Próxima posición a escribir (ISR) */
+  volatile uint16_t tail;        /**< Próxima posición a leer */
+  volatile uint32_t descartados; /**< Bytes perdidos por ring lleno */
+} SPS30_RingBuffer;
+
 /**
  * @brief Estructura que representa un sensor SPS30 con su configuración
  * asociada.
  */
-typedef struct {
+struct SensorSPS30 {
   SPS30 sensor;             /**< Objeto de comunicación SPS30 */
   uint8_t id;               /**< ID único del sensor */
   UART_HandleTypeDef *uart; /**< UART asociada al sensor */
-} SensorSPS30;
+
+  uint8_t dma_buf[SPS30_RX_DMA_BUFFER_SIZE]; /**< Destino del DMA circular */
+  uint16_t dma_pos;                          /**< Última posición del DMA ya copiada */
+  SPS30_RingBuffer rx;                       /**< Bytes pendientes de decodificar */
+  SPS30_RxCallback on_rx;                    /**< Callback de recepción (opcional) */
+  bool dma_activo;                           /**< Recepción DMA en curso */
+};
+
+/**
+ * @brief Resultado por sensor de un ciclo de adquisición concurrente.
+ */
+typedef struct {
+  ConcentracionesPM pm; /**< Concentraciones leídas (cero si no hubo lectura válida) */
+  bool valido;          /**< Lectura recibida y aceptada por el validador */
+  uint8_t intentos;     /**< Rondas de lectura usadas por el sensor */
+  Shdlc_Error error;    /**< Resultado SHDLC de la última lectura */
+} SPS30_Adquisicion;
+
+/**
+ * @brief Criterio de aceptación de una lectura (por ejemplo, rango de concentraciones).
+ */
+typedef bool (*SPS30_Validador)(const ConcentracionesPM *pm);
 
 /* === Declaraciones públicas de variables
  * ==================================================== */
@@ -70,6 +117,121 @@ extern int sensores_disponibles;
  */
 void inicializar_sensores_sps30(void);
 
+/**
+ * @brief Inicia la recepción DMA circular con detección de línea ociosa para un sensor.
+ *
+ * Si tiene éxito, los métodos de recepción del objeto SPS30 pasan a leer desde el ring buffer
+ * del sensor, de modo que el resto del código no cambia.
+ *
+ * @param s Sensor a configurar.
+ * @return true si la UART aceptó la recepción DMA.
+ */
+bool sps30_multi_rx_dma_iniciar(SensorSPS30 *s);
+
+/**
+ * @brief Registra el callback de recepción de un sensor.
+ *
+ * @param s Sensor.
+ * @param cb Callback a invocar desde la ISR, o NULL para desactivarlo.
+ */
+void sps30_multi_set_callback(SensorSPS30 *s, SPS30_RxCallback cb);
+
+/**
+ * @brief Extrae bytes crudos del ring buffer de un sensor.
+ *
+ * @param s Sensor.
+ * @param destino Buffer de salida.
+ * @param max Capacidad de @p destino.
+ * @return Cantidad de bytes copiados.
+ */
+uint16_t sps30_multi_rx_leer(SensorSPS30 *s, uint8_t *destino, uint16_t max);
+
+/**
+ * @brief Solicita la medición a todos los sensores a la vez y espera las respuestas en paralelo.
+ *
+ * Envía READ_MEASUREMENT a cada sensor disponible y luego decodifica los ring buffers hasta
+ * recibir todas las respuestas o agotar SPS30_UART_TIMEOUT_MS, por lo que el tiempo total es el
+ * del sensor más lento y no la suma de los tres. Cada respuesta se valida con
+ * SHDLC_ValidateFrame(); ante un error transitorio se repite sólo la lectura de ese sensor, hasta
+ * SPS30_RELECTURAS veces.
+ *
+ * @param conc Arreglo de NUM_SENSORES_SPS30 concentraciones (índice = posición en sensores_sps30).
+ * @param errores Arreglo de NUM_SENSORES_SPS30 resultados SHDLC (SHDLC_OK si la lectura es válida).
+ * @return Cantidad de sensores con respuesta válida.
+ */
+int sps30_multi_leer_todos(ConcentracionesPM conc[], Shdlc_Error errores[]);
+
+/**
+ * @brief Igual que sps30_multi_leer_todos(), pero sólo para los sensores indicados.
+ *
+ * @param solicitar Arreglo de NUM_SENSORES_SPS30 indicadores; NULL equivale a todos.
+ * @param conc Concentraciones leídas (cero si no hubo respuesta válida).
+ * @param errores Resultado SHDLC por sensor.
+ * @return Cantidad de sensores con respuesta válida.
+ * @note Sólo se escriben las posiciones de los sensores solicitados.
+ */
+int sps30_multi_leer_seleccion(const bool solicitar[], ConcentracionesPM conc[],
+                               Shdlc_Error errores[]);
+
+/**
+ * @brief Ciclo de adquisición concurrente de todos los sensores SPS30.
+ *
+ * En cada ronda inicia la medición en todos los sensores pendientes, espera SPS30_WARMUP_MS una
+ * sola vez, los lee en paralelo y detiene la medición. Sólo los sensores cuya lectura falló o fue
+ * rechazada por @p validar pasan a la ronda siguiente, de modo que el tiempo del ciclo no crece
+ * con la cantidad de sensores.
+ *
+ * En modo continuo (sps30_multi_set_continuo()) los sensores quedan midiendo entre ciclos: sólo
+ * se envía START, con su espera, a los que no están midiendo, y un ciclo en régimen es un único
+ * READ por sensor. Si la respuesta llega sin datos (SHDLC_ERROR_NO_DATA) o es rechazada, la ronda
+ * siguiente espera SPS30_PERIODO_MEDICION_MS al dato nuevo; sólo un error de comunicación o de
+ * estado detiene el sensor para reiniciarlo en la ronda siguiente.
+ *
+ * @param resultados Arreglo de NUM_SENSORES_SPS30 resultados (índice = posición en
+ * sensores_sps30).
+ * @param max_intentos Cantidad máxima de rondas (p. ej. NUM_REINT).
+ * @param validar Criterio de aceptación; NULL acepta toda lectura recibida.
+ * @return Cantidad de sensores con lectura válida.
+ */
+int sps30_multi_adquirir(SPS30_Adquisicion resultados[], uint8_t max_intentos,
+                         SPS30_Validador validar);
+
+/**
+ * @brief Selecciona el modo de adquisición de sps30_multi_adquirir().
+ *
+ * El valor inicial es SPS30_MODO_CONTINUO. Al pasar al modo por ciclo se detienen los sensores
+ * que estaban midiendo.
+ *
+ * @param continuo true para dejar los sensores midiendo entre ciclos; false para start/stop en
+ *        cada ciclo.
+ */
+void sps30_multi_set_continuo(bool continuo);
+
+/**
+ * @brief Indica si la adquisición está en modo continuo.
+ */
+bool sps30_multi_es_continuo(void);
+
+/**
+ * @brief Evento de recepción DMA (línea ociosa, mitad o fin del buffer circular) de una UART.
+ *
+ * Lo llama HAL_UARTEx_RxEventCallback() (uart_callbacks.c); ignora las UART que no son de un
+ * sensor.
+ *
+ * @param huart UART que generó el evento.
+ * @param Size Posición actual del DMA dentro del buffer circular del sensor.
+ */
+void sps30_multi_rx_evento(UART_HandleTypeDef * huart, uint16_t Size);
+
+/**
+ * @brief Error de una UART (overrun, ruido, framing): la HAL abortó el DMA y se reinicia.
+ *
+ * Lo llama HAL_UART_ErrorCallback() (uart_callbacks.c); ignora las UART que no son de un sensor.
+ *
+ * @param huart UART que informó el error.
+ */
+void sps30_multi_error(UART_HandleTypeDef * huart);
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,6 +48,14 @@ extern UART_HandleTypeDef * uart_debug;
  */
 void uart_print(const char * format, ...);
 
+/**
+ * @brief Envía bytes sin formato por la UART de depuración (registros binarios del log).
+ *
+ * @param datos Bytes a enviar.
+ * @param n Cantidad de bytes.
+ */
+void uart_write_bytes(const uint8_t * datos, uint16_t n);
+
 /**
  * @brief Imprime un vector de datos como una cadena de hexadecimales a través
  * de UART3.
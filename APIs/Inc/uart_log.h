@@ -0,0 +1,132 @@
+/**
+ * @file uart_log.h
+ * @brief Cola del log de depuración, vaciada por DMA en segundo plano.
+ *
+ * uart_print() formatea el mensaje y lo copia a un ring buffer; el envío por la UART de
+ * depuración lo hace el DMA, encadenando transferencias desde el callback de fin de transmisión.
+ * Así la escritura de un mensaje cuesta una copia de memoria y no el tiempo de la línea serie
+ * (~87 µs por byte a 115200 bps).
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR.
+ * Ver la Licencia Pública General GNU para más detalles.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+#ifndef INC_UART_LOG_H_
+#define INC_UART_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Inclusión de archivos de cabecera
+ * ====================================================== */
+#include "stm32f4xx_hal.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Declaraciones públicas de tipos de datos
+ * ============================================== */
+
+/**
+ * @brief Qué se descarta cuando un mensaje no entra en la cola.
+ */
+typedef enum {
+  UART_LOG_DESCARTAR_NUEVOS = 0, /**< Se pierde el mensaje nuevo completo */
+  UART_LOG_DESCARTAR_ANTIGUOS,   /**< Se pierden las líneas más viejas aún no enviadas */
+} UartLog_Politica;
+
+#include "uart_log_config.h"
+
+#if (UART_LOG_BUFFER_SIZE & (UART_LOG_BUFFER_SIZE - 1)) != 0
+#error "UART_LOG_BUFFER_SIZE debe ser potencia de 2"
+#endif
+
+/* === Declaraciones públicas de funciones
+ * ==================================================== */
+
+/**
+ * @brief Asocia la cola a la UART de depuración y la vacía.
+ *
+ * La UART debe tener un stream DMA de transmisión enlazado (hdmatx) y su interrupción habilitada.
+ *
+ * @param huart UART de depuración.
+ * @param politica Comportamiento con la cola llena.
+ */
+void uart_log_init(UART_HandleTypeDef *huart, UartLog_Politica politica);
+
+/**
+ * @brief Indica si uart_log_init() ya se llamó.
+ */
+bool uart_log_activo(void);
+
+/**
+ * @brief Encola bytes para la UART de depuración sin esperar la transmisión.
+ *
+ * Si el DMA está libre inicia la transferencia en el momento. Con la cola llena aplica la
+ * política configurada y suma los bytes perdidos a uart_log_descartados().
+ *
+ * @param datos Bytes a enviar.
+ * @param n Cantidad de bytes.
+ * @return Cantidad de bytes encolados (0 si se descartó el mensaje o la cola no está activa).
+ */
+uint16_t uart_log_escribir(const uint8_t *datos, uint16_t n);
+
+/**
+ * @brief Envía todo lo pendiente con transmisión bloqueante.
+ *
+ * Apta para los manejadores de falla y Error_Handler(): no depende de interrupciones ni de
+ * HAL_GetTick(). Detiene el DMA en curso, envía la parte del tramo que no había salido y luego la
+ * cola, escribiendo en la UART byte a byte. Cada espera está acotada por UART_LOG_FLUSH_ESPERA_MAX
+ * vueltas: si la UART no responde, lo que falta se suma a uart_log_descartados() y la función
+ * vuelve igual.
+ */
+void uart_log_flush(void);
+
+/**
+ * @brief Error de la UART de depuración; lo llama HAL_UART_ErrorCallback() (uart_callbacks.c).
+ *
+ * Si la HAL cortó la transmisión (error del DMA), el tramo en vuelo se da por perdido (se suma a
+ * uart_log_descartados()) y el DMA sigue con el resto de la cola. Ignora las demás UART.
+ *
+ * @param huart UART que informó el error.
+ */
+void uart_log_error(UART_HandleTypeDef *huart);
+
+/**
+ * @brief Fin de una transferencia DMA de la UART de depuración: encadena el tramo siguiente.
+ *
+ * Lo llama HAL_UART_TxCpltCallback() (uart_callbacks.c). Ignora las demás UART.
+ *
+ * @param huart UART que terminó de transmitir.
+ */
+void uart_log_tx_completo(UART_HandleTypeDef *huart);
+
+/**
+ * @brief Bytes perdidos por cola llena o errores de la UART desde uart_log_init().
+ */
+uint32_t uart_log_descartados(void);
+
+/**
+ * @brief Bytes en la cola, incluida la transferencia en curso.
+ */
+uint16_t uart_log_pendientes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_UART_LOG_H_ */
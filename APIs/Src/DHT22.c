@@ -36,28 +36,8 @@
 
 /* === Private macros definitions =============================================================== */
 
-#define DELAY_T_BE              1000 // Host the start signal down time 0.8 1 20 m S
-#define DELAY_T_GO              20   // Bus master has released time 20 30 200 µ S
-#define DELAY_T_REL             80   // Response to low time 75 80 85 µ S
-#define DELAY_T_REH             80   // In response to high time 75 80 85 µ S
-
-#define NUM_BITS                5   // Número de bytes leídos del sensor DHT22 (40 bits)
-#define INIT_BITS               0   // Valor inicial para los bits leídos
-#define INIT_CHECKSUM           0   // Valor inicial para el checksum
-#define INIT_TIMEOUT            100 // Valor de timeout inicial para las operaciones de espera
-#define FIN_TIMEOUT             0   // Valor de timeout final para indicar expiración
-
-#define DHT22_DATA_BITS         40 // Número total de bits de datos leídos del sensor DHT22
-#define DHT22_DATA_BYTES        (DHT22_DATA_BITS / 8) // Número de bytes de datos (5 bytes)
-
-#define DHT22_HUMIDITY_SHIFT    8   // Desplazamiento para los datos de humedad
-#define DHT22_TEMPERATURE_SHIFT 8   // Desplazamiento para los datos de temperatura
-#define DHT22_CONVERSION_FACTOR 0.1 // Factor de conversión para los datos leídos
-
-#define DHT22_BYTE_BITS         8 // Número de bits en un byte
-
-#define DHT22_TIMEOUT           100 // Valor de timeout para la lectura de bits individuales
-#define DHT22_BIT_DELAY         30 // Retraso en microsegundos para asegurar una lectura precisa de bits
+#define DELAY_T_BE 1000 // Host the start signal down time 0.8 1 20 m S
+#define US_POR_MHZ 1000000u
 
 /* === Private function declarations ============================================================ */
 
@@ -94,47 +74,64 @@ void DHT22_Init(DHT22_HandleTypeDef * dht, GPIO_TypeDef * GPIOx, uint16_t GPIO_P
  * @retval int Estado de la operación: DHT22_OK si es exitoso, código de error si falla.
  */
 int DHT22_Read(DHT22_HandleTypeDef * dht, DHT22_Data * data) {
-    uint8_t bits[NUM_BITS] = {INIT_BITS}; // Array para almacenar los bits leídos
-    uint8_t checksum = INIT_CHECKSUM;     // Inicializar el checksum
-
-    // Enviar señal de inicio
-    DHT22_StartSignal(dht);
-
-    // Esperar respuesta del sensor: DHT22 debe poner el pin en bajo por 80 µs y luego en alto por
-    // 80 µs
-    uint32_t timeout = INIT_TIMEOUT;
-    while (HAL_GPIO_ReadPin(dht->GPIOx, dht->GPIO_Pin) == GPIO_PIN_SET) {
-        if (--timeout == FIN_TIMEOUT) {
-            return DHT22_ERROR_PIN_HIGH; // Error si el pin permanece en alto
-        }
+    int estado;
+
+    DHT22_ReadMultiple(&dht, data, &estado, 1);
+    return estado;
+}
+
+/**
+ * @brief Lee varios sensores DHT22 a la vez.
+ *
+ * Baja todas las líneas durante el mismo pulso de inicio de 1 ms, las suelta y deja que la EXTI
+ * de cada pin guarde sus flancos mientras se espera el último o DHT22_CAPTURA_TIMEOUT_US. Las
+ * tramas se decodifican después, fuera de la interrupción: otra interrupción durante la lectura
+ * ya no corrompe los bits, sólo atrasa un flanco unos ciclos.
+ *
+ * @param[in] dhts Sensores a leer.
+ * @param[out] datos Lectura de cada sensor (sólo válida si su estado es DHT22_OK).
+ * @param[out] estados Estado de cada sensor: DHT22_OK o el código de error.
+ * @param[in] cantidad Cantidad de sensores (hasta DHT22_MAX_SENSORES).
+ *
+ * @retval int DHT22_OK si todos los sensores respondieron bien, DHT22_ERROR si alguno falló.
+ */
+int DHT22_ReadMultiple(DHT22_HandleTypeDef * const dhts[], DHT22_Data datos[], int estados[],
+                       uint8_t cantidad) {
+    uint32_t ciclos_por_us = SystemCoreClock / US_POR_MHZ;
+    int resultado = DHT22_OK;
+
+    // Señal de inicio común: todas las líneas en bajo durante 1 ms
+    for (uint8_t i = 0; i < cantidad; i++) {
+        DHT22_SetPinOutput(dhts[i]);
+        HAL_GPIO_WritePin(dhts[i]->GPIOx, dhts[i]->GPIO_Pin, GPIO_PIN_RESET);
+    }
+    DWT_Delay(DELAY_T_BE);
+    for (uint8_t i = 0; i < cantidad; i++) {
+        DHT22_IniciarCaptura(dhts[i]);
     }
-    DWT_Delay(DELAY_T_REL); // Esperar 80 µs
 
-    timeout = INIT_TIMEOUT;
-    while (HAL_GPIO_ReadPin(dht->GPIOx, dht->GPIO_Pin) == GPIO_PIN_RESET) {
-        if (--timeout == FIN_TIMEOUT) {
-            return DHT22_ERROR_PIN_LOW; // Error si el pin permanece en bajo
+    // Esperar las tramas: la interrupción guarda los flancos
+    uint32_t inicio = DWT->CYCCNT;
+    bool completas = false;
+    while (!completas && (DWT->CYCCNT - inicio) < DHT22_CAPTURA_TIMEOUT_US * ciclos_por_us) {
+        completas = true;
+        for (uint8_t i = 0; i < cantidad; i++) {
+            completas = completas && DHT22_CapturaCompleta(&dhts[i]->captura);
         }
     }
-    DWT_Delay(DELAY_T_REH); // Esperar 80 µs
 
-    // Leer los 40 bits de datos (5 bytes)
-    for (uint8_t i = 0; i < DHT22_DATA_BYTES; i++) {
-        bits[i] = DHT22_ReadByte(dht);
-    }
+    for (uint8_t i = 0; i < cantidad; i++) {
+        uint8_t bytes[DHT22_CAPTURA_BYTES];
 
-    // Calcular el checksum
-    checksum = bits[0] + bits[1] + bits[2] + bits[3];
-    if (checksum != bits[4]) {
-        return DHT22_ERROR_CHECKSUM; // Error si el checksum no coincide
+        DHT22_DetenerCaptura(dhts[i]);
+        estados[i] = DHT22_CapturaDecodificar(&dhts[i]->captura, ciclos_por_us, bytes);
+        if (estados[i] == DHT22_OK) {
+            DHT22_CapturaConvertir(bytes, &datos[i].temperatura, &datos[i].humedad);
+        } else {
+            resultado = DHT22_ERROR;
+        }
     }
-
-    // Convertir los datos
-    data->humedad =
-        ((bits[0] << DHT22_HUMIDITY_SHIFT) | bits[1]) * DHT22_CONVERSION_FACTOR; // Calcular humedad
-    data->temperatura = ((bits[2] << DHT22_TEMPERATURE_SHIFT) | bits[3]) *
-                        DHT22_CONVERSION_FACTOR; // Calcular temperatura
-    return DHT22_OK;                             // Operación exitosa
+    return resultado;
 }
 
 /**
@@ -0,0 +1,93 @@
+/**
+ * @file DHT22_Captura.c
+ * @brief Trama del DHT22 a partir de los períodos entre flancos descendentes.
+ *
+ * Cada período se mide de un flanco descendente al siguiente (resta sin signo de DWT->CYCCNT, así
+ * que la vuelta del contador no molesta) y se compara contra un umbral fijo entre el ~76 µs de un
+ * 0 y el ~120 µs de un 1. Un período fuera de rango descarta la trama aunque el checksum cierre.
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "DHT22_Captura.h"
+
+/* === Definiciones de macros privadas ======================================================== */
+
+#define RESPUESTA_MIN_US 120u /**< 75 + 75 µs de la hoja de datos, con margen */
+#define RESPUESTA_MAX_US 200u /**< 85 + 85 µs, con margen */
+#define BIT_MIN_US       55u  /**< 48 + 22 µs (un 0 corto), con margen */
+#define BIT_MAX_US       160u /**< 55 + 75 µs (un 1 largo), con margen */
+#define BIT_UMBRAL_US    98u  /**< A partir de acá el bit es un 1 */
+#define BITS_POR_BYTE    8u
+
+#define SIGNO_TEMPERATURA 0x8000u
+
+/* === Funciones públicas ===================================================================== */
+
+void DHT22_CapturaReiniciar(DHT22_Captura * cap) {
+    cap->cantidad = 0;
+}
+
+void DHT22_CapturaFlanco(DHT22_Captura * cap, uint32_t marca) {
+    uint8_t n = cap->cantidad;
+
+    if (n < DHT22_CAPTURA_FLANCOS) {
+        cap->marcas[n] = marca;
+    }
+    if (n < UINT8_MAX) {
+        cap->cantidad = (uint8_t)(n + 1u);
+    }
+}
+
+bool DHT22_CapturaCompleta(const DHT22_Captura * cap) {
+    return cap->cantidad >= DHT22_CAPTURA_FLANCOS;
+}
+
+int DHT22_CapturaDecodificar(const DHT22_Captura * cap, uint32_t ciclos_por_us,
+                             uint8_t datos[DHT22_CAPTURA_BYTES]) {
+    uint8_t cantidad = cap->cantidad;
+
+    if (cantidad == 0u) {
+        return DHT22_ERROR_PIN_HIGH;
+    }
+    if (cantidad != DHT22_CAPTURA_FLANCOS) {
+        return DHT22_ERROR_RESPONSE;
+    }
+
+    uint32_t respuesta = cap->marcas[1] - cap->marcas[0];
+    if (respuesta < RESPUESTA_MIN_US * ciclos_por_us ||
+        respuesta > RESPUESTA_MAX_US * ciclos_por_us) {
+        return DHT22_ERROR_RESPONSE;
+    }
+
+    for (uint8_t i = 0; i < DHT22_CAPTURA_BYTES; i++) {
+        datos[i] = 0;
+    }
+    for (uint8_t bit = 0; bit < DHT22_CAPTURA_BYTES * BITS_POR_BYTE; bit++) {
+        uint32_t periodo = cap->marcas[bit + 2u] - cap->marcas[bit + 1u];
+
+        if (periodo < BIT_MIN_US * ciclos_por_us || periodo > BIT_MAX_US * ciclos_por_us) {
+            return DHT22_ERROR_RESPONSE;
+        }
+        datos[bit / BITS_POR_BYTE] = (uint8_t)((datos[bit / BITS_POR_BYTE] << 1) |
+                                               (periodo >= BIT_UMBRAL_US * ciclos_por_us));
+    }
+
+    uint8_t checksum = (uint8_t)(datos[0] + datos[1] + datos[2] + datos[3]);
+    return (checksum == datos[4]) ? DHT22_OK : DHT22_ERROR_CHECKSUM;
+}
+
+void DHT22_CapturaConvertir(const uint8_t datos[DHT22_CAPTURA_BYTES], float * temperatura,
+                            float * humedad) {
+    uint16_t crudo_humedad = (uint16_t)((datos[0] << 8) | datos[1]);
+    uint16_t crudo_temperatura = (uint16_t)((datos[2] << 8) | datos[3]);
+    float modulo = (float)(crudo_temperatura & ~SIGNO_TEMPERATURA) * 0.1f;
+
+    *humedad = (float)crudo_humedad * 0.1f;
+    *temperatura = (crudo_temperatura & SIGNO_TEMPERATURA) ? -modulo : modulo;
+}
+
+/* === End of documentation ==================================================================== */
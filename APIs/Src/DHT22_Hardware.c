@@ -34,10 +34,6 @@
 
 /* === Macros definitions ====================================================================== */
 
-#define DHT22_BIT_DELAY 30
-#define DHT22_TIMEOUT   100
-#define DHT22_BYTE_BITS 8
-
 /* === Private data type declarations ========================================================== */
 
 /* === Private variable declarations =========================================================== */
@@ -48,8 +44,50 @@
 
 /* === Private variable definitions ============================================================ */
 
+/** Sensores inicializados, para encontrar el handle de un pin desde la interrupción */
+static DHT22_HandleTypeDef * sensores[DHT22_MAX_SENSORES];
+static uint8_t cantidad_sensores = 0;
+
 /* === Private function implementation ========================================================= */
 
+/**
+ * @brief Anota el handle para DHT22_FlancoEXTI(); volver a inicializarlo no lo repite.
+ */
+static void registrar_sensor(DHT22_HandleTypeDef * dht) {
+    for (uint8_t i = 0; i < cantidad_sensores; i++) {
+        if (sensores[i] == dht) {
+            return;
+        }
+    }
+    if (cantidad_sensores < DHT22_MAX_SENSORES) {
+        sensores[cantidad_sensores++] = dht;
+    }
+}
+
+/**
+ * @brief Interrupción que comparte la línea EXTI del pin (EXTIn = pin n, de cualquier puerto).
+ */
+static IRQn_Type irq_del_pin(uint16_t GPIO_Pin) {
+    if (GPIO_Pin >= GPIO_PIN_10) {
+        return EXTI15_10_IRQn;
+    }
+    if (GPIO_Pin >= GPIO_PIN_5) {
+        return EXTI9_5_IRQn;
+    }
+    switch (GPIO_Pin) {
+    case GPIO_PIN_0:
+        return EXTI0_IRQn;
+    case GPIO_PIN_1:
+        return EXTI1_IRQn;
+    case GPIO_PIN_2:
+        return EXTI2_IRQn;
+    case GPIO_PIN_3:
+        return EXTI3_IRQn;
+    default:
+        return EXTI4_IRQn;
+    }
+}
+
 /* === Public function implementation ========================================================== */
 
 /**
@@ -68,6 +106,8 @@
 void DHT22_InitHardware(DHT22_HandleTypeDef * dht, GPIO_TypeDef * GPIOx, uint16_t GPIO_Pin) {
     dht->GPIOx = GPIOx;
     dht->GPIO_Pin = GPIO_Pin;
+    dht->capturando = false;
+    registrar_sensor(dht);
 
     // Habilitar el reloj para el puerto GPIO específico
     if (GPIOx == GPIOA)
@@ -128,82 +168,71 @@ void DHT22_SetPinInput(DHT22_HandleTypeDef * dht) {
 }
 
 /**
- * @brief Envía la señal de inicio al sensor DHT22.
+ * @brief Suelta la línea y empieza a guardar los flancos descendentes del sensor.
  *
- * Esta función configura el pin GPIO como salida, envía una señal de inicio
- * al DHT22 y luego lo configura como entrada para recibir la respuesta del sensor.
+ * El pulso bajo de inicio dejó pendiente un flanco en la EXTI: se borra antes de marcar el
+ * sensor como capturando, así el primer flanco guardado es la respuesta del DHT22.
  *
  * @param[in] dht Puntero a la estructura DHT22_HandleTypeDef que contiene la configuración del
  * puerto y pin GPIO.
  *
  * @retval None
  */
-void DHT22_StartSignal(DHT22_HandleTypeDef * dht) {
-    DHT22_SetPinOutput(dht);                                      // Configurar el pin como salida
-    HAL_GPIO_WritePin(dht->GPIOx, dht->GPIO_Pin, GPIO_PIN_RESET); // Enviar señal de inicio (bajo)
-    DWT_Delay(1000);                                              // Esperar 1000 µs
-    HAL_GPIO_WritePin(dht->GPIOx, dht->GPIO_Pin, GPIO_PIN_SET); // Terminar señal de inicio (alto)
-    DWT_Delay(20);                                              // Esperar 20 µs
-    DHT22_SetPinInput(dht);                                     // Configurar el pin como entrada
+void DHT22_IniciarCaptura(DHT22_HandleTypeDef * dht) {
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    IRQn_Type irq = irq_del_pin(dht->GPIO_Pin);
+
+    DHT22_CapturaReiniciar(&dht->captura);
+
+    GPIO_InitStruct.Pin = dht->GPIO_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(dht->GPIOx, &GPIO_InitStruct); // Soltar la línea: la sube el pull-up
+
+    __HAL_GPIO_EXTI_CLEAR_IT(dht->GPIO_Pin);
+    dht->capturando = true;
+
+    HAL_NVIC_SetPriority(irq, DHT22_EXTI_PRIORIDAD, 0);
+    HAL_NVIC_EnableIRQ(irq);
 }
 
 /**
- * @brief Lee un byte del sensor DHT22.
+ * @brief Deja de guardar flancos y vuelve el pin a salida en alto.
  *
- * Esta función lee 8 bits del pin GPIO del DHT22 y los combina en un solo byte.
+ * HAL_GPIO_Init() en modo salida no toca la EXTI: se enmascara a mano para que el pulso de
+ * inicio siguiente no interrumpa. La interrupción de la línea queda habilitada (la comparten
+ * otros pines).
  *
  * @param[in] dht Puntero a la estructura DHT22_HandleTypeDef que contiene la configuración del
  * puerto y pin GPIO.
  *
- * @retval uint8_t El byte leído del sensor.
+ * @retval None
  */
-uint8_t DHT22_ReadByte(DHT22_HandleTypeDef * dht) {
-    uint8_t result = 0;                             // Inicializa el resultado en 0
-    for (uint8_t i = 0; i < DHT22_BYTE_BITS; i++) { // Itera 8 veces para leer cada bit
-        result <<=
-            1; // Desplaza el resultado a la izquierda para hacer espacio para el siguiente bit
-        result |= DHT22_ReadBit(dht); // Lee un bit y lo añade al resultado
-    }
-    return result; // Devuelve el byte completo leído del sensor
+void DHT22_DetenerCaptura(DHT22_HandleTypeDef * dht) {
+    dht->capturando = false;
+    EXTI->IMR &= ~(uint32_t)dht->GPIO_Pin;
+    __HAL_GPIO_EXTI_CLEAR_IT(dht->GPIO_Pin);
+
+    DHT22_SetPinOutput(dht);
+    HAL_GPIO_WritePin(dht->GPIOx, dht->GPIO_Pin, GPIO_PIN_SET); // Línea en reposo
 }
 
 /**
- * @brief Lee un bit del sensor DHT22.
+ * @brief Guarda el flanco de un pin DHT22 con la marca del contador de ciclos.
  *
- * Esta función espera a que el pin GPIO cambie de estado y luego lee el valor del bit.
- *
- * @param[in] dht Puntero a la estructura DHT22_HandleTypeDef que contiene la configuración del
- * puerto y pin GPIO.
+ * @param[in] GPIO_Pin Pin que generó la interrupción.
  *
- * @retval uint8_t El bit leído del sensor (0 o 1).
+ * @retval None
  */
-uint8_t DHT22_ReadBit(DHT22_HandleTypeDef * dht) {
-    uint32_t timeout = DHT22_TIMEOUT;
+void DHT22_FlancoEXTI(uint16_t GPIO_Pin) {
+    uint32_t marca = DWT->CYCCNT; // Antes que nada: la variación de la latencia es el error
 
-    // Esperar a que el pin cambie a alto
-    while (HAL_GPIO_ReadPin(dht->GPIOx, dht->GPIO_Pin) == GPIO_PIN_RESET) {
-        if (--timeout == 0) {
-            return 0; // Timeout, devolver 0
+    for (uint8_t i = 0; i < cantidad_sensores; i++) {
+        DHT22_HandleTypeDef * dht = sensores[i];
+        if (dht->GPIO_Pin == GPIO_Pin && dht->capturando) {
+            DHT22_CapturaFlanco(&dht->captura, marca);
         }
     }
-
-    // Introducir un pequeño retraso para asegurar una lectura precisa del bit
-    DWT_Delay(DHT22_BIT_DELAY); // Esperar 30 µs
-
-    // Leer el bit (0 o 1) según el estado del pin
-    uint8_t result = HAL_GPIO_ReadPin(dht->GPIOx, dht->GPIO_Pin);
-
-    timeout = DHT22_TIMEOUT;
-
-    // Esperar a que el pin vuelva a su estado bajo
-    while (HAL_GPIO_ReadPin(dht->GPIOx, dht->GPIO_Pin) == GPIO_PIN_SET) {
-        if (--timeout == 0) {
-            break; // Timeout, salir del bucle
-        }
-    }
-
-    // Devolver el bit leído
-    return result;
 }
 
 /* === End of documentation ==================================================================== */
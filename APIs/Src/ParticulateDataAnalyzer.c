@@ -39,6 +39,7 @@
  * - findMaxValue: Encuentra el valor máximo de los datos validados de MP.
  * - findMinValue: Encuentra el valor mínimo de los datos validados de MP.
  * - calculateStandardDeviation: Calcula la desviación estándar de los valores de MP.
+ * - calculateStatistics: Calcula los cuatro parámetros en una sola pasada.
  *
  * La API es aplicable en sistemas de monitoreo de calidad de aire para análisis
  * en entornos interiores y exteriores.
@@ -49,14 +50,10 @@
 #include "ParticulateDataAnalyzer.h"
 #include <stddef.h> // Para NULL
 #include <stdbool.h>
+#include <math.h>
 
 /* === Macros definitions ====================================================================== */
 
-/**
- * @brief Tolerancia usada en el cálculo de la raíz cuadrada mediante el método de búsqueda binaria.
- */
-#define TOLERANCE_SQRT_MET 1e-7
-
 /**
  * @brief Indicador de que no hay datos en el conjunto, utilizado en comprobaciones de tamaño de
  * array.
@@ -83,16 +80,6 @@
  */
 #define INI_SUM_OF_SQUARE 0.0
 
-/**
- * @brief valor divisor por 2
- */
-#define DIV2 2
-
-/**
- * @brief valor minimo de tolerancia para el cálculo de raiz
- */
-#define MIN_VALUE_SQRT_TOLERANCE 0
-
 /**
  * @brief valor inicial suma
  */
@@ -135,7 +122,8 @@
  * @return Verdadero si el valor está dentro del rango; falso en caso contrario.
  */
 bool maskIsDataTrue(float data) {
-    return (data > MP_MIN_VALUE) && (data <= MP_MAX_VALUE);
+    // Límites en float: comparar contra los double de las macros es emulado por software
+    return (data > (float)MP_MIN_VALUE) && (data <= (float)MP_MAX_VALUE);
 }
 
 /**
@@ -153,34 +141,25 @@ bool isArrayEmpty(float data[], int n_data) {
 }
 
 /**
- * @brief Calcula la raíz cuadrada de un número usando el método de búsqueda binaria.
+ * @brief Raíz cuadrada de un float con la FPU.
  *
- * Implementa la búsqueda binaria para encontrar la raíz cuadrada de un número, adecuado para
- * sistemas donde las operaciones de punto flotante no son eficientes. Este método es efectivo
- * para números positivos y retorna cero para números no positivos.
+ * En el Cortex-M4F es una sola instrucción `vsqrt.f32` (14 ciclos). sqrtf() también la genera,
+ * pero agrega la llamada a la biblioteca que fija errno para argumentos negativos. En el host se
+ * usa sqrtf().
  *
  * @param x Número del cual calcular la raíz cuadrada.
- * @return La raíz cuadrada de x, calculada dentro de una tolerancia definida por
- * TOLERANCE_SQRT_MET.
+ * @return La raíz cuadrada de x, o 0 si x no es positivo.
  */
-double sqrt_binary_search(double x) {
-    if (x <= 0)
-        return 0;
-
-    double low = MIN_VALUE_SQRT_TOLERANCE, high = x, mid, guess;
-    double tolerance = TOLERANCE_SQRT_MET;
-
-    while (high - low > tolerance) {
-        mid = (low + high) / DIV2;
-        guess = mid * mid;
-
-        if (guess > x)
-            high = mid;
-        else
-            low = mid;
-    }
-
-    return (low + high) / DIV2;
+static inline float sqrt_fpu(float x) {
+    if (x <= 0.0f)
+        return 0.0f;
+#if defined(__ARM_FP) && (__ARM_FP & 4)
+    float result;
+    __asm__("vsqrt.f32 %0, %1" : "=t"(result) : "t"(x));
+    return result;
+#else
+    return sqrtf(x);
+#endif
 }
 
 /* === Public function implementation ========================================================== */
@@ -234,13 +213,13 @@ float calculateAverage(float data[], int n_data) {
 float findMaxValue(float data[], int n_data) {
     if (isArrayEmpty(data, n_data))
         return MSN_VOID_ARRAY_VALUE; // Manejo de array vacío
-    float value = data[START_LOCATION];
-    // int location = START_LOCATION;
-    for (int i = 1; i < n_data; i++) {
+    float value = MSN_VOID_ARRAY_VALUE;
+    bool found = false; // el primer dato puede ser inválido
+    for (int i = START_LOCATION; i < n_data; i++) {
         if (maskIsDataTrue(data[i])) { // salta valores negativos o iguales a 0
-            if (value < data[i]) {
+            if (!found || value < data[i]) {
                 value = data[i];
-                //          location = i;
+                found = true;
             }
         }
     }
@@ -262,13 +241,13 @@ float findMaxValue(float data[], int n_data) {
 float findMinValue(float data[], int n_data) {
     if (isArrayEmpty(data, n_data))
         return MSN_VOID_ARRAY_VALUE; // Manejo de array vacío
-    float value = data[START_LOCATION];
-    // int location = START_LOCATION;
-    for (int i = 1; i < n_data; i++) {
+    float value = MSN_VOID_ARRAY_VALUE;
+    bool found = false; // el primer dato puede ser inválido
+    for (int i = START_LOCATION; i < n_data; i++) {
         if (maskIsDataTrue(data[i])) { // salta valores negativos o iguales a 0
-            if (value > data[i]) {
+            if (!found || value > data[i]) {
                 value = data[i];
-                //   location = i;
+                found = true;
             }
         }
     }
@@ -308,11 +287,75 @@ float calculateStandardDeviation(float data[], int n) {
 
     // Calcula la desviación estándar solo si hay suficientes datos validados
     if (validCount > MIN_VALID_COUNT) {
-        return sqrt_binary_search(sumOfSquares / (validCount - 1));
+        return sqrt_fpu(sumOfSquares / (validCount - 1));
     } else {
         return MSN_NOT_DATA; // Retorna -777 si no hay suficientes datos para calcular la desviación
                              // estándar
     }
 }
 
+/**
+ * @brief Calcula promedio, máximo, mínimo y desviación estándar en una sola pasada.
+ *
+ * Acumula la suma y la suma de cuadrados de (x - k), con k el primer dato válido: el
+ * desplazamiento evita la cancelación de la fórmula de un solo paso cuando la media es grande
+ * frente a la dispersión, y no agrega divisiones por muestra.
+ *
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se guardan los resultados.
+ */
+
+void calculateStatistics(float data[], int n_data, MPStatistics * stats) {
+    if (stats == NULL)
+        return;
+
+    stats->average = MSN_VOID_ARRAY_VALUE;
+    stats->max = MSN_VOID_ARRAY_VALUE;
+    stats->min = MSN_VOID_ARRAY_VALUE;
+    stats->std = MSN_VOID_ARRAY_VALUE;
+    stats->validCount = INI_VALID_COUNT;
+    if (isArrayEmpty(data, n_data))
+        return; // Manejo de array vacío
+
+    float shift = 0.0f, sum = 0.0f, sumOfSquares = 0.0f;
+    float min = 0.0f, max = 0.0f;
+    int validCount = INI_VALID_COUNT;
+
+    for (int i = START_LOCATION; i < n_data; i++) {
+        float x = data[i];
+        if (!maskIsDataTrue(x))
+            continue;
+
+        if (validCount == INI_VALID_COUNT) {
+            shift = x;
+            min = x;
+            max = x;
+        }
+        float d = x - shift;
+        sum += d;
+        sumOfSquares += d * d;
+        min = (x < min) ? x : min;
+        max = (x > max) ? x : max;
+        validCount++;
+    }
+
+    if (validCount == INI_VALID_COUNT)
+        return; // Todos los datos son inválidos
+
+    stats->validCount = validCount;
+    stats->average = shift + sum / validCount;
+    stats->max = max;
+    stats->min = min;
+
+    if (n_data <= DS_NOTDEFINI) {
+        stats->std = MSN_DS_NOTDEFINI;
+    } else if (validCount <= MIN_VALID_COUNT) {
+        stats->std = MSN_NOT_DATA;
+    } else {
+        float m2 = sumOfSquares - sum * sum / validCount;
+        stats->std = sqrt_fpu(m2 / (validCount - 1));
+    }
+}
+
 /* === End of documentation ==================================================================== */
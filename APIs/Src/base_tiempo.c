@@ -0,0 +1,209 @@
+/**
+ * @file base_tiempo.c
+ * @brief Hora cacheada: un ancla (segundos, tick) que se actualiza con el DS3231 y con SQW.
+ *
+ * La hora es ancla.segundos + (HAL_GetTick() - ancla.tick) / 1000. El ancla la fija cada lectura
+ * del DS3231 y la mueve cada pulso de SQW (un segundo exacto del DS3231), así que con SQW el
+ * SysTick sólo cuenta la fracción desde el último pulso. La interrupción sólo incrementa su propio
+ * contador y guarda el tick: el lazo principal lo lee dos veces hasta ver el mismo valor, sin
+ * deshabilitar interrupciones.
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "base_tiempo.h"
+#include "stm32f4xx_hal.h" // HAL_GetTick()
+
+/* === Definiciones de macros privadas ======================================================== */
+
+#define MS_POR_SEGUNDO   1000u
+#define SQW_TOLERANCIA_MS 50 /**< Atraso de un pulso de SQW antes de seguir sólo con el SysTick */
+#define SEGUNDOS_POR_DIA 86400u
+#define ANIO_MAXIMO      2135u /**< 2^32 segundos desde el año 2000 */
+
+/** Días del 1970-01-01 al 2000-01-01, para las fórmulas que cuentan desde 1970 */
+#define DIAS_1970_A_2000 10957u
+
+/* === Definiciones de variables privadas ===================================================== */
+
+static bool valida = false;         /**< Hubo al menos una lectura buena */
+static bool rtc_ok = false;         /**< La última lectura fue buena */
+static bool pedir_lectura = true;   /**< Leer el DS3231 en la próxima consulta */
+static uint32_t tick_lectura = 0;   /**< Tick de la última lectura (buena o no) */
+static epoca_t segundos_base = 0;   /**< Segundos leídos del DS3231 */
+static uint32_t tick_base = 0;      /**< Tick de esa lectura */
+static uint32_t pulsos_base = 0;    /**< Pulsos de SQW contados al leer */
+static epoca_t ultimo_entregado = 0;
+
+/* Escritas sólo por base_tiempo_pulso_sqw() */
+static volatile uint32_t pulsos_sqw = 0;
+static volatile uint32_t tick_pulso = 0;
+
+static BaseTiempoEstadisticas estadisticas = {0};
+
+/* === Funciones privadas ===================================================================== */
+
+/**
+ * @brief Días desde el 1970-01-01 (algoritmo days_from_civil de H. Hinnant, sin tablas).
+ */
+static uint32_t dias_desde_civil(uint32_t anio, uint32_t mes, uint32_t dia) {
+    anio -= (mes <= 2u);
+    uint32_t era = anio / 400u;
+    uint32_t anio_era = anio - era * 400u;
+    uint32_t dia_anio = (153u * (mes > 2u ? mes - 3u : mes + 9u) + 2u) / 5u + dia - 1u;
+    uint32_t dia_era = anio_era * 365u + anio_era / 4u - anio_era / 100u + dia_anio;
+    return era * 146097u + dia_era - 719468u;
+}
+
+static bool fecha_valida(const ds3231_time_t * dt) {
+    return dt->year >= BASE_TIEMPO_ANIO_EPOCA && dt->year <= ANIO_MAXIMO && dt->month >= 1 &&
+           dt->month <= 12 && dt->day >= 1 && dt->day <= 31 && dt->hour < 24 && dt->min < 60 &&
+           dt->sec < 60;
+}
+
+/**
+ * @brief Pulsos de SQW y tick del último, leídos sin que una interrupción los mezcle.
+ */
+static uint32_t leer_pulsos(uint32_t * tick) {
+    uint32_t pulsos;
+    do {
+        pulsos = pulsos_sqw;
+        *tick = tick_pulso;
+    } while (pulsos != pulsos_sqw);
+    return pulsos;
+}
+
+/**
+ * @brief Hora según el ancla actual (sin la protección contra retrocesos).
+ */
+static epoca_t interpolar(uint32_t ahora) {
+    uint32_t tick;
+    uint32_t pulsos = leer_pulsos(&tick) - pulsos_base;
+    uint32_t desde = (pulsos > 0u) ? tick : tick_base;
+    int32_t transcurrido = (int32_t)(ahora - desde); // el pulso pudo llegar después de 'ahora'
+
+    // Si el SysTick adelanta, el segundo lo termina el pulso siguiente, no el SysTick
+    if (pulsos > 0u && transcurrido >= (int32_t)MS_POR_SEGUNDO &&
+        transcurrido < (int32_t)MS_POR_SEGUNDO + SQW_TOLERANCIA_MS) {
+        transcurrido = (int32_t)MS_POR_SEGUNDO - 1;
+    }
+    return segundos_base + pulsos +
+           ((transcurrido > 0) ? (uint32_t)transcurrido / MS_POR_SEGUNDO : 0u);
+}
+
+static void leer_rtc(uint32_t ahora) {
+    ds3231_time_t dt;
+    uint32_t tick, pulsos;
+    bool ok;
+
+    // Un pulso entre la lectura y el conteo correría el ancla un segundo: se repite la lectura
+    for (int intento = 0; intento < 2; intento++) {
+        pulsos = leer_pulsos(&tick);
+        estadisticas.lecturas_rtc++;
+        ok = ds3231_get_datetime(&dt) && fecha_valida(&dt);
+        if (!ok || pulsos == leer_pulsos(&tick)) {
+            break;
+        }
+    }
+
+    tick_lectura = ahora;
+    pedir_lectura = false;
+    rtc_ok = ok;
+    if (!ok) {
+        estadisticas.fallas_rtc++;
+        return;
+    }
+
+    epoca_t segundos = base_tiempo_a_segundos(&dt);
+    if (valida) {
+        estadisticas.ultimo_ajuste = (int32_t)(segundos - interpolar(ahora));
+    }
+    segundos_base = segundos;
+    tick_base = ahora;
+    pulsos_base = pulsos;
+    valida = true;
+}
+
+/* === Funciones públicas ===================================================================== */
+
+bool base_tiempo_segundos(epoca_t * segundos) {
+    uint32_t ahora = HAL_GetTick();
+    uint32_t espera = rtc_ok ? BASE_TIEMPO_RESINCRONIZAR_MS : BASE_TIEMPO_REINTENTO_MS;
+
+    if (pedir_lectura || (ahora - tick_lectura) >= espera) {
+        leer_rtc(ahora);
+    }
+    if (!valida) {
+        return false;
+    }
+
+    epoca_t s = interpolar(ahora);
+    if (s < ultimo_entregado) {
+        s = ultimo_entregado; // el SysTick adelantó: se espera a la hora del DS3231
+    }
+    ultimo_entregado = s;
+    *segundos = s;
+    return true;
+}
+
+bool base_tiempo_ahora(ds3231_time_t * dt) {
+    epoca_t segundos;
+
+    if (!base_tiempo_segundos(&segundos)) {
+        return false;
+    }
+    base_tiempo_desde_segundos(segundos, dt);
+    return true;
+}
+
+void base_tiempo_resincronizar(void) {
+    pedir_lectura = true;
+    ultimo_entregado = 0; // la hora nueva puede ser anterior
+}
+
+bool base_tiempo_rtc_ok(void) {
+    return rtc_ok;
+}
+
+void base_tiempo_pulso_sqw(void) {
+    tick_pulso = HAL_GetTick();
+    pulsos_sqw = pulsos_sqw + 1u;
+}
+
+BaseTiempoEstadisticas base_tiempo_estadisticas(void) {
+    BaseTiempoEstadisticas copia = estadisticas;
+    copia.pulsos_sqw = pulsos_sqw;
+    return copia;
+}
+
+epoca_t base_tiempo_a_segundos(const ds3231_time_t * dt) {
+    uint32_t dias = dias_desde_civil(dt->year, dt->month, dt->day) - DIAS_1970_A_2000;
+    return dias * SEGUNDOS_POR_DIA + dt->hour * 3600u + dt->min * 60u + dt->sec;
+}
+
+void base_tiempo_desde_segundos(epoca_t segundos, ds3231_time_t * dt) {
+    uint32_t dias = segundos / SEGUNDOS_POR_DIA;
+    uint32_t resto = segundos % SEGUNDOS_POR_DIA;
+
+    dt->hour = (uint8_t)(resto / 3600u);
+    dt->min = (uint8_t)(resto / 60u % 60u);
+    dt->sec = (uint8_t)(resto % 60u);
+
+    // civil_from_days de H. Hinnant, con los días contados desde el 0000-03-01
+    uint32_t z = dias + DIAS_1970_A_2000 + 719468u;
+    uint32_t era = z / 146097u;
+    uint32_t dia_era = z - era * 146097u;
+    uint32_t anio_era = (dia_era - dia_era / 1460u + dia_era / 36524u - dia_era / 146096u) / 365u;
+    uint32_t dia_anio = dia_era - (365u * anio_era + anio_era / 4u - anio_era / 100u);
+    uint32_t mes_marzo = (5u * dia_anio + 2u) / 153u;
+    uint32_t mes = (mes_marzo < 10u) ? mes_marzo + 3u : mes_marzo - 9u;
+
+    dt->day = (uint8_t)(dia_anio - (153u * mes_marzo + 2u) / 5u + 1u);
+    dt->month = (uint8_t)mes;
+    dt->year = (uint16_t)(anio_era + era * 400u + (mes <= 2u));
+}
+
+/* === End of documentation ==================================================================== */
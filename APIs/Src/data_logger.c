@@ -16,6 +16,7 @@
 /* === Headers files inclusions =============================================================== */
 
 #include "config_global.h"
+#include "buffers_config.h" // CSV_LINE_BUFFER_SIZE
 
 #include <string.h>
 #include <stdio.h>
@@ -27,6 +28,7 @@
 #include "fatfs_sd.h"
 #include "microSD.h"
 #include "microSD_utils.h"
+#include "microSD_cache.h"
 
 #include "rtc.h"
 #include "data_logger.h"
@@ -43,31 +45,23 @@
 #endif
 
 #include "rtc_ds3231_for_stm32_hal.h"
+#include "base_tiempo.h"
 
 #include "ParticulateDataAnalyzer.h"
 
+#include "formato_csv.h"
 #include "mp_sensors_info.h"
+#include "punto_fijo.h"
+
+#define LOG_NIVEL_MODULO LOG_NIVEL_DATA_LOGGER
+#include "log.h"
 
 #ifdef UNIT_TESTING
-float calculateAverage(float data[], int n_data) {
-    return 0.0f;
-}
-float findMaxValue(float data[], int n_data) {
-    return 0.0f;
-}
-float findMinValue(float data[], int n_data) {
-    return 0.0f;
-}
-float calculateStandardDeviation(float data[], int n) {
-    return 0.0f;
-}
 void print_fatfs_error(FRESULT res) {
 }
 #endif
 /* === Macros definitions ====================================================================== */
 
-#define CSV_LINE_BUFFER_SIZE 128
-
 /* === Private data type declarations ========================================================== */
 
 /* === Private variable declarations =========================================================== */
@@ -80,6 +74,9 @@ static MedicionMP buffer_diario[BUFFER_DAILY_SIZE];
 static FATFS fs;                // Sistema de archivos FAT32
 static bool sd_mounted = false; // Bandera de estado para evitar montaje doble
 
+/* /AVG10, /AVG60 y /AVG24 ya existen en la tarjeta montada */
+static bool directorios_avg_listos = false;
+
 static BufferCircular buffer_alta_frecuencia = {
     .datos = buffer_alta_frec, .capacidad = BUFFER_HIGH_FREQ_SIZE, .inicio = 0, .cantidad = 0};
 
@@ -92,22 +89,36 @@ static BufferCircular buffer_dia = {
 extern RTC_HandleTypeDef hrtc;
 
 static TimeWindow current_window = {0};
-static float hourly_avgs[AVG10_PER_HOUR] = {0};
+static AcumuladorMP acumulador_1h = {0}; // Promedios de las ventanas de 10 min de la hora en curso
 static int hourly_index = 0;
-static float daily_avgs[AVG1H_PER_DAY] = {0};
+static AcumuladorMP acumulador_24h = {0}; // Promedios de las horas completas del día en curso
 static int daily_index = 0;
-static ds3231_time_t hourly_start_time = {0};
-static ds3231_time_t daily_start_time = {0};
+static epoca_t hourly_start_time = 0;
+static epoca_t daily_start_time = 0;
 /* === Private function declarations =========================================================== */
 
 /* === Public variable definitions ============================================================= */
 
-BufferCircularSensor buffers_10min[MAX_SENSORES_SPS30];
+AcumuladorSensor buffers_10min[MAX_SENSORES_SPS30];
 
 /* === Private variable definitions ============================================================ */
 
 /* === Private function implementation ========================================================= */
 
+/**
+ * @brief Suma una medición al bloque de 10 minutos de su sensor.
+ *
+ * El PM2.5 entra al acumulador sin filtrar por rango, como en los buffers de mediciones que
+ * reemplaza, y la medición queda como la última del bloque.
+ */
+static void acumulador_sensor_agregar(AcumuladorSensor * destino, const MedicionMP * medicion) {
+    acumulador_agregar_sin_rango(&destino->pm2_5, medicion->pm2_5);
+    destino->ultima = *medicion;
+    if (destino->count < UINT16_MAX) {
+        destino->count++;
+    }
+}
+
 /**
  * @brief Añade una medición al buffer circular especificado
  *
@@ -132,115 +143,88 @@ static void buffer_circular_agregar(BufferCircular * buffer, const MedicionMP *
     memcpy(&buffer->datos[indice], medicion, sizeof(MedicionMP));
 }
 
-/**
- * @brief Calcula la diferencia de tiempo en segundos entre dos instantes del día.
- *
- * Esta función calcula cuántos segundos han pasado entre `start` y `end`,
- * considerando un ciclo horario de 24 horas. Si `end` es anterior a `start`,
- * se asume que ocurrió un cambio de día.
- *
- * @param start Puntero a la estructura de tiempo inicial (`ds3231_time_t`).
- * @param end   Puntero a la estructura de tiempo final (`ds3231_time_t`).
- * @return Diferencia de tiempo en segundos (ajustada para rollover diario).
- */
-
-static unsigned int time_diff_seconds(const ds3231_time_t * start, const ds3231_time_t * end);
-
 /**
  * @brief Verifica si ha transcurrido un intervalo de 10 minutos desde el tiempo inicial del buffer
  * de 10min.
  *
- * Compara el tiempo actual `dt` con `current_window.start_time`, y determina si han transcurrido
- * al menos 600 segundos (10 minutos).
+ * Compara el tiempo actual `ahora` con `current_window.start_time`, y determina si han transcurrido
+ * al menos 600 segundos (10 minutos). Con marcas en segundos desde la época la diferencia es una
+ * resta, también entre días distintos.
  *
- * @param dt Puntero a la estructura de tiempo actual (`ds3231_time_t`).
+ * @param ahora Segundos desde la época (`epoca_t`).
  * @return true si han pasado 10 minutos o más; false en caso contrario.
  */
 
-static bool is_10min_boundary(const ds3231_time_t * dt) {
-    return time_diff_seconds(&current_window.start_time, dt) >= 10 * 60;
+static bool is_10min_boundary(epoca_t ahora) {
+    return ahora - current_window.start_time >= 10 * 60;
 }
 
 /**
  * @brief Verifica si ha transcurrido una hora desde el tiempo inicial del buffer horario.
  *
- * Compara el tiempo actual `dt` con `hourly_start_time`, y determina si han transcurrido
+ * Compara el tiempo actual `ahora` con `hourly_start_time`, y determina si han transcurrido
  * al menos 3600 segundos (1 hora).
  *
- * @param dt Puntero a la estructura de tiempo actual (`ds3231_time_t`).
+ * @param ahora Segundos desde la época (`epoca_t`).
  * @return true si ha pasado 1 hora o más; false en caso contrario.
  */
 
 /*
-static bool is_1hour_boundary(const ds3231_time_t * dt) {
-    return time_diff_seconds(&hourly_start_time, dt) >= 60 * 60;
+static bool is_1hour_boundary(epoca_t ahora) {
+    return ahora - hourly_start_time >= 60 * 60;
 }*/
 
 /**
  * @brief Verifica si ha transcurrido un intervalo de 24 horas desde el tiempo inicial del buffer
  * diario.
  *
- * Compara el tiempo actual `dt` con `daily_start_time`, y determina si han transcurrido
+ * Compara el tiempo actual `ahora` con `daily_start_time`, y determina si han transcurrido
  * al menos 86400 segundos (24 horas).
  *
- * @param dt Puntero a la estructura de tiempo actual (`ds3231_time_t`).
+ * @param ahora Segundos desde la época (`epoca_t`).
  * @return true si han pasado 24 horas o más; false en caso contrario.
  */
 /*
-static bool is_24hour_boundary(const ds3231_time_t * dt) {
-    return time_diff_seconds(&daily_start_time, dt) >= 24 * 3600;
+static bool is_24hour_boundary(epoca_t ahora) {
+    return ahora - daily_start_time >= 24 * 3600;
 }*/
 
-/**
- * @brief Calcula la diferencia de tiempo en segundos entre dos instantes del mismo día o con
- * rollover.
- *
- * Esta función convierte dos estructuras de tiempo (`ds3231_time_t`) en segundos desde las 00:00:00
- * y calcula la diferencia entre ellas. Si `end` ocurre antes que `start` (por ejemplo, cuando hay
- * un cambio de día), ajusta la diferencia para considerar el rollover de 24 horas.
- *
- * @param start Puntero a la estructura `ds3231_time_t` que representa el tiempo inicial.
- * @param end   Puntero a la estructura `ds3231_time_t` que representa el tiempo final.
- *
- * @return Diferencia en segundos entre `end` y `start`. El resultado siempre es no negativo
- *         y está en el rango [0, 86399].
- *
- * @note Esta función asume que ambos tiempos corresponden a la misma fecha o que la diferencia
- *       no supera un día completo. No considera cambios de fecha (solo de hora).
- */
-
-static unsigned int time_diff_seconds(const ds3231_time_t * start, const ds3231_time_t * end) {
-    int start_s = start->hour * 3600 + start->min * 60 + start->sec;
-    int end_s = end->hour * 3600 + end->min * 60 + end->sec;
-    int diff = end_s - start_s;
-    if (diff < 0)
-        diff += 24 * 3600;
-    return (unsigned int)diff;
-}
-
 /**
  * @brief Acumula una muestra de PM2.5 en la ventana temporal actual de 10 minutos.
  *
- * Esta función guarda el valor de la muestra en un buffer si hay espacio disponible.
+ * Esta función agrega la muestra al acumulador de la ventana (en O(1), sin guardarla).
  * Si es la primera muestra del ciclo, inicializa los tiempos de referencia para
  * los cálculos de promedios a 10 minutos, 1 hora y 24 horas.
  *
  * @param sample Muestra de concentración PM2.5.
- * @param dt     Puntero a la estructura `ds3231_time_t` con el timestamp de la muestra.
+ * @param ahora  Timestamp de la muestra en segundos desde la época.
  */
 
-static void accumulate_sample_in_current_window(float sample, const ds3231_time_t * dt) {
+static void accumulate_sample_in_current_window(float sample, epoca_t ahora) {
     if (current_window.count == 0) {
-        current_window.start_time = *dt;
+        current_window.start_time = ahora;
         if (hourly_index == 0)
-            hourly_start_time = *dt;
+            hourly_start_time = ahora;
         if (daily_index == 0)
-            daily_start_time = *dt;
+            daily_start_time = ahora;
     }
 
-    if (current_window.count < MAX_SAMPLES_PER_10MIN) {
-        current_window.samples[current_window.count++] = sample;
-    }
+    current_window.count++;
+    acumulador_agregar(&current_window.pm2_5, sample);
+}
+
+/**
+ * @brief Arma el resumen de un acumulador con la fecha y la cantidad de muestras indicadas.
+ */
+static TimeSyncedAverage resumir_acumulador(const AcumuladorMP * acc, epoca_t timestamp,
+                                            uint16_t sample_count) {
+    TimeSyncedAverage avg = {.timestamp = timestamp,
+                             .pm2_5_avg = acumulador_promedio(acc),
+                             .sample_count = sample_count,
+                             .pm2_5_min = acumulador_minimo(acc),
+                             .pm2_5_max = acumulador_maximo(acc),
+                             .pm2_5_std = acumulador_desvio(acc)};
+    return avg;
 }
 
 /**
@@ -248,23 +232,20 @@ static void accumulate_sample_in_current_window(float sample, const ds3231_time_
  *
  * Esta función genera un resumen estadístico (promedio, mínimo, máximo, desviación estándar)
  * de las muestras acumuladas y retorna una estructura `TimeSyncedAverage` con los resultados.
- * Luego, limpia el buffer para el siguiente intervalo de 10 minutos.
+ * El promedio de la ventana entra al acumulador de la hora en curso y el de la ventana se
+ * reinicia para el siguiente intervalo de 10 minutos.
  *
  * @return Estructura `TimeSyncedAverage` con los valores calculados y timestamp inicial.
  */
 
 static TimeSyncedAverage finalize_temporal_window(void) {
-    TimeSyncedAverage avg = {0};
-
-    avg.timestamp = current_window.start_time;
-    avg.sample_count = current_window.count;
-    if (current_window.count > 0) {
-        avg.pm2_5_avg = calculateAverage(current_window.samples, current_window.count);
-        avg.pm2_5_max = findMaxValue(current_window.samples, current_window.count);
-        avg.pm2_5_min = findMinValue(current_window.samples, current_window.count);
-        avg.pm2_5_std = calculateStandardDeviation(current_window.samples, current_window.count);
-    }
+    TimeSyncedAverage avg;
 
+    avg = resumir_acumulador(&current_window.pm2_5, current_window.start_time,
+                             current_window.count);
+
+    acumulador_agregar(&acumulador_1h, avg.pm2_5_avg);
+    acumulador_reiniciar(&current_window.pm2_5);
     current_window.count = 0;
     return avg;
 }
@@ -277,10 +258,15 @@ static TimeSyncedAverage finalize_temporal_window(void) {
  */
 
 static void ensure_avg_directories(void) {
+    if (directorios_avg_listos) {
+        return; // Ya verificados en este montaje
+    }
     const char * dirs[] = {"/AVG10", "/AVG60", "/AVG24"};
+    directorios_avg_listos = true;
     for (unsigned int i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
-        if (f_stat(dirs[i], NULL) != FR_OK) {
-            f_mkdir(dirs[i]);
+        FRESULT res = f_mkdir(dirs[i]);
+        if (res != FR_OK && res != FR_EXIST) {
+            directorios_avg_listos = false;
         }
     }
 }
@@ -306,13 +292,31 @@ static void save_temporal_average_to_csv(const TimeSyncedAverage * avg, const ch
     else if (strstr(path, "AVG24"))
         type = "avg24";
 
+    // "YYYY-MM-DD HH:MM:SS,tipo,%.2f,%u,%.2f,%.2f,%.2f\n" armado campo por campo
+    ds3231_time_t t;
     char line[128];
-    snprintf(line, sizeof(line), "%04d-%02d-%02d %02d:%02d:%02d,%s,%.2f,%u,%.2f,%.2f,%.2f\n",
-             avg->timestamp.year, avg->timestamp.month, avg->timestamp.day, avg->timestamp.hour,
-             avg->timestamp.min, avg->timestamp.sec, type, avg->pm2_5_avg, avg->sample_count,
-             avg->pm2_5_min, avg->pm2_5_max, avg->pm2_5_std);
-
-    microSD_appendLineAbsolute(path, line);
+    const char * fin = line + sizeof(line);
+
+    base_tiempo_desde_segundos(avg->timestamp, &t);
+    char * p = formato_csv_fecha_hora(line, fin, t.year, t.month, t.day, t.hour, t.min, t.sec,
+                                      ' ');
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_texto(p, fin, type);
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_decimal(p, fin, avg->pm2_5_avg, PUNTO_FIJO_DECIMALES_MP);
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_entero(p, fin, avg->sample_count, 1);
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_decimal(p, fin, avg->pm2_5_min, PUNTO_FIJO_DECIMALES_MP);
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_decimal(p, fin, avg->pm2_5_max, PUNTO_FIJO_DECIMALES_MP);
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_decimal(p, fin, avg->pm2_5_std, PUNTO_FIJO_DECIMALES_MP);
+    p = formato_csv_caracter(p, fin, '\n');
+
+    if (p != NULL) {
+        microSD_appendLineAbsolute(path, line);
+    }
 }
 
 /* === Public function implementation ========================================================== */
@@ -392,17 +396,12 @@ void log_avg24h_data(const PMDataAveraged * avg) {
  *
  * Cada promedio se registra en microSD y se imprime vía UART.
  *
- * @param dt Puntero a la estructura `ds3231_time_t` con la hora actual.
+ * @param ahora Hora actual en segundos desde la época.
  */
 static void registrar_promedio_10min(const TimeSyncedAverage * avg10) {
     EstadisticaPM25 resumen = {.sensor_id = 0, // promedio general
-                               .year = avg10->timestamp.year,
-                               .month = avg10->timestamp.month,
-                               .day = avg10->timestamp.day,
-                               .hour = avg10->timestamp.hour,
-                               .min = avg10->timestamp.min,
-                               .sec = avg10->timestamp.sec,
-                               .bloque_10min = (avg10->timestamp.min / 10),
+                               .bloque_10min = BASE_TIEMPO_BLOQUE_10MIN(avg10->timestamp),
+                               .timestamp = avg10->timestamp,
                                .pm2_5_promedio = avg10->pm2_5_avg,
                                .pm2_5_min = avg10->pm2_5_min,
                                .pm2_5_max = avg10->pm2_5_max,
@@ -410,68 +409,52 @@ static void registrar_promedio_10min(const TimeSyncedAverage * avg10) {
                                .num_validos = avg10->sample_count};
 
     data_logger_store_avg10_csv(&resumen);
-    uart_print("[AVG10] PM2.5 = %.2f ug/m3 (%u muestras)\r\n", resumen.pm2_5_promedio,
-               resumen.num_validos);
+    LOG_INFO("[AVG10] PM2.5 = %.2f ug/m3 (%u muestras)\r\n", resumen.pm2_5_promedio,
+             resumen.num_validos);
 }
 
-static void registrar_promedio_1h(const ds3231_time_t * dt) {
-    const int count = AVG10_PER_HOUR;
-    float promedio = calculateAverage(hourly_avgs, count);
-    float min = findMinValue(hourly_avgs, count);
-    float max = findMaxValue(hourly_avgs, count);
-    float std = calculateStandardDeviation(hourly_avgs, count);
-
-    TimeSyncedAverage avg1h = {.timestamp = *dt,
-                               .pm2_5_avg = promedio,
-                               .sample_count = count,
-                               .pm2_5_min = min,
-                               .pm2_5_max = max,
-                               .pm2_5_std = std};
+/*
+ * Las estadísticas de 1 h describen los promedios de las ventanas de 10 minutos y las de 24 h los
+ * promedios horarios: un acumulador recibe un valor por ventana, no las mediciones.
+ */
+static void registrar_promedio_1h(epoca_t ahora) {
+    TimeSyncedAverage avg1h = resumir_acumulador(&acumulador_1h, ahora, AVG10_PER_HOUR);
 
     save_temporal_average_to_csv(&avg1h, "/AVG60/avg60.csv");
-    uart_print("[AVG60] PM2.5 = %.2f ug/m3\r\n", promedio);
+    LOG_INFO("[AVG60] PM2.5 = %.2f ug/m3\r\n", avg1h.pm2_5_avg);
 
-    daily_avgs[daily_index % AVG1H_PER_DAY] = promedio;
+    acumulador_agregar(&acumulador_24h, avg1h.pm2_5_avg);
+    acumulador_reiniciar(&acumulador_1h);
     daily_index++;
 
     if (daily_index % AVG1H_PER_DAY == 0) {
-        registrar_promedio_24h(dt);
+        registrar_promedio_24h(ahora);
     }
 }
 
-void registrar_promedio_24h(const ds3231_time_t * dt) {
-    const int count = AVG1H_PER_DAY;
-    float promedio = calculateAverage(daily_avgs, count);
-    float min = findMinValue(daily_avgs, count);
-    float max = findMaxValue(daily_avgs, count);
-    float std = calculateStandardDeviation(daily_avgs, count);
-
-    TimeSyncedAverage avg24 = {.timestamp = *dt,
-                               .pm2_5_avg = promedio,
-                               .sample_count = count,
-                               .pm2_5_min = min,
-                               .pm2_5_max = max,
-                               .pm2_5_std = std};
+void registrar_promedio_24h(epoca_t ahora) {
+    TimeSyncedAverage avg24 = resumir_acumulador(&acumulador_24h, ahora, AVG1H_PER_DAY);
 
     save_temporal_average_to_csv(&avg24, "/AVG24/avg24.csv");
-    uart_print("[AVG24] PM2.5 = %.2f ug/m3\r\n", promedio);
+    LOG_INFO("[AVG24] PM2.5 = %.2f ug/m3\r\n", avg24.pm2_5_avg);
+
+    acumulador_reiniciar(&acumulador_24h);
 }
 
-static void data_logger_check_time_averages(const ds3231_time_t * dt) {
+static void data_logger_check_time_averages(epoca_t ahora) {
     if (current_window.count == 0)
         return;
 
-    if (time_diff_seconds(&current_window.start_time, dt) < 600 && !is_10min_boundary(dt))
+    if (!is_10min_boundary(ahora))
         return;
 
     TimeSyncedAverage avg10 = finalize_temporal_window();
-    hourly_avgs[hourly_index % AVG10_PER_HOUR] = avg10.pm2_5_avg;
     hourly_index++;
 
     registrar_promedio_10min(&avg10);
 
     if (hourly_index % AVG10_PER_HOUR == 0) {
-        registrar_promedio_1h(dt);
+        registrar_promedio_1h(ahora);
     }
 }
 
@@ -485,13 +468,13 @@ static void data_logger_check_time_averages(const ds3231_time_t * dt) {
  * @param pm25_actual Valor actual de PM2.5 medido.
  */
 void proceso_analisis_periodico(float pm25_actual) {
-    ds3231_time_t dt;
-    if (!ds3231_get_datetime(&dt)) {
+    epoca_t ahora;
+    if (!base_tiempo_segundos(&ahora)) {
         return;
     }
 
-    accumulate_sample_in_current_window(pm25_actual, &dt);
-    data_logger_check_time_averages(&dt);
+    accumulate_sample_in_current_window(pm25_actual, ahora);
+    data_logger_check_time_averages(ahora);
 }
 
 /**
@@ -503,7 +486,10 @@ void proceso_analisis_periodico(float pm25_actual) {
  * @return `true` si la inicialización fue exitosa, `false` si hubo error al montar la SD.
  */
 bool data_logger_init(void) {
-    // Inicializar buffers
+    // Los archivos y directorios de la caché pertenecen al montaje anterior
+    microSD_cache_cerrar_todos();
+    directorios_avg_listos = false;
+
     FRESULT res = f_mount(&fs, "", 1);
     if (res != FR_OK) {
         print_fatfs_error(res); // ⬅️ nueva línea aquí
@@ -511,7 +497,7 @@ bool data_logger_init(void) {
         return false;
     }
 
-    uart_print("[OK] microSD montada correctamente\r\n");
+    LOG_INFO("[OK] microSD montada correctamente\r\n");
     ensure_avg_directories();
     sd_mounted = true;
     return true;
@@ -532,21 +518,22 @@ bool data_logger_init(void) {
  */
 bool data_logger_store_measurement(uint8_t sensor_id, ConcentracionesPM valores, float temp_amb,
                                    float hum_amb) {
-    ds3231_time_t now;
+    epoca_t now;
     // if (!rtc_ds3231_get_time(&now)) return false;
-    if (!ds3231_get_datetime(&now))
+    if (!base_tiempo_segundos(&now))
         return false;
 
     MedicionMP nueva;
 
     nueva.timestamp = now;
-    nueva.bloque_10min = now.min / 10;
+    nueva.bloque_10min = BASE_TIEMPO_BLOQUE_10MIN(now);
     nueva.sensor_id = sensor_id;
 
     nueva.pm1_0 = valores.pm1_0;
     nueva.pm2_5 = valores.pm2_5;
     nueva.pm4_0 = valores.pm4_0;
     nueva.pm10 = valores.pm10;
+    nueva.numero = valores.numero;
 
     nueva.temp_amb = temp_amb;
     nueva.hum_amb = hum_amb;
@@ -600,81 +587,47 @@ float data_logger_get_average_pm25_id(uint8_t sensor_id, uint32_t num_mediciones
     return (contador > 0) ? (suma / contador) : 0.0f;
 }
 
-#include <math.h>
-#include <string.h> // para memset si se quiere limpiar antes
-
 /**
- * @brief Calcula estadísticas combinadas de PM2.5 para los buffers de 10 minutos de todos los
+ * @brief Calcula estadísticas combinadas de PM2.5 para el bloque de 10 minutos de todos los
  * sensores.
  *
- * @param buffers Arreglo de buffers circulares por sensor (uno por cada SPS30).
+ * Combina los acumuladores de cada sensor: el resultado es el de todas las mediciones del
+ * bloque, sin recorrerlas, y num_validos es la cantidad de mediciones. La fecha y el bloque
+ * salen de la última medición del sensor de mayor ID que recibió datos.
+ *
+ * @param buffers Arreglo de acumuladores por sensor (uno por cada SPS30).
  * @param resultado Puntero a estructura donde se almacenará el resultado estadístico.
  * @return true si se calcularon datos válidos, false si no hubo mediciones.
  */
-bool data_logger_estadistica_10min_pm25(const BufferCircularSensor * buffers,
+bool data_logger_estadistica_10min_pm25(const AcumuladorSensor * buffers,
                                         EstadisticaPM25 * resultado) {
     if (!buffers || !resultado)
         return false;
 
-    float suma = 0.0f, min = 10000.0f, max = -10000.0f;
-    float valores[BUFFER_10MIN_SIZE * MAX_SENSORES_SPS30];
-    uint16_t n = 0;
+    AcumuladorMP total;
+    const MedicionMP * muestra = NULL;
 
+    acumulador_reiniciar(&total);
     for (uint8_t i = 0; i < MAX_SENSORES_SPS30; ++i) {
-        const BufferCircularSensor * buf = &buffers[i];
-        if (buf->count == 0)
+        if (buffers[i].count == 0)
             continue;
 
-        for (uint8_t j = 0; j < buf->count; ++j) {
-            uint8_t idx = (buf->head + j) % BUFFER_10MIN_SIZE;
-            float val = buf->buffer[idx].pm2_5;
-
-            valores[n++] = val;
-            suma += val;
-            if (val < min)
-                min = val;
-            if (val > max)
-                max = val;
-        }
+        acumulador_combinar(&total, &buffers[i].pm2_5);
+        muestra = &buffers[i].ultima;
     }
 
-    if (n == 0)
+    if (total.n == 0 || muestra == NULL)
         return false;
 
-    float promedio = suma / n;
-
-    float suma_cuadrados = 0.0f;
-    for (uint16_t i = 0; i < n; ++i) {
-        float diff = valores[i] - promedio;
-        suma_cuadrados += diff * diff;
-    }
-    float stddev = (n > 1) ? sqrtf(suma_cuadrados / (n - 1)) : 0.0f;
-
-    // Buscar última muestra válida para obtener el timestamp
-    for (int8_t i = MAX_SENSORES_SPS30 - 1; i >= 0; --i) {
-        const BufferCircularSensor * buf = &buffers[i];
-        if (buf->count > 0) {
-            uint8_t idx_ultimo = (buf->head + buf->count - 1) % BUFFER_10MIN_SIZE;
-            const MedicionMP * muestra = &buf->buffer[idx_ultimo];
-
-            *resultado = (EstadisticaPM25){.sensor_id = 0, // Combinado
-                                           .year = muestra->timestamp.year,
-                                           .month = muestra->timestamp.month,
-                                           .day = muestra->timestamp.day,
-                                           .hour = muestra->timestamp.hour,
-                                           .min = muestra->timestamp.min,
-                                           .sec = muestra->timestamp.sec,
-                                           .bloque_10min = muestra->bloque_10min,
-                                           .pm2_5_promedio = promedio,
-                                           .pm2_5_min = min,
-                                           .pm2_5_max = max,
-                                           .pm2_5_std = stddev,
-                                           .num_validos = n};
-            return true;
-        }
-    }
-
-    return false;
+    *resultado = (EstadisticaPM25){.sensor_id = 0, // Combinado
+                                   .bloque_10min = muestra->bloque_10min,
+                                   .timestamp = muestra->timestamp,
+                                   .pm2_5_promedio = acumulador_promedio(&total),
+                                   .pm2_5_min = acumulador_minimo(&total),
+                                   .pm2_5_max = acumulador_maximo(&total),
+                                   .pm2_5_std = (total.n > 1) ? acumulador_desvio(&total) : 0.0f,
+                                   .num_validos = (total.n > UINT16_MAX) ? UINT16_MAX : total.n};
+    return true;
 }
 
 /**
@@ -709,11 +662,12 @@ void data_logger_print_summary(void) {
                 buffer_alta_frecuencia.capacidad;
 
             MedicionMP * med = &buffer_alta_frecuencia.datos[idx];
+            ds3231_time_t t;
 
+            base_tiempo_desde_segundos(med->timestamp, &t);
             snprintf(buffer, sizeof(buffer),
-                     "[%04u-%02u-%02u %02u:%02u:%02u] Sensor %d: %.2f µg/m³\n", med->timestamp.year,
-                     med->timestamp.month, med->timestamp.day, med->timestamp.hour,
-                     med->timestamp.min, med->timestamp.sec, med->sensor_id, med->pm2_5);
+                     "[%04u-%02u-%02u %02u:%02u:%02u] Sensor %d: %.2f µg/m³\n", t.year, t.month,
+                     t.day, t.hour, t.min, t.sec, med->sensor_id, med->pm2_5);
             uart_print("%s", buffer);
         }
     }
@@ -740,11 +694,12 @@ void data_logger_print_value(void) {
         for (uint8_t i = 0; i < 3 && i < buf->cantidad; i++) {
             uint16_t idx = (buf->inicio + buf->cantidad - 1 - i) % buf->capacidad;
             const MedicionMP * m = &buf->datos[idx];
+            ds3231_time_t t;
 
+            base_tiempo_desde_segundos(m->timestamp, &t);
             snprintf(buffer, sizeof(buffer),
-                     "[%04u-%02u-%02u %02u:%02u:%02u] Sensor %u: PM2.5 = %.2f µg/m³\n",
-                     m->timestamp.year, m->timestamp.month, m->timestamp.day, m->timestamp.hour,
-                     m->timestamp.min, m->timestamp.sec, m->sensor_id, m->pm2_5);
+                     "[%04u-%02u-%02u %02u:%02u:%02u] Sensor %u: PM2.5 = %.2f µg/m³\n", t.year,
+                     t.month, t.day, t.hour, t.min, t.sec, m->sensor_id, m->pm2_5);
             uart_print("%s", buffer);
         }
     }
@@ -780,7 +735,7 @@ FRESULT guardar_promedio_csv(float pm1_0, float pm2_5, float pm4_0, float pm10,
     // Abrir archivo en modo append o crear si no existe
     res = f_open(&archivo, nombre_archivo, FA_OPEN_APPEND | FA_WRITE);
     if (res != FR_OK) {
-        uart_print("Error abriendo archivo: %s\r\n", nombre_archivo);
+        LOG_ERROR("Error abriendo archivo: %s\r\n", nombre_archivo);
         return res;
     }
 
@@ -794,9 +749,9 @@ FRESULT guardar_promedio_csv(float pm1_0, float pm2_5, float pm4_0, float pm10,
     f_close(&archivo);
 
     if (res == FR_OK && escritos > 0) {
-        uart_print("Promedio guardado: %s", linea);
+        LOG_INFO("Promedio guardado: %s", linea);
     } else {
-        uart_print("Error escribiendo promedio a SD\r\n");
+        LOG_ERROR("Error escribiendo promedio a SD\r\n");
     }
 
     if (f_size(&archivo) == 0) {
@@ -807,26 +762,6 @@ FRESULT guardar_promedio_csv(float pm1_0, float pm2_5, float pm4_0, float pm10,
     return res;
 }
 
-/**
- * @brief Formatea una estructura de datos como línea CSV
- *
- * @param data Puntero a estructura con los datos
- * @param csv_line Cadena de salida donde se almacenará la línea CSV
- * @param max_len Tamaño máximo del búfer de salida
- * @return true si el formateo fue exitoso, false si hubo error de espacio
- */
-bool format_csv_line(const ParticulateData * data, char * csv_line, size_t max_len) {
-    char timestamp[32];
-    build_iso8601_timestamp(timestamp, sizeof(timestamp), data);
-
-    int written =
-        snprintf(csv_line, max_len, "%s,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", timestamp,
-                 data->sensor_id, data->pm1_0, data->pm2_5, data->pm4_0, data->pm10, data->temp_amb,
-                 data->hum_amb, data->temp_cam, data->hum_cam);
-
-    return (written > 0 && (size_t)written < max_len);
-}
-
 /**
  * @brief Convierte una estructura `ParticulateData` en una línea CSV con timestamp.
  *
@@ -841,15 +776,13 @@ bool format_csv_line(const ParticulateData * data, char * csv_line, size_t max_l
 bool build_csv_filepath_from_datetime(char * filepath, size_t max_len) {
     ds3231_time_t dt;
 
-    if (!ds3231_get_datetime(&dt)) {
-        uart_print("Error: No se pudo leer el DS3231\r\n");
+    if (!base_tiempo_ahora(&dt)) {
+        LOG_ERROR("Error: No se pudo leer el DS3231\r\n");
         return false;
     }
 
-    char debug[64];
-    snprintf(debug, sizeof(debug), "RTC DS3231: %04d/%02d/%02d %02d:%02d:%02d\r\n", dt.year,
-             dt.month, dt.day, dt.hour, dt.min, dt.sec);
-    uart_print(debug);
+    LOG_DEBUG("RTC DS3231: %04d/%02d/%02d %02d:%02d:%02d\r\n", dt.year, dt.month, dt.day, dt.hour,
+              dt.min, dt.sec);
 
     int written = snprintf(filepath, max_len, "/%04d/%02d/%02d/DATA_%02d%02d%02d.CSV", dt.year,
                            dt.month, dt.day, dt.hour, dt.min, dt.sec);
@@ -866,21 +799,7 @@ bool build_csv_filepath_from_datetime(char * filepath, size_t max_len) {
  * @return `true` si todos los directorios fueron creados o ya existían.
  */
 bool crear_directorio_fecha(const ds3231_time_t * dt) {
-    char dirpath[64];
-
-    snprintf(dirpath, sizeof(dirpath), "/%04d", dt->year);
-    if (f_mkdir(dirpath) != FR_OK && f_stat(dirpath, NULL) != FR_OK)
-        return false;
-
-    snprintf(dirpath, sizeof(dirpath), "/%04d/%02d", dt->year, dt->month);
-    if (f_mkdir(dirpath) != FR_OK && f_stat(dirpath, NULL) != FR_OK)
-        return false;
-
-    snprintf(dirpath, sizeof(dirpath), "/%04d/%02d/%02d", dt->year, dt->month, dt->day);
-    if (f_mkdir(dirpath) != FR_OK && f_stat(dirpath, NULL) != FR_OK)
-        return false;
-
-    return true;
+    return microSD_cache_directorio_dia(dt->year, dt->month, dt->day) == FR_OK;
 }
 
 /**
@@ -904,7 +823,7 @@ bool obtener_ruta_archivo(const ds3231_time_t * dt, const char * nombre_archivo,
 /**
  * @brief Escribe una línea de texto al final de un archivo CSV existente o nuevo.
  *
- * Abre (o crea) el archivo y posiciona el puntero al final para agregar la línea.
+ * La línea queda en la caché de archivos abiertos hasta la próxima sincronización.
  *
  * @param filepath Ruta completa del archivo donde escribir.
  * @param linea    Cadena de texto a escribir.
@@ -912,18 +831,7 @@ bool obtener_ruta_archivo(const ds3231_time_t * dt, const char * nombre_archivo,
  */
 
 bool escribir_linea_csv(const char * filepath, const char * linea) {
-    FIL file;
-    FRESULT res = f_open(&file, filepath, FA_OPEN_ALWAYS | FA_WRITE);
-    if (res != FR_OK)
-        return false;
-
-    f_lseek(&file, f_size(&file));
-
-    UINT written;
-    res = f_write(&file, linea, strlen(linea), &written);
-    f_close(&file);
-
-    return (res == FR_OK && written == strlen(linea));
+    return microSD_cache_agregar_linea(filepath, linea, NULL) == FR_OK;
 }
 
 /**
@@ -942,35 +850,34 @@ bool log_data_to_sd(const ParticulateData * data) {
     }
 
     ds3231_time_t dt;
-    if (!ds3231_get_datetime(&dt)) {
-        uart_print("Error al obtener la hora del DS3231\r\n");
+    if (!base_tiempo_ahora(&dt)) {
+        LOG_ERROR("Error al obtener la hora del DS3231\r\n");
         return false;
     }
 
     if (!crear_directorio_fecha(&dt)) {
-        uart_print("Error al crear carpetas por fecha\r\n");
+        LOG_ERROR("Error al crear carpetas por fecha\r\n");
         return false;
     }
 
     char filepath[64];
     if (!obtener_ruta_archivo(&dt, "RAW.csv", filepath, sizeof(filepath))) {
-        uart_print("Error al generar nombre de archivo\r\n");
+        LOG_ERROR("Error al generar nombre de archivo\r\n");
         return false;
     }
 
     char csv_line[CSV_LINE_BUFFER_SIZE];
     if (!format_csv_line(data, csv_line, sizeof(csv_line))) {
-        uart_print("Error al generar línea CSV\r\n");
+        LOG_ERROR("Error al generar línea CSV\r\n");
         return false;
     }
 
     if (!escribir_linea_csv(filepath, csv_line)) {
-        uart_print("Fallo al escribir en microSD\r\n");
+        LOG_ERROR("Fallo al escribir en microSD\r\n");
         return false;
     }
 
-    uart_print("Línea escrita en SD:\r\n");
-    uart_print(csv_line);
+    LOG_DEBUG("Línea escrita en SD:\r\n%s", csv_line);
     return true;
 }
 
@@ -987,14 +894,14 @@ bool data_logger_write_csv_line(const ParticulateData * data) {
     char line[CSV_LINE_BUFFER_SIZE];
 
     if (!format_csv_line(data, line, sizeof(line))) {
-        uart_print("Error formateando línea CSV\r\n");
+        LOG_ERROR("Error formateando línea CSV\r\n");
         return false;
     }
 
     // Ruta de archivo
     char path[128];
     if (!build_csv_filepath_from_datetime(path, sizeof(path))) {
-        uart_print("Error generando ruta de archivo CSV\r\n");
+        LOG_ERROR("Error generando ruta de archivo CSV\r\n");
         return false;
     }
 
@@ -1004,7 +911,7 @@ bool data_logger_write_csv_line(const ParticulateData * data) {
     FIL file;
     FRESULT res = f_open(&file, path, FA_OPEN_APPEND | FA_WRITE);
     if (res != FR_OK) {
-        uart_print("No se pudo abrir el archivo CSV\r\n");
+        LOG_ERROR("No se pudo abrir el archivo CSV\r\n");
         return false;
     }
 
@@ -1013,15 +920,16 @@ bool data_logger_write_csv_line(const ParticulateData * data) {
     f_write(&file, "\r\n", 2, &bytes_written);
     f_close(&file);
 
-    uart_print("Línea escrita correctamente en CSV\r\n");
+    LOG_DEBUG("Línea escrita correctamente en CSV\r\n");
     return true;
 }
 
 /**
  * @brief Almacena una medición cruda de un sensor, incluyendo metadatos y encabezado del archivo.
  *
- * Crea la carpeta `/YYYY/MM/DD` si no existe y un archivo individual por sensor y fecha
- * (`RAW_<ID>_YYYYMMDD.CSV`). Agrega encabezado detallado con información del sensor.
+ * Crea la carpeta `/YYYY/MM/DD` si no existe y un archivo individual por sensor y fecha. Con
+ * REGISTRO_RAW_BINARIO el archivo es `RAW_<ID>_YYYYMMDD.BIN`, con encabezado binario y un registro
+ * fijo por muestra (ver registro_raw.h); si no, `RAW_<ID>_YYYYMMDD.CSV` con encabezado `#`.
  *
  * @param data Puntero a la estructura `ParticulateData` con los datos medidos.
  * @return `true` si la línea fue escrita exitosamente.
@@ -1033,74 +941,69 @@ bool data_logger_store_raw(const ParticulateData * data) {
     }
 
     char filepath[128];
-    char csv_line[CSV_LINE_BUFFER_SIZE];
-    char dirpath[64];
 
-    // Crear carpetas: /YYYY/MM/DD
-    snprintf(dirpath, sizeof(dirpath), "/%04d", data->year);
-    f_mkdir(dirpath);
+    // Carpeta /YYYY/MM/DD: sólo toca la tarjeta cuando cambia la fecha
+    FRESULT res = microSD_cache_directorio_dia(data->year, data->month, data->day);
+    if (res != FR_OK) {
+        LOG_ERROR("No se pudo crear la carpeta del día\r\n");
+        print_fatfs_error(res);
+        return false;
+    }
+
+    const MP_SensorInfo * info = &sensor_metadata[data->sensor_id - 1];
 
-    snprintf(dirpath, sizeof(dirpath), "/%04d/%02d", data->year, data->month);
-    f_mkdir(dirpath);
+#if REGISTRO_RAW_BINARIO
+    // Un registro fijo por muestra; tools/raw_bin_a_csv.py regenera el CSV
+    snprintf(filepath, sizeof(filepath), "/%04d/%02d/%02d/RAW_%02d_%04d%02d%02d.BIN", data->year,
+             data->month, data->day, data->sensor_id, data->year, data->month, data->day);
+
+    // El encabezado sólo se usa al abrir un archivo vacío: no se arma si ya está en la caché
+    uint8_t header[REGISTRO_RAW_TAM_ENCABEZADO];
+    size_t largo_header = 0;
+    if (!microSD_cache_abierto(filepath)) {
+        registro_raw_encabezado_bin(header, data, info->serial_number, info->location_name,
+                                    LOCATION_COORDS);
+        largo_header = sizeof(header);
+    }
 
-    snprintf(dirpath, sizeof(dirpath), "/%04d/%02d/%02d", data->year, data->month, data->day);
-    f_mkdir(dirpath);
+    uint8_t registro[REGISTRO_RAW_TAM_REGISTRO];
+    registro_raw_codificar(data, registro);
 
+    res = microSD_cache_agregar(filepath, registro, sizeof(registro), header, largo_header);
+#else
     // Crear nombre del archivo
     snprintf(filepath, sizeof(filepath), "/%04d/%02d/%02d/RAW_%02d_%04d%02d%02d.CSV", data->year,
              data->month, data->day, data->sensor_id, data->year, data->month, data->day);
 
-    // Abrir archivo
-    FIL file;
-    FRESULT res = f_open(&file, filepath, FA_OPEN_ALWAYS | FA_WRITE);
-    if (res != FR_OK) {
-        uart_print("No se pudo abrir archivo para escribir\r\n");
-        print_fatfs_error(res);
-        return false;
-    }
-
-    // Verificar si el archivo está vacío para agregar encabezado
-    if (f_size(&file) == 0) {
-        char header[512];
-        snprintf(header, sizeof(header),
-                 "# Sensor ID: %d\n"
-                 "# Serial: %s\n"
-                 "# Ubicación: %s\n"
-                 "# Coordenadas: %s\n"
-                 "# Unidades:\n"
-                 "#  - PM1.0, PM2.5, PM4.0, PM10 en ug/m3\n"
-                 "#  - Temp_amb y Temp_cam en °C\n"
-                 "#  - Hum_amb y Hum_cam en %%RH\n"
-                 "# Formato:\n"
-                 "#  timestamp, sensor_id, pm1.0, pm2.5, pm4.0, pm10, temp_amb, hum_amb, temp_cam, "
-                 "hum_cam\n",
-                 data->sensor_id, sensor_metadata[data->sensor_id - 1].serial_number,
-                 sensor_metadata[data->sensor_id - 1].location_name, LOCATION_COORDS);
-
-        UINT bw_header;
-        f_write(&file, header, strlen(header), &bw_header);
+    // El encabezado sólo se usa al abrir un archivo vacío: no se arma si ya está en la caché
+    char header[512];
+    char csv_line[CSV_LINE_BUFFER_SIZE];
+    const char * encabezado = NULL;
+    if (!microSD_cache_abierto(filepath)) {
+        registro_raw_encabezado_csv(header, sizeof(header), data->sensor_id, info->serial_number,
+                                    info->location_name, LOCATION_COORDS);
+        encabezado = header;
     }
 
-    // Cerrar archivo después de escribir cabecera
-    f_close(&file);
-
     // Crear línea CSV
     if (!format_csv_line(data, csv_line, sizeof(csv_line))) {
-        uart_print("Error al generar línea CSV\r\n");
+        LOG_ERROR("Error al generar línea CSV\r\n");
         return false;
     }
 
-    // Escribir la línea CSV usando utilidad
-    bool ok = microSD_appendLineAbsolute(filepath, csv_line);
+    // Escribir la línea CSV a través de la caché de archivos abiertos
+    res = microSD_cache_agregar_linea(filepath, csv_line, encabezado);
+#endif
 
-    if (ok) {
-        uart_print("RAW escrito: ");
-        uart_print(csv_line);
+    if (res == FR_OK) {
+        LOG_DEBUG("RAW escrito: sensor %d %02d:%02d:%02d\r\n", data->sensor_id, data->hour,
+                  data->min, data->sec);
     } else {
-        uart_print("Fallo al escribir en RAW\r\n");
+        LOG_ERROR("Fallo al escribir en RAW\r\n");
+        print_fatfs_error(res);
     }
 
-    return ok;
+    return res == FR_OK;
 }
 
 bool data_logger_store_avg10_csv(const EstadisticaPM25 * data) {
@@ -1111,63 +1014,54 @@ bool data_logger_store_avg10_csv(const EstadisticaPM25 * data) {
 
     char filepath[128];
     char csv_line[256];
-    char dirpath[64];
-
-    // Crear carpetas
-    snprintf(dirpath, sizeof(dirpath), "/%04d", data->year);
-    f_mkdir(dirpath);
-
-    snprintf(dirpath, sizeof(dirpath), "/%04d/%02d", data->year, data->month);
-    f_mkdir(dirpath);
+    ds3231_time_t t;
 
-    snprintf(dirpath, sizeof(dirpath), "/%04d/%02d/%02d", data->year, data->month, data->day);
-    f_mkdir(dirpath);
+    // Fecha de calendario sólo para la ruta y la línea
+    base_tiempo_desde_segundos(data->timestamp, &t);
 
-    // Nombre del archivo de promedios cada 10 min
-    snprintf(filepath, sizeof(filepath), "/%04d/%02d/%02d/AVG10_%04d%02d%02d.CSV", data->year,
-             data->month, data->day, data->year, data->month, data->day);
-
-    // Abrir archivo
-    FIL file;
-    FRESULT res = f_open(&file, filepath, FA_OPEN_ALWAYS | FA_WRITE);
+    // Crear carpetas (sin acceso a la tarjeta si ya existen las del día)
+    FRESULT res = microSD_cache_directorio_dia(t.year, t.month, t.day);
     if (res != FR_OK) {
-        uart_print("[ERROR] No se pudo abrir AVG10 para escribir\r\n");
+        LOG_ERROR("[ERROR] No se pudo crear la carpeta de AVG10\r\n");
         print_fatfs_error(res);
         return false;
     }
 
-    // Escribir encabezado si está vacío
-    if (f_size(&file) == 0) {
-        const char * header =
-            "# Formato: timestamp, pm2.5_promedio, pm2.5_min, pm2.5_max, pm2.5_std, muestras\n";
-        UINT bw;
-        f_write(&file, header, strlen(header), &bw);
+    // Nombre del archivo de promedios cada 10 min
+    snprintf(filepath, sizeof(filepath), "/%04d/%02d/%02d/AVG10_%04d%02d%02d.CSV", t.year, t.month,
+             t.day, t.year, t.month, t.day);
+
+    // Encabezado para el archivo nuevo
+    const char * header =
+        "# Formato: timestamp, pm2.5_promedio, pm2.5_min, pm2.5_max, pm2.5_std, muestras\n";
+
+    // Construir línea CSV: "YYYY-MM-DD HH:MM:SS,%.2f,%.2f,%.2f,%.2f,%u\r\n" sin snprintf
+    const char * fin = csv_line + sizeof(csv_line);
+    const float valores[] = {data->pm2_5_promedio, data->pm2_5_min, data->pm2_5_max,
+                             data->pm2_5_std};
+
+    char * p =
+        formato_csv_fecha_hora(csv_line, fin, t.year, t.month, t.day, t.hour, t.min, t.sec, ' ');
+    for (size_t i = 0; i < sizeof(valores) / sizeof(valores[0]); i++) {
+        p = formato_csv_caracter(p, fin, ',');
+        p = formato_csv_decimal(p, fin, valores[i], PUNTO_FIJO_DECIMALES_MP);
+    }
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_entero(p, fin, data->num_validos, 1);
+    p = formato_csv_texto(p, fin, "\r\n");
+    if (p == NULL) {
+        LOG_ERROR("[ERROR] Línea AVG10 truncada\r\n");
+        return false;
     }
-    f_close(&file);
-
-    // Construir línea CSV
-    snprintf(csv_line, sizeof(csv_line), "%04d-%02d-%02d %02d:%02d:%02d,%.2f,%.2f,%.2f,%.2f,%u\r\n",
-             data->year, data->month, data->day, data->hour, data->min, data->sec,
-             data->pm2_5_promedio, data->pm2_5_min, data->pm2_5_max, data->pm2_5_std,
-             data->num_validos);
 
     // Escribir línea CSV
-    return microSD_appendLineAbsolute(filepath, csv_line);
-}
-
-/**
- * @brief Construye una cadena con formato de timestamp ISO8601 a partir de una estructura de datos.
- *
- * Formato: `YYYY-MM-DDTHH:MM:SSZ`
- *
- * @param buffer Buffer de salida para el timestamp.
- * @param len    Longitud máxima del buffer.
- * @param data   Datos con la fecha y hora a convertir.
- */
-
-void build_iso8601_timestamp(char * buffer, size_t len, const ParticulateData * data) {
-    snprintf(buffer, len, "%04u-%02u-%02uT%02u:%02u:%02uZ", data->year, data->month, data->day,
-             data->hour, data->min, data->sec);
+    res = microSD_cache_agregar_linea(filepath, csv_line, header);
+    if (res != FR_OK) {
+        LOG_ERROR("[ERROR] No se pudo escribir AVG10\r\n");
+        print_fatfs_error(res);
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -1254,24 +1148,12 @@ bool buffer_guardar(BufferCircular * buffer) {
         const MedicionMP * data = &buffer->datos[i];
 
         if (data->sensor_id == 0 || data->sensor_id > MAX_SENSORES_SPS30) {
-            uart_print("[ERROR] buffer_guardar: ID de sensor fuera de rango (%d)\r\n",
-                       data->sensor_id);
+            LOG_ERROR("[ERROR] buffer_guardar: ID de sensor fuera de rango (%d)\r\n",
+                      data->sensor_id);
             continue;
         }
 
-        uint8_t idx = data->sensor_id - 1;
-        BufferCircularSensor * buf = &buffers_10min[idx];
-
-        buf->buffer[buf->head] = *data;
-        buf->head = (buf->head + 1) % BUFFER_10MIN_SIZE;
-
-        if (buf->count < BUFFER_10MIN_SIZE) {
-            buf->count++;
-        } else {
-            uart_print("[WARN] buffer_guardar: sobreescritura en buffer sensor %d\r\n",
-                       data->sensor_id);
-        }
-
+        acumulador_sensor_agregar(&buffers_10min[data->sensor_id - 1], data);
         al_menos_uno_guardado = true;
     }
 
@@ -1291,33 +1173,22 @@ bool data_logger_store_sensor_data(const SensorData * data) {
         return false;
     }
 
-    uint8_t idx = data->sensor_id - 1;
-    BufferCircularSensor * buf = &buffers_10min[idx];
-
-    buf->buffer[buf->head] = *data;
-    buf->head = (buf->head + 1) % BUFFER_10MIN_SIZE;
-
-    if (buf->count < BUFFER_10MIN_SIZE) {
-        buf->count++;
-    } else {
-        uart_print("[WARN] buffer sensor %d sobreescribiendo datos\r\n", data->sensor_id);
-    }
-
+    acumulador_sensor_agregar(&buffers_10min[data->sensor_id - 1], data);
     return true;
 }*/
 
 /**
- * @brief Guarda múltiples mediciones en los buffers por sensor.
+ * @brief Acumula múltiples mediciones en los bloques de 10 minutos por sensor.
  *
  * @param temp_data        Puntero al arreglo de mediciones (`MedicionMP`).
  * @param num_mediciones   Cantidad de elementos válidos en el arreglo.
- * @param buffers_destino  Arreglo de buffers circulares por sensor.
+ * @param buffers_destino  Arreglo de acumuladores por sensor.
  * @return true si se almacenaron todas correctamente, false si hubo al menos un error.
  */
 bool data_logger_store_sensor_data(const MedicionMP * temp_data, size_t num_mediciones,
-                                   BufferCircularSensor * buffers_destino) {
+                                   AcumuladorSensor * buffers_destino) {
     if (!temp_data || !buffers_destino || num_mediciones == 0) {
-        uart_print("[ERROR] Parámetros inválidos en data_logger_store_sensor_data()\r\n");
+        LOG_ERROR("[ERROR] Parámetros inválidos en data_logger_store_sensor_data()\r\n");
         return false;
     }
 
@@ -1327,42 +1198,28 @@ bool data_logger_store_sensor_data(const MedicionMP * temp_data, size_t num_medi
         const MedicionMP * d = &temp_data[i];
 
         if (d->sensor_id == 0 || d->sensor_id > MAX_SENSORES_SPS30) {
-            uart_print("[ERROR] ID de sensor inválido (%d) en medición #%u\r\n", d->sensor_id,
-                       (unsigned)i);
+            LOG_ERROR("[ERROR] ID de sensor inválido (%d) en medición #%u\r\n", d->sensor_id,
+                      (unsigned)i);
             todo_ok = false;
             continue;
         }
 
-        uint8_t idx = d->sensor_id - 1;
-        BufferCircularSensor * dest = &buffers_destino[idx];
-
-        dest->buffer[dest->head] = *d;
-        dest->head = (dest->head + 1) % BUFFER_10MIN_SIZE;
-
-        if (dest->count < BUFFER_10MIN_SIZE) {
-            dest->count++;
-        } else {
-            uart_print("[WARN] Sobreescritura en buffer de sensor %d\r\n", d->sensor_id);
-        }
+        acumulador_sensor_agregar(&buffers_destino[d->sensor_id - 1], d);
     }
 
     return todo_ok;
 }
 
 /**
- * @brief Limpia todos los buffers circulares por sensor.
+ * @brief Reinicia los acumuladores de 10 minutos de todos los sensores.
  *
- * @param buffers Arreglo de buffers, uno por sensor.
+ * @param buffers Arreglo de acumuladores, uno por sensor.
  */
-void data_logger_buffer_limpiar_todos(BufferCircularSensor * buffers) {
+void data_logger_buffer_limpiar_todos(AcumuladorSensor * buffers) {
     if (!buffers)
         return;
 
-    for (uint8_t i = 0; i < MAX_SENSORES_SPS30; ++i) {
-        buffers[i].head = 0;
-        buffers[i].count = 0;
-        memset(buffers[i].buffer, 0, sizeof(buffers[i].buffer));
-    }
+    memset(buffers, 0, MAX_SENSORES_SPS30 * sizeof(buffers[0]));
 }
 /* === Función principal: cálculo periódico basado en RTC ===================================== */
 
@@ -1379,11 +1236,11 @@ BufferCircular * get_buffer_daily(void) {
 TimeWindow * get_time_window(void) {
     return &current_window;
 }
-float * get_avg1h_buffer(void) {
-    return hourly_avgs;
+AcumuladorMP * get_acumulador_1h(void) {
+    return &acumulador_1h;
 }
-float * get_avg24h_buffer(void) {
-    return daily_avgs;
+AcumuladorMP * get_acumulador_24h(void) {
+    return &acumulador_24h;
 }
 int get_hourly_index(void) {
     return hourly_index;
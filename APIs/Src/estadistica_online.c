@@ -0,0 +1,102 @@
+/**
+ * @file estadistica_online.c
+ * @brief Acumuladores de Welford para las estadísticas de 10 minutos, 1 hora y 24 horas.
+ *
+ * Todo se calcula en float: en el Cortex-M4F cada muestra cuesta una división y un par de
+ * multiplicaciones en la FPU, sin las rutinas de double por software.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "estadistica_online.h"
+#include <math.h>
+#include <stddef.h>
+
+/* === Funciones públicas ===================================================================== */
+
+void acumulador_reiniciar(AcumuladorMP * acc) {
+    *acc = (AcumuladorMP){0};
+}
+
+bool acumulador_agregar(AcumuladorMP * acc, float valor) {
+    // Misma condición que maskIsDataTrue(): también descarta NaN
+    if (!(valor > ESTADISTICA_MIN_VALIDO && valor <= ESTADISTICA_MAX_VALIDO)) {
+        return false;
+    }
+    return acumulador_agregar_sin_rango(acc, valor);
+}
+
+bool acumulador_agregar_sin_rango(AcumuladorMP * acc, float valor) {
+    acc->n++;
+    if (acc->n == 1) {
+        acc->media = valor;
+        acc->m2 = 0.0f;
+        acc->min = valor;
+        acc->max = valor;
+        return true;
+    }
+
+    float delta = valor - acc->media;
+    acc->media += delta / (float)acc->n;
+    acc->m2 += delta * (valor - acc->media);
+    if (valor < acc->min) {
+        acc->min = valor;
+    }
+    if (valor > acc->max) {
+        acc->max = valor;
+    }
+    return true;
+}
+
+void acumulador_combinar(AcumuladorMP * destino, const AcumuladorMP * origen) {
+    if (origen->n == 0) {
+        return;
+    }
+    if (destino->n == 0) {
+        *destino = *origen;
+        return;
+    }
+
+    uint32_t n = destino->n + origen->n;
+    float delta = origen->media - destino->media;
+    float peso = (float)origen->n / (float)n;
+
+    destino->media += delta * peso;
+    destino->m2 += origen->m2 + delta * delta * (float)destino->n * peso;
+    destino->n = n;
+    if (origen->min < destino->min) {
+        destino->min = origen->min;
+    }
+    if (origen->max > destino->max) {
+        destino->max = origen->max;
+    }
+}
+
+float acumulador_promedio(const AcumuladorMP * acc) {
+    return (acc->n > 0) ? acc->media : ESTADISTICA_SIN_DATOS;
+}
+
+float acumulador_minimo(const AcumuladorMP * acc) {
+    return (acc->n > 0) ? acc->min : ESTADISTICA_SIN_DATOS;
+}
+
+float acumulador_maximo(const AcumuladorMP * acc) {
+    return (acc->n > 0) ? acc->max : ESTADISTICA_SIN_DATOS;
+}
+
+float acumulador_desvio(const AcumuladorMP * acc) {
+    if (acc->n == 0) {
+        return ESTADISTICA_SIN_DATOS;
+    }
+    if (acc->n == 1) {
+        return ESTADISTICA_DS_SIN_DATO;
+    }
+    // El redondeo puede dejar M2 apenas negativo con muestras iguales
+    float varianza = acc->m2 / (float)(acc->n - 1);
+    return (varianza > 0.0f) ? sqrtf(varianza) : 0.0f;
+}
+
+/* === End of documentation ==================================================================== */
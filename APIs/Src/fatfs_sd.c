@@ -10,12 +10,26 @@
 #include "main.h"
 #include "diskio.h"
 #include "fatfs_sd.h"
+#include "fatfs_sd_config.h"
+#include <string.h>
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private defines -----------------------------------------------------------*/
 #define TRUE  1
 #define FALSE 0
 #define bool  BYTE
+
+/* Estado de la transferencia DMA en curso (lo actualizan los callbacks de la HAL) */
+#define SPI_DMA_LISTO     0
+#define SPI_DMA_EN_CURSO  1
+#define SPI_DMA_ERROR     2
+
+/* Un paso de prescaler: el doble o la mitad de la frecuencia de SCK */
+#define SD_PRESCALER_PASO SPI_CR1_BR_0
+
+/* El DMA no llega a la CCM RAM (0x10000000-0x1000FFFF): esos buffers van por transferencia
+ * bloqueante */
+#define SPI_DMA_ACCESIBLE(p) (((uint32_t)(uintptr_t)(p) & 0xFFFF0000u) != 0x10000000u)
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 extern SPI_HandleTypeDef hspi1;
@@ -23,13 +37,21 @@ extern volatile uint8_t Timer1, Timer2;    /* 10 ms (100Hz) decrement timer */
 static volatile DSTATUS Stat = STA_NOINIT; /* Disk status */
 static uint8_t CardType;                   /* b0:MMC, b1:SDC, b2:Block addressing */
 static uint8_t PowerFlag = 0;              /* indicates if "power" is on */
+static volatile uint8_t spi_dma_estado = SPI_DMA_LISTO;
+static SD_Estadisticas estadisticas;
+static SD_Velocidad velocidad;
+static bool negociando = FALSE; /* Verifica el CRC de lo leído y no baja la velocidad por errores */
+
+/* Bytes que se transmiten mientras se recibe un bloque (en flash: el DMA2 la lee) */
+static const uint8_t relleno_ff[512] = {[0 ... 511] = 0xFF};
 
 /* Private function prototypes -----------------------------------------------*/
 static void SELECT(void);
 static void DESELECT(void);
 static void SPI_TxByte(BYTE data);
 static uint8_t SPI_RxByte(void);
-static void SPI_RxBytePtr(uint8_t * buff);
+static bool SPI_RxBlock(BYTE * buff, UINT n);
+static bool SPI_TxBlock(const BYTE * buff, UINT n);
 static uint8_t SD_ReadyWait(void);
 static void SD_PowerOn(void);
 static void SD_PowerOff(void);
@@ -37,6 +59,10 @@ static uint8_t SD_CheckPower(void);
 static bool SD_RxDataBlock(BYTE * buff, UINT btr);
 static bool SD_TxDataBlock(const BYTE * buff, BYTE token);
 static BYTE SD_SendCmd(BYTE cmd, DWORD arg);
+static void SPI_FijarPrescaler(uint32_t prescaler);
+static void SD_BajarVelocidad(void);
+static DRESULT SD_NegociarVelocidad(SD_Velocidad * v);
+static DRESULT SD_MedirThroughput(SD_Benchmark * b);
 
 /* Exported functions --------------------------------------------------------*/
 /*--------------------------------------------------------------------------
@@ -144,6 +170,9 @@ DRESULT SD_disk_read(BYTE pdrv, BYTE * buff, DWORD sector, UINT count) {
     if (!(CardType & 4))
         sector *= 512;
 
+    uint32_t inicio = HAL_GetTick();
+    UINT sectores = count;
+
     SELECT();
 
     if (count == 1) {
@@ -168,6 +197,13 @@ DRESULT SD_disk_read(BYTE pdrv, BYTE * buff, DWORD sector, UINT count) {
     DESELECT();
     SPI_RxByte();
 
+    estadisticas.ms_lectura += HAL_GetTick() - inicio;
+    if (count) {
+        estadisticas.errores++;
+        SD_BajarVelocidad();
+    } else
+        estadisticas.sectores_leidos += sectores;
+
     return count ? RES_ERROR : RES_OK;
 }
 //-------------------------------------------------------------
@@ -188,6 +224,9 @@ DRESULT SD_disk_write(BYTE pdrv, const BYTE * buff, DWORD sector, UINT count) {
     if (!(CardType & 4))
         sector *= 512;
 
+    uint32_t inicio = HAL_GetTick();
+    UINT sectores = count;
+
     SELECT();
 
     if (count == 1) {
@@ -217,6 +256,13 @@ DRESULT SD_disk_write(BYTE pdrv, const BYTE * buff, DWORD sector, UINT count) {
     DESELECT();
     SPI_RxByte();
 
+    estadisticas.ms_escritura += HAL_GetTick() - inicio;
+    if (count) {
+        estadisticas.errores++;
+        SD_BajarVelocidad();
+    } else
+        estadisticas.sectores_escritos += sectores;
+
     return count ? RES_ERROR : RES_OK;
 }
 //-------------------------------------------------------------
@@ -233,7 +279,25 @@ DRESULT SD_disk_ioctl(BYTE drv, BYTE ctrl, void * buff) {
 
     res = RES_ERROR;
 
-    if (ctrl == CTRL_POWER) {
+    if (ctrl == SD_GET_ESTADISTICAS) {
+        *(SD_Estadisticas *)buff = estadisticas;
+        res = RES_OK;
+    } else if (ctrl == SD_RESET_ESTADISTICAS) {
+        memset(&estadisticas, 0, sizeof(estadisticas));
+        res = RES_OK;
+    } else if (ctrl == SD_GET_VELOCIDAD) {
+        *(SD_Velocidad *)buff = velocidad;
+        res = RES_OK;
+    } else if (ctrl == SD_NEGOCIAR_VELOCIDAD || ctrl == SD_BENCHMARK) {
+        /* no disk */
+        if (Stat & STA_NOINIT)
+            return RES_NOTRDY;
+
+        if (ctrl == SD_NEGOCIAR_VELOCIDAD)
+            res = SD_NegociarVelocidad(buff);
+        else
+            res = SD_MedirThroughput(buff);
+    } else if (ctrl == CTRL_POWER) {
         switch (*ptr) {
         case 0:
             if (SD_CheckPower())
@@ -307,6 +371,7 @@ DRESULT SD_disk_ioctl(BYTE drv, BYTE ctrl, void * buff) {
 
                 res = RES_OK;
             }
+            break;
 
         default:
             res = RES_PARERR;
@@ -336,10 +401,8 @@ static void DESELECT(void) {
 }
 //-------------------------------------------------------------
 
-/* SPI transmit a byte */
+/* SPI transmit a byte (las transferencias DMA ya terminaron: el SPI está libre) */
 static void SPI_TxByte(BYTE data) {
-    while (HAL_SPI_GetState(&hspi1) != HAL_SPI_STATE_READY)
-        ;
     HAL_SPI_Transmit(&hspi1, &data, 1, SPI_TIMEOUT);
 }
 //-------------------------------------------------------------
@@ -350,22 +413,219 @@ static uint8_t SPI_RxByte(void) {
     dummy = 0xFF;
     data = 0;
 
-    while ((HAL_SPI_GetState(&hspi1) != HAL_SPI_STATE_READY))
-        ;
     HAL_SPI_TransmitReceive(&hspi1, &dummy, &data, 1, SPI_TIMEOUT);
 
     return data;
 }
 //-------------------------------------------------------------
 
-/* SPI receive a byte via pointer */
-static void SPI_RxBytePtr(uint8_t * buff) {
-    *buff = SPI_RxByte();
+/**
+ * @brief Espera el fin de la transferencia DMA con el núcleo dormido entre interrupciones.
+ *
+ * Las interrupciones se deshabilitan entre la consulta y __WFI(): si el DMA termina en ese
+ * momento, la interrupción queda pendiente y __WFI() vuelve enseguida en lugar de esperar al
+ * próximo SysTick.
+ */
+static bool SPI_EsperarDMA(void) {
+    uint32_t inicio = HAL_GetTick();
+
+    while (spi_dma_estado == SPI_DMA_EN_CURSO) {
+        if (HAL_GetTick() - inicio > SPI_TIMEOUT) {
+            HAL_SPI_Abort(&hspi1);
+            spi_dma_estado = SPI_DMA_ERROR;
+            break;
+        }
+        __disable_irq();
+        if (spi_dma_estado == SPI_DMA_EN_CURSO)
+            __WFI();
+        __enable_irq();
+    }
+
+    if (spi_dma_estado != SPI_DMA_LISTO) {
+        spi_dma_estado = SPI_DMA_LISTO;
+        estadisticas.errores_dma++;
+        return FALSE;
+    }
+    estadisticas.bloques_dma++;
+    return TRUE;
+}
+
+/* SPI receive a block: una transferencia DMA transmitiendo 0xFF */
+static bool SPI_RxBlock(BYTE * buff, UINT n) {
+    if (!SPI_DMA_ACCESIBLE(buff))
+        return HAL_SPI_TransmitReceive(&hspi1, (uint8_t *)relleno_ff, buff, n, SPI_TIMEOUT) ==
+               HAL_OK;
+
+    spi_dma_estado = SPI_DMA_EN_CURSO;
+    if (HAL_SPI_TransmitReceive_DMA(&hspi1, (uint8_t *)relleno_ff, buff, n) != HAL_OK) {
+        spi_dma_estado = SPI_DMA_LISTO;
+        return FALSE;
+    }
+    return SPI_EsperarDMA();
+}
+
+/* SPI transmit a block: una transferencia DMA; lo recibido se descarta */
+static bool SPI_TxBlock(const BYTE * buff, UINT n) {
+    if (!SPI_DMA_ACCESIBLE(buff))
+        return HAL_SPI_Transmit(&hspi1, (uint8_t *)buff, n, SPI_TIMEOUT) == HAL_OK;
+
+    spi_dma_estado = SPI_DMA_EN_CURSO;
+    if (HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)buff, n) != HAL_OK) {
+        spi_dma_estado = SPI_DMA_LISTO;
+        return FALSE;
+    }
+    return SPI_EsperarDMA();
+}
+
+/* Callbacks de la HAL: fin de las transferencias DMA de SPI1 */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef * hspi) {
+    if (hspi == &hspi1)
+        spi_dma_estado = SPI_DMA_LISTO;
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef * hspi) {
+    if (hspi == &hspi1)
+        spi_dma_estado = SPI_DMA_LISTO;
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef * hspi) {
+    if (hspi == &hspi1)
+        spi_dma_estado = SPI_DMA_ERROR;
+}
+
+/* Cambia el reloj de SPI1 como lo hace la HAL: DeInit, nuevo prescaler, Init */
+static void SPI_FijarPrescaler(uint32_t prescaler) {
+    HAL_SPI_DeInit(&hspi1);
+    hspi1.Init.BaudRatePrescaler = prescaler;
+    HAL_SPI_Init(&hspi1);
+
+    velocidad.prescaler = prescaler;
+    velocidad.sck_hz = HAL_RCC_GetPCLK2Freq() >> ((prescaler >> SPI_CR1_BR_Pos) + 1);
 }
 
 /*--------------------------------------------------------------------------
  SD functions
  ---------------------------------------------------------------------------*/
+/* CRC16-CCITT de los bloques de datos (la tarjeta lo envía aunque no verifique el suyo) */
+static WORD SD_CRC16(const BYTE * buff, UINT n) {
+    WORD crc = 0;
+
+    while (n--) {
+        crc ^= (WORD)(*buff++) << 8;
+        for (int i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (WORD)((crc << 1) ^ 0x1021) : (WORD)(crc << 1);
+    }
+    return crc;
+}
+//-------------------------------------------------------------
+
+/* Un error en uso baja un paso la velocidad negociada, sin pasar de la del montaje */
+static void SD_BajarVelocidad(void) {
+    if (negociando || velocidad.sck_hz == 0 || velocidad.prescaler >= SD_SPI_PRESCALER_SEGURO)
+        return;
+
+    SPI_FijarPrescaler(velocidad.prescaler + SD_PRESCALER_PASO);
+    velocidad.bajadas++;
+}
+//-------------------------------------------------------------
+
+/* Relee el sector y lo reescribe con su contenido original; al final lo compara otra vez */
+static bool SD_ProbarVelocidad(DWORD sector, const BYTE * original, BYTE * copia) {
+    for (int i = 0; i < SD_VELOCIDAD_REPETICIONES; i++) {
+        if (SD_disk_read(0, copia, sector, 1) != RES_OK || memcmp(copia, original, 512) != 0)
+            return FALSE;
+        if (SD_disk_write(0, original, sector, 1) != RES_OK)
+            return FALSE;
+    }
+    return SD_disk_read(0, copia, sector, 1) == RES_OK && memcmp(copia, original, 512) == 0;
+}
+//-------------------------------------------------------------
+
+/**
+ * @brief Sube el reloj de SPI1 de a un paso desde SD_SPI_PRESCALER_SEGURO hasta
+ * SD_SPI_PRESCALER_RAPIDO y se queda con el último paso que verificó el sector de prueba.
+ *
+ * El sector original se lee a la velocidad segura. Un paso falla con un CRC distinto, un timeout
+ * o un sector que no coincide, y entonces el original se vuelve a escribir a la velocidad
+ * verificada.
+ */
+static DRESULT SD_NegociarVelocidad(SD_Velocidad * v) {
+    BYTE * original = v->buffer;
+    BYTE * copia = v->buffer + 512;
+    DWORD sector = v->sector;
+    uint32_t prescaler = SD_SPI_PRESCALER_SEGURO;
+    DRESULT res;
+
+    if (sector == 0) {
+        res = SD_disk_ioctl(0, GET_SECTOR_COUNT, &sector);
+        if (res != RES_OK)
+            return res;
+        sector--;
+    }
+
+    velocidad.pasos = 0;
+    velocidad.fallas = 0;
+    velocidad.bajadas = 0;
+    negociando = TRUE;
+    SPI_FijarPrescaler(prescaler);
+
+    res = SD_disk_read(0, original, sector, 1);
+    while (res == RES_OK && prescaler > SD_SPI_PRESCALER_RAPIDO) {
+        SPI_FijarPrescaler(prescaler - SD_PRESCALER_PASO);
+        if (!SD_ProbarVelocidad(sector, original, copia)) {
+            velocidad.fallas++;
+            SPI_FijarPrescaler(prescaler);
+            res = SD_disk_write(0, original, sector, 1);
+            break;
+        }
+        velocidad.pasos++;
+        prescaler -= SD_PRESCALER_PASO;
+    }
+    negociando = FALSE;
+
+    v->prescaler = velocidad.prescaler;
+    v->sck_hz = velocidad.sck_hz;
+    v->pasos = velocidad.pasos;
+    v->fallas = velocidad.fallas;
+    v->bajadas = 0;
+    return res;
+}
+//-------------------------------------------------------------
+
+/* Lectura y reescritura secuencial en transferencias múltiples de b->sectores_buffer sectores */
+static DRESULT SD_MedirThroughput(SD_Benchmark * b) {
+    DWORD ms_lectura = 0, ms_escritura = 0;
+    uint32_t inicio;
+
+    if (b->buffer == NULL || b->sectores_buffer == 0 || b->sectores == 0)
+        return RES_PARERR;
+
+    for (DWORD hecho = 0; hecho < b->sectores;) {
+        UINT n = b->sectores - hecho;
+        if (n > b->sectores_buffer)
+            n = b->sectores_buffer;
+
+        inicio = HAL_GetTick();
+        if (SD_disk_read(0, b->buffer, b->sector + hecho, n) != RES_OK)
+            return RES_ERROR;
+        ms_lectura += HAL_GetTick() - inicio;
+
+        inicio = HAL_GetTick();
+        if (SD_disk_write(0, b->buffer, b->sector + hecho, n) != RES_OK)
+            return RES_ERROR;
+        ms_escritura += HAL_GetTick() - inicio;
+
+        hecho += n;
+    }
+
+    /* sectores / 2 KB en ms / 1000 s */
+    b->kbs_lectura = b->sectores * 500u / (ms_lectura ? ms_lectura : 1);
+    b->kbs_escritura = b->sectores * 500u / (ms_escritura ? ms_escritura : 1);
+    return RES_OK;
+}
+//-------------------------------------------------------------
+
+
 /* wait SD ready */
 static uint8_t SD_ReadyWait(void) {
     uint8_t res;
@@ -435,6 +695,7 @@ static uint8_t SD_CheckPower(void) {
 /* receive data block */
 static bool SD_RxDataBlock(BYTE * buff, UINT btr) {
     uint8_t token;
+    WORD crc;
 
     Timer1 = 10; /* timeout 100ms */
 
@@ -447,14 +708,16 @@ static bool SD_RxDataBlock(BYTE * buff, UINT btr) {
     if (token != 0xFE)
         return FALSE;
 
-    /* receive data */
-    do {
-        SPI_RxBytePtr(buff++);
-        SPI_RxBytePtr(buff++);
-    } while (btr -= 2);
+    /* receive data: el bloque entero en una transferencia */
+    if (!SPI_RxBlock(buff, btr))
+        return FALSE;
 
-    SPI_RxByte(); /* CRC 무시 */
-    SPI_RxByte();
+    /* CRC: sólo se verifica mientras se negocia la velocidad */
+    crc = (WORD)SPI_RxByte() << 8;
+    crc |= SPI_RxByte();
+
+    if (negociando && crc != SD_CRC16(buff, btr))
+        return FALSE;
 
     return TRUE;
 }
@@ -463,7 +726,7 @@ static bool SD_RxDataBlock(BYTE * buff, UINT btr) {
 /* transmit data block */
 #if _READONLY == 0
 static bool SD_TxDataBlock(const BYTE * buff, BYTE token) {
-    uint8_t resp = 0, wc;
+    uint8_t resp = 0;
     uint8_t i = 0;
 
     /* wait SD ready */
@@ -473,35 +736,32 @@ static bool SD_TxDataBlock(const BYTE * buff, BYTE token) {
     /* transmit token */
     SPI_TxByte(token);
 
-    /* if it's not STOP token, transmit data */
-    if (token != 0xFD) {
-        wc = 0;
-
-        /* 512 바이트 데이터 전송 */
-        do {
-            SPI_TxByte(*buff++);
-            SPI_TxByte(*buff++);
-        } while (--wc);
+    /* STOP token: no lleva datos ni respuesta (la espera de ocupado la hace el próximo comando) */
+    if (token == 0xFD)
+        return TRUE;
 
-        SPI_RxByte(); /* CRC 무시 */
-        SPI_RxByte();
+    /* 512 바이트 데이터 전송: el bloque entero en una transferencia */
+    if (!SPI_TxBlock(buff, 512))
+        return FALSE;
 
-        /* 데이트 응답 수신 */
-        while (i <= 64) {
-            resp = SPI_RxByte();
+    SPI_RxByte(); /* CRC 무시 */
+    SPI_RxByte();
 
-            /* transmit 0x05 accepted */
-            if ((resp & 0x1F) == 0x05)
-                break;
+    /* 데이트 응답 수신 */
+    while (i <= 64) {
+        resp = SPI_RxByte();
 
-            i++;
-        }
+        /* transmit 0x05 accepted */
+        if ((resp & 0x1F) == 0x05)
+            break;
 
-        /* recv buffer clear */
-        while (SPI_RxByte() == 0)
-            ;
+        i++;
     }
 
+    /* recv buffer clear */
+    while (SPI_RxByte() == 0)
+        ;
+
     if ((resp & 0x1F) == 0x05)
         return TRUE;
     else
@@ -0,0 +1,159 @@
+/**
+ * @file formato_csv.c
+ * @brief Emisores de campos CSV: el camino rápido de las líneas RAW y de promedios.
+ *
+ * snprintf interpreta el formato en cada llamada y, para "%.1f", pasa el float a double y lo
+ * convierte con la rutina general de newlib. Acá cada campo es una conversión entera fija: dos
+ * cifras para la hora, la fecha copiada de la última línea y punto_fijo_escribir() para los
+ * decimales.
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "formato_csv.h"
+#include "punto_fijo.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* === Definiciones de macros privadas ======================================================== */
+
+/** "%.3f" de FLT_MAX: 39 cifras enteras, signo, punto, 3 decimales y '\0' */
+#define DECIMAL_MAX 48
+
+/** "65535-255-255" y el '\0' */
+#define FECHA_MAX 16
+
+/* === Declaraciones de tipos de datos privados =============================================== */
+
+typedef struct {
+    bool valida;
+    uint16_t anio;
+    uint8_t mes;
+    uint8_t dia;
+    size_t largo;
+    char texto[FECHA_MAX];
+} FechaCache;
+
+/* === Definiciones de variables privadas ===================================================== */
+
+static FechaCache fecha_cache = {0};
+
+/* === Funciones privadas ===================================================================== */
+
+static char * copiar(char * p, const char * fin, const char * texto, size_t largo) {
+    if (p == NULL || (size_t)(fin - p) <= largo) {
+        return NULL;
+    }
+    memcpy(p, texto, largo);
+    p[largo] = '\0';
+    return p + largo;
+}
+
+/**
+ * @brief "%02u" para hora, minuto y segundo; un valor de tres cifras va por el camino general.
+ */
+static char * dos_cifras(char * p, const char * fin, uint8_t valor) {
+    if (valor > 99u) {
+        return formato_csv_entero(p, fin, valor, 2);
+    }
+    if (p == NULL || fin - p <= 2) {
+        return NULL;
+    }
+    p[0] = (char)('0' + valor / 10u);
+    p[1] = (char)('0' + valor % 10u);
+    p[2] = '\0';
+    return p + 2;
+}
+
+/* === Funciones públicas ===================================================================== */
+
+char * formato_csv_caracter(char * p, const char * fin, char c) {
+    return copiar(p, fin, &c, 1);
+}
+
+char * formato_csv_texto(char * p, const char * fin, const char * texto) {
+    return copiar(p, fin, texto, strlen(texto));
+}
+
+char * formato_csv_entero(char * p, const char * fin, uint32_t valor, uint8_t ancho) {
+    char cifras[10];
+    size_t n = 0;
+
+    do {
+        cifras[n++] = (char)('0' + valor % 10u);
+        valor /= 10u;
+    } while (valor > 0u);
+
+    size_t ceros = (ancho > n) ? ancho - n : 0;
+    if (p == NULL || (size_t)(fin - p) <= ceros + n) {
+        return NULL;
+    }
+    memset(p, '0', ceros);
+    p += ceros;
+    while (n > 0) {
+        *p++ = cifras[--n];
+    }
+    *p = '\0';
+    return p;
+}
+
+char * formato_csv_decimal(char * p, const char * fin, float x, uint8_t decimales) {
+    char texto[DECIMAL_MAX];
+    size_t largo;
+
+    if (p == NULL) {
+        return NULL;
+    }
+    // Con lugar para el peor caso se escribe directo en la línea
+    if (fin - p > PUNTO_FIJO_TEXTO_MAX) {
+        largo = punto_fijo_escribir(p, x, decimales);
+        if (largo > 0) {
+            return p + largo;
+        }
+    }
+
+    largo = punto_fijo_escribir(texto, x, decimales);
+    if (largo == 0) {
+        int escrito = snprintf(texto, sizeof(texto), "%.*f", (int)decimales, (double)x);
+        if (escrito < 0 || (size_t)escrito >= sizeof(texto)) {
+            return NULL;
+        }
+        largo = (size_t)escrito;
+    }
+    return copiar(p, fin, texto, largo);
+}
+
+char * formato_csv_fecha_hora(char * p, const char * fin, uint16_t anio, uint8_t mes, uint8_t dia,
+                              uint8_t hora, uint8_t minuto, uint8_t segundo, char separador) {
+    if (!fecha_cache.valida || anio != fecha_cache.anio || mes != fecha_cache.mes ||
+        dia != fecha_cache.dia) {
+        char * q = fecha_cache.texto;
+        const char * fin_fecha = fecha_cache.texto + sizeof(fecha_cache.texto);
+
+        q = formato_csv_entero(q, fin_fecha, anio, 4);
+        q = formato_csv_caracter(q, fin_fecha, '-');
+        q = formato_csv_entero(q, fin_fecha, mes, 2);
+        q = formato_csv_caracter(q, fin_fecha, '-');
+        q = formato_csv_entero(q, fin_fecha, dia, 2);
+        // FECHA_MAX alcanza para cualquier uint16/uint8
+        fecha_cache.largo = (size_t)(q - fecha_cache.texto);
+        fecha_cache.anio = anio;
+        fecha_cache.mes = mes;
+        fecha_cache.dia = dia;
+        fecha_cache.valida = true;
+    }
+
+    p = copiar(p, fin, fecha_cache.texto, fecha_cache.largo);
+    p = formato_csv_caracter(p, fin, separador);
+    p = dos_cifras(p, fin, hora);
+    p = formato_csv_caracter(p, fin, ':');
+    p = dos_cifras(p, fin, minuto);
+    p = formato_csv_caracter(p, fin, ':');
+    return dos_cifras(p, fin, segundo);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,92 @@
+/**
+ * @file log_token.c
+ * @brief Registros binarios del log: codificación de argumentos y envío.
+ *
+ * El identificador de cada formato es su desplazamiento dentro de la sección `log_fmt`. El
+ * enlazador define __start_log_fmt para toda sección de salida con nombre de identificador C;
+ * tools/log_tokens.py lee la misma sección del ELF para reconstruir los mensajes.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "log_token.h"
+#include "uart.h"
+#include <string.h>
+
+/* === Variables privadas ===================================================================== */
+
+extern const char __start_log_fmt[]; /**< Inicio de la sección log_fmt (lo define el enlazador) */
+
+/* === Funciones privadas ===================================================================== */
+
+/**
+ * @brief Reserva n bytes de argumentos; false (y el registro queda truncado) si no entran.
+ */
+static bool log_token_reservar(LogToken_Registro * reg, uint8_t n) {
+    if (reg->truncado || reg->largo + n > LOG_TOKEN_REGISTRO_MAX) {
+        reg->truncado = true;
+        return false;
+    }
+    return true;
+}
+
+/* === Funciones públicas ===================================================================== */
+
+void log_token_inicio(LogToken_Registro * reg, const char * formato) {
+    uint16_t id = (uint16_t)(formato - __start_log_fmt);
+
+    reg->datos[0] = LOG_TOKEN_MARCA;
+    reg->datos[2] = (uint8_t)id;
+    reg->datos[3] = (uint8_t)(id >> 8);
+    reg->largo = 0;
+    reg->truncado = false;
+}
+
+void log_token_entero(LogToken_Registro * reg, int32_t valor) {
+    // Zigzag: los enteros chicos, positivos o negativos, ocupan un byte
+    uint32_t resto = ((uint32_t)valor << 1) ^ (uint32_t)(valor >> 31);
+    uint8_t bytes[5];
+    uint8_t n = 0;
+
+    do {
+        bytes[n] = (uint8_t)(resto & 0x7Fu);
+        resto >>= 7;
+        if (resto != 0) {
+            bytes[n] |= 0x80u;
+        }
+        n++;
+    } while (resto != 0);
+
+    if (log_token_reservar(reg, n)) {
+        memcpy(&reg->datos[4 + reg->largo], bytes, n);
+        reg->largo += n;
+    }
+}
+
+void log_token_real(LogToken_Registro * reg, float valor) {
+    if (log_token_reservar(reg, sizeof(valor))) {
+        memcpy(&reg->datos[4 + reg->largo], &valor, sizeof(valor)); // Cortex-M4: little endian
+        reg->largo += sizeof(valor);
+    }
+}
+
+void log_token_cadena(LogToken_Registro * reg, const char * cadena) {
+    size_t n = (cadena != NULL) ? strnlen(cadena, LOG_TOKEN_CADENA_MAX) : 0;
+
+    if (log_token_reservar(reg, (uint8_t)(n + 1))) {
+        if (n > 0) {
+            memcpy(&reg->datos[4 + reg->largo], cadena, n);
+        }
+        reg->datos[4 + reg->largo + n] = '\0';
+        reg->largo += (uint8_t)(n + 1);
+    }
+}
+
+void log_token_enviar(LogToken_Registro * reg) {
+    reg->datos[1] = reg->largo;
+    reg->datos[4 + reg->largo] = LOG_TOKEN_FIN;
+    uart_write_bytes(reg->datos, (uint16_t)(4 + reg->largo + 1));
+}
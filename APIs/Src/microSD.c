@@ -34,18 +34,18 @@
 /* === Headers files inclusions =============================================================== */
 
 #include "microSD.h"
+#include "microSD_cache.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include "fatfs.h"
+#include "fatfs_sd.h"
 #include "usart.h"
 #include "spi.h"
 #include "uart.h"
 
 /* === Macros definitions ====================================================================== */
 
-extern SPI_HandleTypeDef hspi1;
-
 #define SAFE_STRCPY(dest, src, size)                                                               \
     do {                                                                                           \
         strncpy((dest), (src), (size)-1);                                                          \
@@ -182,11 +182,18 @@ MicroSD * microSD_create(UART_HandleTypeDef * huart, const char * filename,
     if (sd->fresult == FR_OK) {
         uart_print("✅ SD montada correctamente.\n");
 
-        // ⚡ Acelera SPI después del montaje exitoso
-        HAL_SPI_DeInit(&hspi1);
-        hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_8;
-        HAL_SPI_Init(&hspi1);
-        uart_print("⚡ SPI acelerado a prescaler 8.\n");
+        // ⚡ Sube el reloj SPI mientras la tarjeta verifique cada paso (fatfs_sd_config.h)
+        char msg[80];
+        SD_Velocidad velocidad = {.buffer = malloc(2 * BYTES_PER_SECTOR)};
+        if (velocidad.buffer != NULL &&
+            disk_ioctl(0, SD_NEGOCIAR_VELOCIDAD, &velocidad) == RES_OK) {
+            snprintf(msg, sizeof(msg), "⚡ SPI de la SD a %lu kHz (%u pasos, %u fallas).\n",
+                     (unsigned long)(velocidad.sck_hz / 1000), velocidad.pasos, velocidad.fallas);
+        } else {
+            snprintf(msg, sizeof(msg), "⚠️ SPI de la SD en la velocidad de montaje.\n");
+        }
+        free(velocidad.buffer);
+        uart_print(msg);
 
         // Cambiar unidad lógica actual si es necesario
         //  f_chdrive(mount_path);
@@ -208,6 +215,7 @@ MicroSD * microSD_create(UART_HandleTypeDef * huart, const char * filename,
 
 void microSD_destroy(MicroSD * sd) {
     if (sd != NULL) {
+        microSD_cache_cerrar_todos(); // Escribe las líneas pendientes antes de desmontar
         sd->fresult = f_mount(NULL, sd->directory, FORCE_UNMOUNT);
         if (sd->fresult != FR_OK) {
             SEND_UART(sd, UNMOUNT_FAILURE);
@@ -255,6 +263,34 @@ void microSD_getSize(MicroSD * sd) {
     BUFFER_CLEAR(sd->buffer);
 }
 
+void microSD_benchmark(MicroSD * sd, DWORD sectores) {
+    SD_Benchmark b = {.sectores_buffer = BENCHMARK_SECTORES_BUFFER, .sectores = sectores};
+    DWORD total;
+
+    if (disk_ioctl(0, GET_SECTOR_COUNT, &total) != RES_OK || sectores == 0 || sectores >= total) {
+        send_uart(sd, "❌ Benchmark de la SD: cantidad de sectores inválida.\n");
+        return;
+    }
+    b.sector = total - sectores;
+    b.buffer = malloc(BENCHMARK_SECTORES_BUFFER * BYTES_PER_SECTOR);
+    if (b.buffer == NULL) {
+        send_uart(sd, "❌ Benchmark de la SD: sin memoria.\n");
+        return;
+    }
+
+    if (disk_ioctl(0, SD_BENCHMARK, &b) == RES_OK) {
+        snprintf(sd->buffer, sizeof(sd->buffer),
+                 "📊 SD: lectura %lu KB/s, escritura %lu KB/s (%lu sectores)\n",
+                 (unsigned long)b.kbs_lectura, (unsigned long)b.kbs_escritura,
+                 (unsigned long)sectores);
+    } else {
+        snprintf(sd->buffer, sizeof(sd->buffer), "❌ Error en el benchmark de la SD.\n");
+    }
+    free(b.buffer);
+    SEND_UART(sd, sd->buffer);
+    BUFFER_CLEAR(sd->buffer);
+}
+
 void microSD_write(MicroSD * sd, const char * data) {
     sd->fresult = f_open(&sd->fil, sd->filename, FA_OPEN_ALWAYS | FA_WRITE);
     FILE_CHECK_ERROR(sd->fresult, sd, FILE_WRITE_FAILURE);
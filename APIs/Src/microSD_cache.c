@@ -0,0 +1,321 @@
+/**
+ * @file microSD_cache.c
+ * @brief Caché de archivos abiertos con líneas acumuladas en RAM y sincronización por política.
+ *
+ * Cada entrada guarda el FIL abierto en modo escritura, posicionado al final, y un buffer con
+ * los bytes aún no entregados a FatFs. Cuando el buffer se llena se escriben los bytes hasta el
+ * último límite de sector del archivo: el primer tramo completa el sector parcial que dejó una
+ * escritura anterior y el resto son sectores enteros que FatFs envía directo al disco. Con la
+ * tabla llena se reemplaza la entrada usada hace más tiempo. Además recuerda la última fecha cuyo
+ * directorio ya se creó.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "microSD_cache.h"
+#include "stm32f4xx_hal.h"
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define LOG_NIVEL_MODULO LOG_NIVEL_DATA_LOGGER
+#include "log.h"
+
+/* === Tipos privados ========================================================================= */
+
+typedef struct {
+    bool abierto;
+    char ruta[MICROSD_CACHE_RUTA_MAX];
+    FIL archivo;
+    uint8_t buffer[MICROSD_CACHE_BUFFER];
+    uint16_t pendientes;   /**< Bytes en buffer aún no pasados a f_write */
+    uint32_t tick_antiguo; /**< HAL_GetTick() de la línea más vieja en buffer */
+    uint32_t ultimo_uso;   /**< Orden de uso para elegir qué entrada reemplazar */
+} EntradaCache;
+
+/* === Variables privadas ===================================================================== */
+
+static EntradaCache entradas[MICROSD_CACHE_ARCHIVOS];
+static uint32_t contador_uso = 0;
+
+/* Fecha cuyo directorio /YYYY/MM/DD ya existe en la tarjeta montada */
+static bool dia_valido = false;
+static uint16_t dia_anio;
+static uint8_t dia_mes;
+static uint8_t dia_dia;
+
+/* === Funciones privadas ===================================================================== */
+
+static EntradaCache * buscar(const char * ruta) {
+    for (int i = 0; i < MICROSD_CACHE_ARCHIVOS; i++) {
+        if (entradas[i].abierto && strcmp(entradas[i].ruta, ruta) == 0) {
+            return &entradas[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Crea un directorio; que ya exista no es un error.
+ */
+static FRESULT crear_directorio(const char * ruta) {
+    FRESULT res = f_mkdir(ruta);
+    return (res == FR_EXIST) ? FR_OK : res;
+}
+
+/**
+ * @brief Escribe los primeros n bytes del buffer con un único f_write y corre el resto al inicio.
+ */
+static FRESULT escribir(EntradaCache * e, uint16_t n) {
+    UINT escritos = 0;
+    FRESULT res = f_write(&e->archivo, e->buffer, n, &escritos);
+
+    if (res == FR_OK && escritos != n) {
+        res = FR_DENIED; // Tarjeta llena
+    }
+    memmove(e->buffer, &e->buffer[n], e->pendientes - n);
+    e->pendientes -= n;
+    return res;
+}
+
+/**
+ * @brief Escribe hasta el último límite de sector y sincroniza; el resto parcial queda en RAM.
+ */
+static FRESULT volcar_sectores(EntradaCache * e) {
+    FSIZE_t posicion = f_tell(&e->archivo);
+    FSIZE_t limite = ((posicion + e->pendientes) / _MAX_SS) * _MAX_SS;
+
+    if (limite <= posicion) {
+        return FR_OK;
+    }
+    FRESULT res = escribir(e, (uint16_t)(limite - posicion));
+    if (res == FR_OK) {
+        res = f_sync(&e->archivo);
+    }
+    return res;
+}
+
+/**
+ * @brief Escribe todo lo pendiente, incluido el sector parcial, y sincroniza.
+ */
+static FRESULT sincronizar(EntradaCache * e) {
+    if (e->pendientes == 0) {
+        return FR_OK;
+    }
+    FRESULT res = escribir(e, e->pendientes);
+    if (res == FR_OK) {
+        res = f_sync(&e->archivo);
+    }
+    return res;
+}
+
+/**
+ * @brief Cierra el archivo; las líneas que no se pudieron escribir se pierden.
+ */
+static FRESULT cerrar(EntradaCache * e) {
+    FRESULT res = (e->pendientes > 0) ? escribir(e, e->pendientes) : FR_OK;
+    FRESULT res_cierre = f_close(&e->archivo);
+
+    if (res == FR_OK) {
+        res = res_cierre;
+    }
+    if (res != FR_OK) {
+        LOG_ERROR("[ERROR] microSD: fallo %d al cerrar %s\r\n", res, e->ruta);
+    }
+    e->abierto = false;
+    e->pendientes = 0;
+    return res;
+}
+
+/**
+ * @brief Copia datos al buffer; cada vez que se llena escribe los sectores completos.
+ */
+static FRESULT agregar(EntradaCache * e, const uint8_t * datos, size_t n) {
+    if (e->pendientes == 0) {
+        e->tick_antiguo = HAL_GetTick();
+    }
+    while (n > 0) {
+        size_t libre = MICROSD_CACHE_BUFFER - e->pendientes;
+        size_t copia = (n < libre) ? n : libre;
+
+        memcpy(&e->buffer[e->pendientes], datos, copia);
+        e->pendientes += (uint16_t)copia;
+        datos += copia;
+        n -= copia;
+
+        if (e->pendientes == MICROSD_CACHE_BUFFER) {
+            // Queda menos de un sector: siempre hay lugar para seguir copiando
+            FRESULT res = volcar_sectores(e);
+            if (res != FR_OK) {
+                return res;
+            }
+        }
+    }
+    return FR_OK;
+}
+
+/**
+ * @brief Abre el archivo en una entrada libre (o en la usada hace más tiempo) y lo posiciona al
+ * final, dejando el encabezado en el buffer si el archivo está vacío.
+ */
+static FRESULT abrir(const char * ruta, const void * encabezado, size_t largo_encabezado,
+                     EntradaCache ** salida) {
+    EntradaCache * e = &entradas[0];
+
+    for (int i = 0; i < MICROSD_CACHE_ARCHIVOS; i++) {
+        if (!entradas[i].abierto) {
+            e = &entradas[i];
+            break;
+        }
+        if (entradas[i].ultimo_uso < e->ultimo_uso) {
+            e = &entradas[i];
+        }
+    }
+    if (e->abierto) {
+        cerrar(e);
+    }
+
+    FRESULT res = f_open(&e->archivo, ruta, FA_OPEN_ALWAYS | FA_WRITE);
+    if (res != FR_OK) {
+        return res;
+    }
+    res = f_lseek(&e->archivo, f_size(&e->archivo));
+    if (res != FR_OK) {
+        f_close(&e->archivo);
+        return res;
+    }
+
+    strcpy(e->ruta, ruta);
+    e->abierto = true;
+    e->pendientes = 0;
+
+    if (f_size(&e->archivo) == 0 && largo_encabezado > 0) {
+        res = agregar(e, encabezado, largo_encabezado);
+        if (res != FR_OK) {
+            cerrar(e);
+            return res;
+        }
+    }
+    *salida = e;
+    return FR_OK;
+}
+
+/* === Funciones públicas ===================================================================== */
+
+FRESULT microSD_cache_agregar(const char * ruta, const void * datos, size_t largo,
+                              const void * encabezado, size_t largo_encabezado) {
+    if (strlen(ruta) >= MICROSD_CACHE_RUTA_MAX) {
+        return FR_INVALID_NAME;
+    }
+
+    EntradaCache * e = buscar(ruta);
+    FRESULT res;
+
+    if (e == NULL) {
+        res = abrir(ruta, encabezado, largo_encabezado, &e);
+        if (res != FR_OK) {
+            if (res == FR_NO_PATH) {
+                dia_valido = false; // Borraron el directorio o cambiaron la tarjeta
+            }
+            return res;
+        }
+    }
+
+    res = agregar(e, datos, largo);
+    if (res != FR_OK) {
+        cerrar(e);
+        return res;
+    }
+    e->ultimo_uso = ++contador_uso;
+    return FR_OK;
+}
+
+FRESULT microSD_cache_agregar_linea(const char * ruta, const char * linea,
+                                    const char * encabezado) {
+    return microSD_cache_agregar(ruta, linea, strlen(linea), encabezado,
+                                 (encabezado != NULL) ? strlen(encabezado) : 0);
+}
+
+FRESULT microSD_cache_directorio_dia(uint16_t anio, uint8_t mes, uint8_t dia) {
+    bool mismo_anio = dia_valido && anio == dia_anio;
+    bool mismo_mes = mismo_anio && mes == dia_mes;
+
+    if (mismo_mes && dia == dia_dia) {
+        return FR_OK;
+    }
+
+    // Sólo se crean los niveles que cambiaron: un f_mkdir al cambiar de día
+    char ruta[16];
+    FRESULT res = FR_OK;
+    if (!mismo_anio) {
+        snprintf(ruta, sizeof(ruta), "/%04d", anio);
+        res = crear_directorio(ruta);
+    }
+    if (res == FR_OK && !mismo_mes) {
+        snprintf(ruta, sizeof(ruta), "/%04d/%02d", anio, mes);
+        res = crear_directorio(ruta);
+    }
+    if (res == FR_OK) {
+        snprintf(ruta, sizeof(ruta), "/%04d/%02d/%02d", anio, mes, dia);
+        res = crear_directorio(ruta);
+    }
+
+    dia_valido = (res == FR_OK);
+    dia_anio = anio;
+    dia_mes = mes;
+    dia_dia = dia;
+    return res;
+}
+
+bool microSD_cache_abierto(const char * ruta) {
+    return buscar(ruta) != NULL;
+}
+
+void microSD_cache_procesar(void) {
+    uint32_t ahora = HAL_GetTick();
+
+    for (int i = 0; i < MICROSD_CACHE_ARCHIVOS; i++) {
+        EntradaCache * e = &entradas[i];
+        if (e->abierto && e->pendientes > 0 && ahora - e->tick_antiguo >= MICROSD_CACHE_SYNC_MS) {
+            if (sincronizar(e) != FR_OK) {
+                cerrar(e);
+            }
+        }
+    }
+}
+
+FRESULT microSD_cache_sincronizar(void) {
+    FRESULT primero = FR_OK;
+
+    for (int i = 0; i < MICROSD_CACHE_ARCHIVOS; i++) {
+        if (entradas[i].abierto) {
+            FRESULT res = sincronizar(&entradas[i]);
+            if (res != FR_OK) {
+                cerrar(&entradas[i]);
+                if (primero == FR_OK) {
+                    primero = res;
+                }
+            }
+        }
+    }
+    return primero;
+}
+
+FRESULT microSD_cache_cerrar_todos(void) {
+    FRESULT primero = FR_OK;
+
+    dia_valido = false; // La próxima tarjeta montada puede no tener los directorios
+
+    for (int i = 0; i < MICROSD_CACHE_ARCHIVOS; i++) {
+        if (entradas[i].abierto) {
+            FRESULT res = cerrar(&entradas[i]);
+            if (primero == FR_OK) {
+                primero = res;
+            }
+        }
+    }
+    return primero;
+}
@@ -30,6 +30,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include "microSD_utils.h"
+#include "microSD_cache.h"
 #include "uart.h" // Para funciones de impresión/debug opcionales
 #include <stdio.h>
 
@@ -52,45 +53,25 @@
 /**
  * @brief Agrega una línea al final de un archivo CSV dado por su ruta absoluta.
  *
+ * La línea pasa por la caché de archivos abiertos (microSD_cache.h): se escribe en la tarjeta
+ * junto con las siguientes, según la política de sincronización.
+ *
  * @param filepath Ruta absoluta del archivo (ej. "/2025/05/24/RAW_20250524.CSV")
  * @param line Línea de texto a escribir (debe terminar en '\n' si se requiere)
  * @return true si se escribió correctamente, false si hubo error
  */
 
 bool microSD_appendLineAbsolute(const char * filepath, const char * line) {
-    FIL file;
-    FRESULT res;
-    UINT bw;
+    // Encabezado para archivos nuevos: mismas columnas que format_csv_line()
+    static const char header[] = "timestamp,sensor_id,pm1.0,pm2.5,pm4.0,pm10,temp_amb,hum_amb,"
+                                 "temp_cam,hum_cam,nc0.5,nc1.0,nc2.5,nc4.0,nc10,tamano_tipico\n";
 
-    res = f_open(&file, filepath, FA_OPEN_ALWAYS | FA_WRITE);
+    FRESULT res = microSD_cache_agregar_linea(filepath, line, header);
     if (res != FR_OK) {
         print_fatfs_error(res);
         return false;
     }
-
-    // Verificar si el archivo está vacío para escribir encabezado
-    if (f_size(&file) == 0) {
-        const char * header = "timestamp,sensor_id,pm1.0,pm2.5,pm4.0,pm10,temp,hum\n";
-        res = f_write(&file, header, strlen(header), &bw);
-        if (res != FR_OK || bw != strlen(header)) {
-            f_close(&file);
-            uart_print("Error al escribir encabezado CSV\r\n");
-            return false;
-        }
-    }
-
-    // Ir al final del archivo para agregar línea
-    res = f_lseek(&file, f_size(&file));
-    if (res != FR_OK) {
-        f_close(&file);
-        print_fatfs_error(res);
-        return false;
-    }
-
-    res = f_write(&file, line, strlen(line), &bw);
-    f_close(&file);
-
-    return (res == FR_OK && bw == strlen(line));
+    return true;
 }
 
 /**
@@ -155,6 +136,9 @@ void print_fatfs_error(FRESULT res) {
     case FR_LOCKED:
         uart_print("FR_LOCKED: El archivo esta bloqueado\r\n");
         break;
+    case FR_TOO_MANY_OPEN_FILES:
+        uart_print("FR_TOO_MANY_OPEN_FILES: Supera _FS_LOCK archivos abiertos\r\n");
+        break;
     default:
         uart_print("Codigo de error desconocido\r\n");
         break;
@@ -33,11 +33,15 @@
 #include "sensor.h"
 #include "observador_MEF.h"
 #include "data_logger.h"
+#include "microSD_cache.h"
 #include "time_rtc.h"
 #include "uart.h"
 #include "pm25_buffer.h"
 #include "data_types.h"
 
+#define LOG_NIVEL_MODULO LOG_NIVEL_MEF
+#include "log.h"
+
 /* === Macros definitions ====================================================================== */
 
 /* === Private data type declarations ========================================================== */
@@ -73,7 +77,7 @@ static bool reposo_esperando = false;
 void observador_MEF_init(void) {
     estado_actual = ESTADO_REPOSO;
     estado_anterior = ESTADO_REPOSO;
-    uart_print("[MEF] Inicializado en estado REPOSO\r\n");
+    LOG_INFO("[MEF] Inicializado en estado REPOSO\r\n");
 }
 
 /**
@@ -102,7 +106,7 @@ Estado_Observador observador_MEF_estado_actual(void) {
 void observador_MEF_forzar_reset(void) {
     pm25_rbuffer_limpiar();
     observador_MEF_init();
-    uart_print("[MEF] Reinicio forzado del sistema de adquisición\r\n");
+    LOG_WARN("[MEF] Reinicio forzado del sistema de adquisición\r\n");
 }
 
 /**
@@ -112,7 +116,7 @@ void observador_MEF_forzar_reset(void) {
  */
 void observador_MEF_debug_estado(void) {
     const char * nombres[] = {"REPOSO", "LECTURA", "ALMACENAMIENTO", "CALCULO", "ERROR"};
-    uart_printf("[MEF] Estado actual: %s\r\n", nombres[estado_actual]);
+    LOG_DEBUG("[MEF] Estado actual: %s\r\n", nombres[estado_actual]);
 }
 
 /**
@@ -121,7 +125,7 @@ void observador_MEF_debug_estado(void) {
  * Este es el núcleo de la MEF. Evalúa transiciones entre estados según condiciones:
  * - `ESTADO_REPOSO`: espera cambio de tiempo.
  * - `ESTADO_LECTURA`: adquiere datos de sensores.
- * - `ESTADO_ALMACENAMIENTO`: guarda datos en buffer circular.
+ * - `ESTADO_ALMACENAMIENTO`: acumula los datos en el bloque de 10 minutos de cada sensor.
  * - `ESTADO_CALCULO`: calcula estadísticas si hubo cambio de bloque de tiempo.
  * - `ESTADO_GUARDADO`: guarda estadísticas en microSD.
  * - `ESTADO_LIMPIESA`: limpia buffers y vuelve a reposo.
@@ -131,7 +135,7 @@ void observador_MEF_debug_estado(void) {
 void observador_MEF_actualizar(void) {
 
     if (estado_actual != estado_anterior) {
-        uart_printf("[MEF] Transicion: %d -> %d\r\n", estado_anterior, estado_actual);
+        LOG_DEBUG("[MEF] Transicion: %d -> %d\r\n", estado_anterior, estado_actual);
         estado_anterior = estado_actual;
     }
 
@@ -143,6 +147,9 @@ void observador_MEF_actualizar(void) {
             reposo_esperando = true;
         }
 
+        // Sincroniza en la microSD las líneas que superaron el tiempo máximo en RAM
+        microSD_cache_procesar();
+
         // Verificamos si pasó el tiempo deseado
         if (HAL_GetTick() - tiempo_inicio_reposo >= DURACION_REPOSO_MS) {
             reposo_esperando = false;
@@ -182,7 +189,7 @@ void observador_MEF_actualizar(void) {
         if (data_logger_estadistica_10min_pm25(buffers_10min, &resultado)) {
             observador_MEF_cambiar_estado(ESTADO_GUARDADO);
         } else {
-            uart_print("[ERROR] No se pudieron calcular estadísticas de PM2.5\r\n");
+            LOG_ERROR("[ERROR] No se pudieron calcular estadísticas de PM2.5\r\n");
             observador_MEF_cambiar_estado(ESTADO_ERROR);
         }
         break;
@@ -199,7 +206,7 @@ void observador_MEF_actualizar(void) {
     }
 
     case ESTADO_ERROR:
-        uart_print("[ERROR] Se detectó un problema en el sistema de adquisición\r\n");
+        LOG_ERROR("[ERROR] Se detectó un problema en el sistema de adquisición\r\n");
         observador_MEF_cambiar_estado(ESTADO_REPOSO);
         break;
     }
@@ -1,58 +1,34 @@
 #include "pm25_avg10.h"
-#include "ParticulateDataAnalyzer.h"
+#include "base_tiempo.h"
+#include "estadistica_online.h"
 #include "microSD_utils.h"
 #include "uart.h"
-#ifndef MP_MIN_VALUE
-#define MP_MIN_VALUE 0.5f
-#endif
-#ifndef MP_MAX_VALUE
-#define MP_MAX_VALUE 500
-#endif
 #ifdef UNIT_TESTING
 #undef UNIT_TESTING
 #include "ff_stub.h"
 #define UNIT_TESTING
 #include <stddef.h>
 #include <stdbool.h>
-float calculateAverage(float data[], int n){return 0.0f;}
-float findMaxValue(float data[], int n){return 0.0f;}
-float findMinValue(float data[], int n){return 0.0f;}
-float calculateStandardDeviation(float data[], int n){return 0.0f;}
 #else
 #include "ff.h"
 #endif
 #include <stdio.h>
 #include <string.h>
 
-#define AVG10_BUFFER_SIZE 60
-
-static float pm25_buffer[AVG10_BUFFER_SIZE];
+/* Estadística del bloque en curso: las muestras no se guardan */
+static AcumuladorMP pm25_acumulador;
 static uint16_t pm25_count = 0;
-static uint16_t write_index = 0;
 bool flag_promedio_10min = false;
 static int last_boundary_minute = -1;
 
 void pm25_avg10_add_sample(float pm25){
-    pm25_buffer[write_index] = pm25;
-    write_index = (write_index + 1) % AVG10_BUFFER_SIZE;
-    if(pm25_count < AVG10_BUFFER_SIZE) pm25_count++;
+    acumulador_agregar(&pm25_acumulador, pm25);
+    if(pm25_count < UINT16_MAX) pm25_count++;
 }
 
 static void clear_buffer(void){
+    acumulador_reiniciar(&pm25_acumulador);
     pm25_count = 0;
-    write_index = 0;
-}
-
-static bool is_valid_sample(float val){
-    return (val > MP_MIN_VALUE) && (val <= MP_MAX_VALUE);
-}
-
-static uint16_t count_valid_samples(const float *data, uint16_t count){
-    uint16_t valid = 0;
-    for(uint16_t i = 0; i < count; i++){
-        if(is_valid_sample(data[i])) valid++;
-    }
-    return valid;
 }
 
 static void save_avg_csv(const ds3231_time_t *dt, float mean, uint16_t valid_count,
@@ -76,7 +52,7 @@ static void save_avg_csv(const ds3231_time_t *dt, float mean, uint16_t valid_cou
 
 void pm25_avg10_process(void){
     ds3231_time_t dt;
-    if(!ds3231_get_datetime(&dt)) return;
+    if(!base_tiempo_ahora(&dt)) return;
 
     if(dt.min % 10 == 0 && dt.min != last_boundary_minute){
         if(last_boundary_minute != -1){
@@ -88,12 +64,11 @@ void pm25_avg10_process(void){
     }
 
     if(flag_promedio_10min){
-        uint16_t count = pm25_count;
-        uint16_t valid = count_valid_samples(pm25_buffer, count);
-        float mean = calculateAverage(pm25_buffer, count);
-        float min = findMinValue(pm25_buffer, count);
-        float max = findMaxValue(pm25_buffer, count);
-        float std = calculateStandardDeviation(pm25_buffer, count);
+        uint16_t valid = (uint16_t)pm25_acumulador.n;
+        float mean = acumulador_promedio(&pm25_acumulador);
+        float min = acumulador_minimo(&pm25_acumulador);
+        float max = acumulador_maximo(&pm25_acumulador);
+        float std = acumulador_desvio(&pm25_acumulador);
 
         char ts[32];
         snprintf(ts, sizeof(ts), "%04d-%02d-%02d %02d:%02d:%02d", dt.year, dt.month,
@@ -26,13 +26,17 @@
 #include "proceso_observador.h"
 #include "DHT22.h"
 #include "data_logger.h"
-#include "rtc_ds3231_for_stm32_hal.h" // para ds3231_get_datetime()
+#include "base_tiempo.h" // para base_tiempo_ahora()
 #include "time_rtc.h"
+#include "sps30_multi.h"
 #include <stdio.h>
 #include <string.h>
 
 #include "ParticulateDataAnalyzer.h"
 
+#define LOG_NIVEL_MODULO LOG_NIVEL_OBSERVADOR
+#include "log.h"
+
 /* === Definición de funciones
  * ============================================================= */
 
@@ -65,6 +69,13 @@ static bool proceso_observador_base(SPS30 * sensor, uint8_t sensor_id, const cha
                                     float temp_amb, float hum_amb, float temp_cam, float hum_cam,
                                     const char * rtc_error_msg);
 
+static bool concentraciones_en_rango(const ConcentracionesPM * pm);
+
+static bool proceso_observador_registrar(const ConcentracionesPM * pm, uint8_t sensor_id,
+                                         const char * datetime_str, float temp_amb, float hum_amb,
+                                         float temp_cam, float hum_cam,
+                                         const char * rtc_error_msg);
+
 /**
  * @brief Ejecuta un ciclo de observación para el sensor SPS30 con temperatura y humedad ambiente.
  *
@@ -160,62 +171,127 @@ bool proceso_observador_3PM_2TH(SPS30 * sensor, uint8_t sensor_id, const char *
 static bool proceso_observador_base(SPS30 * sensor, uint8_t sensor_id, const char * datetime_str,
                                     float temp_amb, float hum_amb, float temp_cam, float hum_cam,
                                     const char * rtc_error_msg) {
-    DEBUG_PRINT("[INFO] entra a  proceso_observador_base()\r\n");
+    LOG_TRACE("[INFO] entra a  proceso_observador_base()\r\n");
     int reintentos = NUM_REINT;
+    bool continuo = sps30_multi_es_continuo();
 
     while (reintentos--) {
-        sensor->start_measurement(sensor);
-        HAL_Delay(2000); // ⏳ Espera crítica tras start_measurement()
-        ConcentracionesPM pm = sensor->get_concentrations(sensor);
-        sensor->stop_measurement(sensor);
-
-        if ((pm.pm1_0 > CONC_MIN_PM && pm.pm1_0 < CONC_MAX_PM) ||
-            (pm.pm2_5 > CONC_MIN_PM && pm.pm2_5 < CONC_MAX_PM) ||
-            (pm.pm4_0 > CONC_MIN_PM && pm.pm4_0 < CONC_MAX_PM) ||
-            (pm.pm10 > CONC_MIN_PM && pm.pm10 < CONC_MAX_PM)) {
-
-            ds3231_time_t dt;
-            if (!ds3231_get_datetime(&dt)) {
-                uart_print("%s", rtc_error_msg);
-                return false;
-            } else {
-                DEBUG_PRINT(
-                    "[WARN] RTC funcionando correctamente en  proceso_observador_base()\r\n");
-            }
-
-            char buffer[BUFFER_SIZE_MSG_PM_FORMAT];
-            snprintf(buffer, sizeof(buffer), MSG_PM_FORMAT_WITH_TIME, datetime_str, sensor_id,
-                     pm.pm1_0, pm.pm2_5, pm.pm4_0, pm.pm10);
-            DEBUG_PRINT("%s", buffer);
-
-            ParticulateData data = {
-                .sensor_id = sensor_id,
-                .pm1_0 = pm.pm1_0,
-                .pm2_5 = pm.pm2_5,
-                .pm4_0 = pm.pm4_0,
-                .pm10 = pm.pm10,
-                .temp_amb = temp_amb,
-                .hum_amb = hum_amb,
-                .temp_cam = temp_cam,
-                .hum_cam = hum_cam,
-                .year = dt.year,
-                .month = dt.month,
-                .day = dt.day,
-                .hour = dt.hour,
-                .min = dt.min,
-                .sec = dt.sec,
-            };
-
-            data_logger_store_raw(&data);
-            // registrar_lectura_pm25(sensor_id, pm.pm2_5);
-            return true;
+        ConcentracionesPM pm = {0};
+
+        if (!continuo || !sensor->midiendo) {
+            sensor->start_measurement(sensor);
+            HAL_Delay(SPS30_WARMUP_MS); // ⏳ Espera crítica tras start_measurement()
+        }
+        Shdlc_Error err = sensor->read_concentrations(sensor, &pm);
+        if (!continuo || (err != SHDLC_OK && err != SHDLC_ERROR_NO_DATA)) {
+            sensor->stop_measurement(sensor);
         }
 
-        uart_print("%s", MSG_ERROR_REINT);
+        if (err == SHDLC_OK && concentraciones_en_rango(&pm)) {
+            return proceso_observador_registrar(&pm, sensor_id, datetime_str, temp_amb, hum_amb,
+                                                temp_cam, hum_cam, rtc_error_msg);
+        }
+
+        LOG_WARN("%s", MSG_ERROR_REINT);
+        if (continuo && sensor->midiendo) {
+            HAL_Delay(SPS30_PERIODO_MEDICION_MS); // Sensor midiendo: se espera el próximo dato
+        }
     }
 
-    char error_msg[BUFFER_SIZE_MSG_ERROR_FALLO];
-    snprintf(error_msg, sizeof(error_msg), MSG_ERROR_FALLO, datetime_str, sensor_id);
-    uart_print("%s", error_msg);
+    LOG_ERROR(MSG_ERROR_FALLO, datetime_str, sensor_id);
     return false;
 }
+
+/**
+ * @brief Ciclo de adquisición concurrente: una sola espera de estabilización para todos los
+ * sensores y reintentos independientes por sensor.
+ *
+ * @see proceso_observador.h
+ */
+int proceso_observador_ciclo(const char * datetime_str, float temp_amb, float hum_amb,
+                             float temp_cam, float hum_cam, SPS30_Adquisicion resultados[]) {
+    LOG_TRACE("[INFO] entra a  proceso_observador_ciclo()\r\n");
+    int correctos = 0;
+
+    sps30_multi_adquirir(resultados, NUM_REINT, concentraciones_en_rango);
+
+    for (int i = 0; i < sensores_disponibles; i++) {
+        uint8_t sensor_id = sensores_sps30[i].id;
+
+        if (!resultados[i].valido) {
+            // Con SHDLC_OK la trama llegó bien y fue el validador de rango quien la rechazó
+            const char * causa = (resultados[i].error == SHDLC_OK)
+                                     ? "fuera de rango"
+                                     : SHDLC_ErrorString(resultados[i].error);
+            LOG_WARN("[WARN] SPS30 ID %d: %s tras %d intentos\r\n", sensor_id, causa,
+                     resultados[i].intentos);
+            LOG_ERROR(MSG_ERROR_FALLO, datetime_str, sensor_id);
+            continue;
+        }
+
+        if (proceso_observador_registrar(&resultados[i].pm, sensor_id, datetime_str, temp_amb,
+                                         hum_amb, temp_cam, hum_cam,
+                                         "Error leyendo hora del RTC\r\n")) {
+            correctos++;
+        }
+    }
+
+    return correctos;
+}
+
+/**
+ * @brief Verifica que al menos una concentración esté dentro del rango aceptable.
+ *
+ * @param pm Concentraciones leídas.
+ * @return true si alguna concentración está entre CONC_MIN_PM y CONC_MAX_PM.
+ */
+static bool concentraciones_en_rango(const ConcentracionesPM * pm) {
+    return (pm->pm1_0 > CONC_MIN_PM && pm->pm1_0 < CONC_MAX_PM) ||
+           (pm->pm2_5 > CONC_MIN_PM && pm->pm2_5 < CONC_MAX_PM) ||
+           (pm->pm4_0 > CONC_MIN_PM && pm->pm4_0 < CONC_MAX_PM) ||
+           (pm->pm10 > CONC_MIN_PM && pm->pm10 < CONC_MAX_PM);
+}
+
+/**
+ * @brief Registra una lectura válida: timestamp del RTC, mensaje de depuración y CSV RAW.
+ *
+ * @return false si no se pudo leer el RTC.
+ */
+static bool proceso_observador_registrar(const ConcentracionesPM * pm, uint8_t sensor_id,
+                                         const char * datetime_str, float temp_amb, float hum_amb,
+                                         float temp_cam, float hum_cam,
+                                         const char * rtc_error_msg) {
+    ds3231_time_t dt;
+    if (!base_tiempo_ahora(&dt)) {
+        LOG_ERROR("%s", rtc_error_msg);
+        return false;
+    } else {
+        LOG_TRACE("[WARN] RTC funcionando correctamente en  proceso_observador_base()\r\n");
+    }
+
+    LOG_INFO(MSG_PM_FORMAT_WITH_TIME, datetime_str, sensor_id, pm->pm1_0, pm->pm2_5, pm->pm4_0,
+             pm->pm10);
+
+    ParticulateData data = {
+        .sensor_id = sensor_id,
+        .pm1_0 = pm->pm1_0,
+        .pm2_5 = pm->pm2_5,
+        .pm4_0 = pm->pm4_0,
+        .pm10 = pm->pm10,
+        .numero = pm->numero,
+        .temp_amb = temp_amb,
+        .hum_amb = hum_amb,
+        .temp_cam = temp_cam,
+        .hum_cam = hum_cam,
+        .year = dt.year,
+        .month = dt.month,
+        .day = dt.day,
+        .hour = dt.hour,
+        .min = dt.min,
+        .sec = dt.sec,
+    };
+
+    data_logger_store_raw(&data);
+    // registrar_lectura_pm25(sensor_id, pm.pm2_5);
+    return true;
+}
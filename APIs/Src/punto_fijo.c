@@ -0,0 +1,124 @@
+/**
+ * @file punto_fijo.c
+ * @brief Conversión exacta float -> entero escalado y formato decimal sin printf.
+ *
+ * Un float es m * 2^e con m de 24 bits; multiplicado por 10^3 entra en 34 bits, así que el valor
+ * escalado exacto y su resto se obtienen con desplazamientos de 64 bits, sin FPU ni tablas.
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "punto_fijo.h"
+#include <math.h>
+#include <string.h>
+
+/* === Definiciones de macros privadas ======================================================== */
+
+#define FLOAT_BITS_MANTISA  23
+#define FLOAT_MASCARA_MANT  0x007FFFFFu
+#define FLOAT_BIT_IMPLICITO 0x00800000u
+#define FLOAT_EXP_MAXIMO    0xFFu
+#define FLOAT_SESGO         150 /**< 127 del exponente + 23 bits de mantisa */
+
+/* === Definiciones de variables privadas ===================================================== */
+
+static const uint32_t potencias_10[PUNTO_FIJO_DECIMALES_MAX + 1] = {1u, 10u, 100u, 1000u};
+
+/* === Funciones públicas ===================================================================== */
+
+bool punto_fijo_desde_float(float x, uint8_t decimales, int32_t * valor) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    uint32_t exponente = (bits >> FLOAT_BITS_MANTISA) & FLOAT_EXP_MAXIMO;
+    uint32_t mantisa = bits & FLOAT_MASCARA_MANT;
+    int32_t potencia2;
+
+    if (decimales > PUNTO_FIJO_DECIMALES_MAX || exponente == FLOAT_EXP_MAXIMO) {
+        return false;
+    }
+    if (exponente == 0) {
+        potencia2 = 1 - FLOAT_SESGO; // subnormal
+    } else {
+        mantisa |= FLOAT_BIT_IMPLICITO;
+        potencia2 = (int32_t)exponente - FLOAT_SESGO;
+    }
+
+    // x * 10^decimales = escalado * 2^potencia2, exacto en 64 bits
+    uint64_t escalado = (uint64_t)mantisa * potencias_10[decimales];
+    uint64_t resultado;
+
+    if (potencia2 >= 0) {
+        if (potencia2 > 8) {
+            return false; // escalado >= 2^23: con 2^9 ya no entra en un int32
+        }
+        resultado = escalado << potencia2;
+    } else if (potencia2 < -40) {
+        resultado = 0; // escalado < 2^34: menos de media unidad
+    } else {
+        uint32_t corrimiento = (uint32_t)(-potencia2);
+        uint64_t resto = escalado & ((1ull << corrimiento) - 1u);
+        uint64_t mitad = 1ull << (corrimiento - 1u);
+
+        resultado = escalado >> corrimiento;
+        // Al par más cercano, como printf
+        if (resto > mitad || (resto == mitad && (resultado & 1u))) {
+            resultado++;
+        }
+    }
+
+    if (resultado > (uint64_t)INT32_MAX) {
+        return false;
+    }
+    *valor = (bits >> 31) ? -(int32_t)resultado : (int32_t)resultado;
+    return true;
+}
+
+/**
+ * @brief Escribe |valor| con el signo indicado; separado para conservar el "-0.00" de printf.
+ */
+static size_t formatear_magnitud(char * destino, uint32_t magnitud, bool negativo,
+                                 uint8_t decimales) {
+    char cifras[12];
+    size_t n = 0;
+    size_t largo = 0;
+
+    // Cifras de atrás hacia adelante, con al menos un cero antes del punto
+    do {
+        cifras[n++] = (char)('0' + magnitud % 10u);
+        magnitud /= 10u;
+    } while (magnitud > 0u || n <= decimales);
+
+    if (negativo) {
+        destino[largo++] = '-';
+    }
+    while (n > 0) {
+        if (n == decimales) {
+            destino[largo++] = '.';
+        }
+        destino[largo++] = cifras[--n];
+    }
+    destino[largo] = '\0';
+    return largo;
+}
+
+size_t punto_fijo_formatear(char * destino, int32_t valor, uint8_t decimales) {
+    uint32_t magnitud = (valor < 0) ? 0u - (uint32_t)valor : (uint32_t)valor;
+    return formatear_magnitud(destino, magnitud, valor < 0, decimales);
+}
+
+size_t punto_fijo_escribir(char * destino, float x, uint8_t decimales) {
+    int32_t valor;
+
+    if (!punto_fijo_desde_float(x, decimales, &valor)) {
+        return 0;
+    }
+    uint32_t magnitud = (valor < 0) ? 0u - (uint32_t)valor : (uint32_t)valor;
+    // signbit(): un negativo que redondea a cero se escribe "-0.00", igual que printf
+    return formatear_magnitud(destino, magnitud, signbit(x) != 0, decimales);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,222 @@
+/**
+ * @file registro_raw.c
+ * @brief Formatos de los archivos RAW: línea CSV, encabezados y codificación del registro binario.
+ *
+ * La línea CSV y el encabezado `#` son la referencia del formato binario: el exportador del host
+ * (tools/raw_bin_a_csv.py) los reproduce a partir del encabezado binario y los registros.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "registro_raw.h"
+#include "formato_csv.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* === Tipos privados ========================================================================= */
+
+typedef struct {
+    const char * nombre;
+    uint8_t tipo;
+    uint8_t decimales;
+    uint8_t desplazamiento;
+} CampoRaw;
+
+/* === Variables privadas ===================================================================== */
+
+/* Mismo orden que las columnas de format_csv_line(); los tres primeros arman el timestamp */
+static const CampoRaw esquema[] = {
+    {"hora", REGISTRO_RAW_TIPO_U8, 0, 0},
+    {"minuto", REGISTRO_RAW_TIPO_U8, 0, 1},
+    {"segundo", REGISTRO_RAW_TIPO_U8, 0, 2},
+    {"sensor_id", REGISTRO_RAW_TIPO_U8, 0, 3},
+    {"pm1.0", REGISTRO_RAW_TIPO_U16, 1, 4},
+    {"pm2.5", REGISTRO_RAW_TIPO_U16, 1, 6},
+    {"pm4.0", REGISTRO_RAW_TIPO_U16, 1, 8},
+    {"pm10", REGISTRO_RAW_TIPO_U16, 1, 10},
+    {"temp_amb", REGISTRO_RAW_TIPO_I16, 1, 12},
+    {"hum_amb", REGISTRO_RAW_TIPO_I16, 1, 14}, // -1.0 cuando falla el DHT22
+    {"temp_cam", REGISTRO_RAW_TIPO_I16, 1, 16},
+    {"hum_cam", REGISTRO_RAW_TIPO_I16, 1, 18},
+    {"nc0.5", REGISTRO_RAW_TIPO_U16, 1, 20},
+    {"nc1.0", REGISTRO_RAW_TIPO_U16, 1, 22},
+    {"nc2.5", REGISTRO_RAW_TIPO_U16, 1, 24},
+    {"nc4.0", REGISTRO_RAW_TIPO_U16, 1, 26},
+    {"nc10", REGISTRO_RAW_TIPO_U16, 1, 28},
+    {"tamano_tipico", REGISTRO_RAW_TIPO_U16, 3, 30},
+};
+
+#define CAMPOS_ESQUEMA (sizeof(esquema) / sizeof(esquema[0]))
+
+_Static_assert(REGISTRO_RAW_INICIO_ESQUEMA + CAMPOS_ESQUEMA * REGISTRO_RAW_TAM_CAMPO <=
+                   REGISTRO_RAW_TAM_ENCABEZADO,
+               "el esquema no entra en el encabezado");
+
+/* === Funciones privadas ===================================================================== */
+
+static void poner_u16(uint8_t * destino, uint16_t valor) {
+    destino[0] = (uint8_t)valor;
+    destino[1] = (uint8_t)(valor >> 8);
+}
+
+static void poner_cadena(uint8_t * destino, const char * texto, size_t tam) {
+    size_t largo = strnlen(texto, tam - 1); // El resto quedó en cero: siempre termina en '\0'
+    memcpy(destino, texto, largo);
+}
+
+/*
+ * (double)x * 10 y (double)x * 1000 son exactos (24 bits de mantisa del float), así que rint()
+ * redondea el mismo valor que printf, con la misma regla: al par más cercano.
+ */
+static uint16_t codificar_u16(float x, double escala) {
+    double r = rint((double)x * escala);
+
+    if (isnan(r) || signbit(x) || r > (double)(REGISTRO_RAW_INVALIDO_U16 - 1)) {
+        return REGISTRO_RAW_INVALIDO_U16;
+    }
+    return (uint16_t)r;
+}
+
+static int16_t codificar_i16(float x) {
+    double r = rint((double)x * 10.0);
+
+    if (isnan(r) || r > (double)(INT16_MAX - 1) || r < (double)(INT16_MIN + 1)) {
+        return REGISTRO_RAW_INVALIDO_I16;
+    }
+    if (r == 0.0 && signbit(x)) {
+        return REGISTRO_RAW_MENOS_CERO;
+    }
+    return (int16_t)r;
+}
+
+/* === Funciones públicas ===================================================================== */
+
+/**
+ * @brief Construye una cadena con formato de timestamp ISO8601 a partir de una estructura de datos.
+ *
+ * Formato: `YYYY-MM-DDTHH:MM:SSZ`
+ *
+ * @param buffer Buffer de salida para el timestamp.
+ * @param len    Longitud máxima del buffer.
+ * @param data   Datos con la fecha y hora a convertir.
+ */
+void build_iso8601_timestamp(char * buffer, size_t len, const ParticulateData * data) {
+    char * p = formato_csv_fecha_hora(buffer, buffer + len, data->year, data->month, data->day,
+                                      data->hour, data->min, data->sec, 'T');
+
+    if (formato_csv_caracter(p, buffer + len, 'Z') == NULL && len > 0) {
+        // Buffer corto: el mismo texto truncado que antes
+        snprintf(buffer, len, "%04u-%02u-%02uT%02u:%02u:%02uZ", data->year, data->month,
+                 data->day, data->hour, data->min, data->sec);
+    }
+}
+
+/*
+ * Misma línea que "%s,%d,%.1f x 13,%.3f\n" con el timestamp ISO8601, byte a byte, pero escrita
+ * campo por campo directo en csv_line (Tests/formato_csv_runner.c compara las dos).
+ */
+bool format_csv_line(const ParticulateData * data, char * csv_line, size_t max_len) {
+    const char * fin = csv_line + max_len;
+
+    // El registro completo del SPS30 va en la misma línea: no agrega escrituras a la microSD
+    const ConcentracionesNumero * nc = &data->numero;
+    const float una_cifra[] = {data->pm1_0,    data->pm2_5,   data->pm4_0,  data->pm10,
+                               data->temp_amb, data->hum_amb, data->temp_cam, data->hum_cam,
+                               nc->nc0_5,      nc->nc1_0,     nc->nc2_5,    nc->nc4_0,
+                               nc->nc10};
+
+    char * p = formato_csv_fecha_hora(csv_line, fin, data->year, data->month, data->day,
+                                      data->hour, data->min, data->sec, 'T');
+    p = formato_csv_caracter(p, fin, 'Z');
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_entero(p, fin, data->sensor_id, 1);
+    for (size_t i = 0; i < sizeof(una_cifra) / sizeof(una_cifra[0]); i++) {
+        p = formato_csv_caracter(p, fin, ',');
+        p = formato_csv_decimal(p, fin, una_cifra[i], 1);
+    }
+    p = formato_csv_caracter(p, fin, ',');
+    p = formato_csv_decimal(p, fin, nc->tamano_tipico, 3);
+    p = formato_csv_caracter(p, fin, '\n');
+
+    return p != NULL;
+}
+
+size_t registro_raw_encabezado_csv(char * destino, size_t max_len, uint8_t sensor_id,
+                                   const char * serial, const char * ubicacion,
+                                   const char * coordenadas) {
+    int largo = snprintf(destino, max_len,
+                         "# Sensor ID: %d\n"
+                         "# Serial: %s\n"
+                         "# Ubicación: %s\n"
+                         "# Coordenadas: %s\n"
+                         "# Unidades:\n"
+                         "#  - PM1.0, PM2.5, PM4.0, PM10 en ug/m3\n"
+                         "#  - Temp_amb y Temp_cam en °C\n"
+                         "#  - Hum_amb y Hum_cam en %%RH\n"
+                         "#  - NC0.5, NC1.0, NC2.5, NC4.0, NC10 en #/cm3\n"
+                         "#  - Tamaño típico en um\n"
+                         "# Formato:\n"
+                         "#  timestamp, sensor_id, pm1.0, pm2.5, pm4.0, pm10, temp_amb, hum_amb, "
+                         "temp_cam, hum_cam, nc0.5, nc1.0, nc2.5, nc4.0, nc10, tamano_tipico\n",
+                         sensor_id, serial, ubicacion, coordenadas);
+
+    if (largo < 0) {
+        return 0;
+    }
+    return ((size_t)largo < max_len) ? (size_t)largo : max_len - 1;
+}
+
+void registro_raw_encabezado_bin(uint8_t * destino, const ParticulateData * data,
+                                 const char * serial, const char * ubicacion,
+                                 const char * coordenadas) {
+    memset(destino, 0, REGISTRO_RAW_TAM_ENCABEZADO);
+    memcpy(destino, REGISTRO_RAW_MAGIA, 8);
+    poner_u16(&destino[8], REGISTRO_RAW_VERSION);
+    poner_u16(&destino[10], REGISTRO_RAW_TAM_ENCABEZADO);
+    poner_u16(&destino[12], REGISTRO_RAW_TAM_REGISTRO);
+    destino[14] = (uint8_t)CAMPOS_ESQUEMA;
+    destino[15] = data->sensor_id;
+    poner_u16(&destino[16], data->year);
+    destino[18] = data->month;
+    destino[19] = data->day;
+    poner_cadena(&destino[20], serial, REGISTRO_RAW_TAM_SERIAL);
+    poner_cadena(&destino[60], ubicacion, REGISTRO_RAW_TAM_UBICACION);
+    poner_cadena(&destino[124], coordenadas, REGISTRO_RAW_TAM_COORDENADAS);
+
+    for (size_t i = 0; i < CAMPOS_ESQUEMA; i++) {
+        uint8_t * campo = &destino[REGISTRO_RAW_INICIO_ESQUEMA + i * REGISTRO_RAW_TAM_CAMPO];
+        // El nombre puede ocupar los 13 bytes sin '\0'
+        memcpy(campo, esquema[i].nombre,
+               strnlen(esquema[i].nombre, REGISTRO_RAW_TAM_NOMBRE_CAMPO));
+        campo[REGISTRO_RAW_TAM_NOMBRE_CAMPO] = esquema[i].tipo;
+        campo[REGISTRO_RAW_TAM_NOMBRE_CAMPO + 1] = esquema[i].decimales;
+        campo[REGISTRO_RAW_TAM_NOMBRE_CAMPO + 2] = esquema[i].desplazamiento;
+    }
+}
+
+void registro_raw_codificar(const ParticulateData * data, uint8_t * destino) {
+    const ConcentracionesNumero * nc = &data->numero;
+
+    destino[0] = data->hour;
+    destino[1] = data->min;
+    destino[2] = data->sec;
+    destino[3] = data->sensor_id;
+    poner_u16(&destino[4], codificar_u16(data->pm1_0, 10.0));
+    poner_u16(&destino[6], codificar_u16(data->pm2_5, 10.0));
+    poner_u16(&destino[8], codificar_u16(data->pm4_0, 10.0));
+    poner_u16(&destino[10], codificar_u16(data->pm10, 10.0));
+    poner_u16(&destino[12], (uint16_t)codificar_i16(data->temp_amb));
+    poner_u16(&destino[14], (uint16_t)codificar_i16(data->hum_amb));
+    poner_u16(&destino[16], (uint16_t)codificar_i16(data->temp_cam));
+    poner_u16(&destino[18], (uint16_t)codificar_i16(data->hum_cam));
+    poner_u16(&destino[20], codificar_u16(nc->nc0_5, 10.0));
+    poner_u16(&destino[22], codificar_u16(nc->nc1_0, 10.0));
+    poner_u16(&destino[24], codificar_u16(nc->nc2_5, 10.0));
+    poner_u16(&destino[26], codificar_u16(nc->nc4_0, 10.0));
+    poner_u16(&destino[28], codificar_u16(nc->nc10, 10.0));
+    poner_u16(&destino[30], codificar_u16(nc->tamano_tipico, 1000.0));
+}
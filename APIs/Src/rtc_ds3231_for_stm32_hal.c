@@ -25,6 +25,7 @@
 
 #include "rtc_config.h"
 #include "rtc_ds3231_for_stm32_hal.h"
+#include "base_tiempo.h"
 #include "time_rtc.h"
 #include "uart.h"
 #include <stdio.h>
@@ -116,9 +117,16 @@ bool DS3231_SetDateTime(const DS3231_DateTime * dt) {
         uart_print(RTC_MSG_SET_FAIL);
         return false;
     }
+    base_tiempo_resincronizar(); // la hora cacheada toma la nueva en la próxima consulta
     return true;
 }
 
+bool DS3231_EnableSQW1Hz(void) {
+    uint8_t control = DS3231_CONTROL_SQW_1HZ;
+    return HAL_I2C_Mem_Write(_ds3231_i2c, DS3231_I2C_ADDR << 1, DS3231_REG_CONTROL,
+                             I2C_MEMADD_SIZE_8BIT, &control, 1, DS3231_TIMEOUT) == HAL_OK;
+}
+
 float DS3231_GetTemperature(void) {
     int8_t msb = DS3231_GetRegByte(DS3231_REG_TEMP_MSB);
     uint8_t lsb = DS3231_GetRegByte(DS3231_REG_TEMP_LSB);
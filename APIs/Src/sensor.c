@@ -48,7 +48,11 @@
 #include "proceso_observador.h"
 #include "sps30_comm.h"
 #include "shdlc.h"
-#include "rtc_ds3231_for_stm32_hal.h" // para ds3231_get_datetime()
+#include "base_tiempo.h" // para base_tiempo_segundos()
+
+#define LOG_NIVEL_MODULO LOG_NIVEL_SENSOR
+#include "log.h"
+
 #include <string.h>
 
 /* === Macros definitions ====================================================================== */
@@ -138,77 +142,86 @@ SensorStatus sensor_leer_datos(void) {
 SensorStatus sensor_leer_datos(MedicionMP * datos_array) {
 
     if (datos_array == NULL) {
-        uart_print("[WARN] datos_array==NULL.\r\n");
+        LOG_WARN("[WARN] datos_array==NULL.\r\n");
         return SENSOR_ERROR;
     } else {
-        uart_print("[INFO] sistema entra funsion sensor_leer_datos()\r\n");
+        LOG_TRACE("[INFO] sistema entra funsion sensor_leer_datos()\r\n");
     }
 
-    DHT22_Data sensorData;
+    DHT22_HandleTypeDef * const dhts[] = {&dhtA, &dhtB};
+    DHT22_Data sensorData[2];
+    int dht_estado[2];
     bool dht_ok = true;
 
     float temp_amb = -100.0f, hum_amb = -1.0f;
     float temp_cam = -100.0f, hum_cam = -1.0f;
 
-    // Leer DHT ambiente
-    if (DHT22_Read(&dhtA, &sensorData) == DHT22_OK) {
-        uart_print("[INFO] Lee datos de DTH A\r\n");
-        temp_amb = sensorData.temperatura;
-        hum_amb = sensorData.humedad;
-        uart_print("[DATOS] Temp = %.1f , Hum = %.1f\r\n", temp_amb, hum_amb);
+    // Leer los dos DHT22 con el mismo pulso de inicio
+    DHT22_ReadMultiple(dhts, sensorData, dht_estado, 2);
+
+    // DHT ambiente
+    if (dht_estado[0] == DHT22_OK) {
+        LOG_TRACE("[INFO] Lee datos de DTH A\r\n");
+        temp_amb = sensorData[0].temperatura;
+        hum_amb = sensorData[0].humedad;
+        LOG_DEBUG("[DATOS] Temp = %.1f , Hum = %.1f\r\n", temp_amb, hum_amb);
     } else {
-        uart_print("[WARN] no lee datos DTH ambiente.\r\n");
+        LOG_WARN("[WARN] no lee datos DTH ambiente.\r\n");
         dht_ok = false;
     }
 
-    // Leer DHT cámara
-    if (DHT22_Read(&dhtB, &sensorData) == DHT22_OK) {
-        uart_print("[INFO] Lee datos de DHT22 B\r\n");
-        temp_cam = sensorData.temperatura;
-        hum_cam = sensorData.humedad;
-        uart_print("[DATOS] Temp = %.1f , Hum = %.1f\r\n", temp_cam, hum_cam);
+    // DHT cámara
+    if (dht_estado[1] == DHT22_OK) {
+        LOG_TRACE("[INFO] Lee datos de DHT22 B\r\n");
+        temp_cam = sensorData[1].temperatura;
+        hum_cam = sensorData[1].humedad;
+        LOG_DEBUG("[DATOS] Temp = %.1f , Hum = %.1f\r\n", temp_cam, hum_cam);
     } else {
-        uart_print("[WARN] no lee datos DHT22 camara.\r\n");
+        LOG_WARN("[WARN] no lee datos DHT22 camara.\r\n");
         dht_ok = false;
     }
 
-    // Obtener fecha y hora
+    // Obtener fecha y hora: la marca de las mediciones y, para el registro, su texto
+    epoca_t ahora = 0;
     ds3231_time_t dt;
-    if (!ds3231_get_datetime(&dt)) {
+    if (base_tiempo_segundos(&ahora)) {
+        base_tiempo_desde_segundos(ahora, &dt);
+    } else {
         memset(&dt, 0, sizeof(dt));
-        uart_print("[WARN] RTC no respondio, se colocaron ceros en fecha/hora.\r\n");
+        LOG_WARN("[WARN] RTC no respondio, se colocaron ceros en fecha/hora.\r\n");
     }
 
     char datetime_buffer[32];
     snprintf(datetime_buffer, sizeof(datetime_buffer), "%04u-%02u-%02u %02u:%02u:%02u", dt.year,
              dt.month, dt.day, dt.hour, dt.min, dt.sec);
 
-    uart_print("[RTC] Fecha/Hora actual: %s\r\n", datetime_buffer);
+    LOG_DEBUG("[RTC] Fecha/Hora actual: %s\r\n", datetime_buffer);
 
     uint8_t count = 0;
+    SPS30_Adquisicion resultados[NUM_SENSORES_SPS30];
+
+    // Un único ciclo start/espera/lectura/stop para todos los sensores (registra el CSV RAW)
+    proceso_observador_ciclo(datetime_buffer, temp_amb, hum_amb, temp_cam, hum_cam, resultados);
 
     for (uint8_t i = 0; i < sensores_disponibles && count < NUM_SENSORES_SPS30; ++i) {
-        ConcentracionesPM pm =
-            sensores_sps30[i].sensor.get_concentrations(&sensores_sps30[i].sensor);
+        const ConcentracionesPM pm = resultados[i].pm;
 
-        if (pm.pm2_5 < 0.0f || pm.pm2_5 > 1000.0f)
+        if (!resultados[i].valido || pm.pm2_5 < 0.0f || pm.pm2_5 > 1000.0f)
             continue;
 
         MedicionMP * m = &datos_array[count++];
-        m->timestamp = dt;
-        m->bloque_10min = dt.min / 10;
+        m->timestamp = ahora;
+        m->bloque_10min = BASE_TIEMPO_BLOQUE_10MIN(ahora);
         m->sensor_id = sensores_sps30[i].id;
         m->pm1_0 = pm.pm1_0;
         m->pm2_5 = pm.pm2_5;
         m->pm4_0 = pm.pm4_0;
         m->pm10 = pm.pm10;
+        m->numero = pm.numero;
         m->temp_amb = temp_amb;
         m->hum_amb = hum_amb;
         m->temp_cam = temp_cam;
         m->hum_cam = hum_cam;
-
-        proceso_observador_3PM_2TH(&sensores_sps30[i].sensor, sensores_sps30[i].id, datetime_buffer,
-                                   temp_amb, hum_amb, temp_cam, hum_cam);
     }
 
     return (count > 0) ? SENSOR_OK : SENSOR_ERROR;
@@ -229,28 +242,31 @@ uint8_t sensor_get_all(MedicionMP * out_array, uint8_t max_len) {
     if (!out_array || max_len == 0)
         return 0;
 
-    ds3231_time_t dt;
-    if (!ds3231_get_datetime(&dt)) {
-        memset(&dt, 0, sizeof(ds3231_time_t));
-        uart_print("[WARN] RTC no respondió, se colocarán ceros en fecha/hora.\r\n");
+    epoca_t ahora = 0;
+    if (!base_tiempo_segundos(&ahora)) {
+        LOG_WARN("[WARN] RTC no respondió, se colocarán ceros en fecha/hora.\r\n");
     }
 
-    DHT22_Data sensorData;
+    DHT22_HandleTypeDef * const dhts[] = {&dhtA, &dhtB};
+    DHT22_Data sensorData[2];
+    int dht_estado[2];
     float temp_amb = -99.9f;
     float hum_amb = -99.9f;
     float temp_cam = -99.9f;
     float hum_cam = -99.9f;
 
-    if (DHT22_Read(&dhtA, &sensorData) == DHT22_OK) {
-        temp_amb = sensorData.temperatura;
-        hum_amb = sensorData.humedad;
-        uart_print("Ambiente: Temp: %.1f C, Hum: %.1f%%\n", temp_amb, hum_amb);
+    DHT22_ReadMultiple(dhts, sensorData, dht_estado, 2);
+
+    if (dht_estado[0] == DHT22_OK) {
+        temp_amb = sensorData[0].temperatura;
+        hum_amb = sensorData[0].humedad;
+        LOG_DEBUG("Ambiente: Temp: %.1f C, Hum: %.1f%%\n", temp_amb, hum_amb);
     }
 
-    if (DHT22_Read(&dhtB, &sensorData) == DHT22_OK) {
-        temp_cam = sensorData.temperatura;
-        hum_cam = sensorData.humedad;
-        uart_print("Cámara: Temp: %.1f C, Hum: %.1f%%\n", temp_cam, hum_cam);
+    if (dht_estado[1] == DHT22_OK) {
+        temp_cam = sensorData[1].temperatura;
+        hum_cam = sensorData[1].humedad;
+        LOG_DEBUG("Cámara: Temp: %.1f C, Hum: %.1f%%\n", temp_cam, hum_cam);
     }
 
     uint8_t count = 0;
@@ -262,13 +278,14 @@ uint8_t sensor_get_all(MedicionMP * out_array, uint8_t max_len) {
             continue;
 
         MedicionMP m = {
-            .timestamp = dt,
-            .bloque_10min = dt.min / 10,
+            .timestamp = ahora,
+            .bloque_10min = BASE_TIEMPO_BLOQUE_10MIN(ahora),
             .sensor_id = sensores_sps30[i].id,
             .pm1_0 = pm.pm1_0,
             .pm2_5 = pm.pm2_5,
             .pm4_0 = pm.pm4_0,
             .pm10 = pm.pm10,
+            .numero = pm.numero,
             .temp_amb = temp_amb,
             .hum_amb = hum_amb,
             .temp_cam = temp_cam,
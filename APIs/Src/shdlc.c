@@ -7,35 +7,68 @@
  */
 
 #include <stdio.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include "shdlc.h"
 
-void SHDLC_LoadMyVector(Shdlc_FrameMiso * frame, const uint8_t * DataFrame, size_t DataFrameSize) {
+// Intercambio de bytes de 32 bits para los float big-endian del SPS30: en el Cortex-M4 es una
+// sola instrucción REV; en el host se usa el builtin del compilador o desplazamientos.
+#if defined(__arm__) && !defined(UNIT_TESTING)
+#include "stm32f4xx_hal.h" // CMSIS: __REV, __REV16
+#define SHDLC_BSWAP32(x) __REV(x)
+#define SHDLC_BSWAP16(x) ((uint16_t)__REV16(x))
+#elif defined(__GNUC__)
+#define SHDLC_BSWAP32(x) __builtin_bswap32(x)
+#define SHDLC_BSWAP16(x) __builtin_bswap16(x)
+#else
+#define SHDLC_BSWAP32(x)                                                                           \
+    ((((x) & 0xFFu) << 24) | (((x) & 0xFF00u) << 8) | (((x) >> 8) & 0xFF00u) | ((x) >> 24))
+#define SHDLC_BSWAP16(x) ((uint16_t)((((x) & 0xFFu) << 8) | ((x) >> 8)))
+#endif
+
+Shdlc_Error SHDLC_LoadMyVector(Shdlc_FrameMiso * frame, const uint8_t * DataFrame,
+                               size_t DataFrameSize) {
     if (frame == NULL || DataFrame == NULL || DataFrameSize < 5) {
         // Validación básica para asegurarnos de que los parámetros son válidos y DataFrame tiene el
         // tamaño mínimo esperado.
         printf("Datos no válidos para cargar en myVector.\n");
-        return;
+        return SHDLC_ERROR_FRAME;
     }
 
     uint8_t dataLength = DataFrame[4]; // Longitud de los datos útiles.
 
-    if (dataLength > FRAME_DATA_VECTOR_SIZE_MISO || (4 + dataLength) > DataFrameSize) {
+    // DataFrameSize es la cantidad de bytes entre delimitadores (SHDLC_CalculateDataSize): adr,
+    // cmd, state, lon, datos y checksum.
+    if (dataLength > FRAME_DATA_VECTOR_SIZE_MISO || (5 + (size_t)dataLength) > DataFrameSize) {
         // Asegúrate de que la longitud de los datos no excede el tamaño de myVector ni los límites
         // de DataFrame.
         printf("Longitud de los datos excede el tamaño permitido de myVector o los límites de "
                "DataFrame.\n");
-        return;
+        return SHDLC_ERROR_LENGTH;
     }
 
     // Copiar los datos útiles desde DataFrame a myVector en la estructura Shdlc_FrameMiso.
-    memcpy(frame->myVector, &DataFrame[5], dataLength + 1);
+    memcpy(frame->myVector, &DataFrame[5], dataLength);
 
     // Actualizar el campo 'lon' con la longitud de los datos copiados.
     frame->lon = dataLength;
 
-    // Asume que podrías querer también inicializar otros campos aquí.
+    // Cabecera y checksum: DataFrame[0] es el delimitador de inicio.
+    frame->adr = DataFrame[1];
+    frame->cmd = DataFrame[2];
+    frame->state = DataFrame[3];
+    frame->chk = DataFrame[5 + dataLength];
+
+    uint8_t sum = 0;
+    for (size_t i = 1; i < 5 + (size_t)dataLength; i++) {
+        sum += DataFrame[i];
+    }
+    if ((uint8_t)(sum + frame->chk) != 0xFF) {
+        return SHDLC_ERROR_CHECKSUM;
+    }
+
+    return SHDLC_OK;
 }
 
 /**
@@ -127,30 +160,442 @@ size_t SHDLC_revertByteStuffing(const uint8_t * stuffedData, size_t stuffedSize,
     return originalIndex; // Retorna el tamaño del arreglo revertido
 }
 
-// Función para convertir 4 bytes en big-endian a un valor float IEEE754
-float SHDLC_bytesToFloat(uint8_t * bytes) {
+/**
+ * @brief Convierte 4 bytes big-endian (sin alinear) en un float IEEE754 con un solo swap.
+ */
+static inline float shdlc_be_float(const uint8_t * bytes) {
+    uint32_t raw;
     float value;
-    uint8_t reversedBytes[sizeof(value)];
-
-    // Revertir el orden de los bytes para big-endian
-    for (int i = 0; i < sizeof(value); i++) {
-        reversedBytes[i] = bytes[sizeof(value) - i - 1];
-    }
-
-    // Copiar los bytes revertidos en la variable float
-    memcpy(&value, reversedBytes, sizeof(value));
 
+    memcpy(&raw, bytes, sizeof(raw)); // LDR sin alinear en Cortex-M4
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    raw = SHDLC_BSWAP32(raw);
+#endif
+    memcpy(&value, &raw, sizeof(value));
     return value;
 }
 
+// Función para convertir 4 bytes en big-endian a un valor float IEEE754
+float SHDLC_bytesToFloat(uint8_t * bytes) {
+    return shdlc_be_float(bytes);
+}
+
 // Función para llenar la estructura con los datos de concentración
 void SHDLC_llenarConcentraciones(ConcentracionesPM * concentraciones, uint8_t * data) {
     if (!concentraciones || !data)
         return;
 
     // Al menos 4 * sizeof(float) = 16 bytes
-    concentraciones->pm1_0 = SHDLC_bytesToFloat(&data[0]);
-    concentraciones->pm2_5 = SHDLC_bytesToFloat(&data[4]);
-    concentraciones->pm4_0 = SHDLC_bytesToFloat(&data[8]);
-    concentraciones->pm10 = SHDLC_bytesToFloat(&data[12]);
+    concentraciones->pm1_0 = shdlc_be_float(&data[0]);
+    concentraciones->pm2_5 = shdlc_be_float(&data[4]);
+    concentraciones->pm4_0 = shdlc_be_float(&data[8]);
+    concentraciones->pm10 = shdlc_be_float(&data[12]);
+}
+
+void SHDLC_llenarMedicion(ConcentracionesPM * concentraciones, const uint8_t * data, uint8_t lon) {
+    float valores[SPS30_NUM_VALORES_MEDICION] = {0};
+    uint8_t n = lon / sizeof(float);
+
+    if (!concentraciones || !data)
+        return;
+
+    if (n > SPS30_NUM_VALORES_MEDICION) {
+        n = SPS30_NUM_VALORES_MEDICION;
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        valores[i] = shdlc_be_float(&data[i * sizeof(float)]);
+    }
+
+    // Mismo orden que el payload del SPS30
+    concentraciones->pm1_0 = valores[0];
+    concentraciones->pm2_5 = valores[1];
+    concentraciones->pm4_0 = valores[2];
+    concentraciones->pm10 = valores[3];
+    concentraciones->numero.nc0_5 = valores[4];
+    concentraciones->numero.nc1_0 = valores[5];
+    concentraciones->numero.nc2_5 = valores[6];
+    concentraciones->numero.nc4_0 = valores[7];
+    concentraciones->numero.nc10 = valores[8];
+    concentraciones->numero.tamano_tipico = valores[9];
+}
+
+/**
+ * @brief Lee un uint16 big-endian (sin alinear).
+ */
+static inline uint16_t shdlc_be_u16(const uint8_t * bytes) {
+    uint16_t raw;
+
+    memcpy(&raw, bytes, sizeof(raw));
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    raw = SHDLC_BSWAP16(raw);
+#endif
+    return raw;
+}
+
+void SHDLC_llenarMedicionU16(ConcentracionesPMU16 * concentraciones, const uint8_t * data,
+                             uint8_t lon) {
+    uint16_t valores[SPS30_NUM_VALORES_MEDICION] = {0};
+    uint8_t n = lon / sizeof(uint16_t);
+
+    if (!concentraciones || !data)
+        return;
+
+    if (n > SPS30_NUM_VALORES_MEDICION) {
+        n = SPS30_NUM_VALORES_MEDICION;
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        valores[i] = shdlc_be_u16(&data[i * sizeof(uint16_t)]);
+    }
+
+    concentraciones->pm1_0 = valores[0];
+    concentraciones->pm2_5 = valores[1];
+    concentraciones->pm4_0 = valores[2];
+    concentraciones->pm10 = valores[3];
+    concentraciones->nc0_5 = valores[4];
+    concentraciones->nc1_0 = valores[5];
+    concentraciones->nc2_5 = valores[6];
+    concentraciones->nc4_0 = valores[7];
+    concentraciones->nc10 = valores[8];
+    concentraciones->tamano_tipico_nm = valores[9];
+}
+
+void SHDLC_ConcentracionesDesdeU16(ConcentracionesPM * destino, const ConcentracionesPMU16 * origen) {
+    destino->pm1_0 = origen->pm1_0;
+    destino->pm2_5 = origen->pm2_5;
+    destino->pm4_0 = origen->pm4_0;
+    destino->pm10 = origen->pm10;
+    destino->numero.nc0_5 = origen->nc0_5;
+    destino->numero.nc1_0 = origen->nc1_0;
+    destino->numero.nc2_5 = origen->nc2_5;
+    destino->numero.nc4_0 = origen->nc4_0;
+    destino->numero.nc10 = origen->nc10;
+    destino->numero.tamano_tipico = origen->tamano_tipico_nm / 1000.0f;
+}
+
+Shdlc_Error SHDLC_UnstuffFrameInPlace(uint8_t * buf, size_t * len) {
+    size_t r = 0;
+    size_t w = 0;
+    uint8_t sum = 0;
+
+    if (buf == NULL || len == NULL) {
+        return SHDLC_ERROR_FRAME;
+    }
+
+    // Se ignora lo previo al delimitador de inicio (restos de una respuesta anterior)
+    while (r < *len && buf[r] != SHDLC_FRAME_DELIMITER) {
+        r++;
+    }
+    // Salta delimitadores repetidos: el contenido nunca empieza con 0x7E
+    while (r < *len && buf[r] == SHDLC_FRAME_DELIMITER) {
+        r++;
+    }
+
+    // La escritura (w) nunca alcanza a la lectura (r): el frame se compacta sobre sí mismo
+    for (; r < *len; r++) {
+        uint8_t byte = buf[r];
+        if (byte == SHDLC_FRAME_DELIMITER) {
+            break;
+        }
+        if (byte == SHDLC_ESCAPE_BYTE) {
+            if (++r >= *len) {
+                return SHDLC_ERROR_FRAME;
+            }
+            byte = buf[r] ^ SHDLC_ESCAPE_XOR;
+            if (byte != 0x7E && byte != 0x7D && byte != 0x11 && byte != 0x13) {
+                return SHDLC_ERROR_FRAME;
+            }
+        }
+        buf[w++] = byte;
+        sum += byte;
+    }
+
+    if (r >= *len) {
+        return SHDLC_ERROR_FRAME; // Sin delimitador de cierre
+    }
+    if (w < SHDLC_MISO_HEADER_SIZE + 1 || w != (size_t)SHDLC_MISO_HEADER_SIZE + 1 + buf[3]) {
+        return SHDLC_ERROR_LENGTH;
+    }
+    // La suma incluye el checksum, por lo que un frame íntegro suma 0xFF
+    if (sum != 0xFF) {
+        return SHDLC_ERROR_CHECKSUM;
+    }
+
+    *len = w;
+    return SHDLC_OK;
+}
+
+Shdlc_Error SHDLC_ValidateFrameInPlace(uint8_t * buf, size_t * len, uint8_t adr, uint8_t cmd,
+                                       int lon_esperada) {
+    Shdlc_Error err = SHDLC_UnstuffFrameInPlace(buf, len);
+
+    if (err != SHDLC_OK) {
+        if (len != NULL) {
+            *len = 0;
+        }
+        return err;
+    }
+    if (buf[0] != adr) {
+        return SHDLC_ERROR_ADDRESS;
+    }
+    if (buf[1] != cmd) {
+        return SHDLC_ERROR_COMMAND;
+    }
+    if ((buf[2] & SHDLC_STATE_ERROR_MASK) != 0) {
+        return SHDLC_ERROR_STATE;
+    }
+    if (lon_esperada >= 0 && buf[3] != lon_esperada) {
+        return SHDLC_ERROR_LENGTH;
+    }
+    return SHDLC_OK;
+}
+
+Shdlc_Error SHDLC_DecodeConcentracionesInPlace(uint8_t * buf, size_t len, uint8_t adr,
+                                               uint8_t cmd, ConcentracionesPM * conc) {
+    Shdlc_Error err = SHDLC_ValidateFrameInPlace(buf, &len, adr, cmd, -1);
+
+    if (err != SHDLC_OK) {
+        return err;
+    }
+    if (buf[3] < 4 * sizeof(float)) {
+        return SHDLC_ERROR_LENGTH;
+    }
+
+    SHDLC_llenarMedicion(conc, &buf[SHDLC_MISO_HEADER_SIZE], buf[3]);
+    return SHDLC_OK;
+}
+
+/**
+ * @brief Descarta el frame en curso y vuelve a esperar un delimitador de inicio.
+ */
+static void shdlc_stream_reset(Shdlc_StreamDecoder * decoder) {
+    decoder->state = SHDLC_STREAM_WAIT_START;
+    decoder->escape = 0;
+    decoder->index = 0;
+    decoder->sum = 0;
+}
+
+/**
+ * @brief Comienza un frame nuevo tras recibir un 0x7E.
+ */
+static void shdlc_stream_begin(Shdlc_StreamDecoder * decoder) {
+    shdlc_stream_reset(decoder);
+    decoder->state = SHDLC_STREAM_IN_FRAME;
+}
+
+/**
+ * @brief Ubica un byte ya sin stuffing en el campo que le corresponde del frame.
+ *
+ * @return SHDLC_STREAM_ERROR si el frame excede la longitud declarada o la capacidad de myVector.
+ */
+static inline Shdlc_StreamStatus shdlc_stream_store(Shdlc_StreamDecoder * decoder, uint8_t byte) {
+    Shdlc_FrameMiso * frame = &decoder->frame;
+    uint8_t idx = decoder->index;
+
+    // Caso más frecuente primero: bytes de datos
+    if (idx >= SHDLC_MISO_HEADER_SIZE) {
+        uint8_t pos = idx - SHDLC_MISO_HEADER_SIZE;
+        if (pos < frame->lon) {
+            frame->myVector[pos] = byte;
+            decoder->sum += byte;
+        } else if (pos == frame->lon) {
+            frame->chk = byte;
+        } else {
+            decoder->error = SHDLC_ERROR_LENGTH; // Bytes de más antes del delimitador de cierre
+            return SHDLC_STREAM_ERROR;
+        }
+    } else {
+        switch (idx) {
+        case 0:
+            frame->adr = byte;
+            break;
+        case 1:
+            frame->cmd = byte;
+            break;
+        case 2:
+            frame->state = byte;
+            break;
+        default:
+            if (byte > FRAME_DATA_VECTOR_SIZE_MISO) {
+                decoder->error = SHDLC_ERROR_LENGTH;
+                return SHDLC_STREAM_ERROR;
+            }
+            frame->lon = byte;
+            break;
+        }
+        decoder->sum += byte;
+    }
+
+    decoder->index++;
+    return SHDLC_STREAM_INCOMPLETE;
+}
+
+void SHDLC_StreamInit(Shdlc_StreamDecoder * decoder) {
+    if (decoder == NULL) {
+        return;
+    }
+    memset(&decoder->frame, 0, sizeof(decoder->frame));
+    decoder->error = SHDLC_OK;
+    shdlc_stream_reset(decoder);
+}
+
+Shdlc_StreamStatus SHDLC_StreamFeedByte(Shdlc_StreamDecoder * decoder, uint8_t byte) {
+    if (decoder == NULL) {
+        return SHDLC_STREAM_ERROR;
+    }
+
+    if (byte == SHDLC_FRAME_DELIMITER) {
+        if (decoder->state == SHDLC_STREAM_WAIT_START || decoder->index == 0) {
+            // Inicio de frame (o delimitadores consecutivos)
+            shdlc_stream_begin(decoder);
+            return SHDLC_STREAM_INCOMPLETE;
+        }
+
+        Shdlc_FrameMiso * frame = &decoder->frame;
+        uint8_t expected = (uint8_t)(SHDLC_MISO_HEADER_SIZE + frame->lon + 1);
+
+        if (decoder->escape) {
+            decoder->error = SHDLC_ERROR_FRAME;
+        } else if (decoder->index != expected) {
+            decoder->error = SHDLC_ERROR_LENGTH;
+        } else if ((uint8_t)(frame->chk + decoder->sum) != 0xFF) { // chk = ~sum
+            decoder->error = SHDLC_ERROR_CHECKSUM;
+        } else {
+            decoder->error = SHDLC_OK;
+        }
+
+        if (decoder->error != SHDLC_OK) {
+            // El 0x7E puede ser el inicio del siguiente frame si se perdió sincronismo
+            shdlc_stream_begin(decoder);
+            return SHDLC_STREAM_ERROR;
+        }
+
+        frame->longframe = (uint8_t)(frame->lon + SHDLC_MISO_OVERHEAD);
+        shdlc_stream_reset(decoder);
+        return SHDLC_STREAM_COMPLETE;
+    }
+
+    if (decoder->state == SHDLC_STREAM_WAIT_START) {
+        return SHDLC_STREAM_INCOMPLETE; // Ruido entre frames
+    }
+
+    if (decoder->escape) {
+        decoder->escape = 0;
+        byte ^= SHDLC_ESCAPE_XOR;
+        if (byte != SHDLC_FRAME_DELIMITER && byte != SHDLC_ESCAPE_BYTE && byte != 0x11 &&
+            byte != 0x13) {
+            decoder->error = SHDLC_ERROR_FRAME;
+            shdlc_stream_reset(decoder);
+            return SHDLC_STREAM_ERROR;
+        }
+    } else if (byte == SHDLC_ESCAPE_BYTE) {
+        decoder->escape = 1;
+        return SHDLC_STREAM_INCOMPLETE;
+    }
+
+    if (shdlc_stream_store(decoder, byte) == SHDLC_STREAM_ERROR) {
+        shdlc_stream_reset(decoder);
+        return SHDLC_STREAM_ERROR;
+    }
+    return SHDLC_STREAM_INCOMPLETE;
+}
+
+Shdlc_StreamStatus SHDLC_StreamFeed(Shdlc_StreamDecoder * decoder, const uint8_t * data,
+                                    size_t size, size_t * consumed) {
+    Shdlc_StreamStatus status = (decoder == NULL) ? SHDLC_STREAM_ERROR : SHDLC_STREAM_INCOMPLETE;
+    size_t i = 0;
+
+    if (decoder != NULL && data != NULL) {
+        while (i < size) {
+            // Camino rápido: tramo de datos sin delimitadores ni escapes, copiado con índice y
+            // suma en registros en lugar de pasar byte a byte por la máquina de estados
+            if (decoder->state == SHDLC_STREAM_IN_FRAME && !decoder->escape &&
+                decoder->index >= SHDLC_MISO_HEADER_SIZE) {
+                uint8_t pos = decoder->index - SHDLC_MISO_HEADER_SIZE;
+                uint8_t lon = decoder->frame.lon;
+                uint8_t sum = decoder->sum;
+                uint8_t * dst = decoder->frame.myVector;
+                while (pos < lon && i < size) {
+                    uint8_t byte = data[i];
+                    if (byte == SHDLC_FRAME_DELIMITER || byte == SHDLC_ESCAPE_BYTE) {
+                        break;
+                    }
+                    dst[pos++] = byte;
+                    sum += byte;
+                    i++;
+                }
+                decoder->index = pos + SHDLC_MISO_HEADER_SIZE;
+                decoder->sum = sum;
+                if (i >= size) {
+                    break;
+                }
+            }
+
+            status = SHDLC_StreamFeedByte(decoder, data[i++]);
+            if (status != SHDLC_STREAM_INCOMPLETE) {
+                break;
+            }
+        }
+    }
+
+    if (consumed != NULL) {
+        *consumed = i;
+    }
+    return status;
+}
+
+Shdlc_Error SHDLC_ValidateFrame(const Shdlc_FrameMiso * frame, uint8_t adr, uint8_t cmd,
+                                int lon_esperada) {
+    if (frame == NULL || frame->lon > FRAME_DATA_VECTOR_SIZE_MISO) {
+        return SHDLC_ERROR_FRAME;
+    }
+
+    uint8_t sum = frame->adr + frame->cmd + frame->state + frame->lon;
+    for (uint8_t i = 0; i < frame->lon; i++) {
+        sum += frame->myVector[i];
+    }
+    if ((uint8_t)(sum + frame->chk) != 0xFF) {
+        return SHDLC_ERROR_CHECKSUM;
+    }
+    if (frame->adr != adr) {
+        return SHDLC_ERROR_ADDRESS;
+    }
+    if (frame->cmd != cmd) {
+        return SHDLC_ERROR_COMMAND;
+    }
+    if ((frame->state & SHDLC_STATE_ERROR_MASK) != 0) {
+        return SHDLC_ERROR_STATE;
+    }
+    if (lon_esperada >= 0 && frame->lon != lon_esperada) {
+        return SHDLC_ERROR_LENGTH;
+    }
+    return SHDLC_OK;
+}
+
+bool SHDLC_IsTransientError(Shdlc_Error error) {
+    return error != SHDLC_OK && error != SHDLC_ERROR_STATE && error != SHDLC_ERROR_NO_DATA;
+}
+
+const char * SHDLC_ErrorString(Shdlc_Error error) {
+    switch (error) {
+    case SHDLC_OK:
+        return "OK";
+    case SHDLC_ERROR_TIMEOUT:
+        return "timeout";
+    case SHDLC_ERROR_FRAME:
+        return "frame invalido";
+    case SHDLC_ERROR_LENGTH:
+        return "longitud invalida";
+    case SHDLC_ERROR_CHECKSUM:
+        return "checksum invalido";
+    case SHDLC_ERROR_ADDRESS:
+        return "direccion inesperada";
+    case SHDLC_ERROR_COMMAND:
+        return "comando inesperado";
+    case SHDLC_ERROR_STATE:
+        return "error de estado del sensor";
+    case SHDLC_ERROR_NO_DATA:
+        return "sin datos nuevos";
+    default:
+        return "desconocido";
+    }
 }
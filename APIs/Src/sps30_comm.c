@@ -4,15 +4,13 @@
 #include <stdio.h>
 #include <string.h>
 
-#define BUFFER_SIZE                    7
-#define BUFFER_SIZE_READ_DATA          60
+#define BUFFER_SIZE_START              14 // Frame sin datos (7 bytes), con stuffing en el peor caso
 #define BUFFER_SIZE_SERIAL_NUMBER      30
 #define BUFFER_SIZE_NUMBER             30
 #define BUFFER_SIZE_STOP_MEASUREMENT   8
 #define BUFFER_SIZE_SLEEP              8
 #define BUFFER_SIZE_WAKEUP             8
 #define BUFFER_SIZE_RESPONSE           50
-#define BUFFER_PRINT_CONCENTRATION     100
 
 #define MENSAJE_SIZE_RESPUESTA         "\nLongitud de respuesta:\n %d <--"
 #define MSN_SERIAL_NUMBER              "\nSerial Number: %s\n"
@@ -25,13 +23,7 @@
 #define MSG_RESPUESTA_CON_BYTESTUFFING "\n Respuesta con ByteStuffing:\n"
 #define MSG_LONGITUD_RESPUESTA         "\nLongitud de la respuesta:\n %d bytes\n"
 
-#define FORMATO_CONCENTRACION_PM1_0    "\nConcentracion de PM1.0:\n %f ug/m3\n"
-#define FORMATO_CONCENTRACION_PM2_5    "\nConcentracion de PM2.5:\n %f ug/m3\n"
-#define FORMATO_CONCENTRACION_PM4_0    "\nConcentracion de PM4.0:\n %f ug/m3\n"
-#define FORMATO_CONCENTRACION_PM10     "\nConcentracion de PM10:\n %f ug/m3\n"
-
 #define DELAY_WAKEUP                   50
-#define DELAY_START_MEASUREMENT        2
 #define DELAY_STOP_MEASUREMENT         0
 
 #define CLEAR_VAR                      0
@@ -59,18 +51,26 @@ bool sps30_send_receive(SPS30 * self, const uint8_t * command, uint16_t commandS
 }
 
 void sps30_start_measurement(SPS30 * self) {
-    uint8_t startCmd[] = SPS30_FRAME_START_MEASUREMENT; // Comando para iniciar la medición
-    uint8_t dataBuf[BUFFER_SIZE] = {0}; // Buffer para almacenar la respuesta del sensor
+    static const uint8_t startFloat[] = SPS30_FRAME_START_MEASUREMENT;
+    static const uint8_t startUint16[] = SPS30_FRAME_START_MEASUREMENT_UINT16;
+    // Comando para iniciar la medición en el formato de salida configurado
+    const uint8_t * startCmd = (self->formato == SPS30_FORMATO_UINT16) ? startUint16 : startFloat;
+    uint8_t dataBuf[BUFFER_SIZE_START] = {0}; // Respuesta del sensor, con stuffing
+    size_t len;
     // char respuestaStr[BUFFER_SIZE_RESPONSE]; // Buffer para el mensaje de longitud de respuesta
 
     // Envío del comando de inicio de medición
     // uart_print(MSG_INICIO_MEDICION);               // Notifica por UART el inicio de la operación
     // uart_vector_print(sizeof(startCmd), startCmd); // Muestra el comando enviado
-    self->send_command(self, startCmd, sizeof(startCmd)); // Envía el comando al sensor SPS30
-    HAL_Delay(DELAY_START_MEASUREMENT); // Espera para el procesamiento del comando
+    self->send_command(self, startCmd, sizeof(startFloat)); // Envía el comando al sensor SPS30
 
-    // Recepción y procesamiento de la respuesta
-    self->receive_async(self, dataBuf, sizeof(dataBuf));
+    // Sólo queda midiendo si el sensor aceptó el comando: frame íntegro, sin datos y state 0
+    Shdlc_Error err = self->receive_frame(self, dataBuf, sizeof(dataBuf), &len);
+    if (err == SHDLC_OK) {
+        err = SHDLC_ValidateFrameInPlace(dataBuf, &len, SPS30_ADDRESS, SPS30_CMD_START_MEASUREMENT,
+                                         0);
+    }
+    self->midiendo = (err == SHDLC_OK);
     // uart_print(MSG_RESPUESTA_INICIO_MEDICION); // Notifica la recepción de la respuesta
     // uart_vector_print(sizeof(dataBuf), dataBuf);   // Muestra la respuesta recibida
 
@@ -91,6 +91,7 @@ void sps30_stop_measurement(SPS30 * self) {
     // uart_vector_print(sizeof(stopCmd), stopCmd);
     self->send_command(self, stopCmd, sizeof(stopCmd));
     HAL_Delay(DELAY_STOP_MEASUREMENT);
+    self->midiendo = false;
 
     self->receive_async(self, dataBuf, sizeof(dataBuf));
     // uart_print(MSG_RESPUESTA);
@@ -117,59 +118,176 @@ void sps30_sleep(SPS30 * self) {
     // uart_print(respuestaStr);
 }
 
-void sps30_read_data(SPS30 * self) {
-    uint8_t readCmd[] = SPS30_FRAME_READ_MEASUREMENT;
-    uint8_t dataBuf[BUFFER_SIZE_READ_DATA] = {0};
-    uint8_t originalData[BUFFER_SIZE_READ_DATA] = {0};
-    ConcentracionesPM concentraciones;
-    //   char respuestaStr[BUFFER_SIZE_RESPONSE];
+/**
+ * @brief Recibe un frame MISO byte a byte, con stuffing, hasta el 0x7E de cierre.
+ *
+ * A diferencia de una recepción de tamaño fijo, retorna apenas llega el frame completo, sin
+ * esperar el timeout de la UART. Los bytes previos al 0x7E de inicio se descartan; el frame queda
+ * en @p buf para desarmarlo ahí mismo con sps30_validar_medicion().
+ *
+ * @param self Instancia del sensor.
+ * @param buf Frame recibido, de 0x7E a 0x7E.
+ * @param size Capacidad de @p buf (SPS30_RX_FRAME_MAX para una medición).
+ * @param len Bytes escritos en @p buf.
+ * @return SHDLC_OK, SHDLC_ERROR_TIMEOUT o SHDLC_ERROR_FRAME si el frame no entra en @p buf.
+ */
+Shdlc_Error sps30_receive_frame(SPS30 * self, uint8_t * buf, size_t size, size_t * len) {
+    uint32_t inicio = HAL_GetTick();
+    uint32_t transcurrido;
+    size_t n = 0;
+    uint8_t byte;
+
+    *len = 0;
+    while ((transcurrido = HAL_GetTick() - inicio) < SPS30_UART_TIMEOUT_MS) {
+        if (HAL_UART_Receive(self->huart, &byte, 1, SPS30_UART_TIMEOUT_MS - transcurrido) !=
+            HAL_OK) {
+            return SHDLC_ERROR_TIMEOUT;
+        }
+        // Fuera del frame o con 0x7E repetidos sólo interesa el último delimitador de inicio
+        if (n <= 1 && byte == SHDLC_FRAME_DELIMITER) {
+            buf[0] = byte;
+            n = 1;
+            continue;
+        }
+        if (n == 0) {
+            continue;
+        }
+        if (n >= size) {
+            return SHDLC_ERROR_FRAME;
+        }
+        buf[n++] = byte;
+        if (byte == SHDLC_FRAME_DELIMITER) {
+            *len = n;
+            return SHDLC_OK;
+        }
+    }
+    return SHDLC_ERROR_TIMEOUT;
+}
 
-    // uart_print(MSG_SOLICITAR);
-    // uart_vector_print(sizeof(readCmd), readCmd);
-    self->send_receive(self, readCmd, sizeof(readCmd), dataBuf, sizeof(dataBuf));
-    // uart_print(MSG_RESPUESTA);
-    // uart_vector_print(sizeof(dataBuf), dataBuf);
+uint8_t sps30_longitud_medicion(const SPS30 * self) {
+    return (self->formato == SPS30_FORMATO_UINT16) ? SPS30_MEASUREMENT_UINT16_LEN
+                                                   : SPS30_MEASUREMENT_FLOAT_LEN;
+}
 
-    SHDLC_revertByteStuffing(dataBuf, sizeof(dataBuf), originalData);
-    // uart_print(MSG_RESPUESTA_CON_BYTESTUFFING);
-    // uart_vector_print(sizeof(originalData), originalData);
+Shdlc_Error sps30_validar_medicion(const SPS30 * self, uint8_t * buf, size_t len) {
+    Shdlc_Error err = SHDLC_ValidateFrameInPlace(buf, &len, SPS30_ADDRESS,
+                                                 SPS30_CMD_READ_MEASUREMENT,
+                                                 sps30_longitud_medicion(self));
 
-    int longRespuesta = SHDLC_CalculateDataSize(originalData, sizeof(originalData));
-    // snprintf(respuestaStr, sizeof(respuestaStr), MSG_LONGITUD_RESPUESTA, longRespuesta);
-    // uart_print(respuestaStr);
+    // Frame íntegro con sólo cabecera y checksum: lon = 0
+    if (err == SHDLC_ERROR_LENGTH && len == SHDLC_MISO_HEADER_SIZE + 1) {
+        return SHDLC_ERROR_NO_DATA;
+    }
+    return err;
+}
 
-    Shdlc_FrameMiso Newframe = {};
-    SHDLC_LoadMyVector(&Newframe, originalData, longRespuesta);
-    // uart_print(MSG_DATOS_RESPUESTA);
-    // uart_vector_print(Newframe.lon, Newframe.myVector);
+void sps30_decodificar_medicion(const SPS30 * self, const uint8_t * buf, ConcentracionesPM * conc) {
+    const uint8_t * datos = &buf[SHDLC_MISO_HEADER_SIZE];
+    uint8_t lon = buf[SHDLC_MISO_HEADER_SIZE - 1];
 
-    SHDLC_llenarConcentraciones(&concentraciones, Newframe.myVector);
+    if (self->formato == SPS30_FORMATO_UINT16) {
+        ConcentracionesPMU16 enteros;
+        SHDLC_llenarMedicionU16(&enteros, datos, lon);
+        SHDLC_ConcentracionesDesdeU16(conc, &enteros);
+    } else {
+        SHDLC_llenarMedicion(conc, datos, lon);
+    }
+}
 
-    //  char buffer[BUFFER_PRINT_CONCENTRATION];
-    // sprintf(buffer, FORMATO_CONCENTRACION_PM1_0, concentraciones.pm1_0);
-    // uart_print(buffer);
-    // sprintf(buffer, FORMATO_CONCENTRACION_PM2_5, concentraciones.pm2_5);
-    // uart_print(buffer);
-    // sprintf(buffer, FORMATO_CONCENTRACION_PM4_0, concentraciones.pm4_0);
-    // uart_print(buffer);
-    // sprintf(buffer, FORMATO_CONCENTRACION_PM10, concentraciones.pm10);
-    // uart_print(buffer);
+/**
+ * @brief Pide READ_MEASUREMENT y valida la respuesta; ante errores transitorios repite sólo la
+ * lectura.
+ *
+ * @param self Instancia del sensor.
+ * @param buf Al menos SPS30_RX_FRAME_MAX bytes; queda con el contenido validado sin stuffing.
+ * @return SHDLC_OK o el último error obtenido tras SPS30_RELECTURAS relecturas.
+ */
+static Shdlc_Error sps30_read_measurement_frame(SPS30 * self, uint8_t * buf) {
+    uint8_t readCmd[] = SPS30_FRAME_READ_MEASUREMENT;
+    Shdlc_Error err = SHDLC_ERROR_TIMEOUT;
+
+    for (int intento = 0; intento <= SPS30_RELECTURAS; intento++) {
+        size_t len;
+        self->send_command(self, readCmd, sizeof(readCmd));
+        err = self->receive_frame(self, buf, SPS30_RX_FRAME_MAX, &len);
+        if (err == SHDLC_OK) {
+            err = sps30_validar_medicion(self, buf, len);
+        }
+        if (err == SHDLC_OK || !SHDLC_IsTransientError(err)) {
+            break;
+        }
+    }
+    return err;
 }
 
-ConcentracionesPM sps30_get_concentrations(SPS30 * self) {
+/**
+ * @brief Solicita y valida una medición en el formato configurado.
+ *
+ * @param self Instancia del sensor.
+ * @param conc Concentraciones decodificadas (sin cambios si hubo error).
+ * @return SHDLC_OK o el último error obtenido tras SPS30_RELECTURAS relecturas.
+ */
+Shdlc_Error sps30_read_concentrations(SPS30 * self, ConcentracionesPM * conc) {
+    uint8_t buf[SPS30_RX_FRAME_MAX];
+    Shdlc_Error err = sps30_read_measurement_frame(self, buf);
+
+    if (err == SHDLC_OK) {
+        sps30_decodificar_medicion(self, buf, conc);
+    }
+    return err;
+}
+
+/**
+ * @brief Solicita una medición y la entrega como enteros, sin pasar por float.
+ *
+ * @param self Instancia del sensor, configurada con SPS30_FORMATO_UINT16.
+ * @param conc Registro entero (sin cambios si hubo error).
+ * @return SHDLC_OK, el error de la lectura o SHDLC_ERROR_LENGTH si el sensor está en formato
+ *         float (no se envía ningún comando).
+ */
+Shdlc_Error sps30_read_concentrations_u16(SPS30 * self, ConcentracionesPMU16 * conc) {
+    uint8_t buf[SPS30_RX_FRAME_MAX];
+
+    if (self->formato != SPS30_FORMATO_UINT16) {
+        return SHDLC_ERROR_LENGTH;
+    }
+    Shdlc_Error err = sps30_read_measurement_frame(self, buf);
+    if (err == SHDLC_OK) {
+        SHDLC_llenarMedicionU16(conc, &buf[SHDLC_MISO_HEADER_SIZE], SPS30_MEASUREMENT_UINT16_LEN);
+    }
+    return err;
+}
+
+/**
+ * @brief Lee la última medición de un sensor que ya está midiendo, con un único READ.
+ *
+ * Pensada para medición continua a SPS30_PERIODO_MEDICION_MS: no hay START ni espera de
+ * estabilización, y una respuesta sin datos indica que el dato del período todavía no está listo.
+ *
+ * @param self Instancia del sensor.
+ * @param conc Concentraciones decodificadas (sin cambios si no hubo dato nuevo o hubo error).
+ * @return SHDLC_OK, SHDLC_ERROR_NO_DATA o el error de recepción/validación.
+ */
+Shdlc_Error sps30_poll_concentrations(SPS30 * self, ConcentracionesPM * conc) {
     uint8_t readCmd[] = SPS30_FRAME_READ_MEASUREMENT;
-    uint8_t dataBuf[BUFFER_SIZE_READ_DATA] = {0};
-    uint8_t originalData[BUFFER_SIZE_READ_DATA] = {0};
-    ConcentracionesPM concentraciones;
+    uint8_t buf[SPS30_RX_FRAME_MAX];
+    size_t len;
 
-    self->send_receive(self, readCmd, sizeof(readCmd), dataBuf, sizeof(dataBuf));
-    SHDLC_revertByteStuffing(dataBuf, sizeof(dataBuf), originalData);
+    self->send_command(self, readCmd, sizeof(readCmd));
+    Shdlc_Error err = self->receive_frame(self, buf, sizeof(buf), &len);
+    if (err == SHDLC_OK) {
+        err = sps30_validar_medicion(self, buf, len);
+    }
+    if (err == SHDLC_OK) {
+        sps30_decodificar_medicion(self, buf, conc);
+    }
+    return err;
+}
 
-    Shdlc_FrameMiso Newframe = {};
-    SHDLC_LoadMyVector(&Newframe, originalData,
-                       SHDLC_CalculateDataSize(originalData, sizeof(originalData)));
-    SHDLC_llenarConcentraciones(&concentraciones, Newframe.myVector);
+ConcentracionesPM sps30_get_concentrations(SPS30 * self) {
+    ConcentracionesPM concentraciones = {0};
 
+    self->read_concentrations(self, &concentraciones);
     return concentraciones;
 }
 
@@ -223,16 +341,21 @@ void sps30_wake_up(SPS30 * self) {
     // uart_print(respuestaStr);
 }
 
-void SPS30_init(SPS30 * self, UART_HandleTypeDef * huart) {
+void SPS30_init(SPS30 * self, UART_HandleTypeDef * huart, uint8_t formato) {
     self->huart = huart;
+    self->formato = formato;
+    self->midiendo = false;
     self->send_command = sps30_send_command;
     self->receive_async = sps30_receive_async;
+    self->receive_frame = sps30_receive_frame;
     self->send_receive = sps30_send_receive;
     self->start_measurement = sps30_start_measurement;
     self->stop_measurement = sps30_stop_measurement;
     self->sleep = sps30_sleep;
-    self->read_data = sps30_read_data;
     self->serial_number = sps30_serial_number;
     self->wake_up = sps30_wake_up;
     self->get_concentrations = sps30_get_concentrations;
+    self->read_concentrations = sps30_read_concentrations;
+    self->read_concentrations_u16 = sps30_read_concentrations_u16;
+    self->poll_concentrations = sps30_poll_concentrations;
 }
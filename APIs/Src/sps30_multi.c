@@ -12,11 +12,18 @@
  */
 
 #include "sps30_multi.h"
+#include <string.h>
 
 #define ID_SENSOR_UNO  1
 #define ID_SENSOR_DOS  2
 #define ID_SENSOR_TRES 3
 
+#define RX_RING_MASK   (SPS30_RX_RING_SIZE - 1)
+
+#if (SPS30_RX_RING_SIZE & RX_RING_MASK) != 0
+#error "SPS30_RX_RING_SIZE debe ser potencia de 2"
+#endif
+
 /* === UARTs disponibles según usart.c === */
 extern UART_HandleTypeDef huart5;
 extern UART_HandleTypeDef huart7;
@@ -27,7 +34,166 @@ extern UART_HandleTypeDef huart1;
 SensorSPS30 sensores_sps30[NUM_SENSORES_SPS30];
 int sensores_disponibles = 0;
 
-/* === Funciones ============================================================================== */
+static bool modo_continuo = SPS30_MODO_CONTINUO;
+
+/* === Funciones privadas ===================================================================== */
+
+static SensorSPS30 * sensor_desde_uart(UART_HandleTypeDef * huart) {
+    for (int i = 0; i < sensores_disponibles; i++) {
+        if (sensores_sps30[i].uart == huart) {
+            return &sensores_sps30[i];
+        }
+    }
+    return NULL;
+}
+
+static SensorSPS30 * sensor_desde_sps30(SPS30 * self) {
+    for (int i = 0; i < sensores_disponibles; i++) {
+        if (&sensores_sps30[i].sensor == self) {
+            return &sensores_sps30[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Copia bytes al ring buffer (productor: ISR). Los que no caben se cuentan como
+ * descartados.
+ */
+static uint16_t rx_ring_push(SPS30_RingBuffer * r, const uint8_t * datos, uint16_t n) {
+    uint16_t head = r->head;
+    uint16_t i;
+
+    for (i = 0; i < n; i++) {
+        uint16_t siguiente = (head + 1) & RX_RING_MASK;
+        if (siguiente == r->tail) {
+            r->descartados += n - i;
+            break;
+        }
+        r->datos[head] = datos[i];
+        head = siguiente;
+    }
+    r->head = head;
+    return i;
+}
+
+/**
+ * @brief Descarta los bytes pendientes (respuestas atrasadas o ruido) antes de un comando nuevo.
+ */
+static void rx_descartar(SensorSPS30 * s) {
+    s->rx.tail = s->rx.head;
+}
+
+/**
+ * @brief Lee del ring buffer los bytes crudos de un frame SHDLC, hasta el 0x7E de cierre.
+ *
+ * @return Cantidad de bytes copiados; el último es 0x7E si el frame terminó antes del timeout.
+ */
+static uint16_t rx_leer_frame_crudo(SensorSPS30 * s, uint8_t * buf, uint16_t size) {
+    uint32_t inicio = HAL_GetTick();
+    uint16_t n = 0;
+    bool en_frame = false;
+
+    while (n < size && (HAL_GetTick() - inicio) < SPS30_UART_TIMEOUT_MS) {
+        if (sps30_multi_rx_leer(s, &buf[n], 1) == 0) {
+            continue;
+        }
+        if (buf[n++] == SHDLC_FRAME_DELIMITER) {
+            if (en_frame && n >= 2 && buf[n - 2] != SHDLC_FRAME_DELIMITER) {
+                break;
+            }
+            en_frame = true;
+        }
+    }
+    return n;
+}
+
+/* --- Métodos del objeto SPS30 cuando la recepción es por DMA ---------------------------------- */
+
+static void sps30_dma_send_command(SPS30 * self, const uint8_t * command, uint16_t commandSize) {
+    SensorSPS30 * s = sensor_desde_sps30(self);
+    if (s != NULL) {
+        rx_descartar(s);
+    }
+    HAL_UART_Transmit(self->huart, command, commandSize, SPS30_UART_TIMEOUT_MS);
+}
+
+static void sps30_dma_receive_async(SPS30 * self, uint8_t * dataBuffer, uint16_t bufferSize) {
+    SensorSPS30 * s = sensor_desde_sps30(self);
+    if (s != NULL) {
+        rx_leer_frame_crudo(s, dataBuffer, bufferSize);
+    }
+}
+
+static bool sps30_dma_send_receive(SPS30 * self, const uint8_t * command, uint16_t commandSize,
+                                   uint8_t * dataBuffer, uint16_t bufferSize) {
+    SensorSPS30 * s = sensor_desde_sps30(self);
+    if (s == NULL) {
+        return false;
+    }
+
+    rx_descartar(s);
+    if (HAL_UART_Transmit(self->huart, command, commandSize, SPS30_UART_TIMEOUT_MS) != HAL_OK) {
+        return false;
+    }
+
+    uint16_t n = rx_leer_frame_crudo(s, dataBuffer, bufferSize);
+    return n > 0 && dataBuffer[n - 1] == SHDLC_FRAME_DELIMITER;
+}
+
+static Shdlc_Error sps30_dma_receive_frame(SPS30 * self, uint8_t * buf, size_t size,
+                                           size_t * len) {
+    SensorSPS30 * s = sensor_desde_sps30(self);
+
+    *len = 0;
+    if (s == NULL) {
+        return SHDLC_ERROR_TIMEOUT;
+    }
+
+    uint16_t n = rx_leer_frame_crudo(s, buf, (uint16_t)size);
+    if (n >= 2 && buf[n - 1] == SHDLC_FRAME_DELIMITER && buf[n - 2] != SHDLC_FRAME_DELIMITER) {
+        *len = n;
+        return SHDLC_OK;
+    }
+    return (n == size) ? SHDLC_ERROR_FRAME : SHDLC_ERROR_TIMEOUT;
+}
+
+/* === Eventos de UART (los reparte uart_callbacks.c) ========================================== */
+
+void sps30_multi_rx_evento(UART_HandleTypeDef * huart, uint16_t Size) {
+    SensorSPS30 * s = sensor_desde_uart(huart);
+    uint16_t nuevos = 0;
+
+    if (s == NULL || Size > SPS30_RX_DMA_BUFFER_SIZE) {
+        return;
+    }
+
+    if (Size > s->dma_pos) {
+        nuevos += rx_ring_push(&s->rx, &s->dma_buf[s->dma_pos], Size - s->dma_pos);
+    } else if (Size < s->dma_pos) {
+        // El DMA dio la vuelta al buffer circular
+        nuevos += rx_ring_push(&s->rx, &s->dma_buf[s->dma_pos],
+                               SPS30_RX_DMA_BUFFER_SIZE - s->dma_pos);
+        nuevos += rx_ring_push(&s->rx, s->dma_buf, Size);
+    }
+    s->dma_pos = (Size == SPS30_RX_DMA_BUFFER_SIZE) ? 0 : Size;
+
+    if (s->on_rx != NULL && nuevos > 0) {
+        s->on_rx(s, nuevos);
+    }
+}
+
+void sps30_multi_error(UART_HandleTypeDef * huart) {
+    SensorSPS30 * s = sensor_desde_uart(huart);
+
+    if (s != NULL && s->dma_activo) {
+        s->dma_pos = 0;
+        s->dma_activo = (HAL_UARTEx_ReceiveToIdle_DMA(huart, s->dma_buf,
+                                                      SPS30_RX_DMA_BUFFER_SIZE) == HAL_OK);
+    }
+}
+
+/* === Funciones públicas ===================================================================== */
 
 void inicializar_sensores_sps30(void) {
     sensores_disponibles = 0;
@@ -35,21 +201,208 @@ void inicializar_sensores_sps30(void) {
 #if 1 // UART5 está habilitado
     sensores_sps30[sensores_disponibles].id = ID_SENSOR_UNO;
     sensores_sps30[sensores_disponibles].uart = &huart5;
-    SPS30_init(&sensores_sps30[sensores_disponibles].sensor, &huart5);
+    SPS30_init(&sensores_sps30[sensores_disponibles].sensor, &huart5, SPS30_FORMATO_SALIDA);
     sensores_disponibles++;
 #endif
 
 #if 1 // Habilitar cuando uses UART7
     sensores_sps30[sensores_disponibles].id = ID_SENSOR_DOS;
     sensores_sps30[sensores_disponibles].uart = &huart7;
-    SPS30_init(&sensores_sps30[sensores_disponibles].sensor, &huart7);
+    SPS30_init(&sensores_sps30[sensores_disponibles].sensor, &huart7, SPS30_FORMATO_SALIDA);
     sensores_disponibles++;
 #endif
 
 #if 1 // Habilitar cuando uses UART8
     sensores_sps30[sensores_disponibles].id = ID_SENSOR_TRES;
     sensores_sps30[sensores_disponibles].uart = &huart1;
-    SPS30_init(&sensores_sps30[sensores_disponibles].sensor, &huart1);
+    SPS30_init(&sensores_sps30[sensores_disponibles].sensor, &huart1, SPS30_FORMATO_SALIDA);
     sensores_disponibles++;
 #endif
+
+#if SPS30_RX_DMA_HABILITADO
+    for (int i = 0; i < sensores_disponibles; i++) {
+        sps30_multi_rx_dma_iniciar(&sensores_sps30[i]);
+    }
+#endif
+}
+
+bool sps30_multi_rx_dma_iniciar(SensorSPS30 * s) {
+    if (s == NULL || s->uart == NULL) {
+        return false;
+    }
+
+    s->dma_pos = 0;
+    s->rx.head = 0;
+    s->rx.tail = 0;
+    s->rx.descartados = 0;
+    s->dma_activo =
+        (HAL_UARTEx_ReceiveToIdle_DMA(s->uart, s->dma_buf, SPS30_RX_DMA_BUFFER_SIZE) == HAL_OK);
+
+    if (s->dma_activo) {
+        s->sensor.send_command = sps30_dma_send_command;
+        s->sensor.receive_async = sps30_dma_receive_async;
+        s->sensor.send_receive = sps30_dma_send_receive;
+        s->sensor.receive_frame = sps30_dma_receive_frame;
+    }
+    return s->dma_activo;
+}
+
+void sps30_multi_set_callback(SensorSPS30 * s, SPS30_RxCallback cb) {
+    if (s != NULL) {
+        s->on_rx = cb;
+    }
+}
+
+uint16_t sps30_multi_rx_leer(SensorSPS30 * s, uint8_t * destino, uint16_t max) {
+    uint16_t tail = s->rx.tail;
+    uint16_t head = s->rx.head;
+    uint16_t n = 0;
+
+    while (n < max && tail != head) {
+        destino[n++] = s->rx.datos[tail];
+        tail = (tail + 1) & RX_RING_MASK;
+    }
+    s->rx.tail = tail;
+    return n;
+}
+
+int sps30_multi_leer_todos(ConcentracionesPM conc[], Shdlc_Error errores[]) {
+    return sps30_multi_leer_seleccion(NULL, conc, errores);
+}
+
+int sps30_multi_leer_seleccion(const bool solicitar[], ConcentracionesPM conc[],
+                               Shdlc_Error errores[]) {
+    uint8_t readCmd[] = SPS30_FRAME_READ_MEASUREMENT;
+    uint8_t buf[SPS30_RX_FRAME_MAX];
+    bool pendiente[NUM_SENSORES_SPS30];
+    int pendientes = 0;
+    int correctos = 0;
+
+    for (int i = 0; i < sensores_disponibles; i++) {
+        pendiente[i] = (solicitar == NULL || solicitar[i]);
+        if (pendiente[i]) {
+            memset(&conc[i], 0, sizeof(conc[i]));
+            errores[i] = SHDLC_ERROR_TIMEOUT;
+            pendientes++;
+        }
+    }
+
+    // Cada vuelta es una lectura breve; sólo se repite para sensores con error transitorio
+    for (int vuelta = 0; vuelta <= SPS30_RELECTURAS && pendientes > 0; vuelta++) {
+        // Primero se envía el comando a los sensores con DMA: sus respuestas llegan en paralelo
+        for (int i = 0; i < sensores_disponibles; i++) {
+            SPS30 * sensor = &sensores_sps30[i].sensor;
+            if (pendiente[i] && sensores_sps30[i].dma_activo) {
+                sensor->send_command(sensor, readCmd, sizeof(readCmd));
+            }
+        }
+
+        for (int i = 0; i < sensores_disponibles; i++) {
+            SPS30 * sensor = &sensores_sps30[i].sensor;
+            if (!pendiente[i]) {
+                continue;
+            }
+            if (!sensores_sps30[i].dma_activo) {
+                // Sin DMA la respuesta sólo puede recibirse inmediatamente después del envío
+                sensor->send_command(sensor, readCmd, sizeof(readCmd));
+            }
+
+            size_t len;
+            Shdlc_Error err = sensor->receive_frame(sensor, buf, sizeof(buf), &len);
+            if (err == SHDLC_OK) {
+                err = sps30_validar_medicion(sensor, buf, len);
+            }
+            errores[i] = err;
+
+            if (err == SHDLC_OK) {
+                sps30_decodificar_medicion(sensor, buf, &conc[i]);
+                correctos++;
+            }
+            if (err == SHDLC_OK || !SHDLC_IsTransientError(err)) {
+                pendiente[i] = false;
+                pendientes--;
+            }
+        }
+    }
+
+    return correctos;
+}
+
+int sps30_multi_adquirir(SPS30_Adquisicion resultados[], uint8_t max_intentos,
+                         SPS30_Validador validar) {
+    bool pendiente[NUM_SENSORES_SPS30];
+    ConcentracionesPM conc[NUM_SENSORES_SPS30];
+    Shdlc_Error errores[NUM_SENSORES_SPS30];
+    int pendientes = sensores_disponibles;
+
+    for (int i = 0; i < sensores_disponibles; i++) {
+        memset(&resultados[i], 0, sizeof(resultados[i]));
+        resultados[i].error = SHDLC_ERROR_TIMEOUT;
+        pendiente[i] = true;
+    }
+
+    for (uint8_t ronda = 0; ronda < max_intentos && pendientes > 0; ronda++) {
+        bool iniciados = false;
+
+        for (int i = 0; i < sensores_disponibles; i++) {
+            if (pendiente[i]) {
+                SPS30 * sensor = &sensores_sps30[i].sensor;
+                // En modo continuo sólo se inicia el sensor que no está midiendo
+                if (!modo_continuo || !sensor->midiendo) {
+                    sensor->start_measurement(sensor);
+                    iniciados = true;
+                }
+                resultados[i].intentos++;
+            }
+        }
+
+        if (iniciados) {
+            HAL_Delay(SPS30_WARMUP_MS); // Una sola espera para todos los sensores iniciados
+        } else if (ronda > 0) {
+            HAL_Delay(SPS30_PERIODO_MEDICION_MS); // Sensores ya midiendo: próximo dato
+        }
+
+        sps30_multi_leer_seleccion(pendiente, conc, errores);
+
+        for (int i = 0; i < sensores_disponibles; i++) {
+            if (!pendiente[i]) {
+                continue;
+            }
+            SPS30 * sensor = &sensores_sps30[i].sensor;
+            // En modo continuo el sensor sigue midiendo; sólo se reinicia tras un error de
+            // comunicación o de estado, no por falta de dato nuevo o rechazo del validador
+            if (!modo_continuo ||
+                (errores[i] != SHDLC_OK && errores[i] != SHDLC_ERROR_NO_DATA)) {
+                sensor->stop_measurement(sensor);
+            }
+
+            resultados[i].error = errores[i];
+            if (errores[i] == SHDLC_OK && (validar == NULL || validar(&conc[i]))) {
+                resultados[i].pm = conc[i];
+                resultados[i].valido = true;
+                pendiente[i] = false;
+                pendientes--;
+            }
+        }
+    }
+
+    return sensores_disponibles - pendientes;
+}
+
+void sps30_multi_set_continuo(bool continuo) {
+    modo_continuo = continuo;
+    if (continuo) {
+        return;
+    }
+    // El modo por ciclo espera sensores detenidos entre lecturas
+    for (int i = 0; i < sensores_disponibles; i++) {
+        SPS30 * sensor = &sensores_sps30[i].sensor;
+        if (sensor->midiendo) {
+            sensor->stop_measurement(sensor);
+        }
+    }
+}
+
+bool sps30_multi_es_continuo(void) {
+    return modo_continuo;
 }
@@ -30,6 +30,7 @@
 #include "time_rtc.h"
 #include "rtc_buildtime.h"
 #include "rtc_ds3231_for_stm32_hal.h"
+#include "base_tiempo.h"
 #include "rtc.h" // HAL RTC interno
 #include "rtc_buildtime.h"
 #include "rtc_config.h"
@@ -72,11 +73,8 @@ static bool rtc_external_available(void) {
 bool rtc_esta_activo(void) {
     if (active_rtc == RTC_SOURCE_EXTERNAL) {
         ds3231_time_t dt;
-        if (!ds3231_get_datetime(&dt)) {
-            return false;
-        }
-        // Validación simple de rango
-        return (dt.hour < 24 && dt.min < 60 && dt.sec < 60);
+        // La hora cacheada valida el rango al leer el DS3231; rtc_ok indica si la última respondió
+        return base_tiempo_ahora(&dt) && base_tiempo_rtc_ok();
     } else if (active_rtc == RTC_SOURCE_INTERNAL) {
         RTC_TimeTypeDef sTime;
         if (HAL_RTC_GetTime(&hrtc, &sTime, RTC_FORMAT_BIN) != HAL_OK) {
@@ -97,6 +95,11 @@ bool rtc_auto_init(void) {
     if (rtc_external_available()) {
         DS3231_Init(&RTC_I2C_HANDLER);
         active_rtc = RTC_SOURCE_EXTERNAL;
+#if BASE_TIEMPO_USAR_SQW
+        if (!DS3231_EnableSQW1Hz()) {
+            uart_print("[WARN] No se pudo configurar SQW a 1 Hz en el DS3231\r\n");
+        }
+#endif
 #if RTC_USE_BUILD_TIME_IF_NO_SOURCE
         DS3231_DateTime now;
         DS3231_GetDateTime(&now);
@@ -201,7 +204,7 @@ void time_rtc_ActualizarEstadoPorTiempo(void) {
     char debug_buf[64];
 
     ds3231_time_t dt;
-    if (!ds3231_get_datetime(&dt)) {
+    if (!base_tiempo_ahora(&dt)) {
         uart_print("[ERROR] No se pudo leer el RTC para actualizar el estado.\r\n");
         return;
     }
@@ -229,8 +232,23 @@ void time_rtc_ActualizarEstadoPorTiempo(void);
 
 /* === Wrappers de compatibilidad =================================================== */
 
+/**
+ * @brief Fecha y hora formateadas desde la hora cacheada; con el RTC interno, o si el DS3231
+ *        nunca respondió, se lee directamente como antes.
+ */
+static void formatear_fecha_hora(char * buffer, size_t len) {
+    ds3231_time_t dt;
+
+    if (active_rtc == RTC_SOURCE_EXTERNAL && base_tiempo_ahora(&dt)) {
+        snprintf(buffer, len, RTC_GET_FORMAT_DATETIME, dt.year, dt.month, dt.day, dt.hour, dt.min,
+                 dt.sec);
+    } else {
+        rtc_get_time(buffer, len);
+    }
+}
+
 void obtener_fecha_hora(char * fecha_hora_str) {
-    rtc_get_time(fecha_hora_str, 32);
+    formatear_fecha_hora(fecha_hora_str, 32);
 }
 
 void time_rtc_Init(void) {
@@ -238,7 +256,7 @@ void time_rtc_Init(void) {
 }
 
 void time_rtc_GetFormattedDateTime(char * buffer, size_t len) {
-    rtc_get_time(buffer, len);
+    formatear_fecha_hora(buffer, len);
 }
 
 /**
@@ -248,7 +266,7 @@ void time_rtc_GetFormattedDateTime(char * buffer, size_t len) {
 bool time_rtc_hay_cambio_bloque(void) {
     ds3231_time_t dt;
 
-    if (!ds3231_get_datetime(&dt)) {
+    if (!base_tiempo_ahora(&dt)) {
         uart_print("[WARN] RTC no respondió en time_rtc_hay_cambio_bloque()\r\n");
         return false;
     }
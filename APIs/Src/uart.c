@@ -30,6 +30,7 @@
  * ===================================================== */
 #include "uart.h"
 #include "stm32f4xx_hal.h"
+#include "uart_log.h"
 #include "usart.h"
 #include <stdarg.h>
 #include <stdio.h>  // Para usar snprintf
@@ -73,18 +74,47 @@ UART_HandleTypeDef * uart_debug = NULL;
 
 /**
  * @brief Envía un mensaje a través de UART3.
+ *
+ * Con UART_LOG_HABILITADO el mensaje sólo se copia a la cola del log y lo transmite el DMA en
+ * segundo plano; sin cola activa se transmite bloqueando.
+ *
  * @param message Mensaje a enviar.
  */
 void uart_print(const char * format, ...) {
     char buffer[256];
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
     va_end(args);
 
+    if (len <= 0) {
+        return;
+    }
+    if (len >= (int)sizeof(buffer)) {
+        len = sizeof(buffer) - 1; // Mensaje truncado por vsnprintf
+    }
+
+    uart_write_bytes((const uint8_t *)buffer, (uint16_t)len);
+}
+
+/**
+ * @brief Envía bytes sin formato por la UART de depuración.
+ *
+ * Mismo camino que uart_print(): a la cola del log si está activa, si no transmisión bloqueante.
+ *
+ * @param datos Bytes a enviar.
+ * @param n Cantidad de bytes.
+ */
+void uart_write_bytes(const uint8_t * datos, uint16_t n) {
+#if UART_LOG_HABILITADO
+    if (uart_log_activo()) {
+        uart_log_escribir(datos, n);
+        return;
+    }
+#endif
+
     if (uart_debug != NULL) {
-        if (HAL_UART_Transmit(uart_debug, (uint8_t *)buffer, strlen(buffer), UART_TX_TIMEOUT_MS) !=
-            HAL_OK) {
+        if (HAL_UART_Transmit(uart_debug, (uint8_t *)datos, n, UART_TX_TIMEOUT_MS) != HAL_OK) {
             return; // Transmission failed or timed out
         }
     }
@@ -0,0 +1,38 @@
+/**
+ * @file uart_callbacks.c
+ * @brief Callbacks de UART de la HAL, repartidos a los módulos que usan cada puerto.
+ *
+ * La HAL tiene un único HAL_UART_ErrorCallback() y un único HAL_UART_TxCpltCallback() para todas
+ * las UART. Se definen sólo acá y cada módulo recibe el evento e ignora los puertos que no son
+ * suyos: uart_log la UART de depuración, sps30_multi las de los sensores.
+ *
+ * @author lgomez
+ * @date 17-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "sps30_multi.h"
+#include "uart_log.h"
+
+/**
+ * @brief Fin de una transmisión DMA.
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef * huart) {
+    uart_log_tx_completo(huart);
+}
+
+/**
+ * @brief Error de UART (overrun, ruido, framing o del DMA); la HAL ya abortó la transferencia.
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef * huart) {
+    uart_log_error(huart);
+    sps30_multi_error(huart);
+}
+
+/**
+ * @brief Evento de recepción DMA (línea ociosa, mitad o fin del buffer circular).
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef * huart, uint16_t Size) {
+    sps30_multi_rx_evento(huart, Size);
+}
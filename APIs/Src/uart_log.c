@@ -0,0 +1,284 @@
+/**
+ * @file uart_log.c
+ * @brief Cola del log de depuración, vaciada por DMA en segundo plano.
+ *
+ * Los mensajes se copian a un ring buffer. Cada transferencia DMA toma hasta
+ * UART_LOG_TRAMO_DMA bytes de la cola y los copia a un buffer propio, de modo que el ring sólo
+ * contiene bytes que todavía no salieron y la política de descarte nunca toca lo que el DMA está
+ * leyendo. El callback de fin de transmisión encadena la transferencia siguiente.
+ *
+ * uart_log_flush() corre con las interrupciones apagadas (también desde los fault handlers), donde
+ * HAL_GetTick() no avanza: por eso detiene el DMA y transmite tocando los registros, con esperas
+ * acotadas por cantidad de vueltas en lugar de los timeouts de la HAL.
+ *
+ * @author lgomez
+ * @date 16-10-2026
+ * @copyright (C) 2023 Luis Gómez CESE FiUBA
+ * @license GNU GPL v3.0
+ */
+
+#include "uart_log.h"
+#include <string.h>
+
+#define LOG_MASK (UART_LOG_BUFFER_SIZE - 1)
+
+/* Los índices los modifican el lazo principal y la ISR de fin de DMA */
+#if defined(__arm__) && !defined(UNIT_TESTING)
+#define UART_LOG_BLOQUEAR()                                                                        \
+    uint32_t primask_previo = __get_PRIMASK();                                                     \
+    __disable_irq()
+#define UART_LOG_DESBLOQUEAR() __set_PRIMASK(primask_previo)
+#else
+#define UART_LOG_BLOQUEAR()                                                                        \
+    do {                                                                                           \
+    } while (0)
+#define UART_LOG_DESBLOQUEAR()                                                                     \
+    do {                                                                                           \
+    } while (0)
+#endif
+
+/* === Variables privadas ===================================================================== */
+
+static UART_HandleTypeDef * uart_log = NULL;
+static UartLog_Politica politica_actual = UART_LOG_DESCARTAR_NUEVOS;
+
+static uint8_t cola[UART_LOG_BUFFER_SIZE];
+static volatile uint32_t head; /**< Próximo byte a escribir (contador libre, se enmascara) */
+static volatile uint32_t tail; /**< Próximo byte a pasar al DMA */
+
+static uint8_t tramo[UART_LOG_TRAMO_DMA]; /**< Origen de la transferencia DMA en curso */
+static volatile uint16_t en_vuelo;        /**< Bytes de la transferencia en curso (0 = libre) */
+
+static volatile uint32_t descartados;
+
+/* === Funciones privadas ===================================================================== */
+
+/**
+ * @brief Copia de la cola al destino los n bytes desde tail, dando la vuelta al ring si hace falta.
+ */
+static void cola_extraer(uint8_t * destino, uint32_t n) {
+    uint32_t inicio = tail & LOG_MASK;
+    uint32_t primero = UART_LOG_BUFFER_SIZE - inicio;
+
+    if (primero > n) {
+        primero = n;
+    }
+    memcpy(destino, &cola[inicio], primero);
+    memcpy(&destino[primero], cola, n - primero);
+    tail += n;
+}
+
+static void cola_insertar(const uint8_t * datos, uint32_t n) {
+    uint32_t inicio = head & LOG_MASK;
+    uint32_t primero = UART_LOG_BUFFER_SIZE - inicio;
+
+    if (primero > n) {
+        primero = n;
+    }
+    memcpy(&cola[inicio], datos, primero);
+    memcpy(cola, &datos[primero], n - primero);
+    head += n;
+}
+
+/**
+ * @brief Si el DMA está libre, le pasa el próximo tramo de la cola. Llamar con la cola bloqueada
+ * o desde la ISR.
+ */
+static void uart_log_iniciar_dma(void) {
+    uint32_t pendientes = head - tail;
+
+    if (uart_log == NULL || en_vuelo != 0 || pendientes == 0) {
+        return;
+    }
+    if (pendientes > UART_LOG_TRAMO_DMA) {
+        pendientes = UART_LOG_TRAMO_DMA;
+    }
+    cola_extraer(tramo, pendientes);
+    en_vuelo = (uint16_t)pendientes;
+
+    if (HAL_UART_Transmit_DMA(uart_log, tramo, en_vuelo) != HAL_OK) {
+        // Se devuelve el tramo a la cola; se reintenta en la próxima escritura
+        tail -= en_vuelo;
+        en_vuelo = 0;
+    }
+}
+
+/**
+ * @brief Libera espacio descartando las líneas más viejas: avanza hasta cubrir @p necesarios y
+ * luego hasta el próximo fin de línea, para que la salida siga en el comienzo de una línea.
+ */
+static void uart_log_descartar_antiguos(uint32_t necesarios) {
+    uint32_t inicio = tail;
+    uint32_t libres = UART_LOG_BUFFER_SIZE - (head - tail);
+
+    tail += necesarios - libres;
+    while (tail != head && cola[(tail - 1) & LOG_MASK] != '\n') {
+        tail++;
+    }
+    descartados += tail - inicio;
+}
+
+/**
+ * @brief Espera, a lo sumo UART_LOG_FLUSH_ESPERA_MAX vueltas, a que la UART active @p flag.
+ */
+static bool uart_log_esperar_flag(uint32_t flag) {
+    for (uint32_t i = 0; i < UART_LOG_FLUSH_ESPERA_MAX; i++) {
+        if (__HAL_UART_GET_FLAG(uart_log, flag)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Detiene el DMA de transmisión sin la HAL y deja UART y stream libres, como
+ * HAL_UART_AbortTransmit() pero sin sus timeouts.
+ *
+ * @return Bytes del tramo en vuelo que el DMA todavía no había tomado, o en_vuelo si el stream no
+ * llegó a detenerse (no se sabe cuánto salió).
+ */
+static uint16_t uart_log_detener_dma(void) {
+    DMA_HandleTypeDef * hdma = uart_log->hdmatx;
+    uint32_t i = 0;
+
+    __HAL_DMA_DISABLE_IT(hdma, DMA_IT_TC | DMA_IT_HT | DMA_IT_TE | DMA_IT_DME);
+    CLEAR_BIT(uart_log->Instance->CR3, USART_CR3_DMAT);
+    __HAL_DMA_DISABLE(hdma);
+    while ((hdma->Instance->CR & DMA_SxCR_EN) != 0 && i < UART_LOG_FLUSH_ESPERA_MAX) {
+        i++;
+    }
+    uint16_t restantes = (hdma->Instance->CR & DMA_SxCR_EN) != 0
+                             ? en_vuelo
+                             : (uint16_t)__HAL_DMA_GET_COUNTER(hdma);
+
+    CLEAR_BIT(uart_log->Instance->CR1, USART_CR1_TXEIE | USART_CR1_TCIE);
+    hdma->State = HAL_DMA_STATE_READY;
+    __HAL_UNLOCK(hdma);
+    uart_log->gState = HAL_UART_STATE_READY;
+    return (restantes > en_vuelo) ? en_vuelo : restantes;
+}
+
+/**
+ * @brief Transmite byte a byte por DR. Si la UART deja de aceptar bytes, devuelve cuántos
+ * quedaron sin enviar.
+ */
+static uint32_t uart_log_transmitir_directo(const uint8_t * datos, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (!uart_log_esperar_flag(UART_FLAG_TXE)) {
+            return n - i;
+        }
+        uart_log->Instance->DR = datos[i];
+    }
+    return 0;
+}
+
+/* === Funciones públicas ===================================================================== */
+
+void uart_log_init(UART_HandleTypeDef * huart, UartLog_Politica politica) {
+    UART_LOG_BLOQUEAR();
+    uart_log = huart;
+    politica_actual = politica;
+    head = 0;
+    tail = 0;
+    en_vuelo = 0;
+    descartados = 0;
+    UART_LOG_DESBLOQUEAR();
+}
+
+bool uart_log_activo(void) {
+    return uart_log != NULL;
+}
+
+uint16_t uart_log_escribir(const uint8_t * datos, uint16_t n) {
+    uint16_t encolados = 0;
+
+    if (uart_log == NULL || datos == NULL || n == 0) {
+        return 0;
+    }
+
+    UART_LOG_BLOQUEAR();
+    uint32_t libres = UART_LOG_BUFFER_SIZE - (head - tail);
+
+    if (n > libres && politica_actual == UART_LOG_DESCARTAR_ANTIGUOS) {
+        if (n > UART_LOG_BUFFER_SIZE) {
+            // Mensaje más grande que la cola: se conserva su final
+            descartados += n - UART_LOG_BUFFER_SIZE;
+            datos += n - UART_LOG_BUFFER_SIZE;
+            n = UART_LOG_BUFFER_SIZE;
+        }
+        uart_log_descartar_antiguos(n);
+        libres = UART_LOG_BUFFER_SIZE - (head - tail);
+    }
+
+    if (n <= libres) {
+        cola_insertar(datos, n);
+        encolados = n;
+    } else {
+        descartados += n; // Mensaje completo o nada: no se cortan líneas
+    }
+
+    uart_log_iniciar_dma();
+    UART_LOG_DESBLOQUEAR();
+    return encolados;
+}
+
+void uart_log_flush(void) {
+    if (uart_log == NULL) {
+        return;
+    }
+
+    UART_LOG_BLOQUEAR();
+    uint32_t sin_enviar = 0;
+
+    if (en_vuelo != 0) {
+        // Sólo lo que el DMA no llegó a tomar: lo ya enviado no se repite
+        uint16_t restantes = uart_log_detener_dma();
+        sin_enviar = uart_log_transmitir_directo(&tramo[en_vuelo - restantes], restantes);
+        en_vuelo = 0;
+    }
+    while (head != tail) {
+        uint32_t n = head - tail;
+        if (n > UART_LOG_TRAMO_DMA) {
+            n = UART_LOG_TRAMO_DMA;
+        }
+        cola_extraer(tramo, n);
+        if (sin_enviar != 0) {
+            sin_enviar += n; // La UART no responde: el resto se cuenta sin intentar
+        } else {
+            sin_enviar = uart_log_transmitir_directo(tramo, n);
+        }
+    }
+    if (sin_enviar == 0) {
+        uart_log_esperar_flag(UART_FLAG_TC); // Que el último byte salga antes de un reset
+    }
+    descartados += sin_enviar;
+    UART_LOG_DESBLOQUEAR();
+}
+
+void uart_log_error(UART_HandleTypeDef * huart) {
+    if (uart_log == NULL || huart != uart_log) {
+        return;
+    }
+    if (en_vuelo != 0 && huart->gState != HAL_UART_STATE_BUSY_TX) {
+        // La transmisión se cortó: no se sabe cuánto salió, el tramo se cuenta como perdido
+        descartados += en_vuelo;
+        en_vuelo = 0;
+        uart_log_iniciar_dma();
+    }
+}
+
+uint32_t uart_log_descartados(void) {
+    return descartados;
+}
+
+uint16_t uart_log_pendientes(void) {
+    return (uint16_t)((head - tail) + en_vuelo);
+}
+
+void uart_log_tx_completo(UART_HandleTypeDef * huart) {
+    if (huart != uart_log) {
+        return;
+    }
+    en_vuelo = 0;
+    uart_log_iniciar_dma();
+}
@@ -34,6 +34,7 @@
 #include "sps30_multi.h"
 #include "sps30_comm.h"
 #include "uart.h"
+#include "uart_log.h"
 #include "proceso_observador.h"
 #include "data_logger.h"
 #include "time_rtc.h"
@@ -42,6 +43,7 @@
 #include "microSD.h"
 #include "mp_sensors_info.h"
 #include "DHT22.h"
+#include "base_tiempo.h"
 #include "observador_MEF.h"
 
 #include "sistema_init.h"
@@ -134,6 +136,9 @@ int main(void) {
     /* USER CODE BEGIN 2 */
 
     uart_debug = &huart3;
+#if UART_LOG_HABILITADO
+    uart_log_init(&huart3, UART_LOG_POLITICA);
+#endif
 
     /* Initialization welcome message */
     MSG_BANNER_PM25_HEADER();
@@ -234,6 +239,18 @@ void SystemClock_Config(void) {
 
 /* USER CODE BEGIN 4 */
 
+/**
+ * @brief Flancos de las entradas EXTI: tramas de los DHT22 y, si se usa, SQW del DS3231.
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+    DHT22_FlancoEXTI(GPIO_Pin);
+#if BASE_TIEMPO_USAR_SQW
+    if (GPIO_Pin == BASE_TIEMPO_SQW_PIN) {
+        base_tiempo_pulso_sqw();
+    }
+#endif
+}
+
 /* USER CODE END 4 */
 
 /**
@@ -243,6 +260,7 @@ void SystemClock_Config(void) {
 void Error_Handler(void) {
     /* USER CODE BEGIN Error_Handler_Debug */
     /* User can add his own implementation to report the HAL error return state */
+    uart_log_flush(); // Lo que quedó en la cola del log sale antes de detenerse
     __disable_irq();
     while (1) {
     }
@@ -21,7 +21,33 @@
 #include "spi.h"
 
 /* USER CODE BEGIN 0 */
+/* DMA de los bloques de datos de la microSD (modo normal, uno por sector) */
+DMA_HandleTypeDef hdma_spi1_rx;
+DMA_HandleTypeDef hdma_spi1_tx;
 
+/**
+ * @brief Configura un stream de DMA en modo normal de a bytes para SPI1.
+ */
+static void spi_config_dma(DMA_HandleTypeDef * hdma, DMA_Stream_TypeDef * stream,
+                           uint32_t direccion, IRQn_Type dma_irq) {
+    hdma->Instance = stream;
+    hdma->Init.Channel = DMA_CHANNEL_3;
+    hdma->Init.Direction = direccion;
+    hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma->Init.MemInc = DMA_MINC_ENABLE;
+    hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma->Init.Mode = DMA_NORMAL;
+    hdma->Init.Priority = DMA_PRIORITY_MEDIUM;
+    hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(hdma) != HAL_OK) {
+        Error_Handler();
+    }
+
+    // Misma prioridad que el log: los sensores SPS30 (5) no esperan a la microSD
+    HAL_NVIC_SetPriority(dma_irq, 6, 0);
+    HAL_NVIC_EnableIRQ(dma_irq);
+}
 /* USER CODE END 0 */
 
 SPI_HandleTypeDef hspi1;
@@ -80,6 +106,14 @@ void HAL_SPI_MspInit(SPI_HandleTypeDef * spiHandle) {
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
         /* USER CODE BEGIN SPI1_MspInit 1 */
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        spi_config_dma(&hdma_spi1_rx, DMA2_Stream0, DMA_PERIPH_TO_MEMORY, DMA2_Stream0_IRQn);
+        __HAL_LINKDMA(spiHandle, hdmarx, hdma_spi1_rx);
+        spi_config_dma(&hdma_spi1_tx, DMA2_Stream3, DMA_MEMORY_TO_PERIPH, DMA2_Stream3_IRQn);
+        __HAL_LINKDMA(spiHandle, hdmatx, hdma_spi1_tx);
+
+        HAL_NVIC_SetPriority(SPI1_IRQn, 6, 0);
+        HAL_NVIC_EnableIRQ(SPI1_IRQn);
 
         /* USER CODE END SPI1_MspInit 1 */
     }
@@ -102,6 +136,11 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef * spiHandle) {
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
 
         /* USER CODE BEGIN SPI1_MspDeInit 1 */
+        HAL_DMA_DeInit(spiHandle->hdmarx);
+        HAL_DMA_DeInit(spiHandle->hdmatx);
+        HAL_NVIC_DisableIRQ(DMA2_Stream0_IRQn);
+        HAL_NVIC_DisableIRQ(DMA2_Stream3_IRQn);
+        HAL_NVIC_DisableIRQ(SPI1_IRQn);
 
         /* USER CODE END SPI1_MspDeInit 1 */
     }
@@ -22,6 +22,7 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "uart_log.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -65,7 +66,17 @@ void SDTimer_Handler(void) {
 /* External variables --------------------------------------------------------*/
 
 /* USER CODE BEGIN EV */
-
+extern UART_HandleTypeDef huart5;
+extern UART_HandleTypeDef huart7;
+extern UART_HandleTypeDef huart1;
+extern DMA_HandleTypeDef hdma_uart5_rx;
+extern DMA_HandleTypeDef hdma_uart7_rx;
+extern DMA_HandleTypeDef hdma_usart1_rx;
+extern UART_HandleTypeDef huart3;
+extern DMA_HandleTypeDef hdma_usart3_tx;
+extern SPI_HandleTypeDef hspi1;
+extern DMA_HandleTypeDef hdma_spi1_rx;
+extern DMA_HandleTypeDef hdma_spi1_tx;
 /* USER CODE END EV */
 
 /******************************************************************************/
@@ -89,7 +100,7 @@ void NMI_Handler(void) {
  */
 void HardFault_Handler(void) {
     /* USER CODE BEGIN HardFault_IRQn 0 */
-
+    uart_log_flush(); // Vacía el log pendiente antes de quedar detenido
     /* USER CODE END HardFault_IRQn 0 */
     while (1) {
         /* USER CODE BEGIN W1_HardFault_IRQn 0 */
@@ -102,7 +113,7 @@ void HardFault_Handler(void) {
  */
 void MemManage_Handler(void) {
     /* USER CODE BEGIN MemoryManagement_IRQn 0 */
-
+    uart_log_flush(); // Vacía el log pendiente antes de quedar detenido
     /* USER CODE END MemoryManagement_IRQn 0 */
     while (1) {
         /* USER CODE BEGIN W1_MemoryManagement_IRQn 0 */
@@ -115,7 +126,7 @@ void MemManage_Handler(void) {
  */
 void BusFault_Handler(void) {
     /* USER CODE BEGIN BusFault_IRQn 0 */
-
+    uart_log_flush(); // Vacía el log pendiente antes de quedar detenido
     /* USER CODE END BusFault_IRQn 0 */
     while (1) {
         /* USER CODE BEGIN W1_BusFault_IRQn 0 */
@@ -128,7 +139,7 @@ void BusFault_Handler(void) {
  */
 void UsageFault_Handler(void) {
     /* USER CODE BEGIN UsageFault_IRQn 0 */
-
+    uart_log_flush(); // Vacía el log pendiente antes de quedar detenido
     /* USER CODE END UsageFault_IRQn 0 */
     while (1) {
         /* USER CODE BEGIN W1_UsageFault_IRQn 0 */
@@ -199,4 +210,65 @@ void SysTick_Handler(void) {
 
 /* USER CODE BEGIN 1 */
 
+/**
+ * @brief Interrupciones de recepción DMA + línea ociosa de los sensores SPS30.
+ */
+void UART5_IRQHandler(void) {
+    HAL_UART_IRQHandler(&huart5);
+}
+
+void UART7_IRQHandler(void) {
+    HAL_UART_IRQHandler(&huart7);
+}
+
+void USART1_IRQHandler(void) {
+    HAL_UART_IRQHandler(&huart1);
+}
+
+void DMA1_Stream0_IRQHandler(void) {
+    HAL_DMA_IRQHandler(&hdma_uart5_rx);
+}
+
+void DMA1_Stream3_IRQHandler(void) {
+    HAL_DMA_IRQHandler(&hdma_uart7_rx);
+}
+
+void DMA2_Stream2_IRQHandler(void) {
+    HAL_DMA_IRQHandler(&hdma_usart1_rx);
+}
+
+/**
+ * @brief Interrupciones de transmisión DMA del log de depuración (USART3).
+ */
+void USART3_IRQHandler(void) {
+    HAL_UART_IRQHandler(&huart3);
+}
+
+void DMA1_Stream4_IRQHandler(void) {
+    HAL_DMA_IRQHandler(&hdma_usart3_tx);
+}
+
+/**
+ * @brief Interrupciones DMA de los bloques de datos de la microSD (SPI1).
+ */
+void SPI1_IRQHandler(void) {
+    HAL_SPI_IRQHandler(&hspi1);
+}
+
+void DMA2_Stream0_IRQHandler(void) {
+    HAL_DMA_IRQHandler(&hdma_spi1_rx);
+}
+
+void DMA2_Stream3_IRQHandler(void) {
+    HAL_DMA_IRQHandler(&hdma_spi1_tx);
+}
+
+/**
+ * @brief Flancos de las tramas de los DHT22 (PB11 ambiente, PB12 cámara).
+ */
+void EXTI15_10_IRQHandler(void) {
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_11);
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_12);
+}
+
 /* USER CODE END 1 */
@@ -21,7 +21,67 @@
 #include "usart.h"
 
 /* USER CODE BEGIN 0 */
+/* DMA de recepción (modo circular + línea ociosa) de los puertos SPS30 */
+DMA_HandleTypeDef hdma_uart5_rx;
+DMA_HandleTypeDef hdma_uart7_rx;
+DMA_HandleTypeDef hdma_usart1_rx;
+/* DMA de transmisión (modo normal) del log de depuración */
+DMA_HandleTypeDef hdma_usart3_tx;
 
+/**
+ * @brief Configura un stream de DMA periférico->memoria circular y lo enlaza a la UART.
+ */
+static void usart_config_dma_rx(UART_HandleTypeDef * uartHandle, DMA_HandleTypeDef * hdma,
+                                DMA_Stream_TypeDef * stream, uint32_t channel, IRQn_Type dma_irq,
+                                IRQn_Type uart_irq) {
+    hdma->Instance = stream;
+    hdma->Init.Channel = channel;
+    hdma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma->Init.MemInc = DMA_MINC_ENABLE;
+    hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma->Init.Mode = DMA_CIRCULAR;
+    hdma->Init.Priority = DMA_PRIORITY_LOW;
+    hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(hdma) != HAL_OK) {
+        Error_Handler();
+    }
+    __HAL_LINKDMA(uartHandle, hdmarx, *hdma);
+
+    HAL_NVIC_SetPriority(dma_irq, 5, 0);
+    HAL_NVIC_EnableIRQ(dma_irq);
+    HAL_NVIC_SetPriority(uart_irq, 5, 0);
+    HAL_NVIC_EnableIRQ(uart_irq);
+}
+
+/**
+ * @brief Configura un stream de DMA memoria->periférico en modo normal y lo enlaza a la UART.
+ */
+static void usart_config_dma_tx(UART_HandleTypeDef * uartHandle, DMA_HandleTypeDef * hdma,
+                                DMA_Stream_TypeDef * stream, uint32_t channel, IRQn_Type dma_irq,
+                                IRQn_Type uart_irq) {
+    hdma->Instance = stream;
+    hdma->Init.Channel = channel;
+    hdma->Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma->Init.MemInc = DMA_MINC_ENABLE;
+    hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma->Init.Mode = DMA_NORMAL;
+    hdma->Init.Priority = DMA_PRIORITY_LOW;
+    hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(hdma) != HAL_OK) {
+        Error_Handler();
+    }
+    __HAL_LINKDMA(uartHandle, hdmatx, *hdma);
+
+    // Prioridad menor que la de los sensores: el log nunca demora una recepción SPS30
+    HAL_NVIC_SetPriority(dma_irq, 6, 0);
+    HAL_NVIC_EnableIRQ(dma_irq);
+    HAL_NVIC_SetPriority(uart_irq, 6, 0);
+    HAL_NVIC_EnableIRQ(uart_irq);
+}
 /* USER CODE END 0 */
 
 UART_HandleTypeDef huart5;
@@ -190,6 +250,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_Init(GPIOD, &GPIO_InitStruct);
 
         /* USER CODE BEGIN UART5_MspInit 1 */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        usart_config_dma_rx(uartHandle, &hdma_uart5_rx, DMA1_Stream0, DMA_CHANNEL_4,
+                            DMA1_Stream0_IRQn, UART5_IRQn);
 
         /* USER CODE END UART5_MspInit 1 */
     } else if (uartHandle->Instance == UART7) {
@@ -219,6 +282,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_Init(GPIOF, &GPIO_InitStruct);
 
         /* USER CODE BEGIN UART7_MspInit 1 */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        usart_config_dma_rx(uartHandle, &hdma_uart7_rx, DMA1_Stream3, DMA_CHANNEL_5,
+                            DMA1_Stream3_IRQn, UART7_IRQn);
 
         /* USER CODE END UART7_MspInit 1 */
     } else if (uartHandle->Instance == USART1) {
@@ -248,6 +314,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
         /* USER CODE BEGIN USART1_MspInit 1 */
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        usart_config_dma_rx(uartHandle, &hdma_usart1_rx, DMA2_Stream2, DMA_CHANNEL_4,
+                            DMA2_Stream2_IRQn, USART1_IRQn);
 
         /* USER CODE END USART1_MspInit 1 */
     } else if (uartHandle->Instance == USART3) {
@@ -270,6 +339,10 @@ void HAL_UART_MspInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_Init(GPIOD, &GPIO_InitStruct);
 
         /* USER CODE BEGIN USART3_MspInit 1 */
+        // USART3_TX: DMA1 stream 4, canal 7 (el stream 3 lo usa UART7_RX)
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        usart_config_dma_tx(uartHandle, &hdma_usart3_tx, DMA1_Stream4, DMA_CHANNEL_7,
+                            DMA1_Stream4_IRQn, USART3_IRQn);
 
         /* USER CODE END USART3_MspInit 1 */
     } else if (uartHandle->Instance == USART6) {
@@ -315,6 +388,9 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_DeInit(GPIOD, GPIO_PIN_2);
 
         /* USER CODE BEGIN UART5_MspDeInit 1 */
+        HAL_DMA_DeInit(uartHandle->hdmarx);
+        HAL_NVIC_DisableIRQ(DMA1_Stream0_IRQn);
+        HAL_NVIC_DisableIRQ(UART5_IRQn);
 
         /* USER CODE END UART5_MspDeInit 1 */
     } else if (uartHandle->Instance == UART7) {
@@ -331,6 +407,9 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_DeInit(GPIOF, GPIO_PIN_6 | GPIO_PIN_7);
 
         /* USER CODE BEGIN UART7_MspDeInit 1 */
+        HAL_DMA_DeInit(uartHandle->hdmarx);
+        HAL_NVIC_DisableIRQ(DMA1_Stream3_IRQn);
+        HAL_NVIC_DisableIRQ(UART7_IRQn);
 
         /* USER CODE END UART7_MspDeInit 1 */
     } else if (uartHandle->Instance == USART1) {
@@ -347,6 +426,9 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_9 | GPIO_PIN_10);
 
         /* USER CODE BEGIN USART1_MspDeInit 1 */
+        HAL_DMA_DeInit(uartHandle->hdmarx);
+        HAL_NVIC_DisableIRQ(DMA2_Stream2_IRQn);
+        HAL_NVIC_DisableIRQ(USART1_IRQn);
 
         /* USER CODE END USART1_MspDeInit 1 */
     } else if (uartHandle->Instance == USART3) {
@@ -363,6 +445,9 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef * uartHandle) {
         HAL_GPIO_DeInit(GPIOD, GPIO_PIN_8 | GPIO_PIN_9);
 
         /* USER CODE BEGIN USART3_MspDeInit 1 */
+        HAL_DMA_DeInit(uartHandle->hdmatx);
+        HAL_NVIC_DisableIRQ(DMA1_Stream4_IRQn);
+        HAL_NVIC_DisableIRQ(USART3_IRQn);
 
         /* USER CODE END USART3_MspDeInit 1 */
     } else if (uartHandle->Instance == USART6) {
@@ -0,0 +1,205 @@
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../APIs/Src/ParticulateDataAnalyzer.c"
+
+/*
+ * calculateStatistics() contra las cuatro funciones del analizador y contra una referencia en
+ * double, más una comparación de tiempos con la versión anterior (tres recorridos y la raíz por
+ * bisección en double).
+ */
+
+static int fallas = 0;
+static uint32_t semilla = 7;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static uint32_t aleatorio(void) {
+    semilla = semilla * 1103515245u + 12345u;
+    return semilla >> 8;
+}
+
+/* PM2.5 con datos fuera de rango (0, negativos, saturación) en cualquier posición */
+static void llenar(float * datos, int n, float base, float amplitud) {
+    for (int i = 0; i < n; i++) {
+        uint32_t r = aleatorio();
+        if (r % 20 == 0) {
+            static const float invalidos[] = {0.0f, -1.0f, 0.5f, 500.5f, 1000.0f};
+            datos[i] = invalidos[r % 5];
+        } else {
+            datos[i] = base + amplitud * (float)(r % 100000u) / 100000.0f;
+        }
+    }
+}
+
+/*
+ * Raíz por bisección en double, como la calculaba calculateStandardDeviation(). Sólo para medir
+ * tiempos: con x < 1 la raíz queda fuera de [0, x] y devolvía x (la varianza).
+ */
+static double sqrt_biseccion(double x) {
+    if (x <= 0)
+        return 0;
+    double low = 0, high = x;
+    while (high - low > 1e-7) {
+        double mid = (low + high) / 2;
+        if (mid * mid > x)
+            high = mid;
+        else
+            low = mid;
+    }
+    return (low + high) / 2;
+}
+
+static float desvio_anterior(float data[], int n) {
+    float mean = calculateAverage(data, n);
+    float sumOfSquares = 0.0f;
+    int valid = 0;
+    for (int i = 0; i < n; i++) {
+        if (maskIsDataTrue(data[i])) {
+            sumOfSquares += (data[i] - mean) * (data[i] - mean);
+            valid++;
+        }
+    }
+    return (valid > 1) ? sqrt_biseccion(sumOfSquares / (valid - 1)) : MSN_NOT_DATA;
+}
+
+static bool cerca(double a, double b, double tolerancia) {
+    return fabs(a - b) <= tolerancia * (fabs(b) > 1.0 ? fabs(b) : 1.0);
+}
+
+static void comparar(float * datos, int n, const char * caso) {
+    MPStatistics st;
+    char msg[128];
+    double suma = 0.0, m2 = 0.0;
+    int validos = 0;
+
+    calculateStatistics(datos, n, &st);
+
+    for (int i = 0; i < n; i++) {
+        if (maskIsDataTrue(datos[i])) {
+            suma += datos[i];
+            validos++;
+        }
+    }
+    double media = suma / validos;
+    for (int i = 0; i < n; i++) {
+        if (maskIsDataTrue(datos[i])) {
+            m2 += (datos[i] - media) * (datos[i] - media);
+        }
+    }
+    double desvio = sqrt(m2 / (validos - 1));
+
+    snprintf(msg, sizeof(msg), "%s: cantidad %d / %d", caso, st.validCount, validos);
+    CHECK(st.validCount == validos, msg);
+    snprintf(msg, sizeof(msg), "%s: promedio %.6f / %.6f", caso, st.average,
+             calculateAverage(datos, n));
+    CHECK(cerca(st.average, calculateAverage(datos, n), 1e-5) && cerca(st.average, media, 1e-5),
+          msg);
+    snprintf(msg, sizeof(msg), "%s: extremos", caso);
+    CHECK(st.max == findMaxValue(datos, n) && st.min == findMinValue(datos, n), msg);
+    snprintf(msg, sizeof(msg), "%s: desvío %.6f / %.6f / %.6f", caso, st.std,
+             calculateStandardDeviation(datos, n), desvio);
+    CHECK(cerca(st.std, calculateStandardDeviation(datos, n), 1e-4) && cerca(st.std, desvio, 1e-4),
+          msg);
+}
+
+static void test_precision(void) {
+    static float datos[8640];
+    static const int tamanos[] = {6, 24, 60, 240, 360, 8640};
+
+    for (size_t t = 0; t < sizeof(tamanos) / sizeof(tamanos[0]); t++) {
+        for (int rep = 0; rep < 20; rep++) {
+            llenar(datos, tamanos[t], 1.0f, 80.0f);
+            datos[0] = (rep % 2) ? 1000.0f : datos[0]; // primer dato inválido
+            comparar(datos, tamanos[t], "aleatorio");
+        }
+    }
+
+    // Media alta con poca dispersión (varianza menor que 1)
+    llenar(datos, 360, 450.0f, 1.0f);
+    datos[0] = 450.5f;
+    comparar(datos, 360, "media alta");
+    float desvio = calculateStandardDeviation(datos, 360);
+    CHECK(cerca(desvio * desvio, 1.0 / 12.0, 0.2), "desvío, no varianza, con varianza < 1");
+}
+
+static void test_casos_limite(void) {
+    MPStatistics st;
+    float uno[] = {12.0f};
+    float invalidos[] = {0.0f, 600.0f, -3.0f};
+    float un_valido[] = {0.0f, 25.0f, -3.0f};
+    float iguales[] = {7.3f, 7.3f, 7.3f, 7.3f};
+
+    calculateStatistics(NULL, 0, &st);
+    CHECK(st.average == MSN_VOID_ARRAY_VALUE && st.std == MSN_VOID_ARRAY_VALUE &&
+              st.validCount == 0,
+          "array vacío");
+
+    calculateStatistics(uno, 1, &st);
+    CHECK(st.average == 12.0f && st.std == calculateStandardDeviation(uno, 1) &&
+              st.std == MSN_DS_NOTDEFINI,
+          "un solo dato");
+
+    calculateStatistics(invalidos, 3, &st);
+    CHECK(st.average == calculateAverage(invalidos, 3) && st.max == findMaxValue(invalidos, 3) &&
+              st.min == findMinValue(invalidos, 3) && st.max == MSN_VOID_ARRAY_VALUE,
+          "todos inválidos");
+
+    calculateStatistics(un_valido, 3, &st);
+    CHECK(st.average == 25.0f && st.min == 25.0f && st.max == 25.0f && st.std == MSN_NOT_DATA &&
+              calculateStandardDeviation(un_valido, 3) == MSN_NOT_DATA,
+          "un dato válido");
+
+    calculateStatistics(iguales, 4, &st);
+    CHECK(st.std == 0.0f && calculateStandardDeviation(iguales, 4) == 0.0f, "datos iguales");
+}
+
+static double segundos(clock_t desde) {
+    return (double)(clock() - desde) / CLOCKS_PER_SEC;
+}
+
+static void benchmark(void) {
+    enum { VENTANA = 60, REPETICIONES = 200000 };
+    static float datos[VENTANA];
+    volatile float sumidero = 0.0f;
+
+    llenar(datos, VENTANA, 1.0f, 80.0f);
+
+    clock_t t = clock();
+    for (int i = 0; i < REPETICIONES; i++) {
+        datos[i % VENTANA] += 0.0f * sumidero; // evita que el compilador saque el cálculo del lazo
+        sumidero += calculateAverage(datos, VENTANA) + findMaxValue(datos, VENTANA) +
+                    findMinValue(datos, VENTANA) + desvio_anterior(datos, VENTANA);
+    }
+    double antes = segundos(t);
+
+    t = clock();
+    for (int i = 0; i < REPETICIONES; i++) {
+        MPStatistics st;
+        datos[i % VENTANA] += 0.0f * sumidero;
+        calculateStatistics(datos, VENTANA, &st);
+        sumidero += st.average + st.max + st.min + st.std;
+    }
+    double despues = segundos(t);
+
+    printf("BENCH ventana de %d: cuatro funciones + bisección %.3f us, una pasada %.3f us "
+           "(x%.1f)\n",
+           VENTANA, antes * 1e6 / REPETICIONES, despues * 1e6 / REPETICIONES,
+           despues > 0 ? antes / despues : 0.0);
+}
+
+int main(void) {
+    test_casos_limite();
+    test_precision();
+    benchmark();
+
+    printf(fallas == 0 ? "PASS\n" : "FAILED\n");
+    return fallas == 0 ? 0 : 1;
+}
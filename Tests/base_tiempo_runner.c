@@ -0,0 +1,270 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "stubs/rtc_ds3231_for_stm32_hal.h" // ds3231_time_t sin los tipos de la HAL
+#include "../APIs/Src/base_tiempo.c"
+
+/*
+ * Simula un DS3231 exacto y un SysTick con deriva (ppm) durante horas de consultas, con y sin
+ * pulsos de SQW, con el RTC caído un rato y con el tick dando la vuelta. Verifica el error contra
+ * la hora del DS3231, que la hora no retroceda y cuántas lecturas por I2C se hicieron.
+ */
+
+static int fallas = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+/* === Reloj simulado ========================================================================= */
+
+#define LECTURA_I2C_US 1000u /* Una lectura (o un timeout) del DS3231 */
+
+static uint64_t t_us;           /* Tiempo real */
+static uint32_t segundos_rtc;   /* Hora del DS3231 en t_us = 0 */
+static int32_t ppm;             /* Deriva del SysTick */
+static uint32_t tick_inicial;
+static bool sqw;                /* Pulsos de SQW conectados */
+static uint64_t falla_desde_us, falla_hasta_us;
+static uint32_t lecturas;
+
+uint32_t HAL_GetTick(void) {
+    return tick_inicial + (uint32_t)(t_us * (uint64_t)(1000000 + ppm) / 1000000000u);
+}
+
+static uint32_t hora_rtc(void) {
+    return segundos_rtc + (uint32_t)(t_us / 1000000u);
+}
+
+/* Avanza el tiempo real; cada segundo del DS3231 es un flanco de SQW */
+static void avanzar(uint64_t us) {
+    uint64_t fin = t_us + us;
+    while (sqw && (t_us / 1000000u + 1u) * 1000000u <= fin) {
+        t_us = (t_us / 1000000u + 1u) * 1000000u;
+        base_tiempo_pulso_sqw();
+    }
+    t_us = fin;
+}
+
+bool ds3231_get_datetime(ds3231_time_t * dt) {
+    uint32_t segundos = hora_rtc(); // los registros se copian al empezar la lectura
+    bool ok = !(t_us >= falla_desde_us && t_us < falla_hasta_us);
+
+    lecturas++;
+    avanzar(LECTURA_I2C_US);
+    if (ok) {
+        base_tiempo_desde_segundos(segundos, dt);
+    }
+    return ok;
+}
+
+static void reiniciar(int32_t deriva, uint32_t tick, bool con_sqw) {
+    valida = false;
+    rtc_ok = false;
+    pedir_lectura = true;
+    tick_lectura = segundos_base = tick_base = pulsos_base = ultimo_entregado = 0;
+    pulsos_sqw = tick_pulso = 0;
+    memset(&estadisticas, 0, sizeof(estadisticas));
+
+    t_us = 0;
+    segundos_rtc = 836956800u + 3599u; // 2026-07-10 00:59:59
+    ppm = deriva;
+    tick_inicial = tick;
+    sqw = con_sqw;
+    falla_desde_us = falla_hasta_us = 0;
+    lecturas = 0;
+}
+
+/* === Escenarios ============================================================================= */
+
+typedef struct {
+    int32_t error_min, error_max;
+    uint32_t consultas, exactas, fallidas;
+    bool retrocedio;
+} Resultado;
+
+/* Consulta la hora cada paso_ms durante duracion_s y la compara con la del DS3231 */
+static Resultado consultar(uint32_t duracion_s, uint32_t paso_ms) {
+    Resultado r = {.error_min = 1000, .error_max = -1000};
+    uint32_t anterior = 0;
+    uint64_t fin = t_us + (uint64_t)duracion_s * 1000000u;
+
+    while (t_us < fin) {
+        avanzar((uint64_t)paso_ms * 1000u);
+        uint32_t esperado = hora_rtc(); // antes de una posible lectura, que corre el reloj
+        uint32_t s;
+
+        r.consultas++;
+        if (!base_tiempo_segundos(&s)) {
+            r.fallidas++;
+            continue;
+        }
+        int32_t error = (int32_t)(s - esperado);
+        r.error_min = (error < r.error_min) ? error : r.error_min;
+        r.error_max = (error > r.error_max) ? error : r.error_max;
+        r.exactas += (error == 0);
+        r.retrocedio |= (anterior != 0 && s < anterior);
+        anterior = s;
+    }
+    return r;
+}
+
+static void probar_deriva(int32_t deriva, uint32_t tick) {
+    char msg[96];
+    const uint32_t duracion_s = 6u * 3600u;
+
+    reiniciar(deriva, tick, false);
+    Resultado r = consultar(duracion_s, 100);
+
+    printf("Deriva %+d ppm: error [%d, %d] s, %u lecturas I2C en %u consultas\n", deriva,
+           r.error_min, r.error_max, lecturas, r.consultas);
+    snprintf(msg, sizeof(msg), "error acotado con %+d ppm", deriva);
+    // La lectura descarta la fracción de segundo; la deriva de un minuto puede sumar otro
+    CHECK(r.error_min >= (deriva < 0 ? -2 : -1) && r.error_max <= (deriva > 0 ? 1 : 0), msg);
+    snprintf(msg, sizeof(msg), "monótona con %+d ppm", deriva);
+    CHECK(!r.retrocedio && r.fallidas == 0, msg);
+    snprintf(msg, sizeof(msg), "una lectura por minuto con %+d ppm", deriva);
+    CHECK(lecturas <= duracion_s * 1000u / BASE_TIEMPO_RESINCRONIZAR_MS + 2u, msg);
+}
+
+static void probar_sqw(int32_t deriva) {
+    char msg[96];
+    const uint32_t duracion_s = 3600u;
+
+    reiniciar(deriva, 0xFFFF0000u, true);
+    avanzar(350000u); // la lectura cae a mitad de un segundo
+    Resultado r = consultar(duracion_s, 7);
+
+    printf("SQW con %+d ppm: error [%d, %d] s, %u pulsos, %u lecturas I2C\n", deriva, r.error_min,
+           r.error_max, base_tiempo_estadisticas().pulsos_sqw, lecturas);
+    snprintf(msg, sizeof(msg), "SQW: la hora es la del DS3231 con %+d ppm", deriva);
+    // Hasta el primer pulso la hora es la de la lectura, que descarta la fracción
+    CHECK(r.error_min >= -1 && r.error_max == 0 && r.consultas - r.exactas <= 100u, msg);
+    CHECK(!r.retrocedio, "SQW: monótona");
+    CHECK(lecturas <= 2u * (duracion_s * 1000u / BASE_TIEMPO_RESINCRONIZAR_MS + 2u),
+          "SQW: lecturas acotadas");
+
+    // Sin pulsos (SQW desconectado) sigue con el SysTick
+    sqw = false;
+    r = consultar(600, 100);
+    CHECK(r.error_min >= -2 && r.error_max <= 1 && !r.retrocedio, "SQW: sin pulsos sigue");
+}
+
+static void probar_rtc_caido(void) {
+    reiniciar(150, 0, false);
+
+    // Nunca respondió: no hay hora, y se reintenta una vez por BASE_TIEMPO_REINTENTO_MS
+    falla_hasta_us = 30000000u;
+    Resultado r = consultar(20, 50);
+    CHECK(r.fallidas == r.consultas, "sin lectura buena no hay hora");
+    CHECK(!base_tiempo_rtc_ok(), "rtc_ok en falso");
+    CHECK(lecturas <= 20000u / BASE_TIEMPO_REINTENTO_MS + 2u, "reintentos espaciados");
+
+    // Responde, y después se cae cinco minutos: la hora sigue con el SysTick
+    falla_hasta_us = 0;
+    consultar(100, 50);
+    CHECK(base_tiempo_rtc_ok(), "rtc_ok tras responder");
+    falla_desde_us = t_us;
+    falla_hasta_us = t_us + 300000000u;
+    lecturas = 0;
+    r = consultar(300, 50);
+    printf("RTC caído 300 s: error [%d, %d] s, %u lecturas, %u fallas en total\n", r.error_min,
+           r.error_max, lecturas, base_tiempo_estadisticas().fallas_rtc);
+    CHECK(r.fallidas == 0 && r.error_min >= -2 && r.error_max <= 1 && !r.retrocedio,
+          "RTC caído: la hora sigue");
+    CHECK(!base_tiempo_rtc_ok(), "RTC caído: rtc_ok en falso");
+    CHECK(lecturas <= 300000u / BASE_TIEMPO_REINTENTO_MS + 2u, "RTC caído: reintentos espaciados");
+
+    r = consultar(5, 50);
+    CHECK(base_tiempo_rtc_ok() && r.error_min >= -1 && r.error_max <= 0, "RTC vuelve");
+}
+
+static void probar_puesta_en_hora(void) {
+    uint32_t s;
+
+    reiniciar(0, 0, false);
+    consultar(10, 100);
+    uint32_t lecturas_antes = lecturas;
+
+    segundos_rtc -= 3600u; // DS3231_SetDateTime() una hora antes
+    base_tiempo_resincronizar();
+    CHECK(base_tiempo_segundos(&s) && s == hora_rtc(), "la nueva hora se toma enseguida");
+    CHECK(lecturas == lecturas_antes + 1u, "una lectura tras resincronizar");
+    Resultado r = consultar(120, 100);
+    CHECK(!r.retrocedio && r.error_min >= -1 && r.error_max <= 0, "sigue desde la nueva hora");
+}
+
+/* Recorre el calendario día por día, sin las fórmulas de base_tiempo.c */
+static void probar_calendario(void) {
+    static const uint8_t dias_mes[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    ds3231_time_t dt = {.hour = 0, .min = 0, .sec = 0, .day = 1, .month = 1, .year = 2000};
+    uint32_t dia = 0;
+    bool ok = true;
+
+    while (dt.year < 2136) {
+        ds3231_time_t fin = dt, obtenido;
+        fin.hour = 23;
+        fin.min = 59;
+        fin.sec = 59;
+
+        ok &= base_tiempo_a_segundos(&dt) == dia * 86400u;
+        ok &= base_tiempo_a_segundos(&fin) == dia * 86400u + 86399u;
+        base_tiempo_desde_segundos(dia * 86400u + 86399u, &obtenido);
+        ok &= memcmp(&obtenido, &fin, sizeof(fin)) == 0;
+        base_tiempo_desde_segundos(dia * 86400u, &obtenido);
+        ok &= memcmp(&obtenido, &dt, sizeof(dt)) == 0;
+        ok &= BASE_TIEMPO_BLOQUE_10MIN(base_tiempo_a_segundos(&fin)) == fin.min / 10;
+        if (!ok) {
+            printf("FAIL calendario en %04u-%02u-%02u\n", dt.year, dt.month, dt.day);
+            fallas++;
+            return;
+        }
+
+        bool bisiesto = (dt.year % 4 == 0 && dt.year % 100 != 0) || dt.year % 400 == 0;
+        uint8_t largo = dias_mes[dt.month - 1] + (dt.month == 2 && bisiesto);
+        if (++dt.day > largo) {
+            dt.day = 1;
+            if (++dt.month > 12) {
+                dt.month = 1;
+                dt.year++;
+            }
+        }
+        dia++;
+    }
+
+    // Ventanas entre días: la diferencia es una resta
+    ds3231_time_t antes = {.hour = 23, .min = 55, .sec = 0, .day = 31, .month = 12, .year = 2025};
+    ds3231_time_t despues = {.hour = 0, .min = 5, .sec = 0, .day = 2, .month = 1, .year = 2026};
+    CHECK(base_tiempo_a_segundos(&despues) - base_tiempo_a_segundos(&antes) == 86400u + 600u,
+          "diferencia de un día y diez minutos entre años");
+
+    ds3231_time_t d;
+    base_tiempo_desde_segundos(0xFFFFFFFFu, &d);
+    CHECK(d.year == 2136 && d.month == 2 && d.day == 7 && d.hour == 6 && d.min == 28 &&
+              d.sec == 15,
+          "último segundo representable");
+    base_tiempo_desde_segundos(3661u + 59u * 86400u, &d);
+    CHECK(d.year == 2000 && d.month == 2 && d.day == 29 && d.hour == 1 && d.min == 1 && d.sec == 1,
+          "2000 es bisiesto");
+}
+
+int main(void) {
+    probar_calendario();
+    probar_deriva(0, 0);
+    probar_deriva(200, 0xFFFFFF00u - 30000u); // el tick da la vuelta a los 30 s
+    probar_deriva(-200, 0);
+    probar_sqw(200);
+    probar_sqw(-200);
+    probar_rtc_caido();
+    probar_puesta_en_hora();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -27,6 +27,8 @@
 #endif
 
 // Incluir el .c del módulo bajo prueba sólo en test
+#include "../APIs/Src/microSD_cache.c" // con el doble de uart.h de arriba
+#include "../APIs/Src/registro_raw.c"
 #include "../APIs/Src/data_logger.c"
 
 // Declaración de buffers que quieras inspeccionar
@@ -14,6 +14,8 @@
 #include "stubs/mp_sensors_info.h"
 #include "stubs/main.h"
 #include "stubs/usart.h"
+#include "../APIs/Src/microSD_cache.c" // con el doble de uart.h de arriba
+#include "../APIs/Src/registro_raw.c"
 #include "../APIs/Src/data_logger.c"
 
 int main(void){
@@ -22,14 +24,16 @@ int main(void){
         stub_advance_seconds(10);
         proceso_analisis_periodico(10.0f); // constant value
     }
-    float *hbuf = get_avg1h_buffer();
-    if(get_hourly_index()>0){
+    AcumuladorMP *h = get_acumulador_1h();
+    // La hora acumula un promedio por ventana de 10 min, no las mediciones
+    if(get_hourly_index()>0 && h->n==1 && acumulador_promedio(h)==10.0f){
         for(int i=1;i<6;i++){
             for(int j=0;j<61;j++){ stub_advance_seconds(10); proceso_analisis_periodico(10.0f); }
         }
-        if(get_daily_index()>0){ printf("PASS\n"); return 0; }
+        AcumuladorMP *d = get_acumulador_24h();
+        if(get_daily_index()>0 && d->n==1 && acumulador_promedio(d)==10.0f){ printf("PASS\n"); return 0; }
     }
-    printf("hourly_index=%d daily_index=%d first=%f\n", get_hourly_index(), get_daily_index(), hbuf[0]);
+    printf("hourly_index=%d daily_index=%d n1h=%u\n", get_hourly_index(), get_daily_index(), (unsigned)h->n);
     printf("FAIL\n");
     return 1;
 }
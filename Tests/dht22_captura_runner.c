@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../APIs/Src/DHT22_Captura.c"
+
+/*
+ * Sintetiza los flancos descendentes que guardaría la EXTI durante una trama del DHT22 (con la
+ * variación de tiempos de la hoja de datos más la de la latencia de la interrupción), los pasa
+ * por el decodificador y compara los bytes. Incluye la vuelta de DWT->CYCCNT, dos sensores
+ * intercalados, temperaturas bajo cero y tramas rotas.
+ */
+
+static int fallas = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+#define MHZ_HSI   16u  /* Reloj actual (HSI sin PLL) */
+#define MHZ_PLL   180u /* Reloj máximo del STM32F429 */
+#define LATENCIA  3    /* Atraso variable de la EXTI (0 a 3 µs) */
+#define EVENTOS   (2u * DHT22_CAPTURA_FLANCOS)
+
+typedef struct {
+    uint32_t marca;
+    DHT22_Captura * cap;
+} Flanco;
+
+static uint32_t semilla = 12345u;
+
+/* Entero en [min, max] */
+static int azar(int min, int max) {
+    semilla = semilla * 1103515245u + 12345u;
+    return min + (int)((semilla >> 16) % (uint32_t)(max - min + 1));
+}
+
+/*
+ * Marcas de los 42 flancos de una trama que empieza en 'inicio'. Los tiempos salen de la hoja de
+ * datos: respuesta 75..85 + 75..85 µs, bit 48..55 µs bajo y 22..30 (0) o 68..75 (1) µs alto.
+ */
+static void sintetizar(const uint8_t datos[5], uint32_t inicio, uint32_t mhz, uint32_t marcas[]) {
+    int64_t t = 0;
+
+    marcas[0] = inicio + (uint32_t)(azar(0, LATENCIA) * (int)mhz);
+    t += azar(75, 85) + azar(75, 85);
+    marcas[1] = inicio + (uint32_t)((t + azar(0, LATENCIA)) * mhz);
+    for (int bit = 0; bit < 40; bit++) {
+        bool uno = (datos[bit / 8] >> (7 - bit % 8)) & 1u;
+        t += azar(48, 55) + (uno ? azar(68, 75) : azar(22, 30));
+        marcas[bit + 2] = inicio + (uint32_t)((t + azar(0, LATENCIA)) * mhz);
+    }
+}
+
+static void cargar(DHT22_Captura * cap, const uint32_t marcas[], int cantidad) {
+    DHT22_CapturaReiniciar(cap);
+    for (int i = 0; i < cantidad; i++) {
+        DHT22_CapturaFlanco(cap, marcas[i]);
+    }
+}
+
+static void trama(uint8_t datos[5], uint16_t humedad, uint16_t temperatura) {
+    datos[0] = (uint8_t)(humedad >> 8);
+    datos[1] = (uint8_t)humedad;
+    datos[2] = (uint8_t)(temperatura >> 8);
+    datos[3] = (uint8_t)temperatura;
+    datos[4] = (uint8_t)(datos[0] + datos[1] + datos[2] + datos[3]);
+}
+
+static int por_marca(const void * a, const void * b) {
+    uint32_t x = ((const Flanco *)a)->marca, y = ((const Flanco *)b)->marca;
+    return (x > y) - (x < y);
+}
+
+int main(void) {
+    DHT22_Captura cap;
+    uint32_t marcas[DHT22_CAPTURA_FLANCOS];
+    uint8_t datos[5], leidos[5];
+    float temperatura, humedad;
+
+    /* Trama conocida: 65.2 %, 23.5 °C, con el contador dando la vuelta en el medio */
+    trama(datos, 652u, 235u);
+    sintetizar(datos, 0xFFFFF000u, MHZ_PLL, marcas);
+    CHECK(marcas[DHT22_CAPTURA_FLANCOS - 1] < marcas[0], "la trama cruza la vuelta de CYCCNT");
+    cargar(&cap, marcas, DHT22_CAPTURA_FLANCOS);
+    CHECK(DHT22_CapturaCompleta(&cap), "42 flancos completan la trama");
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_PLL, leidos) == DHT22_OK, "trama válida");
+    CHECK(memcmp(datos, leidos, 5) == 0, "bytes de la trama válida");
+    DHT22_CapturaConvertir(leidos, &temperatura, &humedad);
+    CHECK(temperatura > 23.45f && temperatura < 23.55f, "temperatura 23.5");
+    CHECK(humedad > 65.15f && humedad < 65.25f, "humedad 65.2");
+
+    /* Bajo cero: bit 15 de signo y módulo en décimas (antes daba 3286.9 °C) */
+    trama(datos, 450u, 0x8000u | 101u);
+    sintetizar(datos, 1000u, MHZ_HSI, marcas);
+    cargar(&cap, marcas, DHT22_CAPTURA_FLANCOS);
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_HSI, leidos) == DHT22_OK, "trama bajo cero");
+    DHT22_CapturaConvertir(leidos, &temperatura, &humedad);
+    CHECK(temperatura < -10.05f && temperatura > -10.15f, "temperatura -10.1");
+    CHECK(humedad > 44.95f && humedad < 45.05f, "humedad 45.0");
+
+    /* Muchas tramas al azar, a los dos relojes */
+    int errores = 0;
+    for (int n = 0; n < 20000; n++) {
+        uint32_t mhz = (n % 2) ? MHZ_PLL : MHZ_HSI;
+        trama(datos, (uint16_t)azar(0, 1000), (uint16_t)azar(0, 0xFFFF));
+        sintetizar(datos, (uint32_t)azar(0, 0x7FFFFFFF) * 2u, mhz, marcas);
+        cargar(&cap, marcas, DHT22_CAPTURA_FLANCOS);
+        if (DHT22_CapturaDecodificar(&cap, mhz, leidos) != DHT22_OK || memcmp(datos, leidos, 5)) {
+            errores++;
+        }
+    }
+    CHECK(errores == 0, "tramas al azar con la variación de la hoja de datos");
+
+    /* Dos sensores leídos a la vez: la EXTI recibe los flancos intercalados */
+    DHT22_Captura amb, cam;
+    uint32_t marcas_cam[DHT22_CAPTURA_FLANCOS];
+    uint8_t datos_cam[5], leidos_cam[5];
+    Flanco eventos[EVENTOS];
+
+    trama(datos, 312u, 187u);
+    trama(datos_cam, 998u, 0x8000u | 5u);
+    sintetizar(datos, 500000u, MHZ_PLL, marcas);
+    sintetizar(datos_cam, 500000u + 7u * MHZ_PLL, MHZ_PLL, marcas_cam);
+    for (unsigned i = 0; i < DHT22_CAPTURA_FLANCOS; i++) {
+        eventos[2 * i] = (Flanco){marcas[i], &amb};
+        eventos[2 * i + 1] = (Flanco){marcas_cam[i], &cam};
+    }
+    qsort(eventos, EVENTOS, sizeof(Flanco), por_marca);
+    DHT22_CapturaReiniciar(&amb);
+    DHT22_CapturaReiniciar(&cam);
+    for (unsigned i = 0; i < EVENTOS; i++) {
+        DHT22_CapturaFlanco(eventos[i].cap, eventos[i].marca);
+    }
+    CHECK(DHT22_CapturaDecodificar(&amb, MHZ_PLL, leidos) == DHT22_OK &&
+              memcmp(datos, leidos, 5) == 0,
+          "sensor ambiente intercalado");
+    CHECK(DHT22_CapturaDecodificar(&cam, MHZ_PLL, leidos_cam) == DHT22_OK &&
+              memcmp(datos_cam, leidos_cam, 5) == 0,
+          "sensor cámara intercalado");
+
+    /* Tramas rotas */
+    trama(datos, 652u, 235u);
+    sintetizar(datos, 0u, MHZ_PLL, marcas);
+
+    DHT22_CapturaReiniciar(&cap);
+    CHECK(!DHT22_CapturaCompleta(&cap), "sin flancos no está completa");
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_PLL, leidos) == DHT22_ERROR_PIN_HIGH,
+          "sensor que no responde");
+
+    cargar(&cap, marcas, DHT22_CAPTURA_FLANCOS - 1);
+    CHECK(!DHT22_CapturaCompleta(&cap), "41 flancos no completan la trama");
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_PLL, leidos) == DHT22_ERROR_RESPONSE,
+          "falta el último flanco");
+
+    cargar(&cap, marcas, DHT22_CAPTURA_FLANCOS);
+    DHT22_CapturaFlanco(&cap, marcas[DHT22_CAPTURA_FLANCOS - 1] + 10u * MHZ_PLL);
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_PLL, leidos) == DHT22_ERROR_RESPONSE,
+          "flanco de ruido de más");
+    for (int i = 0; i < 300; i++) {
+        DHT22_CapturaFlanco(&cap, 0u);
+    }
+    CHECK(cap.cantidad == UINT8_MAX, "el conteo de flancos no da la vuelta");
+
+    uint32_t copia[DHT22_CAPTURA_FLANCOS];
+    memcpy(copia, marcas, sizeof(copia));
+    copia[1] = copia[0] + 60u * MHZ_PLL; // respuesta corta: ruido en la línea
+    cargar(&cap, copia, DHT22_CAPTURA_FLANCOS);
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_PLL, leidos) == DHT22_ERROR_RESPONSE,
+          "respuesta fuera de rango");
+
+    memcpy(copia, marcas, sizeof(copia));
+    for (unsigned i = 20; i < DHT22_CAPTURA_FLANCOS; i++) {
+        copia[i] += 200u * MHZ_PLL; // un bit de 270 µs o más: se perdió un flanco
+    }
+    cargar(&cap, copia, DHT22_CAPTURA_FLANCOS);
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_PLL, leidos) == DHT22_ERROR_RESPONSE,
+          "bit fuera de rango");
+
+    datos[4] ^= 0x01u; // checksum que no cierra
+    sintetizar(datos, 0u, MHZ_PLL, marcas);
+    cargar(&cap, marcas, DHT22_CAPTURA_FLANCOS);
+    CHECK(DHT22_CapturaDecodificar(&cap, MHZ_PLL, leidos) == DHT22_ERROR_CHECKSUM,
+          "checksum incorrecto");
+
+    if (fallas == 0) {
+        printf("PASS\n");
+    }
+    return fallas ? 1 : 0;
+}
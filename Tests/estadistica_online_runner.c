@@ -0,0 +1,200 @@
+#include <math.h>
+#include <stdio.h>
+
+#include "../APIs/Src/estadistica_online.c"
+
+/*
+ * Compara los acumuladores con el cálculo en dos pasadas (en double) sobre las mismas muestras,
+ * y verifica que combinar ventanas o sensores dé lo mismo que acumular todo junto.
+ */
+
+#define MUESTRAS_10MIN 60
+#define SENSORES       4
+
+static int fallas = 0;
+static uint32_t semilla = 2026;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+typedef struct {
+    int n;
+    double media, desvio, min, max;
+} Referencia;
+
+static uint32_t aleatorio(void) {
+    semilla = semilla * 1103515245u + 12345u;
+    return semilla >> 8;
+}
+
+/* PM2.5 típico con alguna muestra fuera de rango (sensor sin datos, saturación) */
+static float muestra(float base) {
+    uint32_t r = aleatorio();
+    if (r % 50 == 0) {
+        return (r % 100 == 0) ? 0.0f : 1000.0f;
+    }
+    return base + (float)(r % 100000u) / 1000.0f;
+}
+
+static bool valido(float x) {
+    return x > 0.5f && x <= 500.0f;
+}
+
+static Referencia dos_pasadas(const float * datos, int n) {
+    Referencia ref = {0};
+    double suma = 0.0;
+
+    for (int i = 0; i < n; i++) {
+        if (!valido(datos[i])) {
+            continue;
+        }
+        if (ref.n == 0 || datos[i] < ref.min) {
+            ref.min = datos[i];
+        }
+        if (ref.n == 0 || datos[i] > ref.max) {
+            ref.max = datos[i];
+        }
+        suma += datos[i];
+        ref.n++;
+    }
+    ref.media = suma / ref.n;
+    double m2 = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (valido(datos[i])) {
+            m2 += (datos[i] - ref.media) * (datos[i] - ref.media);
+        }
+    }
+    ref.desvio = sqrt(m2 / (ref.n - 1));
+    return ref;
+}
+
+static bool cerca(double a, double b, double tolerancia) {
+    return fabs(a - b) <= tolerancia * (fabs(b) > 1.0 ? fabs(b) : 1.0);
+}
+
+static void comparar(const AcumuladorMP * acc, const Referencia * ref, const char * caso) {
+    char msg[96];
+
+    snprintf(msg, sizeof(msg), "%s: n", caso);
+    CHECK(acc->n == (uint32_t)ref->n, msg);
+    snprintf(msg, sizeof(msg), "%s: promedio %.6f / %.6f", caso, acumulador_promedio(acc),
+             ref->media);
+    CHECK(cerca(acumulador_promedio(acc), ref->media, 1e-5), msg);
+    snprintf(msg, sizeof(msg), "%s: desvío %.6f / %.6f", caso, acumulador_desvio(acc),
+             ref->desvio);
+    CHECK(cerca(acumulador_desvio(acc), ref->desvio, 1e-4), msg);
+    snprintf(msg, sizeof(msg), "%s: extremos", caso);
+    CHECK(acumulador_minimo(acc) == (float)ref->min && acumulador_maximo(acc) == (float)ref->max,
+          msg);
+}
+
+static void test_casos_limite(void) {
+    AcumuladorMP acc;
+
+    acumulador_reiniciar(&acc);
+    CHECK(acumulador_promedio(&acc) == ESTADISTICA_SIN_DATOS, "vacío: promedio");
+    CHECK(acumulador_desvio(&acc) == ESTADISTICA_SIN_DATOS, "vacío: desvío");
+    CHECK(acumulador_minimo(&acc) == ESTADISTICA_SIN_DATOS, "vacío: mínimo");
+
+    CHECK(!acumulador_agregar(&acc, 0.5f), "0,5 no es válido");
+    CHECK(!acumulador_agregar(&acc, NAN), "NaN no es válido");
+    CHECK(!acumulador_agregar(&acc, -3.0f), "negativo no es válido");
+    CHECK(!acumulador_agregar(&acc, 500.1f), "sobre el máximo no es válido");
+    CHECK(acumulador_agregar(&acc, 500.0f), "500 es válido");
+    CHECK(acc.n == 1 && acumulador_desvio(&acc) == ESTADISTICA_DS_SIN_DATO, "una muestra");
+
+    acumulador_agregar(&acc, 500.0f);
+    acumulador_agregar(&acc, 500.0f);
+    CHECK(acumulador_desvio(&acc) == 0.0f, "muestras iguales: desvío cero");
+
+    /* El promedio combinado de 10 minutos acumula todas las mediciones, como antes */
+    AcumuladorMP crudo = {0};
+    CHECK(acumulador_agregar_sin_rango(&crudo, 0.3f), "sin rango: aire limpio");
+    CHECK(acumulador_agregar_sin_rango(&crudo, 0.0f), "sin rango: cero");
+    CHECK(acumulador_agregar_sin_rango(&crudo, 600.0f), "sin rango: sobre el máximo");
+    CHECK(crudo.n == 3 && fabsf(acumulador_promedio(&crudo) - 200.1f) < 1e-3f, "sin rango: media");
+    CHECK(acumulador_minimo(&crudo) == 0.0f && acumulador_maximo(&crudo) == 600.0f,
+          "sin rango: extremos");
+
+    AcumuladorMP vacio = {0};
+    AcumuladorMP copia = acc;
+    acumulador_combinar(&acc, &vacio);
+    CHECK(acc.n == copia.n && acc.media == copia.media, "combinar con vacío no cambia nada");
+    acumulador_combinar(&vacio, &copia);
+    CHECK(vacio.n == copia.n && vacio.m2 == copia.m2, "combinar en vacío copia");
+}
+
+/* Un bloque de 10 minutos de cuatro sensores: por sensor y combinados */
+static void test_bloque_sensores(void) {
+    float datos[SENSORES * MUESTRAS_10MIN];
+    AcumuladorMP por_sensor[SENSORES] = {0};
+    AcumuladorMP total = {0};
+
+    for (int s = 0; s < SENSORES; s++) {
+        for (int i = 0; i < MUESTRAS_10MIN; i++) {
+            float x = muestra(5.0f + 20.0f * s);
+            datos[s * MUESTRAS_10MIN + i] = x;
+            acumulador_agregar(&por_sensor[s], x);
+        }
+        Referencia ref = dos_pasadas(&datos[s * MUESTRAS_10MIN], MUESTRAS_10MIN);
+        comparar(&por_sensor[s], &ref, "sensor");
+        acumulador_combinar(&total, &por_sensor[s]);
+    }
+
+    Referencia ref = dos_pasadas(datos, SENSORES * MUESTRAS_10MIN);
+    comparar(&total, &ref, "sensores combinados");
+}
+
+/* Un día de muestras cada 10 s: ventanas de 10 min -> horas -> día, como data_logger.c */
+static void test_dia(void) {
+    static float datos[24 * 6 * MUESTRAS_10MIN];
+    AcumuladorMP dia = {0};
+    int n = 0;
+
+    for (int h = 0; h < 24; h++) {
+        AcumuladorMP hora = {0};
+        for (int v = 0; v < 6; v++) {
+            AcumuladorMP ventana = {0};
+            // Ciclo diario: valores bajos de noche, altos en la tarde
+            float base = 10.0f + 60.0f * (float)(h > 12 ? 24 - h : h) / 12.0f;
+            for (int i = 0; i < MUESTRAS_10MIN; i++) {
+                datos[n] = muestra(base);
+                acumulador_agregar(&ventana, datos[n++]);
+            }
+            acumulador_combinar(&hora, &ventana);
+        }
+        Referencia ref = dos_pasadas(&datos[n - 6 * MUESTRAS_10MIN], 6 * MUESTRAS_10MIN);
+        comparar(&hora, &ref, "hora");
+        acumulador_combinar(&dia, &hora);
+    }
+
+    Referencia ref = dos_pasadas(datos, n);
+    comparar(&dia, &ref, "día");
+
+    // Valores grandes con poca dispersión: el caso que pierde precisión con suma de cuadrados
+    AcumuladorMP acc = {0};
+    for (int i = 0; i < n; i++) {
+        datos[i] = 450.0f + (float)(aleatorio() % 1000u) / 1000.0f;
+        acumulador_agregar(&acc, datos[i]);
+    }
+    ref = dos_pasadas(datos, n);
+    comparar(&acc, &ref, "media alta");
+}
+
+int main(void) {
+    test_casos_limite();
+    test_bloque_sensores();
+    test_dia();
+
+    printf("RAM: ventana de 10 min %u -> %u bytes; 1 h + 24 h %u -> %u bytes\n",
+           (unsigned)(MUESTRAS_10MIN * sizeof(float)), (unsigned)sizeof(AcumuladorMP),
+           (unsigned)((6 + 24) * sizeof(float)), (unsigned)(2 * sizeof(AcumuladorMP)));
+
+    printf(fallas == 0 ? "PASS\n" : "FAILED\n");
+    return fallas == 0 ? 0 : 1;
+}
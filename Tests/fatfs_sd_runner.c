@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <string.h>
+#include "stubs/sd_spi_sim.h"
+#include "stubs/diskio.h"
+#include "../APIs/Inc/fatfs_sd.h"
+
+SPI_HandleTypeDef hspi1 = {.id = 1};
+volatile uint8_t Timer1, Timer2;
+
+#include "../APIs/Src/fatfs_sd.c"
+
+static int fallas = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static uint8_t escrito[8 * 512];
+static uint8_t leido[8 * 512];
+
+static void patron(uint8_t * buff, size_t n, uint8_t semilla) {
+    for (size_t i = 0; i < n; i++) {
+        buff[i] = (uint8_t)(i * 7u + semilla);
+    }
+}
+
+static uint8_t trabajo[4 * 512];
+
+static void montar(void) {
+    sd_sim_reset();
+    Stat = STA_NOINIT;
+    CardType = 0;
+    hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_8; // Como MX_SPI1_Init()
+    memset(&velocidad, 0, sizeof(velocidad));
+    SD_disk_ioctl(0, SD_RESET_ESTADISTICAS, NULL);
+    CHECK(SD_disk_initialize(0) == 0, "inicialización");
+    CHECK(CardType == 6, "SDHC con direccionamiento por bloques");
+}
+
+static void test_integridad(void) {
+    montar();
+
+    patron(escrito, 512, 1);
+    CHECK(SD_disk_write(0, escrito, 3, 1) == RES_OK, "escritura de un sector");
+    CHECK(memcmp(sd_sim_sector(3), escrito, 512) == 0, "sector escrito en la tarjeta");
+    memset(leido, 0, sizeof(leido));
+    CHECK(SD_disk_read(0, leido, 3, 1) == RES_OK, "lectura de un sector");
+    CHECK(memcmp(leido, escrito, 512) == 0, "sector leído");
+
+    // CMD25: el token de fin no tiene respuesta de datos y antes devolvía siempre RES_ERROR
+    patron(escrito, sizeof(escrito), 9);
+    CHECK(SD_disk_write(0, escrito, 10, 8) == RES_OK, "escritura múltiple");
+    for (uint32_t s = 0; s < 8; s++) {
+        CHECK(memcmp(sd_sim_sector(10 + s), &escrito[s * 512], 512) == 0,
+              "sectores de la escritura múltiple");
+    }
+    memset(leido, 0, sizeof(leido));
+    CHECK(SD_disk_read(0, leido, 10, 8) == RES_OK, "lectura múltiple");
+    CHECK(memcmp(leido, escrito, sizeof(escrito)) == 0, "sectores de la lectura múltiple");
+
+    // La lectura múltiple termina con CMD12: la tarjeta tiene que seguir respondiendo
+    CHECK(SD_disk_read(0, leido, 3, 1) == RES_OK && leido[0] == 1, "comando después de CMD12");
+}
+
+static void test_llamadas_hal(void) {
+    montar();
+    patron(escrito, sizeof(escrito), 3);
+
+    sd_sim_reset_contadores();
+    CHECK(SD_disk_write(0, escrito, 20, 8) == RES_OK, "escritura múltiple");
+    uint32_t bloqueantes_escritura = sd_sim.llamadas_bloqueantes;
+    uint32_t dma_escritura = sd_sim.llamadas_dma;
+
+    sd_sim_reset_contadores();
+    CHECK(SD_disk_read(0, leido, 20, 8) == RES_OK, "lectura múltiple");
+    uint32_t bloqueantes_lectura = sd_sim.llamadas_bloqueantes;
+    uint32_t dma_lectura = sd_sim.llamadas_dma;
+
+    CHECK(dma_escritura == 8 && dma_lectura == 8, "una transferencia DMA por sector");
+    CHECK(sd_sim.consultas_estado == 0, "sin esperas activas en HAL_SPI_GetState");
+    // Antes: 512 llamadas + 512 consultas de estado por sector, más los comandos
+    CHECK(bloqueantes_escritura < 8 * 100 && bloqueantes_lectura < 8 * 20,
+          "llamadas de a un byte sólo para comandos, tokens y esperas");
+
+    printf("BENCH escritura 8 sectores: %u llamadas bloqueantes, %u DMA (antes >= %u + %u "
+           "consultas de estado)\n",
+           bloqueantes_escritura, dma_escritura, 8u * 512u, 8u * 512u);
+    printf("BENCH lectura 8 sectores: %u llamadas bloqueantes, %u DMA (antes >= %u + %u "
+           "consultas de estado)\n",
+           bloqueantes_lectura, dma_lectura, 8u * 512u, 8u * 512u);
+}
+
+static void test_estadisticas(void) {
+    SD_Estadisticas e;
+
+    montar();
+    patron(escrito, sizeof(escrito), 5);
+    SD_disk_write(0, escrito, 0, 8);
+    SD_disk_write(0, escrito, 8, 1);
+    SD_disk_read(0, leido, 0, 4);
+
+    CHECK(SD_disk_ioctl(0, SD_GET_ESTADISTICAS, &e) == RES_OK, "ioctl de estadísticas");
+    CHECK(e.sectores_escritos == 9 && e.sectores_leidos == 4, "sectores contados");
+    CHECK(e.bloques_dma == 13 && e.errores_dma == 0 && e.errores == 0, "bloques DMA");
+    CHECK(e.ms_escritura >= 4 && e.ms_lectura >= 2, "tiempo medido con HAL_GetTick");
+    printf("BENCH throughput: escritura %u KiB/s, lectura %u KiB/s (prescaler 8, 4 us/byte)\n",
+           (unsigned)(e.sectores_escritos * 512u / e.ms_escritura * 1000u / 1024u),
+           (unsigned)(e.sectores_leidos * 512u / e.ms_lectura * 1000u / 1024u));
+
+    CHECK(SD_disk_ioctl(0, SD_RESET_ESTADISTICAS, NULL) == RES_OK, "ioctl de reinicio");
+    SD_disk_ioctl(0, SD_GET_ESTADISTICAS, &e);
+    CHECK(e.sectores_escritos == 0 && e.ms_lectura == 0 && e.bloques_dma == 0,
+          "contadores en cero");
+}
+
+static void test_fallas_dma(void) {
+    SD_Estadisticas e;
+
+    montar();
+    patron(escrito, 512, 11);
+    SD_disk_write(0, escrito, 5, 1);
+
+    sd_sim_fallar_dma(SD_SIM_DMA_ERROR);
+    CHECK(SD_disk_read(0, leido, 5, 1) == RES_ERROR, "error de DMA en la lectura");
+    CHECK(SD_disk_read(0, leido, 5, 1) == RES_OK && memcmp(leido, escrito, 512) == 0,
+          "lectura después del error");
+
+    uint32_t antes = HAL_GetTick();
+    sd_sim_fallar_dma(SD_SIM_DMA_COLGADO);
+    CHECK(SD_disk_read(0, leido, 5, 1) == RES_ERROR, "DMA sin fin");
+    CHECK(HAL_GetTick() - antes >= SPI_TIMEOUT, "espera hasta SPI_TIMEOUT");
+    CHECK(SD_disk_read(0, leido, 5, 1) == RES_OK && memcmp(leido, escrito, 512) == 0,
+          "lectura después del aborto");
+
+    SD_disk_ioctl(0, SD_GET_ESTADISTICAS, &e);
+    CHECK(e.errores_dma == 2 && e.errores == 2, "errores contados");
+}
+
+static int negociar(uint32_t limite, DWORD sector, SD_Velocidad * v) {
+    montar();
+    sd_sim_limite_prescaler(limite);
+    patron(sd_sim_sector(sector), 512, 77);
+    memcpy(escrito, sd_sim_sector(sector), 512);
+
+    memset(v, 0, sizeof(*v));
+    v->buffer = trabajo;
+    v->sector = sector;
+    DRESULT res = SD_disk_ioctl(0, SD_NEGOCIAR_VELOCIDAD, v);
+    CHECK(memcmp(sd_sim_sector(sector), escrito, 512) == 0, "sector de prueba intacto");
+    return res == RES_OK;
+}
+
+static void test_negociacion(void) {
+    SD_Velocidad v, en_uso;
+
+    CHECK(negociar(SPI_BAUDRATEPRESCALER_2, 40, &v), "negociación sin límite");
+    CHECK(v.prescaler == SPI_BAUDRATEPRESCALER_2 && v.sck_hz == 8000000u, "prescaler 2: 8 MHz");
+    CHECK(v.pasos == 2 && v.fallas == 0, "dos pasos sobre el prescaler 8");
+    CHECK(hspi1.Init.BaudRatePrescaler == SPI_BAUDRATEPRESCALER_2, "SPI1 reconfigurado");
+
+    // El prescaler 2 daña un byte por bloque: el CRC lo detecta y queda el 4
+    CHECK(negociar(SPI_BAUDRATEPRESCALER_4, 40, &v), "negociación con límite 4");
+    CHECK(v.prescaler == SPI_BAUDRATEPRESCALER_4 && v.sck_hz == 4000000u, "prescaler 4: 4 MHz");
+    CHECK(v.pasos == 1 && v.fallas == 1 && sd_sim.bloques_corruptos > 0, "un paso descartado");
+    SD_disk_ioctl(0, SD_GET_VELOCIDAD, &en_uso);
+    CHECK(en_uso.prescaler == v.prescaler && en_uso.sck_hz == v.sck_hz && en_uso.fallas == 1,
+          "velocidad registrada");
+
+    // Ningún paso verifica: queda la velocidad del montaje; sector 0 usa el último de la tarjeta
+    montar();
+    sd_sim_limite_prescaler(SPI_BAUDRATEPRESCALER_8);
+    patron(sd_sim_sector((7584u << 10) - 1), 512, 5);
+    memcpy(escrito, sd_sim_sector((7584u << 10) - 1), 512);
+    v = (SD_Velocidad){.buffer = trabajo, .sector = 0};
+    CHECK(SD_disk_ioctl(0, SD_NEGOCIAR_VELOCIDAD, &v) == RES_OK, "negociación con límite 8");
+    CHECK(v.prescaler == SPI_BAUDRATEPRESCALER_8 && v.pasos == 0 && v.fallas == 1,
+          "sin pasos verificados");
+    CHECK(memcmp(sd_sim_sector((7584u << 10) - 1), escrito, 512) == 0, "último sector intacto");
+
+    // Errores en uso: baja de a un paso hasta la velocidad del montaje
+    negociar(SPI_BAUDRATEPRESCALER_2, 40, &v);
+    for (int i = 0; i < 3; i++) {
+        sd_sim_fallar_dma(SD_SIM_DMA_ERROR);
+        SD_disk_read(0, leido, 40, 1);
+    }
+    SD_disk_ioctl(0, SD_GET_VELOCIDAD, &en_uso);
+    CHECK(en_uso.prescaler == SPI_BAUDRATEPRESCALER_8 && en_uso.bajadas == 2,
+          "bajadas por errores");
+    CHECK(hspi1.Init.BaudRatePrescaler == SPI_BAUDRATEPRESCALER_8, "SPI1 en la velocidad segura");
+}
+
+static void test_benchmark(void) {
+    SD_Benchmark b = {.buffer = trabajo, .sectores_buffer = 4, .sector = 0, .sectores = 32};
+    SD_Velocidad v;
+
+    montar();
+    CHECK(SD_disk_ioctl(0, SD_BENCHMARK, &(SD_Benchmark){0}) == RES_PARERR, "sin buffer");
+    for (uint32_t s = 0; s < 32; s++) {
+        patron(sd_sim_sector(s), 512, (uint8_t)s);
+    }
+    memcpy(escrito, sd_sim_sector(0), 512);
+
+    CHECK(SD_disk_ioctl(0, SD_BENCHMARK, &b) == RES_OK, "benchmark a prescaler 8");
+    DWORD lectura_8 = b.kbs_lectura, escritura_8 = b.kbs_escritura;
+    CHECK(lectura_8 > 0 && escritura_8 > 0, "KB/s medidos");
+    CHECK(memcmp(sd_sim_sector(0), escrito, 512) == 0 && sd_sim_sector(31)[0] == 31,
+          "contenido reescrito igual");
+
+    v = (SD_Velocidad){.buffer = trabajo, .sector = 40};
+    SD_disk_ioctl(0, SD_NEGOCIAR_VELOCIDAD, &v);
+    CHECK(SD_disk_ioctl(0, SD_BENCHMARK, &b) == RES_OK, "benchmark a prescaler 2");
+    CHECK(b.kbs_lectura > 2 * lectura_8 && b.kbs_escritura > 2 * escritura_8,
+          "la velocidad negociada se nota en el throughput");
+
+    printf("BENCH secuencial prescaler 8 (2 MHz): lectura %u KB/s, escritura %u KB/s\n",
+           (unsigned)lectura_8, (unsigned)escritura_8);
+    printf("BENCH secuencial prescaler 2 (8 MHz): lectura %u KB/s, escritura %u KB/s\n",
+           (unsigned)b.kbs_lectura, (unsigned)b.kbs_escritura);
+
+    Stat = STA_NOINIT;
+    CHECK(SD_disk_ioctl(0, SD_BENCHMARK, &b) == RES_NOTRDY, "sin tarjeta inicializada");
+}
+
+static void test_ioctl(void) {
+    DWORD sectores = 0;
+    BYTE ocr[4] = {0};
+
+    montar();
+    CHECK(SD_disk_ioctl(0, GET_SECTOR_COUNT, &sectores) == RES_OK, "GET_SECTOR_COUNT");
+    CHECK(sectores == 7584u << 10, "capacidad del CSD");
+    CHECK(SD_disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK, "CTRL_SYNC");
+    // Antes caía en default y devolvía RES_PARERR
+    CHECK(SD_disk_ioctl(0, MMC_GET_OCR, ocr) == RES_OK && ocr[0] == 0xC0, "MMC_GET_OCR");
+}
+
+int main(void) {
+    test_integridad();
+    test_llamadas_hal();
+    test_estadisticas();
+    test_fallas_dma();
+    test_ioctl();
+    test_negociacion();
+    test_benchmark();
+
+    printf(fallas == 0 ? "PASS\n" : "FAILED\n");
+    return fallas == 0 ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "buffers_config.h"
+
+#include "../APIs/Src/punto_fijo.c"
+#include "../APIs/Src/formato_csv.c"
+#include "../APIs/Src/registro_raw.c"
+
+/*
+ * Compara format_csv_line() y build_iso8601_timestamp() con las versiones con snprintf que
+ * reemplazan, byte a byte y con buffers de cualquier largo, y mide el costo por línea.
+ */
+
+static int fallas = 0;
+static uint32_t semilla = 4242;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+/* === Versiones anteriores, con snprintf ===================================================== */
+
+static void iso8601_snprintf(char * buffer, size_t len, const ParticulateData * data) {
+    snprintf(buffer, len, "%04u-%02u-%02uT%02u:%02u:%02uZ", data->year, data->month, data->day,
+             data->hour, data->min, data->sec);
+}
+
+static bool linea_snprintf(const ParticulateData * data, char * csv_line, size_t max_len) {
+    char timestamp[32];
+    iso8601_snprintf(timestamp, sizeof(timestamp), data);
+
+    const ConcentracionesNumero * nc = &data->numero;
+    int written = snprintf(
+        csv_line, max_len,
+        "%s,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f\n", timestamp,
+        data->sensor_id, data->pm1_0, data->pm2_5, data->pm4_0, data->pm10, data->temp_amb,
+        data->hum_amb, data->temp_cam, data->hum_cam, nc->nc0_5, nc->nc1_0, nc->nc2_5, nc->nc4_0,
+        nc->nc10, nc->tamano_tipico);
+
+    return (written > 0 && (size_t)written < max_len);
+}
+
+/* === Datos ================================================================================== */
+
+static uint32_t aleatorio(void) {
+    semilla = semilla * 1103515245u + 12345u;
+    return semilla >> 8;
+}
+
+static float valor(float maximo) {
+    static const float especiales[] = {-0.0f, -0.04f, -0.05f, -1.0f, 0.05f, 0.25f, 6553.45f,
+                                       1e9f,  -3e38f, 3.4e38f, INFINITY, -INFINITY};
+    uint32_t r = aleatorio();
+
+    switch (r % 16) {
+    case 0:
+        return especiales[aleatorio() % (sizeof(especiales) / sizeof(especiales[0]))];
+    case 1:
+        return NAN;
+    case 2:
+        return (float)(aleatorio() % 40000u) * 0.25f - 5000.0f; // empates en la primera cifra
+    default:
+        return (float)(r % 1000000u) / 1000000.0f * maximo;
+    }
+}
+
+static void muestra(ParticulateData * d) {
+    memset(d, 0, sizeof(*d));
+    d->sensor_id = (uint8_t)(aleatorio() % 8 == 0 ? aleatorio() : 1 + aleatorio() % 4);
+    // Varias muestras seguidas con la misma fecha, y a veces una fecha fuera de rango
+    if (aleatorio() % 5 == 0) {
+        d->year = (uint16_t)(aleatorio() % 8 == 0 ? aleatorio() : 2025 + aleatorio() % 3);
+        d->month = (uint8_t)(aleatorio() % 8 == 0 ? aleatorio() : 1 + aleatorio() % 12);
+        d->day = (uint8_t)(1 + aleatorio() % 31);
+    } else {
+        d->year = 2026;
+        d->month = 10;
+        d->day = 17;
+    }
+    d->hour = (uint8_t)(aleatorio() % 16 == 0 ? aleatorio() : aleatorio() % 24);
+    d->min = (uint8_t)(aleatorio() % 60);
+    d->sec = (uint8_t)(aleatorio() % 60);
+    d->pm1_0 = valor(50.0f);
+    d->pm2_5 = valor(80.0f);
+    d->pm4_0 = valor(120.0f);
+    d->pm10 = valor(999.9f);
+    d->temp_amb = valor(45.0f) - 10.0f;
+    d->hum_amb = valor(100.0f);
+    d->temp_cam = valor(45.0f) - 10.0f;
+    d->hum_cam = valor(100.0f);
+    d->numero.nc0_5 = valor(3000.0f);
+    d->numero.nc1_0 = valor(3000.0f);
+    d->numero.nc2_5 = valor(3000.0f);
+    d->numero.nc4_0 = valor(3000.0f);
+    d->numero.nc10 = valor(3000.0f);
+    d->numero.tamano_tipico = (aleatorio() % 4 == 0) ? 0.0625f * (float)(1 + aleatorio() % 40)
+                                                       : valor(10.0f);
+}
+
+/* === Pruebas ================================================================================ */
+
+static void comparar_linea(const ParticulateData * d) {
+    char esperado[1024], obtenido[1024];
+    bool ok_esperado = linea_snprintf(d, esperado, sizeof(esperado));
+    bool ok_obtenido = format_csv_line(d, obtenido, sizeof(obtenido));
+
+    if (ok_esperado != ok_obtenido || strcmp(esperado, obtenido) != 0) {
+        printf("FAIL línea\n  esperado %s  obtenido %s", esperado, obtenido);
+        fallas++;
+        return;
+    }
+
+    // Con buffers cortos format_csv_line() falla justo donde snprintf truncaba
+    size_t largo = strlen(esperado);
+    for (size_t max_len = 0; max_len <= largo + 1; max_len++) {
+        if (linea_snprintf(d, esperado, max_len) != format_csv_line(d, obtenido, max_len)) {
+            printf("FAIL línea con max_len %zu\n", max_len);
+            fallas++;
+            return;
+        }
+    }
+}
+
+static void comparar_iso8601(const ParticulateData * d) {
+    for (size_t len = 0; len <= 32; len++) {
+        char esperado[40], obtenido[40];
+        memset(esperado, '#', sizeof(esperado));
+        memset(obtenido, '#', sizeof(obtenido));
+        iso8601_snprintf(esperado, len, d);
+        build_iso8601_timestamp(obtenido, len, d);
+        if (memcmp(esperado, obtenido, sizeof(esperado)) != 0) {
+            printf("FAIL iso8601 con len %zu: %.*s\n", len, (int)len, esperado);
+            fallas++;
+            return;
+        }
+    }
+}
+
+/* Campos de las líneas AVG de data_logger.c */
+static void probar_emisores(void) {
+    for (int i = 0; i < 100000; i++) {
+        char esperado[64], obtenido[64];
+        float x = valor(600.0f);
+        uint32_t n = aleatorio() >> (aleatorio() % 24);
+        uint8_t ancho = (uint8_t)(aleatorio() % 6);
+
+        snprintf(esperado, sizeof(esperado), "%.2f", (double)x);
+        formato_csv_decimal(obtenido, obtenido + sizeof(obtenido), x, 2);
+        CHECK(strcmp(esperado, obtenido) == 0, "decimal");
+
+        snprintf(esperado, sizeof(esperado), "%0*u", (int)ancho, (unsigned)n);
+        formato_csv_entero(obtenido, obtenido + sizeof(obtenido), n, ancho);
+        CHECK(strcmp(esperado, obtenido) == 0, "entero");
+    }
+
+    char linea[8];
+    char * p = formato_csv_texto(linea, linea + sizeof(linea), "avg10");
+    CHECK(p == linea + 5, "texto");
+    CHECK(formato_csv_texto(p, linea + sizeof(linea), "\r\n") == linea + 7, "texto al límite");
+    CHECK(formato_csv_caracter(linea + 7, linea + sizeof(linea), ',') == NULL, "sin lugar");
+    CHECK(formato_csv_entero(NULL, linea + sizeof(linea), 1, 1) == NULL, "NULL encadenado");
+}
+
+/* Los datos de Tests/test_format_csv.c, la prueba en el equipo */
+static void probar_ejemplo_del_equipo(void) {
+    ParticulateData d = {.year = 2025, .month = 5, .day = 21, .hour = 21, .min = 30, .sec = 0,
+                         .sensor_id = 1, .pm1_0 = 3.2, .pm2_5 = 5.6, .pm4_0 = 6.7, .pm10 = 7.2,
+                         .temp_amb = 23.4, .hum_amb = 42.1, .temp_cam = 24.8, .hum_cam = 46.7};
+    char linea[CSV_LINE_BUFFER_SIZE];
+
+    CHECK(format_csv_line(&d, linea, sizeof(linea)), "ejemplo");
+    CHECK(strcmp(linea, "2025-05-21T21:30:00Z,1,3.2,5.6,6.7,7.2,23.4,42.1,24.8,46.7,"
+                        "0.0,0.0,0.0,0.0,0.0,0.000\n") == 0,
+          "ejemplo de test_format_csv.c");
+    comparar_linea(&d);
+}
+
+static double segundos(clock_t desde) {
+    return (double)(clock() - desde) / CLOCKS_PER_SEC;
+}
+
+static void benchmark(void) {
+    enum { N = 256, VUELTAS = 400 };
+    static ParticulateData datos[N];
+    char linea[CSV_LINE_BUFFER_SIZE];
+    volatile size_t total = 0;
+
+    // Un día normal: misma fecha, valores en rango
+    for (int i = 0; i < N; i++) {
+        muestra(&datos[i]);
+        datos[i].year = 2026;
+        datos[i].month = 10;
+        datos[i].day = 17;
+        datos[i].hour = (uint8_t)(i % 24);
+        datos[i].sensor_id = (uint8_t)(1 + i % 4);
+        datos[i].pm1_0 = (float)(aleatorio() % 100000u) / 1000.0f;
+        datos[i].pm2_5 = (float)(aleatorio() % 100000u) / 1000.0f;
+        datos[i].pm4_0 = (float)(aleatorio() % 100000u) / 1000.0f;
+        datos[i].pm10 = (float)(aleatorio() % 100000u) / 1000.0f;
+    }
+
+    clock_t t = clock();
+    for (int v = 0; v < VUELTAS; v++) {
+        for (int i = 0; i < N; i++) {
+            linea_snprintf(&datos[i], linea, sizeof(linea));
+            total += (size_t)linea[20];
+        }
+    }
+    double con_snprintf = segundos(t);
+
+    t = clock();
+    for (int v = 0; v < VUELTAS; v++) {
+        for (int i = 0; i < N; i++) {
+            format_csv_line(&datos[i], linea, sizeof(linea));
+            total += (size_t)linea[20];
+        }
+    }
+    double con_emisores = segundos(t);
+
+    printf("Línea RAW: snprintf %.0f ns, format_csv_line %.0f ns (%.1fx)\n",
+           con_snprintf * 1e9 / (N * VUELTAS), con_emisores * 1e9 / (N * VUELTAS),
+           con_snprintf / con_emisores);
+    (void)total;
+}
+
+int main(void) {
+    probar_ejemplo_del_equipo();
+    probar_emisores();
+    for (int i = 0; i < 20000; i++) {
+        ParticulateData d;
+        muestra(&d);
+        comparar_linea(&d);
+        comparar_iso8601(&d);
+    }
+    benchmark();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,89 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/* uart_print propio: cuenta las llamadas en lugar del stub vacío de Tests/stubs/uart.h */
+#define UART_H
+void uart_print(const char * format, ...);
+
+/* Sin LOG_NIVEL_PRUEBA el módulo toma el umbral por defecto de log_config.h */
+#ifdef LOG_NIVEL_PRUEBA
+#define LOG_NIVEL_MODULO LOG_NIVEL_PRUEBA
+#endif
+#include "log.h"
+
+static int fallas = 0;
+static int llamadas = 0;
+static char ultimo[64];
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+void uart_print(const char * format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(ultimo, sizeof(ultimo), format, args);
+    va_end(args);
+    llamadas++;
+}
+
+/* Un mensaje por nivel con cadenas únicas: el test de Python las busca en el objeto compilado */
+static void mensajes_por_nivel(int * evaluados) {
+    LOG_ERROR("CADENA_NIVEL_ERROR %d\r\n", ++*evaluados);
+    LOG_WARN("CADENA_NIVEL_WARN %d\r\n", ++*evaluados);
+    LOG_INFO("CADENA_NIVEL_INFO %d\r\n", ++*evaluados);
+    LOG_DEBUG("CADENA_NIVEL_DEBUG %d\r\n", ++*evaluados);
+    LOG_TRACE("CADENA_NIVEL_TRACE %d\r\n", ++*evaluados);
+}
+
+static void test_umbral(void) {
+    int evaluados = 0;
+
+    llamadas = 0;
+    mensajes_por_nivel(&evaluados);
+    CHECK(llamadas == LOG_NIVEL_MODULO, "umbral: mensajes impresos");
+    CHECK(evaluados == LOG_NIVEL_MODULO, "umbral: argumentos evaluados solo si se imprime");
+
+    for (int nivel = LOG_NIVEL_ERROR; nivel <= LOG_NIVEL_TRACE; nivel++) {
+        CHECK(LOG_ACTIVO(nivel) == (nivel <= LOG_NIVEL_MODULO), "umbral: LOG_ACTIVO");
+    }
+}
+
+static void test_formato(void) {
+    llamadas = 0;
+    ultimo[0] = '\0';
+    LOG_ERROR("[ERROR] sensor %d: %s\r\n", 2, "timeout");
+#if LOG_ACTIVO(LOG_NIVEL_ERROR)
+    CHECK(llamadas == 1 && strcmp(ultimo, "[ERROR] sensor 2: timeout\r\n") == 0, "formato");
+#else
+    CHECK(llamadas == 0 && ultimo[0] == '\0', "formato: silenciado");
+#endif
+}
+
+static void test_sentencia_unica(void) {
+    /* Las macros se comportan como una sentencia: válidas en if/else sin llaves */
+    int rama = 0;
+    if (llamadas >= 0)
+        LOG_TRACE("rama %d\r\n", rama);
+    else
+        rama = 1;
+    CHECK(rama == 0, "sentencia unica");
+}
+
+int main(void) {
+    test_umbral();
+    test_formato();
+    test_sentencia_unica();
+
+    printf("NIVEL %d\n", LOG_NIVEL_MODULO);
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,192 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <stdint.h>
+
+/* Salida de depuración propia: captura los bytes en lugar del stub vacío de Tests/stubs/uart.h */
+#define UART_H
+void uart_print(const char * format, ...);
+void uart_write_bytes(const uint8_t * datos, uint16_t n);
+
+#define LOG_TOKENIZADO   1
+#define LOG_NIVEL_MODULO LOG_NIVEL_TRACE
+#include "log.h"
+#include "../APIs/Src/log_token.c"
+
+#define MSG_PM_FORMAT_WITH_TIME                                                                    \
+    "[%s] SPS30 ID:%d | PM1.0: %.2f | PM2.5: %.2f | PM4.0: %.2f | PM10: %.2f | "                   \
+    "ug/m3\n"
+#define MSG_ERROR_FALLO "**ERROR[SPS30_FAIL][%s] Sensor ID:%d sin respuesta tras 3 intentos\n"
+#define MSG_AVG10       "[AVG10] PM2.5 = %.2f ug/m3 (%u muestras)\r\n"
+
+static int fallas = 0;
+static uint8_t captura[4096];
+static size_t capturados = 0;
+static int capturar = 1;
+static char esperado[4096];
+static size_t esperados = 0;
+static volatile uint32_t sumidero;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+void uart_write_bytes(const uint8_t * datos, uint16_t n) {
+    sumidero += n;
+    if (capturar && capturados + n <= sizeof(captura)) {
+        memcpy(&captura[capturados], datos, n);
+        capturados += n;
+    }
+}
+
+/* Igual que uart_print() de APIs/Src/uart.c */
+void uart_print(const char * format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (len > 0) {
+        uart_write_bytes((const uint8_t *)buffer, (uint16_t)len);
+    }
+}
+
+/* Texto que debería reconstruir el decodificador (los reales viajan con precisión simple) */
+static void esperar(const char * format, ...) {
+    va_list args;
+    va_start(args, format);
+    esperados += vsnprintf(&esperado[esperados], sizeof(esperado) - esperados, format, args);
+    va_end(args);
+}
+
+static void emitir_mensajes(void) {
+    const char * fecha = "2026-10-16 12:34:56";
+    float pm[4] = {3.25f, 7.5f, 9.125f, 11.0f};
+
+    LOG_INFO(MSG_PM_FORMAT_WITH_TIME, fecha, 2, pm[0], pm[1], pm[2], pm[3]);
+    esperar(MSG_PM_FORMAT_WITH_TIME, fecha, 2, pm[0], pm[1], pm[2], pm[3]);
+
+    uint8_t muestras = 60;
+    double promedio = 12.3456; // Como un double: se envía como float
+    LOG_INFO(MSG_AVG10, promedio, muestras);
+    esperar(MSG_AVG10, (double)(float)promedio, muestras);
+
+    LOG_WARN("[WARN] SPS30 ID %d: %s tras %d intentos\r\n", 3, "timeout", 3);
+    esperar("[WARN] SPS30 ID %d: %s tras %d intentos\r\n", 3, "timeout", 3);
+
+    LOG_ERROR(MSG_ERROR_FALLO, fecha, 1);
+    esperar(MSG_ERROR_FALLO, fecha, 1);
+
+    /* Texto directo intercalado: el decodificador lo deja pasar */
+    uart_print("Resumen: %u/%u muestras\n", 5u, 360u);
+    esperar("Resumen: %u/%u muestras\n", 5u, 360u);
+
+    LOG_DEBUG("[MEF] Transicion: %d -> %d (%ld, 0x%08X, %c)\r\n", -1, 70000, -2147483647L - 1,
+              0xDEADBEEFu, 'Z');
+    esperar("[MEF] Transicion: %d -> %d (%ld, 0x%08X, %c)\r\n", -1, 70000, -2147483647L - 1,
+            0xDEADBEEFu, 'Z');
+
+    LOG_INFO("[OK] microSD montada correctamente (100%%)\r\n");
+    esperar("[OK] microSD montada correctamente (100%%)\r\n");
+
+    char ruta[48] = "/2026/10/16/RAW_01_20261016.CSV";
+    LOG_TRACE("%-8s|%5.1f|%s\r\n", "RAW", -0.25f, ruta);
+    esperar("%-8s|%5.1f|%s\r\n", "RAW", -0.25, ruta);
+
+    /* Cadenas largas: cada una se corta en LOG_TOKEN_CADENA_MAX y el registro en su máximo */
+    const char * larga = "0123456789abcdefghijklmnopqrstuvwxyzABCD";
+    LOG_DEBUG("%s|%s|%s\r\n", larga, larga, larga);
+    esperar("%.*s|?|?\r\n", LOG_TOKEN_CADENA_MAX, larga);
+}
+
+static void test_registro(void) {
+    capturados = 0;
+    LOG_INFO(MSG_AVG10, 1.0f, 60);
+
+    /* Marca, largo, id, float de 4 bytes, varint zigzag de 60 (120 < 128: un byte), fin */
+    CHECK(capturados == 4 + 5 + 1, "registro: largo");
+    CHECK(captura[0] == LOG_TOKEN_MARCA && captura[1] == 5, "registro: cabecera");
+    CHECK(captura[8] == 120 && captura[9] == LOG_TOKEN_FIN, "registro: entero y fin");
+}
+
+static double segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void bench(void) {
+    const int iteraciones = 200000;
+    const char * fecha = "2026-10-16 12:34:56";
+    volatile float pm = 12.34f;
+    char texto[256];
+
+    capturar = 0;
+    double t0 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        uart_print(MSG_PM_FORMAT_WITH_TIME, fecha, 2, pm, pm, pm, pm);
+    }
+    double t1 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        LOG_INFO(MSG_PM_FORMAT_WITH_TIME, fecha, 2, pm, pm, pm, pm);
+    }
+    double t2 = segundos();
+    capturar = 1;
+
+    int bytes_texto = snprintf(texto, sizeof(texto), MSG_PM_FORMAT_WITH_TIME, fecha, 2, pm, pm,
+                               pm, pm);
+    capturados = 0;
+    LOG_INFO(MSG_PM_FORMAT_WITH_TIME, fecha, 2, pm, pm, pm, pm);
+    size_t bytes_pm = capturados;
+
+    int bytes_avg = snprintf(texto, sizeof(texto), MSG_AVG10, pm, 60);
+    capturados = 0;
+    LOG_INFO(MSG_AVG10, pm, 60);
+    size_t bytes_avg_reg = capturados;
+
+    double ns_texto = (t1 - t0) * 1e9 / iteraciones;
+    double ns_token = (t2 - t1) * 1e9 / iteraciones;
+    printf("BENCH PM (4 floats + fecha): texto %d bytes %.0f ns, registro %zu bytes %.0f ns\n",
+           bytes_texto, ns_texto, bytes_pm, ns_token);
+    printf("BENCH AVG10: texto %d bytes, registro %zu bytes\n", bytes_avg, bytes_avg_reg);
+    CHECK(bytes_pm * 2 < (size_t)bytes_texto && bytes_avg_reg * 4 < (size_t)bytes_avg,
+          "bench: bytes");
+    /* El tiempo de pared depende de la carga de la máquina: se informa, no se verifica */
+    if (ns_token >= ns_texto) {
+        printf("BENCH aviso: el registro no fue mas barato que el texto en esta corrida\n");
+    }
+}
+
+static int guardar(const char * ruta, const void * datos, size_t n) {
+    FILE * f = fopen(ruta, "wb");
+    if (f == NULL) {
+        return 0;
+    }
+    size_t escritos = fwrite(datos, 1, n, f);
+    fclose(f);
+    return escritos == n;
+}
+
+int main(int argc, char ** argv) {
+    test_registro();
+
+    capturados = 0;
+    emitir_mensajes();
+    if (argc >= 3) {
+        CHECK(guardar(argv[1], captura, capturados), "guardar captura");
+        CHECK(guardar(argv[2], esperado, esperados), "guardar esperado");
+    }
+
+    bench();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
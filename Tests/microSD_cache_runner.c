@@ -0,0 +1,354 @@
+#include <stdio.h>
+#include <string.h>
+#include "fatfs_sim.h"
+#include "uart.h"                         /* Doble vacío, antes que el de APIs/Inc */
+#include "../APIs/Inc/microSD_utils.h"   /* El de Tests/stubs no declara print_fatfs_error */
+#include "../APIs/Src/microSD_cache.c"
+#include "../APIs/Src/microSD_utils.c"
+
+#define DIA        "/2026/10/16"
+#define ENCABEZADO "# encabezado\n"
+
+static int fallas = 0;
+static uint32_t tick_ms = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+uint32_t HAL_GetTick(void) {
+    return tick_ms;
+}
+
+void HAL_Delay(uint32_t ms) {
+    tick_ms += ms;
+}
+
+static void preparar_tarjeta(void) {
+    microSD_cache_cerrar_todos();
+    fatfs_sim_reset();
+    f_mkdir("/2026");
+    f_mkdir("/2026/10");
+    f_mkdir(DIA);
+    fatfs_sim_reset_contadores();
+    tick_ms = 0;
+}
+
+/* Línea RAW como la de format_csv_line(): ~110 bytes */
+static int linea_raw(char * buf, size_t len, int sensor, int k) {
+    return snprintf(buf, len,
+                    "2026-10-16T%02d:%02d:%02dZ,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,"
+                    "%.1f,%.1f,%.1f,%.1f,%.1f,%.2f\n",
+                    (k / 720) % 24, (k / 12) % 60, (k * 5) % 60, sensor, 3.1 + k % 7, 7.5 + k % 5,
+                    9.2, 11.0, 22.4, 51.0, 25.1, 40.2, 20.1 + k % 3, 23.5, 24.0, 24.1, 24.2, 0.55);
+}
+
+static bool contenido_igual(const char * ruta, const char * esperado, size_t n) {
+    uint32_t largo;
+    const uint8_t * datos = fatfs_sim_contenido(ruta, &largo);
+    return datos != NULL && largo == n && memcmp(datos, esperado, n) == 0;
+}
+
+static void test_contenido(void) {
+    static char esperado[3][64 * 1024];
+    size_t n[3] = {0};
+    char ruta[3][64];
+    char linea[160];
+
+    preparar_tarjeta();
+    for (int s = 0; s < 3; s++) {
+        snprintf(ruta[s], sizeof(ruta[s]), DIA "/RAW_%02d_20261016.CSV", s + 1);
+        n[s] = (size_t)snprintf(esperado[s], sizeof(esperado[s]), "%s", ENCABEZADO);
+    }
+    for (int k = 0; k < 300; k++) {
+        for (int s = 0; s < 3; s++) {
+            int largo = linea_raw(linea, sizeof(linea), s + 1, k);
+            CHECK(microSD_cache_agregar_linea(ruta[s], linea, ENCABEZADO) == FR_OK,
+                  "contenido: agregar");
+            memcpy(&esperado[s][n[s]], linea, (size_t)largo);
+            n[s] += (size_t)largo;
+        }
+    }
+    CHECK(fatfs_sim.f_open == 3, "contenido: un f_open por archivo");
+
+    /* Línea más larga que el buffer: se escribe directamente, en orden */
+    char larga[MICROSD_CACHE_BUFFER + 100];
+    memset(larga, 'x', sizeof(larga) - 2);
+    larga[sizeof(larga) - 2] = '\n';
+    larga[sizeof(larga) - 1] = '\0';
+    CHECK(microSD_cache_agregar_linea(ruta[0], "corta\n", NULL) == FR_OK, "contenido: corta");
+    CHECK(microSD_cache_agregar_linea(ruta[0], larga, NULL) == FR_OK, "contenido: larga");
+    n[0] += (size_t)sprintf(&esperado[0][n[0]], "corta\n%s", larga);
+
+    CHECK(microSD_cache_cerrar_todos() == FR_OK, "contenido: cerrar");
+    CHECK(fatfs_sim_abiertos() == 0, "contenido: todo cerrado");
+    for (int s = 0; s < 3; s++) {
+        CHECK(contenido_igual(ruta[s], esperado[s], n[s]), "contenido: bytes");
+        CHECK(fatfs_sim_tamano_directorio(ruta[s]) == n[s], "contenido: tamaño en directorio");
+    }
+
+    /* Al reabrir un archivo existente no se repite el encabezado */
+    CHECK(microSD_cache_agregar_linea(ruta[1], "mas\n", ENCABEZADO) == FR_OK, "reabrir");
+    microSD_cache_cerrar_todos();
+    memcpy(&esperado[1][n[1]], "mas\n", 4);
+    CHECK(contenido_igual(ruta[1], esperado[1], n[1] + 4), "reabrir: sin encabezado");
+}
+
+/* Registros binarios (con bytes en cero) detrás de un encabezado de un sector */
+static void test_binario(void) {
+    const char * ruta = DIA "/RAW_01_20261016.BIN";
+    static uint8_t esperado[512 + 100 * 32];
+    uint8_t registro[32];
+
+    preparar_tarjeta();
+    memset(esperado, 0, 512);
+    memcpy(esperado, "SPS30RAW", 8);
+    for (int k = 0; k < 100; k++) {
+        for (int i = 0; i < 32; i++) {
+            registro[i] = (uint8_t)((i % 3 == 0) ? 0 : k + i);
+        }
+        CHECK(microSD_cache_agregar(ruta, registro, sizeof(registro), esperado, 512) == FR_OK,
+              "binario: agregar");
+        memcpy(&esperado[512 + k * 32], registro, sizeof(registro));
+    }
+    CHECK(fatfs_sim.f_write_sin_alinear == 0, "binario: sólo sectores completos");
+    CHECK(microSD_cache_cerrar_todos() == FR_OK, "binario: cerrar");
+    CHECK(contenido_igual(ruta, (const char *)esperado, sizeof(esperado)), "binario: bytes");
+}
+
+static void test_volcado_por_sectores(void) {
+    const char * ruta = DIA "/RAW_01_20261016.CSV";
+    char linea[160];
+    size_t total = strlen(ENCABEZADO);
+    int k = 0;
+
+    preparar_tarjeta();
+    microSD_cache_agregar_linea(ruta, "", ENCABEZADO);
+    while (total + (size_t)linea_raw(linea, sizeof(linea), 1, k) < MICROSD_CACHE_BUFFER) {
+        total += strlen(linea);
+        microSD_cache_agregar_linea(ruta, linea, ENCABEZADO);
+        k++;
+    }
+    CHECK(fatfs_sim.f_write == 0, "sectores: nada escrito con el buffer sin llenar");
+
+    /* La línea que llena el buffer escribe sólo sectores completos y sincroniza */
+    total += strlen(linea);
+    microSD_cache_agregar_linea(ruta, linea, ENCABEZADO);
+    uint32_t largo;
+    fatfs_sim_contenido(ruta, &largo);
+    CHECK(fatfs_sim.f_write == 1 && fatfs_sim.f_sync == 1, "sectores: un f_write y un f_sync");
+    CHECK(largo == (total / _MAX_SS) * _MAX_SS, "sectores: hasta el último límite de sector");
+    CHECK(fatfs_sim_tamano_directorio(ruta) == largo, "sectores: persistido");
+    CHECK(fatfs_sim.f_write_sin_alinear == 0, "sectores: termina en límite de sector");
+    CHECK(fatfs_sim.escrituras_multibloque == 1, "sectores: una escritura multibloque");
+
+    /* El resto parcial sigue en RAM y se escribe al cerrar */
+    microSD_cache_cerrar_todos();
+    fatfs_sim_contenido(ruta, &largo);
+    CHECK(largo == total, "sectores: resto escrito al cerrar");
+}
+
+static void test_sync_por_tiempo(void) {
+    const char * ruta = DIA "/AVG10_20261016.CSV";
+
+    preparar_tarjeta();
+    tick_ms = 1000;
+    microSD_cache_agregar_linea(ruta, "2026-10-16 12:00:00,10.0\n", ENCABEZADO);
+    tick_ms += MICROSD_CACHE_SYNC_MS - 1;
+    microSD_cache_agregar_linea(ruta, "2026-10-16 12:10:00,11.0\n", ENCABEZADO);
+    microSD_cache_procesar();
+    CHECK(fatfs_sim.f_sync == 0, "tiempo: sin sync antes de T");
+
+    tick_ms += 1; // La primera línea cumple T
+    microSD_cache_procesar();
+    microSD_cache_procesar();
+    CHECK(fatfs_sim.f_sync == 1, "tiempo: un sync al cumplir T");
+    CHECK(fatfs_sim_tamano_directorio(ruta) == strlen(ENCABEZADO) + 2 * 25, "tiempo: persistido");
+    CHECK(microSD_cache_abierto(ruta), "tiempo: sigue abierto");
+}
+
+static void test_reemplazo(void) {
+    char ruta[MICROSD_CACHE_ARCHIVOS + 1][64];
+
+    preparar_tarjeta();
+    for (int i = 0; i <= MICROSD_CACHE_ARCHIVOS; i++) {
+        snprintf(ruta[i], sizeof(ruta[i]), DIA "/F%d.CSV", i);
+        if (i == MICROSD_CACHE_ARCHIVOS) {
+            microSD_cache_agregar_linea(ruta[0], "uso\n", NULL); // El 1 pasa a ser el más viejo
+        }
+        microSD_cache_agregar_linea(ruta[i], "linea\n", NULL);
+    }
+    CHECK(fatfs_sim_abiertos() == MICROSD_CACHE_ARCHIVOS, "reemplazo: tabla llena");
+    CHECK(microSD_cache_abierto(ruta[0]) && !microSD_cache_abierto(ruta[1]), "reemplazo: LRU");
+    CHECK(fatfs_sim_tamano_directorio(ruta[1]) == 6, "reemplazo: cerrado con sus datos");
+}
+
+static void test_errores(void) {
+    const char * ruta = DIA "/RAW_01_20261016.CSV";
+    char ruta_larga[MICROSD_CACHE_RUTA_MAX + 8];
+
+    preparar_tarjeta();
+    memset(ruta_larga, 'a', sizeof(ruta_larga) - 1);
+    ruta_larga[sizeof(ruta_larga) - 1] = '\0';
+    CHECK(microSD_cache_agregar_linea(ruta_larga, "x\n", NULL) == FR_INVALID_NAME, "ruta larga");
+    CHECK(microSD_cache_agregar_linea("/NO/EXISTE.CSV", "x\n", NULL) == FR_NO_PATH, "sin ruta");
+    CHECK(fatfs_sim_abiertos() == 0, "sin ruta: nada abierto");
+
+    /* Falla al vaciar el buffer: se informa, se cierra y la próxima línea lo reabre */
+    char linea[200];
+    memset(linea, 'b', sizeof(linea) - 2);
+    linea[sizeof(linea) - 2] = '\n';
+    linea[sizeof(linea) - 1] = '\0';
+    for (int k = 0; k < MICROSD_CACHE_BUFFER / 199; k++) {
+        microSD_cache_agregar_linea(ruta, linea, NULL);
+    }
+    fatfs_sim_fallar_escritura(FR_DISK_ERR);
+    CHECK(microSD_cache_agregar_linea(ruta, linea, NULL) == FR_DISK_ERR, "error: informado");
+    CHECK(!microSD_cache_abierto(ruta) && fatfs_sim_abiertos() == 0, "error: cerrado");
+    CHECK(microSD_cache_agregar_linea(ruta, "ok\n", NULL) == FR_OK, "error: reabre");
+    CHECK(microSD_appendLineAbsolute(ruta, "ok\n"), "error: appendLineAbsolute");
+
+    fatfs_sim_fallar_sync(FR_DISK_ERR);
+    CHECK(microSD_cache_sincronizar() == FR_DISK_ERR, "sync: informado");
+    CHECK(!microSD_cache_abierto(ruta), "sync: cerrado");
+}
+
+/* Tres sensores por ciclo, como data_logger_store_raw(): sólo el cambio de fecha toca la tarjeta */
+static void test_directorios(void) {
+    char ruta[64];
+
+    preparar_tarjeta();
+    microSD_cache_cerrar_todos(); // Tarjeta recién montada: la fecha no está en caché
+    for (int k = 0; k < 1000; k++) {
+        for (int s = 1; s <= 3; s++) {
+            CHECK(microSD_cache_directorio_dia(2026, 10, 16) == FR_OK, "directorios: día");
+        }
+    }
+    CHECK(fatfs_sim.f_mkdir == 3 && fatfs_sim.f_stat == 0, "directorios: tres f_mkdir en total");
+
+    /* Cambio de día, de mes y de año: sólo los niveles nuevos */
+    fatfs_sim_reset_contadores();
+    CHECK(microSD_cache_directorio_dia(2026, 10, 17) == FR_OK, "directorios: día nuevo");
+    CHECK(fatfs_sim.f_mkdir == 1, "directorios: un nivel");
+    CHECK(microSD_cache_directorio_dia(2026, 11, 1) == FR_OK, "directorios: mes nuevo");
+    CHECK(fatfs_sim.f_mkdir == 3, "directorios: dos niveles");
+    CHECK(microSD_cache_directorio_dia(2027, 1, 1) == FR_OK, "directorios: año nuevo");
+    CHECK(fatfs_sim.f_mkdir == 6, "directorios: tres niveles");
+    CHECK(fatfs_sim_existe_directorio("/2027/01/01"), "directorios: creados");
+    microSD_cache_directorio_dia(2027, 1, 1);
+    CHECK(fatfs_sim.f_mkdir == 6, "directorios: sin acceso");
+
+    /* Tarjeta cambiada sin desmontar: el f_open falla y la fecha se vuelve a verificar */
+    fatfs_sim_reset();
+    snprintf(ruta, sizeof(ruta), "/2027/01/01/RAW_01_20270101.BIN");
+    CHECK(microSD_cache_agregar_linea(ruta, "x\n", NULL) == FR_NO_PATH, "directorios: sin ruta");
+    CHECK(microSD_cache_directorio_dia(2027, 1, 1) == FR_OK && fatfs_sim.f_mkdir == 3,
+          "directorios: recreados");
+    CHECK(microSD_cache_agregar_linea(ruta, "x\n", NULL) == FR_OK, "directorios: escribe");
+    microSD_cache_cerrar_todos();
+}
+
+/* Secuencia anterior de data_logger_store_raw(): las tres carpetas de la fecha, abrir para revisar
+ * el encabezado, cerrar, y microSD_appendLineAbsolute() con abrir, posicionar, escribir y cerrar */
+static void agregar_por_linea(const char * ruta, const char * linea) {
+    FIL f;
+    UINT bw;
+
+    f_mkdir("/2026");
+    f_mkdir("/2026/10");
+    f_mkdir(DIA);
+    f_open(&f, ruta, FA_OPEN_ALWAYS | FA_WRITE);
+    if (f_size(&f) == 0) {
+        f_write(&f, ENCABEZADO, strlen(ENCABEZADO), &bw);
+    }
+    f_close(&f);
+
+    f_open(&f, ruta, FA_OPEN_ALWAYS | FA_WRITE);
+    f_lseek(&f, f_size(&f));
+    f_write(&f, linea, strlen(linea), &bw);
+    f_close(&f);
+}
+
+/* Ciclos de 5 s: una línea por sensor y un promedio cada 10 min */
+static FatfsSim_Contadores registrar(int ciclos, bool con_cache) {
+    char ruta[3][64];
+    char linea[160];
+    const char * avg = DIA "/AVG10_20261016.CSV";
+
+    preparar_tarjeta();
+    for (int s = 0; s < 3; s++) {
+        snprintf(ruta[s], sizeof(ruta[s]), DIA "/RAW_%02d_20261016.CSV", s + 1);
+    }
+    for (int k = 0; k < ciclos; k++) {
+        for (int s = 0; s < 3; s++) {
+            linea_raw(linea, sizeof(linea), s + 1, k);
+            if (con_cache) {
+                microSD_cache_directorio_dia(2026, 10, 16);
+                microSD_cache_agregar_linea(ruta[s], linea, ENCABEZADO);
+            } else {
+                agregar_por_linea(ruta[s], linea);
+            }
+        }
+        if (k % 120 == 119) {
+            const char * l = "2026-10-16 12:10:00,12.34,10.00,15.00,1.23,120\r\n";
+            if (con_cache) {
+                microSD_cache_directorio_dia(2026, 10, 16);
+                microSD_cache_agregar_linea(avg, l, ENCABEZADO);
+            } else {
+                agregar_por_linea(avg, l);
+            }
+        }
+        tick_ms += 5000;
+        microSD_cache_procesar();
+    }
+    microSD_cache_cerrar_todos();
+    return fatfs_sim;
+}
+
+static void imprimir(const char * nombre, const FatfsSim_Contadores * c, int muestras) {
+    printf("BENCH %-9s cada 1000 muestras: f_mkdir+f_stat %4u f_open %4u f_write %4u "
+           "f_sync+f_close %4u, sectores leídos %5u escritos %4u (%u disk_write, %u multibloque)\n",
+           nombre, (c->f_mkdir + c->f_stat) * 1000 / muestras, c->f_open * 1000 / muestras,
+           c->f_write * 1000 / muestras,
+           (c->f_sync + c->f_close) * 1000 / muestras, c->sectores_leidos * 1000 / muestras,
+           c->sectores_escritos * 1000 / muestras, c->escrituras_disco * 1000 / muestras,
+           c->escrituras_multibloque * 1000 / muestras);
+}
+
+static void bench(void) {
+    const int ciclos = 1000;
+    const int muestras = 3 * ciclos;
+    FatfsSim_Contadores antes = registrar(ciclos, false);
+    FatfsSim_Contadores despues = registrar(ciclos, true);
+
+    imprimir("por línea", &antes, muestras);
+    imprimir("con caché", &despues, muestras);
+
+    CHECK(despues.f_mkdir <= 3 && despues.f_stat == 0, "bench: directorios");
+    CHECK(despues.f_open <= 4, "bench: f_open");
+    CHECK(despues.f_write * 10 < antes.f_write, "bench: f_write");
+    CHECK(despues.sectores_escritos * 8 < antes.sectores_escritos, "bench: sectores escritos");
+    CHECK(despues.sectores_leidos * 20 < antes.sectores_leidos, "bench: sectores leídos");
+    CHECK(despues.escrituras_multibloque * 2 > despues.f_write, "bench: escrituras multibloque");
+}
+
+int main(void) {
+    test_contenido();
+    test_binario();
+    test_volcado_por_sectores();
+    test_sync_por_tiempo();
+    test_reemplazo();
+    test_errores();
+    test_directorios();
+    bench();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
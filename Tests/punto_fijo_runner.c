@@ -0,0 +1,133 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../APIs/Src/punto_fijo.c"
+
+/*
+ * Compara punto_fijo_escribir() con snprintf("%.Nf") y mide el tiempo de las dos conversiones.
+ */
+
+static int fallas = 0;
+static uint32_t semilla = 2026;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static uint32_t aleatorio(void) {
+    semilla = semilla * 1103515245u + 12345u;
+    return semilla >> 8;
+}
+
+static float float_desde_bits(uint32_t bits) {
+    float x;
+    memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+/* PM2.5 con tres decimales como los entrega el SPS30 */
+static float muestra(float base) {
+    return base + (float)(aleatorio() % 100000u) / 1000.0f;
+}
+
+static void comparar_texto(float x) {
+    for (uint8_t d = 0; d <= PUNTO_FIJO_DECIMALES_MAX; d++) {
+        char esperado[64], obtenido[PUNTO_FIJO_TEXTO_MAX];
+        int32_t valor;
+
+        snprintf(esperado, sizeof(esperado), "%.*f", (int)d, (double)x);
+        if (!punto_fijo_desde_float(x, d, &valor)) {
+            continue; // fuera del rango de un int32: formato_csv usa snprintf
+        }
+        size_t largo = punto_fijo_escribir(obtenido, x, d);
+        if (largo != strlen(esperado) || strcmp(esperado, obtenido) != 0) {
+            printf("FAIL texto %a con %u decimales: \"%s\" != \"%s\"\n", (double)x, d, obtenido,
+                   esperado);
+            fallas++;
+        }
+    }
+}
+
+static void probar_texto(void) {
+    static const float fijos[] = {0.0f,    -0.0f,    0.005f,   0.015f,  0.125f,  0.375f,  2.5f,
+                                  -2.5f,   -0.001f,  -0.004f,  499.995f, 500.0f, -999.0f, -777.0f,
+                                  -666.0f, 1e-30f,   -1e-30f,  1e-45f,   65535.0f, 21474836.0f};
+    char texto[PUNTO_FIJO_TEXTO_MAX];
+
+    for (size_t i = 0; i < sizeof(fijos) / sizeof(fijos[0]); i++) {
+        comparar_texto(fijos[i]);
+    }
+    // Empates exactos k/8 y k/16: el redondeo al par es el que decide
+    for (int k = -4000; k <= 4000; k++) {
+        comparar_texto((float)k / 8.0f);
+        comparar_texto((float)k / 16.0f);
+    }
+    // Concentraciones con tres decimales, como las del SPS30
+    for (int k = 0; k <= 1000000; k += 7) {
+        comparar_texto((float)k / 1000.0f);
+    }
+    // Bits al azar con exponentes del rango útil
+    for (int i = 0; i < 200000; i++) {
+        uint32_t bits = aleatorio() ^ (aleatorio() << 24);
+        uint32_t exponente = 100u + aleatorio() % 60u; // 2^-27 .. 2^32
+        bits = (bits & 0x807FFFFFu) | (exponente << 23);
+        comparar_texto(float_desde_bits(bits));
+    }
+
+    int32_t valor;
+    CHECK(!punto_fijo_desde_float(NAN, 2, &valor), "NaN");
+    CHECK(!punto_fijo_desde_float(INFINITY, 2, &valor), "infinito");
+    CHECK(!punto_fijo_desde_float(3e7f, 2, &valor), "fuera de rango");
+    CHECK(!punto_fijo_desde_float(1.0f, PUNTO_FIJO_DECIMALES_MAX + 1, &valor), "decimales");
+
+    punto_fijo_formatear(texto, -5, 2);
+    CHECK(strcmp(texto, "-0.05") == 0, "formatear -0.05");
+    punto_fijo_formatear(texto, INT32_MIN, 3);
+    CHECK(strcmp(texto, "-2147483.648") == 0, "formatear INT32_MIN");
+    CHECK(punto_fijo_formatear(texto, 123456, 0) == 6 && strcmp(texto, "123456") == 0,
+          "formatear sin decimales");
+}
+
+static void benchmark(void) {
+    enum { N = 1 << 16, VUELTAS = 4 };
+    static float datos[N];
+    char texto[64];
+    volatile size_t largo = 0;
+
+    for (int i = 0; i < N; i++) {
+        datos[i] = muestra(0.0f);
+    }
+    clock_t t = clock();
+    for (int i = 0; i < N * VUELTAS; i++) {
+        largo += (size_t)snprintf(texto, sizeof(texto), "%.2f", (double)datos[i % N]);
+    }
+    double con_printf = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+    t = clock();
+    for (int i = 0; i < N * VUELTAS; i++) {
+        largo += punto_fijo_escribir(texto, datos[i % N], PUNTO_FIJO_DECIMALES_MP);
+    }
+    double entero = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+    printf("BENCH texto: snprintf %.1f ns/valor, punto_fijo_escribir %.1f ns/valor\n",
+           con_printf * 1e9 / ((double)N * VUELTAS), entero * 1e9 / ((double)N * VUELTAS));
+    (void)largo;
+}
+
+int main(void) {
+    probar_texto();
+    benchmark();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,180 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../APIs/Src/punto_fijo.c"
+#include "../APIs/Src/formato_csv.c"
+#include "../APIs/Src/registro_raw.c"
+
+/*
+ * Escribe en la carpeta indicada pares RAW_xx.BIN / RAW_xx.esperado: el archivo binario y el CSV
+ * que escribía el equipo con las mismas muestras. test_registro_raw.py los compara con la salida
+ * de tools/raw_bin_a_csv.py.
+ */
+
+static int fallas = 0;
+static uint32_t semilla = 12345;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static uint32_t aleatorio(void) {
+    semilla = semilla * 1103515245u + 12345u;
+    return semilla >> 8;
+}
+
+/* Valores con decimales arbitrarios, y a veces un empate exacto (x.x5 representable) */
+static float valor(float maximo) {
+    uint32_t r = aleatorio();
+    if (r % 4 == 0) {
+        return (float)(r % (uint32_t)(maximo * 4)) * 0.25f; // k/4: empates en la primera cifra
+    }
+    return (float)(r % 1000000u) / 1000000.0f * maximo;
+}
+
+static float temperatura(void) {
+    uint32_t r = aleatorio() % 8;
+    static const float especiales[] = {-100.0f, -99.9f, -0.04f, -0.0f, -5.35f, -0.05f};
+    if (r < 6) {
+        return (aleatorio() % 2) ? especiales[r] : valor(45.0f) - 10.0f;
+    }
+    return valor(45.0f);
+}
+
+static float humedad(void) {
+    return (aleatorio() % 10 == 0) ? -1.0f : valor(100.0f);
+}
+
+static void muestra(ParticulateData * d, uint8_t sensor_id, int i) {
+    memset(d, 0, sizeof(*d));
+    d->sensor_id = sensor_id;
+    d->year = 2026;
+    d->month = 10;
+    d->day = 16;
+    d->hour = (uint8_t)(i / 360);
+    d->min = (uint8_t)((i / 6) % 60);
+    d->sec = (uint8_t)((i % 6) * 10);
+    d->pm1_0 = valor(50.0f);
+    d->pm2_5 = valor(80.0f);
+    d->pm4_0 = valor(120.0f);
+    d->pm10 = valor(999.9f);
+    d->temp_amb = temperatura();
+    d->hum_amb = humedad();
+    d->temp_cam = temperatura();
+    d->hum_cam = humedad();
+    d->numero.nc0_5 = valor(3000.0f);
+    d->numero.nc1_0 = valor(3000.0f);
+    d->numero.nc2_5 = valor(3000.0f);
+    d->numero.nc4_0 = valor(3000.0f);
+    d->numero.nc10 = valor(3000.0f);
+    // 0,0625 um * 1000 = 62,5: empate exacto en la tercera cifra
+    d->numero.tamano_tipico = (aleatorio() % 4 == 0) ? 0.0625f * (float)(1 + aleatorio() % 40)
+                                                       : valor(10.0f);
+}
+
+static FILE * abrir(const char * carpeta, const char * nombre) {
+    char ruta[512];
+    snprintf(ruta, sizeof(ruta), "%s/%s", carpeta, nombre);
+    FILE * f = fopen(ruta, "wb");
+    if (f == NULL) {
+        perror(ruta);
+        exit(2);
+    }
+    return f;
+}
+
+/* Un día de un sensor: el binario por el camino de data_logger_store_raw() y el CSV de antes */
+static void generar(const char * carpeta, const char * nombre, uint8_t sensor_id, int muestras,
+                    const char * serial, const char * ubicacion,
+                    void (*ajuste)(ParticulateData *)) {
+    char ruta[64];
+    snprintf(ruta, sizeof(ruta), "%s.BIN", nombre);
+    FILE * bin = abrir(carpeta, ruta);
+    snprintf(ruta, sizeof(ruta), "%s.esperado", nombre);
+    FILE * csv = abrir(carpeta, ruta);
+
+    for (int i = 0; i < muestras; i++) {
+        ParticulateData d;
+        muestra(&d, sensor_id, i);
+        if (ajuste != NULL) {
+            ajuste(&d);
+        }
+
+        if (i == 0) {
+            uint8_t encabezado[REGISTRO_RAW_TAM_ENCABEZADO];
+            char texto[512];
+            registro_raw_encabezado_bin(encabezado, &d, serial, ubicacion, "-33.495, -70.720");
+            fwrite(encabezado, 1, sizeof(encabezado), bin);
+            size_t largo = registro_raw_encabezado_csv(texto, sizeof(texto), sensor_id, serial,
+                                                       ubicacion, "-33.495, -70.720");
+            fwrite(texto, 1, largo, csv);
+        }
+
+        uint8_t registro[REGISTRO_RAW_TAM_REGISTRO];
+        char linea[192];
+        registro_raw_codificar(&d, registro);
+        fwrite(registro, 1, sizeof(registro), bin);
+        CHECK(format_csv_line(&d, linea, sizeof(linea)), "línea CSV truncada");
+        fputs(linea, csv);
+    }
+    fclose(bin);
+    fclose(csv);
+}
+
+/* Muestras que el registro no representa: el exportador deja "nan" en esas columnas */
+static void fuera_de_rango(ParticulateData * d) {
+    d->pm1_0 = NAN;
+    d->pm10 = 7000.0f;
+    d->hum_amb = 4000.0f;
+    d->temp_cam = -4000.0f;
+    d->numero.nc0_5 = -0.01f;
+    d->numero.tamano_tipico = INFINITY;
+}
+
+static void test_codificacion(void) {
+    ParticulateData d = {.sensor_id = 2, .hour = 21, .min = 30, .sec = 10, .pm2_5 = 5.6f,
+                         .temp_amb = -99.9f, .hum_amb = -1.0f, .temp_cam = -0.04f};
+    d.numero.tamano_tipico = 0.0625f;
+    uint8_t r[REGISTRO_RAW_TAM_REGISTRO];
+
+    registro_raw_codificar(&d, r);
+    CHECK(r[0] == 21 && r[1] == 30 && r[2] == 10 && r[3] == 2, "hora y sensor");
+    CHECK(r[6] == 56 && r[7] == 0, "pm2.5 en décimas");
+    CHECK((int16_t)(r[12] | r[13] << 8) == -999, "temperatura negativa");
+    CHECK((int16_t)(r[14] | r[15] << 8) == -10, "humedad del DHT22 fallido");
+    CHECK((int16_t)(r[16] | r[17] << 8) == REGISTRO_RAW_MENOS_CERO, "-0.0");
+    CHECK((r[30] | r[31] << 8) == 62, "empate al par en la tercera cifra");
+
+    uint8_t e[REGISTRO_RAW_TAM_ENCABEZADO];
+    d.year = 2026;
+    registro_raw_encabezado_bin(e, &d, "0001", "Cerrillos", "-33.495, -70.720");
+    CHECK(memcmp(e, "SPS30RAW", 8) == 0 && e[8] == REGISTRO_RAW_VERSION, "magia y versión");
+    CHECK(e[14] == 18 && e[15] == 2 && (e[16] | e[17] << 8) == 2026, "campos, sensor y año");
+    CHECK(strcmp((const char *)&e[20], "0001") == 0, "serial");
+    CHECK(REGISTRO_RAW_TAM_ENCABEZADO % REGISTRO_RAW_TAM_REGISTRO == 0 &&
+              512 % REGISTRO_RAW_TAM_REGISTRO == 0,
+          "registros alineados con los sectores");
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        printf("uso: %s carpeta\n", argv[0]);
+        return 2;
+    }
+    test_codificacion();
+
+    generar(argv[1], "RAW_01_20261016", 1, 2000, "0001", "Cerrillos", NULL);
+    // Serial y ubicación al largo máximo de MP_SensorInfo
+    generar(argv[1], "RAW_03_20261016", 3, 50, "ABCDEFGHIJKLMNOPQRSTUVWXYZ012345",
+            "Estación de monitoreo Cerrillos, Región Metropolitana, Chile", NULL);
+    generar(argv[1], "INVALIDOS", 2, 10, "0002", "Cerrillos", fuera_de_rango);
+
+    printf(fallas == 0 ? "PASS\n" : "FAILED\n");
+    return fallas == 0 ? 0 : 1;
+}
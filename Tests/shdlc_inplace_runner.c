@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#define UNIT_TESTING
+#include "../APIs/Src/shdlc.c"
+
+// Respuesta real a READ_MEASUREMENT (formato float, 40 bytes) con 0x13, 0x7D y 0x7E escapados
+static const uint8_t frame_medicion[] = {
+    0x7E, 0x00, 0x03, 0x00, 0x28, 0x41, 0x7D, 0x33, 0x00, 0x00, 0x41, 0x48, 0x00,
+    0x00, 0x41, 0x50, 0x00, 0x00, 0x41, 0x74, 0x00, 0x00, 0x42, 0x70, 0x80, 0x00,
+    0x42, 0x7D, 0x5D, 0x00, 0x00, 0x42, 0x7D, 0x5E, 0x00, 0x00, 0x42, 0x8F, 0xA0,
+    0x00, 0x42, 0x8F, 0xC0, 0x00, 0x3F, 0x08, 0x00, 0x00, 0xB7, 0x7E};
+
+// Misma respuesta sin 0x7E en los datos, para comparar con el camino de tres pasadas
+static const uint8_t frame_medicion_legacy[] = {
+    0x7E, 0x00, 0x03, 0x00, 0x28, 0x41, 0x7D, 0x33, 0x00, 0x00, 0x41, 0x48, 0x00, 0x00, 0x41, 0x50,
+    0x00, 0x00, 0x41, 0x74, 0x00, 0x00, 0x42, 0x70, 0x80, 0x00, 0x42, 0x8D, 0x80, 0x00, 0x42, 0x8F,
+    0x00, 0x00, 0x42, 0x8F, 0xA0, 0x00, 0x42, 0x8F, 0xC0, 0x00, 0x3F, 0x08, 0x00, 0x00, 0x16, 0x7E};
+
+#define BUFFER_SIZE_READ_DATA 60 /* Buffers del camino anterior de sps30_comm.c */
+
+static int fallas = 0;
+static volatile float sumidero;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+/* Conversión anterior: invierte los bytes uno a uno en un arreglo temporal */
+static float legacy_bytes_to_float(const uint8_t * bytes) {
+    float value;
+    uint8_t reversedBytes[sizeof(value)];
+    for (int i = 0; i < (int)sizeof(value); i++) {
+        reversedBytes[i] = bytes[sizeof(value) - i - 1];
+    }
+    memcpy(&value, reversedBytes, sizeof(value));
+    return value;
+}
+
+static void legacy_llenar(ConcentracionesPM * c, const uint8_t * data) {
+    c->pm1_0 = legacy_bytes_to_float(&data[0]);
+    c->pm2_5 = legacy_bytes_to_float(&data[4]);
+    c->pm4_0 = legacy_bytes_to_float(&data[8]);
+    c->pm10 = legacy_bytes_to_float(&data[12]);
+}
+
+/* Camino anterior de sps30_get_concentrations: dos buffers, un Shdlc_FrameMiso y tres pasadas */
+static void legacy_decode(const uint8_t * frame, size_t n, ConcentracionesPM * c) {
+    uint8_t dataBuf[BUFFER_SIZE_READ_DATA] = {0};
+    uint8_t originalData[BUFFER_SIZE_READ_DATA] = {0};
+    Shdlc_FrameMiso Newframe = {0};
+
+    memcpy(dataBuf, frame, n);
+    SHDLC_revertByteStuffing(dataBuf, sizeof(dataBuf), originalData);
+    int longRespuesta = SHDLC_CalculateDataSize(originalData, sizeof(originalData));
+    SHDLC_LoadMyVector(&Newframe, originalData, longRespuesta);
+    legacy_llenar(c, Newframe.myVector);
+}
+
+static Shdlc_Error inplace_decode(const uint8_t * frame, size_t n, ConcentracionesPM * c) {
+    uint8_t dataBuf[BUFFER_SIZE_READ_DATA];
+
+    memcpy(dataBuf, frame, n);
+    return SHDLC_DecodeConcentracionesInPlace(dataBuf, n, 0x00, 0x03, c);
+}
+
+static double segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void test_equivalencia(void) {
+    ConcentracionesPM a = {0}, b;
+    uint8_t datos[16];
+
+    /* El camino anterior sólo decodificaba la masa */
+    legacy_decode(frame_medicion_legacy, sizeof(frame_medicion_legacy), &a);
+    CHECK(inplace_decode(frame_medicion_legacy, sizeof(frame_medicion_legacy), &b) == SHDLC_OK,
+          "equivalencia: decodifica");
+    CHECK(memcmp(&a, &b, 4 * sizeof(float)) == 0, "equivalencia: concentraciones");
+
+    /* 0x7E escapado dentro de los datos: el camino anterior lo truncaba */
+    CHECK(inplace_decode(frame_medicion, sizeof(frame_medicion), &b) == SHDLC_OK,
+          "0x7E en datos: decodifica");
+    CHECK(b.pm1_0 == 9.1875f && b.pm2_5 == 12.5f && b.pm4_0 == 13.0f && b.pm10 == 15.25f,
+          "0x7E en datos: valores");
+    CHECK(b.numero.nc0_5 == 60.125f && b.numero.nc1_0 == 63.25f && b.numero.nc2_5 == 63.5f &&
+              b.numero.nc4_0 == 71.8125f && b.numero.nc10 == 71.875f &&
+              b.numero.tamano_tipico == 0.53125f,
+          "registro completo: numero y tamano tipico");
+
+    /* bytesToFloat con swap contra la conversión anterior, incluso sin alinear */
+    for (int k = 0; k < 256; k++) {
+        for (int i = 0; i < 16; i++) {
+            datos[i] = (uint8_t)(k * 31 + i * 7);
+        }
+        float nuevo = SHDLC_bytesToFloat(&datos[1 + (k % 12)]);
+        float viejo = legacy_bytes_to_float(&datos[1 + (k % 12)]);
+        CHECK(memcmp(&nuevo, &viejo, sizeof(float)) == 0, "bytesToFloat: bits");
+    }
+}
+
+static void test_unstuff_en_sitio(void) {
+    uint8_t buf[sizeof(frame_medicion) + 3];
+    size_t n;
+
+    /* Basura previa y delimitador repetido antes del frame */
+    buf[0] = 0x55;
+    buf[1] = 0x7E;
+    memcpy(&buf[2], frame_medicion, sizeof(frame_medicion));
+    n = sizeof(frame_medicion) + 2;
+    CHECK(SHDLC_UnstuffFrameInPlace(buf, &n) == SHDLC_OK, "unstuff: ok");
+    CHECK(n == 4 + 40 + 1, "unstuff: longitud");
+    CHECK(buf[0] == 0x00 && buf[1] == 0x03 && buf[3] == 40, "unstuff: cabecera");
+    CHECK(buf[5] == 0x13 && buf[25] == 0x7D && buf[29] == 0x7E, "unstuff: escapes");
+}
+
+static void test_registro_parcial(void) {
+    /* Datos que sólo traen masa: el resto del registro queda en cero */
+    uint8_t buf[sizeof(frame_medicion)];
+    size_t n = sizeof(frame_medicion);
+    ConcentracionesPM c;
+
+    memcpy(buf, frame_medicion, n);
+    CHECK(SHDLC_UnstuffFrameInPlace(buf, &n) == SHDLC_OK, "parcial: unstuff");
+    memset(&c, 0xFF, sizeof(c));
+    SHDLC_llenarMedicion(&c, &buf[SHDLC_MISO_HEADER_SIZE], 4 * sizeof(float));
+    CHECK(c.pm10 == 15.25f && c.numero.nc0_5 == 0.0f && c.numero.tamano_tipico == 0.0f,
+          "parcial: resto en cero");
+}
+
+static void test_rechazos(void) {
+    uint8_t buf[BUFFER_SIZE_READ_DATA];
+    ConcentracionesPM c = {1.0f, 2.0f, 3.0f, 4.0f};
+    size_t n = sizeof(frame_medicion);
+
+    memcpy(buf, frame_medicion, n);
+    buf[10] ^= 0x01;
+    CHECK(SHDLC_DecodeConcentracionesInPlace(buf, n, 0x00, 0x03, &c) == SHDLC_ERROR_CHECKSUM,
+          "rechazo: checksum");
+    CHECK(c.pm1_0 == 1.0f, "rechazo: conc sin cambios");
+
+    memcpy(buf, frame_medicion, n);
+    CHECK(SHDLC_DecodeConcentracionesInPlace(buf, n - 1, 0x00, 0x03, &c) == SHDLC_ERROR_FRAME,
+          "rechazo: sin cierre");
+
+    memcpy(buf, frame_medicion, n);
+    buf[7] = 0x01; /* 0x7D 0x01: escape inválido */
+    CHECK(SHDLC_DecodeConcentracionesInPlace(buf, n, 0x00, 0x03, &c) == SHDLC_ERROR_FRAME,
+          "rechazo: escape");
+
+    memcpy(buf, frame_medicion, n);
+    CHECK(SHDLC_DecodeConcentracionesInPlace(buf, n, 0x00, 0x00, &c) == SHDLC_ERROR_COMMAND,
+          "rechazo: comando");
+
+    const uint8_t estado_error[] = {0x7E, 0x00, 0x03, 0x43, 0x00, 0xB9, 0x7E};
+    memcpy(buf, estado_error, sizeof(estado_error));
+    CHECK(SHDLC_DecodeConcentracionesInPlace(buf, sizeof(estado_error), 0x00, 0x03, &c) ==
+              SHDLC_ERROR_STATE,
+          "rechazo: estado");
+
+    const uint8_t sin_datos[] = {0x7E, 0x00, 0x03, 0x00, 0x00, 0xFC, 0x7E};
+    memcpy(buf, sin_datos, sizeof(sin_datos));
+    CHECK(SHDLC_DecodeConcentracionesInPlace(buf, sizeof(sin_datos), 0x00, 0x03, &c) ==
+              SHDLC_ERROR_LENGTH,
+          "rechazo: sin datos");
+}
+
+static void test_validar_en_sitio(void) {
+    uint8_t buf[BUFFER_SIZE_READ_DATA];
+    size_t n = sizeof(frame_medicion);
+
+    memcpy(buf, frame_medicion, n);
+    CHECK(SHDLC_ValidateFrameInPlace(buf, &n, 0x00, 0x03, 40) == SHDLC_OK && n == 4 + 40 + 1,
+          "validar: ok");
+
+    /* Frame íntegro con otra longitud: len queda en el contenido para ver lon */
+    n = sizeof(frame_medicion);
+    memcpy(buf, frame_medicion, n);
+    CHECK(SHDLC_ValidateFrameInPlace(buf, &n, 0x00, 0x03, 20) == SHDLC_ERROR_LENGTH &&
+              n == 4 + 40 + 1,
+          "validar: longitud");
+
+    const uint8_t sin_datos[] = {0x7E, 0x00, 0x03, 0x00, 0x00, 0xFC, 0x7E};
+    n = sizeof(sin_datos);
+    memcpy(buf, sin_datos, n);
+    CHECK(SHDLC_ValidateFrameInPlace(buf, &n, 0x00, 0x03, 40) == SHDLC_ERROR_LENGTH && n == 5 &&
+              buf[3] == 0,
+          "validar: sin datos");
+
+    n = sizeof(frame_medicion) - 1;
+    memcpy(buf, frame_medicion, n);
+    CHECK(SHDLC_ValidateFrameInPlace(buf, &n, 0x00, 0x03, -1) == SHDLC_ERROR_FRAME && n == 0,
+          "validar: sin cierre");
+}
+
+static void bench(void) {
+    const int iteraciones = 1000000;
+    ConcentracionesPM c;
+    uint8_t datos[16];
+    memcpy(datos, &frame_medicion_legacy[5], sizeof(datos));
+
+    double t0 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        legacy_decode(frame_medicion_legacy, sizeof(frame_medicion_legacy), &c);
+        sumidero += c.pm2_5;
+    }
+    double t1 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        inplace_decode(frame_medicion_legacy, sizeof(frame_medicion_legacy), &c);
+        sumidero += c.pm2_5;
+    }
+    double t2 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        datos[k & 15] ^= 1; /* Evita que el compilador saque la conversión del lazo */
+        legacy_llenar(&c, datos);
+        sumidero += c.pm10;
+    }
+    double t3 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        datos[k & 15] ^= 1;
+        SHDLC_llenarConcentraciones(&c, datos);
+        sumidero += c.pm10;
+    }
+    double t4 = segundos();
+
+    double ns_legacy = (t1 - t0) * 1e9 / iteraciones;
+    double ns_inplace = (t2 - t1) * 1e9 / iteraciones;
+    printf("BENCH frame completo: anterior %.1f ns, en sitio %.1f ns\n", ns_legacy, ns_inplace);
+    printf("BENCH 4 floats: anterior %.1f ns, con swap %.1f ns\n",
+           (t3 - t2) * 1e9 / iteraciones, (t4 - t3) * 1e9 / iteraciones);
+    printf("BENCH stack: anterior %zu bytes, en sitio %zu bytes\n",
+           2 * (size_t)BUFFER_SIZE_READ_DATA + sizeof(Shdlc_FrameMiso),
+           (size_t)BUFFER_SIZE_READ_DATA);
+    /* El tiempo de pared depende de la carga de la máquina: se informa, no se verifica */
+    if (ns_inplace >= ns_legacy) {
+        printf("BENCH aviso: el camino en sitio no fue mas rapido en esta corrida\n");
+    }
+}
+
+int main(void) {
+    test_equivalencia();
+    test_unstuff_en_sitio();
+    test_registro_parcial();
+    test_rechazos();
+    test_validar_en_sitio();
+    bench();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#define UNIT_TESTING
+#include "../APIs/Src/shdlc.c"
+
+// Respuesta real a READ_MEASUREMENT (formato float, 40 bytes) con 0x13, 0x7D y 0x7E escapados
+static const uint8_t frame_medicion[] = {
+    0x7E, 0x00, 0x03, 0x00, 0x28, 0x41, 0x7D, 0x33, 0x00, 0x00, 0x41, 0x48, 0x00,
+    0x00, 0x41, 0x50, 0x00, 0x00, 0x41, 0x74, 0x00, 0x00, 0x42, 0x70, 0x80, 0x00,
+    0x42, 0x7D, 0x5D, 0x00, 0x00, 0x42, 0x7D, 0x5E, 0x00, 0x00, 0x42, 0x8F, 0xA0,
+    0x00, 0x42, 0x8F, 0xC0, 0x00, 0x3F, 0x08, 0x00, 0x00, 0xB7, 0x7E};
+static const float valores_medicion[10] = {9.1875f, 12.5f,    13.0f,   15.25f,  60.125f,
+                                           63.25f,  63.5f,    71.8125f, 71.875f, 0.53125f};
+
+// Misma respuesta sin 0x7E en los datos: el camino de tres pasadas busca el delimitador después
+// de revertir el stuffing y trunca los frames que sí lo contienen
+static const uint8_t frame_medicion_legacy[] = {
+    0x7E, 0x00, 0x03, 0x00, 0x28, 0x41, 0x7D, 0x33, 0x00, 0x00, 0x41, 0x48, 0x00, 0x00, 0x41, 0x50,
+    0x00, 0x00, 0x41, 0x74, 0x00, 0x00, 0x42, 0x70, 0x80, 0x00, 0x42, 0x8D, 0x80, 0x00, 0x42, 0x8F,
+    0x00, 0x00, 0x42, 0x8F, 0xA0, 0x00, 0x42, 0x8F, 0xC0, 0x00, 0x3F, 0x08, 0x00, 0x00, 0x16, 0x7E};
+
+// Respuesta a START_MEASUREMENT (sin datos)
+static const uint8_t frame_start[] = {0x7E, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x7E};
+
+// Respuesta con byte de estado de error 0x43 (comando no permitido)
+static const uint8_t frame_estado_error[] = {0x7E, 0x00, 0x03, 0x43, 0x00, 0xB9, 0x7E};
+
+static int fallas = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static Shdlc_StreamStatus alimentar(Shdlc_StreamDecoder * dec, const uint8_t * data, size_t n) {
+    Shdlc_StreamStatus st = SHDLC_STREAM_INCOMPLETE;
+    for (size_t i = 0; i < n; i++) {
+        st = SHDLC_StreamFeedByte(dec, data[i]);
+    }
+    return st;
+}
+
+static void test_frame_medicion_byte_a_byte(void) {
+    Shdlc_StreamDecoder dec;
+    SHDLC_StreamInit(&dec);
+    CHECK(alimentar(&dec, frame_medicion, sizeof(frame_medicion)) == SHDLC_STREAM_COMPLETE,
+          "medicion: no completa");
+    CHECK(dec.frame.cmd == 0x03 && dec.frame.state == 0x00 && dec.frame.lon == 40,
+          "medicion: cabecera");
+    CHECK(dec.frame.longframe == 47, "medicion: longframe");
+    for (int i = 0; i < 10; i++) {
+        CHECK(SHDLC_bytesToFloat(&dec.frame.myVector[4 * i]) == valores_medicion[i],
+              "medicion: valor");
+    }
+}
+
+static void test_equivalencia_con_tres_pasadas(void) {
+    uint8_t dataBuf[60] = {0};
+    uint8_t originalData[60] = {0};
+    Shdlc_FrameMiso legacy = {0};
+    Shdlc_StreamDecoder dec;
+    ConcentracionesPM a = {0}, b = {0};
+
+    memcpy(dataBuf, frame_medicion_legacy, sizeof(frame_medicion_legacy));
+    SHDLC_revertByteStuffing(dataBuf, sizeof(dataBuf), originalData);
+    SHDLC_LoadMyVector(&legacy, originalData,
+                       SHDLC_CalculateDataSize(originalData, sizeof(originalData)));
+    SHDLC_llenarConcentraciones(&a, legacy.myVector);
+
+    SHDLC_StreamInit(&dec);
+    alimentar(&dec, frame_medicion_legacy, sizeof(frame_medicion_legacy));
+    SHDLC_llenarConcentraciones(&b, dec.frame.myVector);
+
+    CHECK(legacy.lon == dec.frame.lon, "equivalencia: lon");
+    CHECK(memcmp(legacy.myVector, dec.frame.myVector, legacy.lon) == 0, "equivalencia: datos");
+    CHECK(memcmp(&a, &b, sizeof(a)) == 0, "equivalencia: concentraciones");
+}
+
+static void test_bloques_partidos(void) {
+    // Se parte el frame en todas las posiciones, incluida la mitad de una secuencia de escape
+    for (size_t corte = 1; corte < sizeof(frame_medicion); corte++) {
+        Shdlc_StreamDecoder dec;
+        size_t usados = 0;
+        SHDLC_StreamInit(&dec);
+        CHECK(SHDLC_StreamFeed(&dec, frame_medicion, corte, &usados) == SHDLC_STREAM_INCOMPLETE,
+              "bloques: primer bloque");
+        CHECK(usados == corte, "bloques: consumidos");
+        CHECK(SHDLC_StreamFeed(&dec, &frame_medicion[corte], sizeof(frame_medicion) - corte,
+                               &usados) == SHDLC_STREAM_COMPLETE,
+              "bloques: segundo bloque");
+        CHECK(dec.frame.lon == 40, "bloques: lon");
+    }
+}
+
+static void test_frames_consecutivos_con_ruido(void) {
+    uint8_t flujo[128];
+    size_t n = 0;
+    const uint8_t ruido[] = {0x00, 0xFF, 0x13};
+    memcpy(&flujo[n], ruido, sizeof(ruido));
+    n += sizeof(ruido);
+    memcpy(&flujo[n], frame_start, sizeof(frame_start));
+    n += sizeof(frame_start);
+    memcpy(&flujo[n], frame_medicion, sizeof(frame_medicion));
+    n += sizeof(frame_medicion);
+
+    Shdlc_StreamDecoder dec;
+    size_t usados = 0, pos = 0;
+    SHDLC_StreamInit(&dec);
+    CHECK(SHDLC_StreamFeed(&dec, flujo, n, &usados) == SHDLC_STREAM_COMPLETE, "flujo: primero");
+    CHECK(dec.frame.cmd == 0x00 && dec.frame.lon == 0, "flujo: start");
+    pos += usados;
+    CHECK(SHDLC_StreamFeed(&dec, &flujo[pos], n - pos, &usados) == SHDLC_STREAM_COMPLETE,
+          "flujo: segundo");
+    CHECK(dec.frame.cmd == 0x03 && dec.frame.lon == 40, "flujo: medicion");
+    CHECK(pos + usados == n, "flujo: fin");
+}
+
+static void test_estado_error(void) {
+    Shdlc_StreamDecoder dec;
+    SHDLC_StreamInit(&dec);
+    CHECK(alimentar(&dec, frame_estado_error, sizeof(frame_estado_error)) ==
+              SHDLC_STREAM_COMPLETE,
+          "estado: no completa");
+    CHECK(dec.frame.state == 0x43, "estado: byte de estado");
+}
+
+static void test_frames_invalidos(void) {
+    Shdlc_StreamDecoder dec;
+    uint8_t copia[sizeof(frame_medicion)];
+
+    // Checksum alterado
+    memcpy(copia, frame_medicion, sizeof(copia));
+    copia[sizeof(copia) - 2] ^= 0x01;
+    SHDLC_StreamInit(&dec);
+    CHECK(alimentar(&dec, copia, sizeof(copia)) == SHDLC_STREAM_ERROR, "invalido: checksum");
+
+    // Frame truncado: el 0x7E de cierre llega antes de tiempo
+    const uint8_t truncado[] = {0x7E, 0x00, 0x03, 0x00, 0x28, 0x41, 0x42, 0x7E};
+    SHDLC_StreamInit(&dec);
+    CHECK(alimentar(&dec, truncado, sizeof(truncado)) == SHDLC_STREAM_ERROR, "invalido: corto");
+
+    // Longitud mayor que la capacidad de myVector
+    const uint8_t largo[] = {0x7E, 0x00, 0x03, 0x00, 0xF0};
+    SHDLC_StreamInit(&dec);
+    CHECK(alimentar(&dec, largo, sizeof(largo)) == SHDLC_STREAM_ERROR, "invalido: largo");
+
+    // Secuencia de escape desconocida
+    const uint8_t escape[] = {0x7E, 0x00, 0x7D, 0x01};
+    SHDLC_StreamInit(&dec);
+    CHECK(alimentar(&dec, escape, sizeof(escape)) == SHDLC_STREAM_ERROR, "invalido: escape");
+
+    // Tras un error el decodificador se recupera con el siguiente frame
+    CHECK(alimentar(&dec, frame_medicion, sizeof(frame_medicion)) == SHDLC_STREAM_COMPLETE,
+          "invalido: recuperacion");
+}
+
+static double segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void benchmark(void) {
+    const int iteraciones = 200000;
+    volatile float sumidero = 0.0f;
+    ConcentracionesPM c;
+
+    double t0 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        uint8_t dataBuf[60] = {0};
+        uint8_t originalData[60] = {0};
+        Shdlc_FrameMiso frame = {0};
+        memcpy(dataBuf, frame_medicion_legacy, sizeof(frame_medicion_legacy));
+        SHDLC_revertByteStuffing(dataBuf, sizeof(dataBuf), originalData);
+        SHDLC_LoadMyVector(&frame, originalData,
+                           SHDLC_CalculateDataSize(originalData, sizeof(originalData)));
+        SHDLC_llenarConcentraciones(&c, frame.myVector);
+        sumidero += c.pm2_5;
+    }
+    double t1 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        Shdlc_StreamDecoder dec;
+        SHDLC_StreamInit(&dec);
+        SHDLC_StreamFeed(&dec, frame_medicion_legacy, sizeof(frame_medicion_legacy), NULL);
+        SHDLC_llenarConcentraciones(&c, dec.frame.myVector);
+        sumidero += c.pm2_5;
+    }
+    double t2 = segundos();
+
+    printf("BENCH tres_pasadas: %.1f ns/frame\n", (t1 - t0) * 1e9 / iteraciones);
+    printf("BENCH incremental:  %.1f ns/frame\n", (t2 - t1) * 1e9 / iteraciones);
+    (void)sumidero;
+}
+
+int main(void) {
+    test_frame_medicion_byte_a_byte();
+    test_equivalencia_con_tres_pasadas();
+    test_bloques_partidos();
+    test_frames_consecutivos_con_ruido();
+    test_estado_error();
+    test_frames_invalidos();
+    benchmark();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
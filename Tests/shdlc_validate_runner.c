@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <string.h>
+#define UNIT_TESTING
+#include "../APIs/Src/shdlc.c"
+
+#define ADR_SPS30      0x00
+#define CMD_READ       0x03
+#define LON_MEDICION   40
+#define FRAME_MAX      (2 * (FRAME_DATA_VECTOR_SIZE_MISO + 5) + 2)
+#define FRAMES_FUZZ    2000
+#define BYTES_AZAR     200000
+
+static int fallas = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+/* xorshift32 con semilla fija: las corridas son reproducibles */
+static uint32_t semilla = 0x5B530u;
+
+static uint32_t azar(void) {
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    return semilla;
+}
+
+static size_t poner(uint8_t * out, size_t n, uint8_t b) {
+    if (b == 0x7E || b == 0x7D || b == 0x11 || b == 0x13) {
+        out[n++] = SHDLC_ESCAPE_BYTE;
+        out[n++] = b ^ SHDLC_ESCAPE_XOR;
+    } else {
+        out[n++] = b;
+    }
+    return n;
+}
+
+/* Codifica un frame MISO completo con stuffing; devuelve la cantidad de bytes */
+static size_t codificar(uint8_t adr, uint8_t cmd, uint8_t state, const uint8_t * datos,
+                        uint8_t lon, uint8_t * out) {
+    uint8_t sum = adr + cmd + state + lon;
+    size_t n = 0;
+
+    out[n++] = SHDLC_FRAME_DELIMITER;
+    n = poner(out, n, adr);
+    n = poner(out, n, cmd);
+    n = poner(out, n, state);
+    n = poner(out, n, lon);
+    for (uint8_t i = 0; i < lon; i++) {
+        sum += datos[i];
+        n = poner(out, n, datos[i]);
+    }
+    n = poner(out, n, (uint8_t)~sum);
+    out[n++] = SHDLC_FRAME_DELIMITER;
+    return n;
+}
+
+/* Datos al azar con abundancia de bytes que requieren stuffing */
+static void datos_azar(uint8_t * datos, uint8_t lon) {
+    static const uint8_t especiales[] = {0x7E, 0x7D, 0x11, 0x13};
+    for (uint8_t i = 0; i < lon; i++) {
+        uint32_t r = azar();
+        datos[i] = (r & 0x700u) == 0 ? especiales[r & 3u] : (uint8_t)(r >> 16);
+    }
+}
+
+static Shdlc_Error decodificar(const uint8_t * data, size_t n, Shdlc_FrameMiso * frame) {
+    Shdlc_StreamDecoder dec;
+    Shdlc_Error err = SHDLC_ERROR_TIMEOUT;
+
+    SHDLC_StreamInit(&dec);
+    for (size_t i = 0; i < n; i++) {
+        Shdlc_StreamStatus st = SHDLC_StreamFeedByte(&dec, data[i]);
+        if (st == SHDLC_STREAM_COMPLETE) {
+            *frame = dec.frame;
+            return SHDLC_OK;
+        }
+        if (st == SHDLC_STREAM_ERROR) {
+            err = dec.error;
+        }
+    }
+    return err;
+}
+
+static void test_frames_validos(void) {
+    uint8_t datos[FRAME_DATA_VECTOR_SIZE_MISO];
+    uint8_t out[FRAME_MAX];
+    Shdlc_FrameMiso frame;
+
+    for (int k = 0; k < FRAMES_FUZZ; k++) {
+        uint8_t lon = azar() % (FRAME_DATA_VECTOR_SIZE_MISO + 1);
+        datos_azar(datos, lon);
+        size_t n = codificar(ADR_SPS30, CMD_READ, 0x00, datos, lon, out);
+
+        CHECK(decodificar(out, n, &frame) == SHDLC_OK, "validos: no decodifica");
+        CHECK(SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, lon) == SHDLC_OK,
+              "validos: rechazado");
+        CHECK(frame.lon == lon && memcmp(frame.myVector, datos, lon) == 0, "validos: datos");
+    }
+}
+
+static void test_un_bit_invertido(void) {
+    uint8_t datos[LON_MEDICION];
+    uint8_t out[FRAME_MAX];
+    Shdlc_FrameMiso frame;
+    int aceptados = 0;
+    int detectados = 0;
+
+    for (int k = 0; k < FRAMES_FUZZ / 10; k++) {
+        datos_azar(datos, LON_MEDICION);
+        size_t n = codificar(ADR_SPS30, CMD_READ, 0x00, datos, LON_MEDICION, out);
+
+        for (size_t pos = 0; pos < n; pos++) {
+            for (int bit = 0; bit < 8; bit++) {
+                out[pos] ^= (uint8_t)(1u << bit);
+                Shdlc_Error err = decodificar(out, n, &frame);
+                if (err == SHDLC_OK) {
+                    err = SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, LON_MEDICION);
+                }
+                if (err == SHDLC_OK) {
+                    aceptados++;
+                } else {
+                    detectados++;
+                }
+                out[pos] ^= (uint8_t)(1u << bit);
+            }
+        }
+    }
+    CHECK(aceptados == 0, "bit invertido: frame corrupto aceptado");
+    printf("INFO bits invertidos detectados: %d\n", detectados);
+}
+
+static void test_flujo_al_azar(void) {
+    /* Ruido arbitrario intercalado con frames válidos: el decodificador no debe desbordar, sólo
+     * entrega frames con checksum correcto y se resincroniza para recuperar los válidos */
+    Shdlc_StreamDecoder dec;
+    uint8_t flujo[256 + FRAME_MAX];
+    uint8_t datos[LON_MEDICION];
+    int insertados = 0;
+    int recuperados = 0;
+
+    SHDLC_StreamInit(&dec);
+    for (int k = 0; k < BYTES_AZAR / 256; k++) {
+        size_t n = 0;
+        for (; n < 256; n++) {
+            uint32_t r = azar();
+            flujo[n] = (r & 0xF00u) == 0 ? 0x7E : (r & 0xF000u) == 0 ? 0x7D : (uint8_t)(r >> 16);
+        }
+        if ((k & 3) == 0) {
+            /* El delimitador previo cierra cualquier frame a medio recibir */
+            flujo[n - 1] = SHDLC_FRAME_DELIMITER;
+            datos_azar(datos, LON_MEDICION);
+            n += codificar(ADR_SPS30, CMD_READ, 0x00, datos, LON_MEDICION, &flujo[n]);
+            insertados++;
+        }
+
+        size_t pos = 0;
+        while (pos < n) {
+            size_t consumidos = 0;
+            Shdlc_StreamStatus st = SHDLC_StreamFeed(&dec, &flujo[pos], n - pos, &consumidos);
+            pos += consumidos;
+            if (st == SHDLC_STREAM_COMPLETE) {
+                CHECK(dec.frame.lon <= FRAME_DATA_VECTOR_SIZE_MISO, "azar: longitud");
+                CHECK(SHDLC_ValidateFrame(&dec.frame, dec.frame.adr, dec.frame.cmd, -1) !=
+                          SHDLC_ERROR_CHECKSUM,
+                      "azar: checksum");
+                if (SHDLC_ValidateFrame(&dec.frame, ADR_SPS30, CMD_READ, LON_MEDICION) ==
+                        SHDLC_OK &&
+                    memcmp(dec.frame.myVector, datos, LON_MEDICION) == 0) {
+                    recuperados++;
+                }
+            }
+            if (consumidos == 0) {
+                break;
+            }
+        }
+    }
+    CHECK(recuperados == insertados, "azar: frames validos perdidos");
+    printf("INFO frames recuperados entre ruido: %d/%d\n", recuperados, insertados);
+}
+
+static void test_errores_tipados(void) {
+    uint8_t datos[LON_MEDICION] = {0};
+    uint8_t out[FRAME_MAX];
+    Shdlc_FrameMiso frame;
+    size_t n;
+
+    n = codificar(0x01, CMD_READ, 0x00, datos, LON_MEDICION, out);
+    CHECK(decodificar(out, n, &frame) == SHDLC_OK &&
+              SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, LON_MEDICION) ==
+                  SHDLC_ERROR_ADDRESS,
+          "tipados: direccion");
+
+    /* Respuesta atrasada a START_MEASUREMENT leída como si fuera la de READ */
+    n = codificar(ADR_SPS30, 0x00, 0x00, NULL, 0, out);
+    CHECK(decodificar(out, n, &frame) == SHDLC_OK &&
+              SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, LON_MEDICION) ==
+                  SHDLC_ERROR_COMMAND,
+          "tipados: comando");
+
+    n = codificar(ADR_SPS30, CMD_READ, 0x43, NULL, 0, out);
+    CHECK(decodificar(out, n, &frame) == SHDLC_OK &&
+              SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, LON_MEDICION) ==
+                  SHDLC_ERROR_STATE,
+          "tipados: estado");
+    CHECK(!SHDLC_IsTransientError(SHDLC_ERROR_STATE), "tipados: estado no transitorio");
+
+    /* Bit 7 del estado: aviso de error del dispositivo, no impide usar los datos */
+    n = codificar(ADR_SPS30, CMD_READ, 0x80, datos, LON_MEDICION, out);
+    CHECK(decodificar(out, n, &frame) == SHDLC_OK &&
+              SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, LON_MEDICION) == SHDLC_OK,
+          "tipados: aviso de dispositivo");
+
+    /* Sin datos nuevos el SPS30 responde READ con lon = 0 */
+    n = codificar(ADR_SPS30, CMD_READ, 0x00, NULL, 0, out);
+    CHECK(decodificar(out, n, &frame) == SHDLC_OK &&
+              SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, LON_MEDICION) ==
+                  SHDLC_ERROR_LENGTH,
+          "tipados: longitud");
+    CHECK(SHDLC_IsTransientError(SHDLC_ERROR_LENGTH), "tipados: longitud transitoria");
+
+    n = codificar(ADR_SPS30, CMD_READ, 0x00, datos, LON_MEDICION, out);
+    out[n - 2] ^= 0x01;
+    CHECK(decodificar(out, n, &frame) == SHDLC_ERROR_CHECKSUM, "tipados: checksum stream");
+
+    const uint8_t escape_invalido[] = {0x7E, 0x00, 0x7D, 0x7E};
+    CHECK(decodificar(escape_invalido, sizeof(escape_invalido), &frame) == SHDLC_ERROR_FRAME,
+          "tipados: escape");
+
+    for (int e = SHDLC_OK; e <= SHDLC_ERROR_STATE; e++) {
+        CHECK(SHDLC_ErrorString((Shdlc_Error)e) != NULL, "tipados: texto");
+    }
+}
+
+static void test_load_my_vector(void) {
+    uint8_t datos[LON_MEDICION];
+    uint8_t out[FRAME_MAX];
+    uint8_t plano[FRAME_MAX];
+    Shdlc_FrameMiso frame;
+
+    datos_azar(datos, LON_MEDICION);
+    for (int i = 0; i < LON_MEDICION; i++) {
+        datos[i] = (datos[i] == 0x7E) ? 0x00 : datos[i]; /* Camino de tres pasadas: sin 0x7E */
+    }
+    codificar(ADR_SPS30, CMD_READ, 0x00, datos, LON_MEDICION, out);
+    memset(plano, 0, sizeof(plano));
+    SHDLC_revertByteStuffing(out, sizeof(out), plano);
+    int lon = SHDLC_CalculateDataSize(plano, sizeof(plano));
+
+    CHECK(SHDLC_LoadMyVector(&frame, plano, lon) == SHDLC_OK, "load: frame valido");
+    CHECK(frame.cmd == CMD_READ && frame.lon == LON_MEDICION &&
+              memcmp(frame.myVector, datos, LON_MEDICION) == 0,
+          "load: contenido");
+    CHECK(SHDLC_ValidateFrame(&frame, ADR_SPS30, CMD_READ, LON_MEDICION) == SHDLC_OK,
+          "load: validacion");
+    CHECK(SHDLC_LoadMyVector(&frame, plano, lon - 1) == SHDLC_ERROR_LENGTH, "load: truncado");
+
+    plano[10] ^= 0x04;
+    CHECK(SHDLC_LoadMyVector(&frame, plano, lon) == SHDLC_ERROR_CHECKSUM, "load: checksum");
+}
+
+int main(void) {
+    test_frames_validos();
+    test_un_bit_invertido();
+    test_flujo_al_azar();
+    test_errores_tipados();
+    test_load_my_vector();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <string.h>
+#define UNIT_TESTING
+#define INC_UART_H_ /* Se usa el stub de uart.h en lugar del de APIs/Inc */
+#include "stubs/uart.h"
+#include "stubs/uart_double.h"
+#include "stubs/sps30_sim.h"
+#include "../APIs/Src/shdlc.c"
+#include "../APIs/Src/sps30_comm.c"
+#include "../APIs/Src/sps30_multi.c"
+#include "../APIs/Src/uart_callbacks.c"
+
+UART_HandleTypeDef huart5 = {.id = 1};
+UART_HandleTypeDef huart7 = {.id = 2};
+UART_HandleTypeDef huart1 = {.id = 3};
+
+#define MAX_INTENTOS 3 /* Igual que NUM_REINT */
+
+static int fallas = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static void preparar(void) {
+    uart_double_reset();
+    sps30_sim_reset();
+    sps30_sim_exigir_inicio = true;
+    uart_double_set_responder(sps30_sim_responder);
+    huart5.dma_activo = huart7.dma_activo = huart1.dma_activo = 0;
+    inicializar_sensores_sps30();
+    sps30_multi_set_continuo(false); /* Estas pruebas cubren el ciclo start/lectura/stop */
+}
+
+/* Ciclo anterior: start, espera, lectura y stop sensor por sensor */
+static uint32_t ciclo_serie_ms(int n) {
+    uint32_t t0 = uart_double_now_us();
+    for (int i = 0; i < n; i++) {
+        SPS30 * s = &sensores_sps30[i].sensor;
+        s->start_measurement(s);
+        HAL_Delay(SPS30_WARMUP_MS);
+        ConcentracionesPM pm = s->get_concentrations(s);
+        s->stop_measurement(s);
+        CHECK(pm.pm2_5 == sps30_sim_valor(sensores_sps30[i].uart->id, 1), "serie: valor");
+    }
+    return (uart_double_now_us() - t0) / 1000;
+}
+
+static uint32_t ciclo_concurrente_ms(int n, SPS30_Adquisicion * res, SPS30_Validador validar) {
+    sensores_disponibles = n;
+    uint32_t t0 = uart_double_now_us();
+    sps30_multi_adquirir(res, MAX_INTENTOS, validar);
+    uint32_t t = (uart_double_now_us() - t0) / 1000;
+    sensores_disponibles = NUM_SENSORES_SPS30;
+    return t;
+}
+
+static void test_tiempo_de_ciclo(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+    uint32_t concurrente[NUM_SENSORES_SPS30 + 1];
+
+    preparar();
+    uint32_t serie = ciclo_serie_ms(NUM_SENSORES_SPS30);
+
+    for (int n = 1; n <= NUM_SENSORES_SPS30; n++) {
+        concurrente[n] = ciclo_concurrente_ms(n, res, NULL);
+        for (int i = 0; i < n; i++) {
+            CHECK(res[i].valido && res[i].intentos == 1, "concurrente: resultado");
+            CHECK(res[i].pm.pm10 == sps30_sim_valor(sensores_sps30[i].uart->id, 3),
+                  "concurrente: valor");
+        }
+        printf("BENCH %d sensores: concurrente %u ms\n", n, concurrente[n]);
+    }
+    printf("BENCH %d sensores: en serie %u ms\n", NUM_SENSORES_SPS30, serie);
+
+    /* Una sola espera de estabilización: el ciclo no crece con la cantidad de sensores */
+    CHECK(concurrente[NUM_SENSORES_SPS30] < SPS30_WARMUP_MS + 100, "tiempo: ciclo plano");
+    CHECK(concurrente[NUM_SENSORES_SPS30] - concurrente[1] < 50, "tiempo: crecimiento");
+    CHECK(serie >= NUM_SENSORES_SPS30 * SPS30_WARMUP_MS, "tiempo: referencia en serie");
+    for (int id = 1; id <= NUM_SENSORES_SPS30; id++) {
+        CHECK(!sps30_sim[id].midiendo, "tiempo: medicion detenida");
+    }
+}
+
+static void test_relectura_sin_reinicio(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar();
+    sps30_sim[2].corromper = 1; /* La primera respuesta de UART7 llega con checksum inválido */
+    uint32_t t = ciclo_concurrente_ms(NUM_SENSORES_SPS30, res, NULL);
+
+    CHECK(res[0].valido && res[1].valido && res[2].valido, "relectura: validos");
+    CHECK(res[0].intentos == 1 && res[1].intentos == 1 && res[2].intentos == 1,
+          "relectura: sin nueva ronda");
+    CHECK(res[1].error == SHDLC_OK, "relectura: error final");
+    CHECK(sps30_sim[2].starts == 1 && sps30_sim[2].lecturas == 1, "relectura: un solo start");
+    CHECK(t < SPS30_WARMUP_MS + 100, "relectura: tiempo");
+}
+
+static void test_reintento_independiente(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar();
+    /* Corrompe todas las relecturas de la primera ronda de UART7 */
+    sps30_sim[2].corromper = SPS30_RELECTURAS + 1;
+    uint32_t t = ciclo_concurrente_ms(NUM_SENSORES_SPS30, res, NULL);
+
+    CHECK(res[0].valido && res[1].valido && res[2].valido, "reintento: validos");
+    CHECK(res[0].intentos == 1 && res[1].intentos == 2 && res[2].intentos == 1,
+          "reintento: intentos por sensor");
+    CHECK(sps30_sim[1].starts == 1 && sps30_sim[2].starts == 2 && sps30_sim[3].starts == 1,
+          "reintento: sólo se reinicia el sensor con error");
+    CHECK(t < 2 * SPS30_WARMUP_MS + 300, "reintento: tiempo");
+}
+
+static bool rechazar_sensor_tres(const ConcentracionesPM * pm) {
+    return pm->pm1_0 != sps30_sim_valor(3, 0);
+}
+
+static void test_validador_y_sensor_mudo(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar();
+    sps30_sim[1].mudo = true;
+    ciclo_concurrente_ms(NUM_SENSORES_SPS30, res, rechazar_sensor_tres);
+
+    CHECK(!res[0].valido && res[0].intentos == MAX_INTENTOS, "mudo: agota intentos");
+    CHECK(res[0].error == SHDLC_ERROR_TIMEOUT, "mudo: error de timeout");
+    CHECK(res[1].valido && res[1].intentos == 1, "mudo: no bloquea a los demás");
+    CHECK(!res[2].valido && res[2].intentos == MAX_INTENTOS, "validador: rechazo");
+    CHECK(res[2].error == SHDLC_OK, "validador: trama correcta");
+    CHECK(res[0].pm.pm2_5 == 0.0f && res[2].pm.pm2_5 == 0.0f, "fallidos: concentración en cero");
+}
+
+int main(void) {
+    test_tiempo_de_ciclo();
+    test_relectura_sin_reinicio();
+    test_reintento_independiente();
+    test_validador_y_sensor_mudo();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <string.h>
+#define UNIT_TESTING
+#define INC_UART_H_ /* Se usa el stub de uart.h en lugar del de APIs/Inc */
+#include "stubs/uart.h"
+#include "stubs/uart_double.h"
+#include "stubs/sps30_sim.h"
+#include "../APIs/Src/shdlc.c"
+#include "../APIs/Src/sps30_comm.c"
+#include "../APIs/Src/sps30_multi.c"
+#include "../APIs/Src/uart_callbacks.c"
+
+UART_HandleTypeDef huart5 = {.id = 1};
+UART_HandleTypeDef huart7 = {.id = 2};
+UART_HandleTypeDef huart1 = {.id = 3};
+
+#define MAX_INTENTOS 3    /* Igual que NUM_REINT */
+#define REPOSO_MS    5000 /* Igual que DURACION_REPOSO_MS */
+#define CICLOS_BENCH 10
+
+static int fallas = 0;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static void preparar(bool continuo) {
+    uart_double_reset();
+    sps30_sim_reset();
+    sps30_sim_exigir_inicio = true;
+    uart_double_set_responder(sps30_sim_responder);
+    huart5.dma_activo = huart7.dma_activo = huart1.dma_activo = 0;
+    inicializar_sensores_sps30();
+    sps30_multi_set_continuo(continuo);
+}
+
+static uint32_t ciclo_ms(SPS30_Adquisicion * res, uint8_t max_intentos) {
+    uint32_t t0 = uart_double_now_us();
+    sps30_multi_adquirir(res, max_intentos, NULL);
+    return (uart_double_now_us() - t0) / 1000;
+}
+
+static void test_primer_ciclo_y_regimen(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar(true);
+    CHECK(sps30_multi_es_continuo(), "modo: continuo por defecto");
+
+    /* Primer ciclo: un START y una sola espera de estabilización */
+    uint32_t primero = ciclo_ms(res, MAX_INTENTOS);
+    for (int i = 0; i < NUM_SENSORES_SPS30; i++) {
+        int id = sensores_sps30[i].uart->id;
+        CHECK(res[i].valido && res[i].intentos == 1, "primero: resultado");
+        CHECK(sps30_sim[id].starts == 1 && sps30_sim[id].midiendo, "primero: queda midiendo");
+        CHECK(sensores_sps30[i].sensor.midiendo, "primero: estado del driver");
+    }
+    CHECK(primero >= SPS30_WARMUP_MS && primero < SPS30_WARMUP_MS + 100, "primero: tiempo");
+
+    /* En régimen: sin START ni espera, un único READ por sensor */
+    HAL_Delay(REPOSO_MS);
+    uint32_t regimen = ciclo_ms(res, MAX_INTENTOS);
+    for (int i = 0; i < NUM_SENSORES_SPS30; i++) {
+        int id = sensores_sps30[i].uart->id;
+        CHECK(res[i].valido && res[i].intentos == 1, "regimen: resultado");
+        CHECK(res[i].pm.pm2_5 == sps30_sim_valor(id, 1), "regimen: valor");
+        CHECK(sps30_sim[id].starts == 1 && sps30_sim[id].lecturas == 2, "regimen: sin START");
+    }
+    CHECK(regimen < 50, "regimen: sin espera de estabilizacion");
+    printf("BENCH ciclo continuo: primero %u ms, en regimen %u ms\n", primero, regimen);
+
+    /* A la cadencia propia del sensor cada ciclo encuentra un dato nuevo */
+    for (int k = 0; k < 5; k++) {
+        HAL_Delay(SPS30_PERIODO_MEDICION_MS);
+        CHECK(ciclo_ms(res, MAX_INTENTOS) < 50, "1 Hz: tiempo");
+        CHECK(res[0].valido && res[1].valido && res[2].valido && res[0].intentos == 1,
+              "1 Hz: dato nuevo en cada ciclo");
+    }
+    CHECK(sps30_sim[1].starts == 1 && sps30_sim[1].lecturas == 7, "1 Hz: lecturas");
+}
+
+static void test_sin_dato_nuevo(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar(true);
+    ciclo_ms(res, MAX_INTENTOS);
+
+    /* Un ciclo antes del próximo período: READ responde sin datos y se espera un período */
+    uint32_t t = ciclo_ms(res, MAX_INTENTOS);
+    for (int i = 0; i < NUM_SENSORES_SPS30; i++) {
+        int id = sensores_sps30[i].uart->id;
+        CHECK(res[i].valido && res[i].intentos == 2, "sin dato: segunda ronda");
+        CHECK(sps30_sim[id].starts == 1, "sin dato: sin reinicio");
+    }
+    CHECK(t >= SPS30_PERIODO_MEDICION_MS && t < SPS30_PERIODO_MEDICION_MS + 100,
+          "sin dato: espera de un periodo");
+
+    /* Con un solo intento el ciclo informa la falta de dato sin detener los sensores */
+    ciclo_ms(res, 1);
+    CHECK(!res[0].valido && res[0].error == SHDLC_ERROR_NO_DATA, "sin dato: error tipado");
+    CHECK(sps30_sim[1].midiendo && sensores_sps30[0].sensor.midiendo, "sin dato: sigue midiendo");
+}
+
+static void test_poll(void) {
+    ConcentracionesPM pm = {0};
+
+    preparar(true);
+    SPS30 * s = &sensores_sps30[1].sensor;
+    s->start_measurement(s);
+    CHECK(s->poll_concentrations(s, &pm) == SHDLC_ERROR_NO_DATA, "poll: antes del primer dato");
+
+    HAL_Delay(SPS30_PERIODO_MEDICION_MS);
+    CHECK(s->poll_concentrations(s, &pm) == SHDLC_OK && pm.pm4_0 == sps30_sim_valor(2, 2),
+          "poll: dato nuevo");
+
+    /* La misma muestra no se entrega dos veces y conc no cambia */
+    memset(&pm, 0, sizeof(pm));
+    CHECK(s->poll_concentrations(s, &pm) == SHDLC_ERROR_NO_DATA && pm.pm4_0 == 0.0f,
+          "poll: sin dato nuevo");
+
+    /* La lectura con relecturas no insiste ante la falta de dato: un solo READ */
+    uint32_t t0 = uart_double_now_us();
+    CHECK(s->read_concentrations(s, &pm) == SHDLC_ERROR_NO_DATA, "read: sin dato nuevo");
+    CHECK(uart_double_now_us() - t0 < 2 * SPS30_SIM_LATENCIA_US, "read: sin relecturas");
+    CHECK(!SHDLC_IsTransientError(SHDLC_ERROR_NO_DATA), "sin dato: no transitorio");
+}
+
+static void test_start_rechazado(void) {
+    SPS30 * s;
+
+    preparar(true);
+    s = &sensores_sps30[1].sensor;
+
+    /* El sensor responde con error de estado: el driver no lo da por midiendo */
+    sps30_sim[2].estado_start = 0x43;
+    s->start_measurement(s);
+    CHECK(!s->midiendo && !sps30_sim[2].midiendo, "start: rechazado");
+
+    /* Sin respuesta tampoco */
+    sps30_sim[2].estado_start = 0;
+    sps30_sim[2].mudo = true;
+    s->start_measurement(s);
+    CHECK(!s->midiendo, "start: sin respuesta");
+
+    sps30_sim[2].mudo = false;
+    s->start_measurement(s);
+    CHECK(s->midiendo && sps30_sim[2].starts == 1, "start: aceptado");
+}
+
+static void test_error_reinicia(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar(true);
+    ciclo_ms(res, MAX_INTENTOS);
+    HAL_Delay(REPOSO_MS);
+
+    /* UART7 deja de responder: sólo ese sensor se detiene y se reinicia */
+    sps30_sim[2].mudo = true;
+    ciclo_ms(res, 2);
+    CHECK(res[0].valido && res[2].valido, "error: los demas siguen");
+    CHECK(!res[1].valido && res[1].error == SHDLC_ERROR_TIMEOUT, "error: timeout");
+    CHECK(!sensores_sps30[1].sensor.midiendo, "error: sensor detenido");
+    CHECK(sps30_sim[1].starts == 1 && sps30_sim[3].starts == 1, "error: sin reinicio ajeno");
+
+    sps30_sim[2].mudo = false;
+    HAL_Delay(REPOSO_MS);
+    ciclo_ms(res, MAX_INTENTOS);
+    CHECK(res[1].valido && sps30_sim[2].starts == 2 && sps30_sim[2].midiendo,
+          "error: reinicio al recuperarse");
+    CHECK(sps30_sim[1].starts == 1, "error: los demas siguen sin START");
+}
+
+static void test_cambio_de_modo(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar(true);
+    ciclo_ms(res, MAX_INTENTOS);
+    sps30_multi_set_continuo(false);
+    for (int i = 0; i < NUM_SENSORES_SPS30; i++) {
+        CHECK(!sps30_sim[sensores_sps30[i].uart->id].midiendo, "modo: sensores detenidos");
+    }
+    CHECK(!sps30_multi_es_continuo(), "modo: por ciclo");
+}
+
+static void bench(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+    uint32_t total[2];
+    uint32_t starts[2];
+
+    for (int modo = 0; modo < 2; modo++) {
+        preparar(modo == 1);
+        total[modo] = 0;
+        for (int c = 0; c < CICLOS_BENCH; c++) {
+            total[modo] += ciclo_ms(res, MAX_INTENTOS);
+            CHECK(res[0].valido && res[1].valido && res[2].valido, "bench: lecturas");
+            HAL_Delay(REPOSO_MS);
+        }
+        starts[modo] = sps30_sim[1].starts + sps30_sim[2].starts + sps30_sim[3].starts;
+    }
+    printf("BENCH %d ciclos por ciclo: %u ms, %u START\n", CICLOS_BENCH, total[0], starts[0]);
+    printf("BENCH %d ciclos continuo: %u ms, %u START\n", CICLOS_BENCH, total[1], starts[1]);
+    CHECK(starts[1] == NUM_SENSORES_SPS30, "bench: un START por sensor");
+    CHECK(total[1] * 5 < total[0], "bench: el modo continuo no es mas rapido");
+}
+
+int main(void) {
+    test_primer_ciclo_y_regimen();
+    test_sin_dato_nuevo();
+    test_poll();
+    test_start_rechazado();
+    test_error_reinicia();
+    test_cambio_de_modo();
+    bench();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#define UNIT_TESTING
+#define INC_UART_H_ /* Se usa el stub de uart.h en lugar del de APIs/Inc */
+#include "stubs/uart.h"
+#include "stubs/uart_double.h"
+#include "stubs/sps30_sim.h"
+#include "../APIs/Src/shdlc.c"
+#include "../APIs/Src/sps30_comm.c"
+#include "../APIs/Src/sps30_multi.c"
+#include "../APIs/Src/uart_callbacks.c"
+
+UART_HandleTypeDef huart5 = {.id = 1};
+UART_HandleTypeDef huart7 = {.id = 2};
+UART_HandleTypeDef huart1 = {.id = 3};
+
+static int fallas = 0;
+static volatile uint32_t sumidero;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+/* Medición típica en interior: masa [µg/m³], número [#/cm³] y tamaño típico */
+static const float tipica[10] = {4.2f, 6.8f, 8.1f, 8.9f, 28.4f, 33.6f, 34.9f, 35.1f, 35.2f, 0.48f};
+
+static uint16_t construir_float(uint8_t * out) {
+    uint8_t datos[SPS30_MEASUREMENT_FLOAT_LEN];
+    for (int k = 0; k < 10; k++) {
+        uint32_t raw;
+        memcpy(&raw, &tipica[k], sizeof(raw));
+        datos[4 * k] = (uint8_t)(raw >> 24);
+        datos[4 * k + 1] = (uint8_t)(raw >> 16);
+        datos[4 * k + 2] = (uint8_t)(raw >> 8);
+        datos[4 * k + 3] = (uint8_t)raw;
+    }
+    return sps30_sim_construir_frame(SPS30_CMD_READ_MEASUREMENT, 0x00, datos, sizeof(datos), out);
+}
+
+static uint16_t construir_u16(uint8_t * out) {
+    uint8_t datos[SPS30_MEASUREMENT_UINT16_LEN];
+    for (int k = 0; k < 10; k++) {
+        /* El tamaño típico viaja en nm; el resto redondeado a la unidad */
+        uint16_t v = (uint16_t)(k == 9 ? tipica[k] * 1000.0f + 0.5f : tipica[k] + 0.5f);
+        datos[2 * k] = (uint8_t)(v >> 8);
+        datos[2 * k + 1] = (uint8_t)v;
+    }
+    return sps30_sim_construir_frame(SPS30_CMD_READ_MEASUREMENT, 0x00, datos, sizeof(datos), out);
+}
+
+static void preparar(void) {
+    uart_double_reset();
+    sps30_sim_reset();
+    uart_double_set_responder(sps30_sim_responder);
+    huart5.dma_activo = huart7.dma_activo = huart1.dma_activo = 0;
+    inicializar_sensores_sps30();
+}
+
+static void test_decodificador_u16(void) {
+    const uint8_t datos[] = {0x00, 0x04, 0x00, 0x07, 0x00, 0x08, 0x00, 0x09, 0x00, 0x1C,
+                             0x00, 0x22, 0x00, 0x23, 0x00, 0x23, 0x01, 0x23, 0x01, 0xE0};
+    ConcentracionesPMU16 u;
+    ConcentracionesPM f;
+
+    SHDLC_llenarMedicionU16(&u, datos, sizeof(datos));
+    CHECK(u.pm1_0 == 4 && u.pm2_5 == 7 && u.pm10 == 9 && u.nc10 == 0x123 &&
+              u.tamano_tipico_nm == 480,
+          "u16: valores");
+    SHDLC_ConcentracionesDesdeU16(&f, &u);
+    CHECK(f.pm2_5 == 7.0f && f.numero.nc10 == 291.0f && f.numero.tamano_tipico == 0.48f,
+          "u16: conversion a float");
+
+    SHDLC_llenarMedicionU16(&u, datos, 8);
+    CHECK(u.pm10 == 9 && u.nc0_5 == 0 && u.tamano_tipico_nm == 0, "u16: registro parcial");
+}
+
+static void test_sensor_u16(void) {
+    preparar();
+    SPS30 * s = &sensores_sps30[1].sensor;
+    ConcentracionesPM pm;
+    ConcentracionesPMU16 u;
+
+    s->formato = SPS30_FORMATO_UINT16;
+    s->start_measurement(s);
+    CHECK(sps30_sim[2].formato == SPS30_FORMATO_UINT16, "sensor: START pide uint16");
+
+    CHECK(s->read_concentrations(s, &pm) == SHDLC_OK, "sensor: lectura");
+    CHECK(pm.pm2_5 == sps30_sim_valor(2, 1) && pm.numero.nc10 == sps30_sim_valor(2, 8),
+          "sensor: valores");
+    CHECK(pm.numero.tamano_tipico == sps30_sim_valor(2, 9) / 1000.0f, "sensor: tamano en um");
+
+    CHECK(s->read_concentrations_u16(s, &u) == SHDLC_OK, "sensor: lectura entera");
+    CHECK(u.pm10 == 23 && u.tamano_tipico_nm == 29, "sensor: valores enteros");
+
+    /* Un sensor en formato float no puede entregar el registro entero */
+    SPS30 * f = &sensores_sps30[0].sensor;
+    f->start_measurement(f);
+    CHECK(sps30_sim[1].formato == SPS30_FORMATO_FLOAT, "float: START pide float");
+    CHECK(f->read_concentrations_u16(f, &u) == SHDLC_ERROR_LENGTH, "float: sin lectura entera");
+    CHECK(f->read_concentrations(f, &pm) == SHDLC_OK && pm.pm10 == sps30_sim_valor(1, 3),
+          "float: lectura");
+}
+
+static void test_multi_formatos_mezclados(void) {
+    SPS30_Adquisicion res[NUM_SENSORES_SPS30];
+
+    preparar();
+    sensores_sps30[2].sensor.formato = SPS30_FORMATO_UINT16;
+    CHECK(sps30_multi_adquirir(res, 1, NULL) == NUM_SENSORES_SPS30, "multi: lecturas");
+    for (int i = 0; i < NUM_SENSORES_SPS30; i++) {
+        int id = sensores_sps30[i].uart->id;
+        CHECK(res[i].valido && res[i].pm.pm4_0 == sps30_sim_valor(id, 2), "multi: valores");
+    }
+}
+
+static uint32_t tiempo_read_us(SPS30 * s) {
+    ConcentracionesPM pm;
+    uint32_t t0 = uart_double_now_us();
+    s->read_concentrations(s, &pm);
+    return uart_double_now_us() - t0;
+}
+
+static double segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void bench(void) {
+    uint8_t frame_f[128], frame_u[128], buf[128];
+    uint16_t n_f = construir_float(frame_f);
+    uint16_t n_u = construir_u16(frame_u);
+    const int iteraciones = 1000000;
+    ConcentracionesPM pm;
+    ConcentracionesPMU16 u;
+
+    /* Bytes en el cable y tiempo de UART de una lectura completa (115200 bps) */
+    preparar();
+    SPS30 * s = &sensores_sps30[0].sensor;
+    s->start_measurement(s);
+    uint32_t t_float = tiempo_read_us(s);
+    s->formato = SPS30_FORMATO_UINT16;
+    s->start_measurement(s);
+    uint32_t t_u16 = tiempo_read_us(s);
+    printf("BENCH bytes MISO: float %u, uint16 %u\n", n_f, n_u);
+    printf("BENCH lectura UART: float %u us, uint16 %u us\n", t_float, t_u16);
+    CHECK(n_u * 10 < n_f * 7, "bench: el frame uint16 no es mas corto");
+    CHECK(t_u16 < t_float, "bench: la lectura uint16 no es mas rapida");
+
+    double t0 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        memcpy(buf, frame_f, n_f);
+        SHDLC_DecodeConcentracionesInPlace(buf, n_f, 0x00, SPS30_CMD_READ_MEASUREMENT, &pm);
+        sumidero += (uint32_t)pm.pm2_5;
+    }
+    double t1 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        size_t n = n_u;
+        memcpy(buf, frame_u, n_u);
+        if (SHDLC_UnstuffFrameInPlace(buf, &n) == SHDLC_OK) {
+            SHDLC_llenarMedicionU16(&u, &buf[SHDLC_MISO_HEADER_SIZE], buf[3]);
+        }
+        sumidero += u.pm2_5;
+    }
+    double t2 = segundos();
+    printf("BENCH decodificacion: float %.1f ns, uint16 %.1f ns\n",
+           (t1 - t0) * 1e9 / iteraciones, (t2 - t1) * 1e9 / iteraciones);
+    CHECK(u.pm2_5 == 7 && u.tamano_tipico_nm == 480, "bench: valores uint16");
+}
+
+int main(void) {
+    test_decodificador_u16();
+    test_sensor_u16();
+    test_multi_formatos_mezclados();
+    bench();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <string.h>
+#define UNIT_TESTING
+#define INC_UART_H_ /* Se usa el stub de uart.h en lugar del de APIs/Inc */
+#include "stubs/uart.h"
+#include "stubs/uart_double.h"
+#include "stubs/sps30_sim.h"
+#include "../APIs/Src/shdlc.c"
+#include "../APIs/Src/sps30_comm.c"
+#include "../APIs/Src/sps30_multi.c"
+#include "../APIs/Src/uart_callbacks.c"
+
+UART_HandleTypeDef huart5 = {.id = 1};
+UART_HandleTypeDef huart7 = {.id = 2};
+UART_HandleTypeDef huart1 = {.id = 3};
+
+static int fallas = 0;
+static uint32_t bytes_callback[4]; /* Bytes informados por el callback, por id de UART */
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static void contar_bytes(SensorSPS30 * s, uint16_t nuevos) {
+    bytes_callback[s->uart->id] += nuevos;
+}
+
+static void test_inicializacion(void) {
+    inicializar_sensores_sps30();
+    CHECK(sensores_disponibles == 3, "init: sensores");
+    for (int i = 0; i < sensores_disponibles; i++) {
+        CHECK(sensores_sps30[i].dma_activo, "init: dma activo");
+        CHECK(sensores_sps30[i].sensor.receive_frame == sps30_dma_receive_frame,
+              "init: metodos DMA");
+        sps30_multi_set_callback(&sensores_sps30[i], contar_bytes);
+    }
+}
+
+static void test_lectura_concurrente(void) {
+    ConcentracionesPM conc[NUM_SENSORES_SPS30];
+    Shdlc_Error errores[NUM_SENSORES_SPS30];
+
+    /* Referencia: los tres sensores consultados uno tras otro */
+    uint32_t t0 = uart_double_now_us();
+    for (int i = 0; i < sensores_disponibles; i++) {
+        SPS30 * s = &sensores_sps30[i].sensor;
+        ConcentracionesPM c = s->get_concentrations(s);
+        CHECK(c.pm2_5 == sps30_sim_valor(sensores_sps30[i].uart->id, 1), "secuencial: valor");
+    }
+    uint32_t secuencial = uart_double_now_us() - t0;
+
+    t0 = uart_double_now_us();
+    int ok = sps30_multi_leer_todos(conc, errores);
+    uint32_t concurrente = uart_double_now_us() - t0;
+
+    CHECK(ok == 3, "concurrente: respuestas");
+    for (int i = 0; i < 3; i++) {
+        int id = sensores_sps30[i].uart->id;
+        CHECK(errores[i] == SHDLC_OK, "concurrente: valido");
+        CHECK(conc[i].pm1_0 == sps30_sim_valor(id, 0) && conc[i].pm10 == sps30_sim_valor(id, 3),
+              "concurrente: valores");
+        CHECK(conc[i].numero.nc0_5 == sps30_sim_valor(id, 4) &&
+                  conc[i].numero.tamano_tipico == sps30_sim_valor(id, 9),
+              "concurrente: registro completo");
+    }
+    CHECK(concurrente * 2 < secuencial, "concurrente: no es mas rapido");
+    printf("BENCH secuencial: %u us, concurrente: %u us\n", secuencial, concurrente);
+}
+
+static void test_vuelta_de_buffer(void) {
+    /* Frames de 47+ bytes sobre un DMA de 64: varias lecturas obligan a dar la vuelta */
+    ConcentracionesPM conc[NUM_SENSORES_SPS30];
+    Shdlc_Error errores[NUM_SENSORES_SPS30];
+    memset(bytes_callback, 0, sizeof(bytes_callback));
+
+    for (int r = 0; r < 10; r++) {
+        CHECK(sps30_multi_leer_todos(conc, errores) == 3, "vuelta: lectura");
+    }
+    for (int id = 1; id <= 3; id++) {
+        CHECK(bytes_callback[id] >= 10 * 47, "vuelta: bytes en callback");
+    }
+    for (int i = 0; i < 3; i++) {
+        CHECK(sensores_sps30[i].rx.descartados == 0, "vuelta: descartados");
+    }
+}
+
+static void test_sensor_mudo(void) {
+    ConcentracionesPM conc[NUM_SENSORES_SPS30];
+    Shdlc_Error errores[NUM_SENSORES_SPS30];
+
+    sps30_sim[2].mudo = true;
+    CHECK(sps30_multi_leer_todos(conc, errores) == 2, "mudo: respuestas");
+    CHECK(errores[0] == SHDLC_OK && errores[1] == SHDLC_ERROR_TIMEOUT && errores[2] == SHDLC_OK,
+          "mudo: errores");
+    CHECK(conc[1].pm2_5 == 0.0f, "mudo: concentracion en cero");
+    sps30_sim[2].mudo = false;
+}
+
+static void test_comandos_crudos(void) {
+    /* start/stop/serial usan receive_async y send_receive sobre el ring buffer */
+    SPS30 * s = &sensores_sps30[0].sensor;
+    uint8_t cmd[] = SPS30_FRAME_STOP_MEASUREMENT;
+    uint8_t resp[16] = {0};
+
+    CHECK(s->send_receive(s, cmd, sizeof(cmd), resp, sizeof(resp)), "crudo: send_receive");
+    CHECK(resp[0] == 0x7E && resp[2] == SPS30_CMD_STOP_MEASUREMENT && resp[6] == 0x7E,
+          "crudo: frame");
+}
+
+static void test_reinicio_tras_error(void) {
+    ConcentracionesPM conc[NUM_SENSORES_SPS30];
+    Shdlc_Error errores[NUM_SENSORES_SPS30];
+
+    uart_double_error(&huart7);
+    CHECK(sensores_sps30[1].dma_activo && huart7.dma_activo, "error: DMA reiniciado");
+    CHECK(sps30_multi_leer_todos(conc, errores) == 3, "error: lectura posterior");
+}
+
+static void test_ring_lleno(void) {
+    SensorSPS30 * s = &sensores_sps30[0];
+    uint8_t basura[200];
+    memset(basura, 0x55, sizeof(basura));
+
+    rx_descartar(s);
+    uart_double_responder(&huart5, basura, sizeof(basura), 0);
+    uart_double_avanzar_us(sizeof(basura) * UART_DOUBLE_BYTE_US * 2);
+    CHECK(s->rx.descartados == sizeof(basura) - (SPS30_RX_RING_SIZE - 1), "ring: descartados");
+    rx_descartar(s);
+}
+
+int main(void) {
+    uart_double_reset();
+    sps30_sim_reset();
+    uart_double_set_responder(sps30_sim_responder);
+
+    test_inicializacion();
+    test_lectura_concurrente();
+    test_vuelta_de_buffer();
+    test_sensor_mudo();
+    test_comandos_crudos();
+    test_reinicio_tras_error();
+    test_ring_lleno();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -1,12 +1,14 @@
 #ifndef PARTICULATEDATAANALYZER_H
 #define PARTICULATEDATAANALYZER_H
 #include <stdint.h>
+#include "shdlc.h"
 typedef struct {
     uint8_t sensor_id;
     float pm1_0;
     float pm2_5;
     float pm4_0;
     float pm10;
+    ConcentracionesNumero numero;
     float temp_amb;
     float hum_amb;
     float temp_cam;
@@ -0,0 +1,37 @@
+#ifndef _DISKIO_DEFINED
+#define _DISKIO_DEFINED
+/* Doble de diskio.h de FatFs R0.12 para pruebas en host: tipos y códigos que usa fatfs_sd.c */
+#include "ff.h"
+
+typedef BYTE DSTATUS;
+
+typedef enum {
+    RES_OK = 0, /* 0: Successful */
+    RES_ERROR,  /* 1: R/W Error */
+    RES_WRPRT,  /* 2: Write Protected */
+    RES_NOTRDY, /* 3: Not Ready */
+    RES_PARERR  /* 4: Invalid Parameter */
+} DRESULT;
+
+/* Disk Status Bits (DSTATUS) */
+#define STA_NOINIT  0x01
+#define STA_NODISK  0x02
+#define STA_PROTECT 0x04
+
+/* Generic command (Used by FatFs) */
+#define CTRL_SYNC        0
+#define GET_SECTOR_COUNT 1
+#define GET_SECTOR_SIZE  2
+#define GET_BLOCK_SIZE   3
+#define CTRL_TRIM        4
+
+/* Generic command (Not used by FatFs) */
+#define CTRL_POWER 5
+
+/* MMC/SDC specific ioctl command */
+#define MMC_GET_TYPE 10
+#define MMC_GET_CSD  11
+#define MMC_GET_CID  12
+#define MMC_GET_OCR  13
+
+#endif
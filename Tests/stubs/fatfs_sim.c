@@ -0,0 +1,493 @@
+/* Doble de FatFs en memoria con conteo de llamadas y de sectores (ver fatfs_sim.h) */
+#include "fatfs_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_ARCHIVOS    64
+#define SIM_DIRECTORIOS 64
+#define SIM_RUTA_MAX    96
+
+/* Identificadores de sector: el tipo en los bits altos separa datos, directorios y FAT */
+#define SECTOR_NINGUNO 0xFFFFFFFFu
+#define SECTOR_DATOS   0x00000000u
+#define SECTOR_DIR     0x40000000u
+#define SECTOR_FAT     0x80000000u
+
+typedef struct {
+    bool usado;
+    char ruta[SIM_RUTA_MAX];
+    uint8_t * datos;
+    uint32_t capacidad;
+    uint32_t tamano;
+    uint32_t tamano_dir; /* Tamaño en la entrada de directorio (actualizado por f_sync) */
+    uint32_t clusters;
+    uint32_t primer_cluster;
+    bool abierto;
+    bool modificado;
+} ArchivoSim;
+
+FatfsSim_Contadores fatfs_sim;
+
+static ArchivoSim archivos[SIM_ARCHIVOS];
+static char directorios[SIM_DIRECTORIOS][SIM_RUTA_MAX];
+static int num_directorios;
+static uint32_t proximo_cluster;
+static uint32_t ventana = SECTOR_NINGUNO;
+static bool ventana_sucia;
+static FRESULT falla_escritura = FR_OK;
+static FRESULT falla_sync = FR_OK;
+
+/* === Ventana de sector compartida (_FS_TINY) ================================================= */
+
+static void sincronizar_ventana(void) {
+    if (ventana_sucia) {
+        fatfs_sim.sectores_escritos++;
+        fatfs_sim.escrituras_disco++;
+        ventana_sucia = false;
+    }
+}
+
+static void mover_ventana(uint32_t sector) {
+    if (ventana != sector) {
+        sincronizar_ventana();
+        fatfs_sim.sectores_leidos++;
+        ventana = sector;
+    }
+}
+
+static uint32_t sector_datos(int id, uint32_t pos) {
+    return SECTOR_DATOS | ((uint32_t)id << 20) | (pos / _MAX_SS);
+}
+
+static uint32_t sector_fat(uint32_t cluster) {
+    return SECTOR_FAT | (cluster / FATFS_SIM_ENTRADAS_SECTOR);
+}
+
+static uint32_t sector_directorio(const char * dir) {
+    uint32_t h = 5381;
+    while (*dir) {
+        h = h * 33u + (uint8_t)*dir++;
+    }
+    return SECTOR_DIR | (h & 0x3FFFFFFFu);
+}
+
+/* === Rutas ==================================================================================== */
+
+/* Directorio que contiene a ruta ("" para la raíz) */
+static void directorio_padre(const char * ruta, char * padre) {
+    const char * barra = strrchr(ruta, '/');
+    size_t n = (barra != NULL) ? (size_t)(barra - ruta) : 0;
+    memcpy(padre, ruta, n);
+    padre[n] = '\0';
+}
+
+static bool existe_directorio(const char * dir) {
+    if (dir[0] == '\0') {
+        return true;
+    }
+    for (int i = 0; i < num_directorios; i++) {
+        if (strcmp(directorios[i], dir) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Recorre los directorios de la ruta como f_open/f_stat: carga un sector por nivel */
+static FRESULT recorrer_ruta(const char * ruta) {
+    char parcial[SIM_RUTA_MAX];
+    size_t n = strlen(ruta);
+
+    if (n == 0 || n >= SIM_RUTA_MAX) {
+        return FR_INVALID_NAME;
+    }
+    for (size_t i = 0; i <= n; i++) {
+        if (i == n || (ruta[i] == '/' && i > 0)) {
+            memcpy(parcial, ruta, i);
+            parcial[i] = '\0';
+            char padre[SIM_RUTA_MAX];
+            directorio_padre(parcial, padre);
+            if (!existe_directorio(padre)) {
+                return FR_NO_PATH;
+            }
+            mover_ventana(sector_directorio(padre));
+        }
+    }
+    return FR_OK;
+}
+
+static ArchivoSim * buscar_archivo(const char * ruta) {
+    for (int i = 0; i < SIM_ARCHIVOS; i++) {
+        if (archivos[i].usado && strcmp(archivos[i].ruta, ruta) == 0) {
+            return &archivos[i];
+        }
+    }
+    return NULL;
+}
+
+static ArchivoSim * archivo_de(FIL * fp) {
+    if (fp == NULL || fp->obj.id < 0 || fp->obj.id >= SIM_ARCHIVOS ||
+        !archivos[fp->obj.id].abierto) {
+        return NULL;
+    }
+    return &archivos[fp->obj.id];
+}
+
+static void asegurar_capacidad(ArchivoSim * a, uint32_t n) {
+    if (n > a->capacidad) {
+        uint32_t nueva = a->capacidad ? a->capacidad : 1024;
+        while (nueva < n) {
+            nueva *= 2;
+        }
+        a->datos = realloc(a->datos, nueva);
+        a->capacidad = nueva;
+    }
+}
+
+/* Reserva clusters hasta cubrir n bytes; cada uno actualiza la FAT a través de la ventana */
+static void asignar_clusters(ArchivoSim * a, uint32_t n) {
+    const uint32_t bytes_cluster = FATFS_SIM_SECTORES_CLUSTER * _MAX_SS;
+    while (a->clusters * bytes_cluster < n) {
+        uint32_t cluster = proximo_cluster++;
+        if (a->clusters == 0) {
+            a->primer_cluster = cluster;
+        }
+        a->clusters++;
+        mover_ventana(sector_fat(cluster));
+        ventana_sucia = true;
+    }
+}
+
+/* === API de control del doble ================================================================= */
+
+void fatfs_sim_reset(void) {
+    for (int i = 0; i < SIM_ARCHIVOS; i++) {
+        free(archivos[i].datos);
+    }
+    memset(archivos, 0, sizeof(archivos));
+    num_directorios = 0;
+    proximo_cluster = 2;
+    ventana = SECTOR_NINGUNO;
+    ventana_sucia = false;
+    falla_escritura = FR_OK;
+    falla_sync = FR_OK;
+    fatfs_sim_reset_contadores();
+}
+
+void fatfs_sim_reset_contadores(void) {
+    memset(&fatfs_sim, 0, sizeof(fatfs_sim));
+}
+
+void fatfs_sim_fallar_escritura(FRESULT res) {
+    falla_escritura = res;
+}
+
+void fatfs_sim_fallar_sync(FRESULT res) {
+    falla_sync = res;
+}
+
+const uint8_t * fatfs_sim_contenido(const char * ruta, uint32_t * largo) {
+    ArchivoSim * a = buscar_archivo(ruta);
+    if (a == NULL) {
+        *largo = 0;
+        return NULL;
+    }
+    *largo = a->tamano;
+    return a->datos;
+}
+
+uint32_t fatfs_sim_tamano_directorio(const char * ruta) {
+    ArchivoSim * a = buscar_archivo(ruta);
+    return (a != NULL) ? a->tamano_dir : 0;
+}
+
+bool fatfs_sim_existe_directorio(const char * ruta) {
+    return existe_directorio(ruta);
+}
+
+int fatfs_sim_abiertos(void) {
+    int n = 0;
+    for (int i = 0; i < SIM_ARCHIVOS; i++) {
+        n += archivos[i].abierto;
+    }
+    return n;
+}
+
+/* === API de FatFs ============================================================================= */
+
+FRESULT f_mount(FATFS * fs, const TCHAR * path, BYTE opt) {
+    (void)path;
+    (void)opt;
+    if (fs != NULL) {
+        fs->montado = 1;
+    }
+    ventana = SECTOR_NINGUNO;
+    ventana_sucia = false;
+    return FR_OK;
+}
+
+FRESULT f_open(FIL * fp, const TCHAR * path, BYTE mode) {
+    fatfs_sim.f_open++;
+    fp->obj.id = -1;
+
+    FRESULT res = recorrer_ruta(path);
+    if (res != FR_OK) {
+        return res;
+    }
+    if (fatfs_sim_abiertos() >= _FS_LOCK) {
+        return FR_TOO_MANY_OPEN_FILES;
+    }
+
+    ArchivoSim * a = buscar_archivo(path);
+    if (a != NULL && a->abierto) {
+        return FR_LOCKED;
+    }
+    if (a != NULL && (mode & FA_CREATE_NEW)) {
+        return FR_EXIST;
+    }
+    if (a == NULL) {
+        if (!(mode & (FA_CREATE_NEW | FA_CREATE_ALWAYS | FA_OPEN_ALWAYS))) {
+            return FR_NO_FILE;
+        }
+        for (int i = 0; i < SIM_ARCHIVOS && a == NULL; i++) {
+            if (!archivos[i].usado) {
+                a = &archivos[i];
+            }
+        }
+        if (a == NULL) {
+            return FR_DENIED;
+        }
+        memset(a, 0, sizeof(*a));
+        a->usado = true;
+        strcpy(a->ruta, path);
+        ventana_sucia = true; /* Entrada nueva en el sector de directorio */
+    } else if (mode & FA_CREATE_ALWAYS) {
+        a->tamano = 0;
+        a->modificado = true;
+    }
+
+    a->abierto = true;
+    fp->obj.id = (int)(a - archivos);
+    fp->obj.objsize = a->tamano;
+    fp->flag = mode;
+    fp->err = 0;
+    fp->fptr = 0;
+    if ((mode & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+        return f_lseek(fp, a->tamano);
+    }
+    return FR_OK;
+}
+
+FRESULT f_lseek(FIL * fp, FSIZE_t ofs) {
+    fatfs_sim.f_lseek++;
+    ArchivoSim * a = archivo_de(fp);
+    if (a == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    if (ofs > a->tamano && !(fp->flag & FA_WRITE)) {
+        ofs = a->tamano;
+    }
+    /* Seguir la cadena de clusters lee la FAT (asignación contigua: un sector) */
+    if (ofs >= FATFS_SIM_SECTORES_CLUSTER * _MAX_SS && a->clusters > 0) {
+        mover_ventana(sector_fat(a->primer_cluster));
+    }
+    if (ofs > a->tamano) {
+        asignar_clusters(a, ofs);
+        asegurar_capacidad(a, ofs);
+        memset(&a->datos[a->tamano], 0, ofs - a->tamano);
+        a->tamano = ofs;
+        fp->obj.objsize = ofs;
+        a->modificado = true;
+    }
+    fp->fptr = ofs;
+    return FR_OK;
+}
+
+FRESULT f_write(FIL * fp, const void * buff, UINT btw, UINT * bw) {
+    fatfs_sim.f_write++;
+    *bw = 0;
+    ArchivoSim * a = archivo_de(fp);
+    if (a == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    if (!(fp->flag & FA_WRITE)) {
+        return FR_DENIED;
+    }
+    if (falla_escritura != FR_OK) {
+        FRESULT res = falla_escritura;
+        falla_escritura = FR_OK;
+        fp->err = (BYTE)res;
+        return res;
+    }
+
+    const uint8_t * datos = buff;
+    int id = fp->obj.id;
+    uint32_t resto = btw;
+
+    while (resto > 0) {
+        uint32_t pos = fp->fptr;
+        uint32_t en_sector = pos % _MAX_SS;
+        uint32_t n;
+
+        uint32_t completos = 0;
+
+        if (en_sector == 0) {
+            asignar_clusters(a, pos + 1);
+            /* Sectores completos: escritura directa sin pasar por la ventana, hasta fin de
+             * cluster */
+            uint32_t hasta_cluster = FATFS_SIM_SECTORES_CLUSTER -
+                                     (pos / _MAX_SS) % FATFS_SIM_SECTORES_CLUSTER;
+            completos = resto / _MAX_SS;
+            if (completos > hasta_cluster) {
+                completos = hasta_cluster;
+            }
+            if (completos == 0 && pos >= a->tamano) {
+                /* Borde de crecimiento: no hace falta leer el sector */
+                sincronizar_ventana();
+                ventana = sector_datos(id, pos);
+            }
+        }
+
+        if (completos > 0) {
+            uint32_t primero = sector_datos(id, pos);
+            if (ventana >= primero && ventana < primero + completos) {
+                ventana_sucia = false; /* La ventana queda con los datos nuevos */
+            }
+            fatfs_sim.sectores_escritos += completos;
+            fatfs_sim.escrituras_disco++;
+            fatfs_sim.escrituras_multibloque += (completos > 1);
+            n = completos * _MAX_SS;
+        } else {
+            n = _MAX_SS - en_sector;
+            if (n > resto) {
+                n = resto;
+            }
+            mover_ventana(sector_datos(id, pos));
+            ventana_sucia = true;
+        }
+
+        asegurar_capacidad(a, pos + n);
+        memcpy(&a->datos[pos], datos, n);
+        datos += n;
+        resto -= n;
+        fp->fptr = pos + n;
+        if (fp->fptr > a->tamano) {
+            a->tamano = fp->fptr;
+        }
+    }
+
+    fp->obj.objsize = a->tamano;
+    a->modificado = true;
+    fatfs_sim.f_write_sin_alinear += (fp->fptr % _MAX_SS != 0);
+    *bw = btw;
+    return FR_OK;
+}
+
+FRESULT f_read(FIL * fp, void * buff, UINT btr, UINT * br) {
+    fatfs_sim.f_read++;
+    *br = 0;
+    ArchivoSim * a = archivo_de(fp);
+    if (a == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    if (fp->fptr + btr > a->tamano) {
+        btr = a->tamano - fp->fptr;
+    }
+    for (uint32_t pos = fp->fptr; pos < fp->fptr + btr; pos = (pos / _MAX_SS + 1) * _MAX_SS) {
+        mover_ventana(sector_datos(fp->obj.id, pos));
+    }
+    memcpy(buff, &a->datos[fp->fptr], btr);
+    fp->fptr += btr;
+    *br = btr;
+    return FR_OK;
+}
+
+/* Actualiza tamaño y fecha en la entrada de directorio y vacía la ventana */
+static FRESULT sincronizar_archivo(ArchivoSim * a) {
+    if (falla_sync != FR_OK) {
+        FRESULT res = falla_sync;
+        falla_sync = FR_OK;
+        return res;
+    }
+    if (a->modificado) {
+        char padre[SIM_RUTA_MAX];
+        directorio_padre(a->ruta, padre);
+        mover_ventana(sector_directorio(padre));
+        ventana_sucia = true;
+        sincronizar_ventana();
+        a->tamano_dir = a->tamano;
+        a->modificado = false;
+    }
+    return FR_OK;
+}
+
+FRESULT f_sync(FIL * fp) {
+    fatfs_sim.f_sync++;
+    ArchivoSim * a = archivo_de(fp);
+    if (a == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    return sincronizar_archivo(a);
+}
+
+FRESULT f_close(FIL * fp) {
+    fatfs_sim.f_close++;
+    ArchivoSim * a = archivo_de(fp);
+    if (a == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    FRESULT res = sincronizar_archivo(a);
+    a->abierto = false;
+    fp->obj.id = -1;
+    return res;
+}
+
+FRESULT f_mkdir(const TCHAR * path) {
+    fatfs_sim.f_mkdir++;
+    FRESULT res = recorrer_ruta(path);
+    if (res != FR_OK) {
+        return res;
+    }
+    if (existe_directorio(path) || buscar_archivo(path) != NULL) {
+        return FR_EXIST;
+    }
+    if (num_directorios >= SIM_DIRECTORIOS) {
+        return FR_DENIED;
+    }
+
+    /* Cluster nuevo en la FAT, cluster del directorio en cero y entrada en el padre */
+    mover_ventana(sector_fat(proximo_cluster++));
+    ventana_sucia = true;
+    sincronizar_ventana();
+    fatfs_sim.sectores_escritos += FATFS_SIM_SECTORES_CLUSTER;
+    fatfs_sim.escrituras_disco++;
+    fatfs_sim.escrituras_multibloque++;
+    char padre[SIM_RUTA_MAX];
+    directorio_padre(path, padre);
+    mover_ventana(sector_directorio(padre));
+    ventana_sucia = true;
+    sincronizar_ventana();
+
+    strcpy(directorios[num_directorios++], path);
+    return FR_OK;
+}
+
+FRESULT f_stat(const TCHAR * path, FILINFO * fno) {
+    fatfs_sim.f_stat++;
+    FRESULT res = recorrer_ruta(path);
+    if (res != FR_OK) {
+        return res;
+    }
+    ArchivoSim * a = buscar_archivo(path);
+    if (a == NULL && !existe_directorio(path)) {
+        return FR_NO_FILE;
+    }
+    if (fno != NULL) {
+        memset(fno, 0, sizeof(*fno));
+        fno->fsize = (a != NULL) ? a->tamano_dir : 0;
+        fno->fattrib = (a != NULL) ? 0 : AM_DIR;
+        const char * nombre = strrchr(path, '/');
+        strncpy(fno->fname, nombre ? nombre + 1 : path, sizeof(fno->fname) - 1);
+    }
+    return FR_OK;
+}
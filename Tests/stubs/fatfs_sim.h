@@ -0,0 +1,53 @@
+#ifndef FATFS_SIM_H
+#define FATFS_SIM_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "ff.h"
+
+/* Geometría simulada: clusters de 32 KiB (SDHC formateada con valores por defecto) y entradas de
+ * FAT de 4 bytes (FAT32) */
+#define FATFS_SIM_SECTORES_CLUSTER 64
+#define FATFS_SIM_ENTRADAS_SECTOR  (_MAX_SS / 4)
+
+/**
+ * Contadores de llamadas a la API y de sectores transferidos por el controlador de disco.
+ *
+ * El tráfico de sectores sigue a FatFs R0.12 con _FS_TINY: una única ventana de sector compartida
+ * entre datos, directorios y FAT que se escribe al moverla si está sucia, escrituras directas de
+ * sectores completos y lecturas para completar sectores parciales que no están en la ventana.
+ */
+typedef struct {
+    uint32_t f_open;
+    uint32_t f_close;
+    uint32_t f_read;
+    uint32_t f_write;
+    uint32_t f_lseek;
+    uint32_t f_sync;
+    uint32_t f_mkdir;
+    uint32_t f_stat;
+    uint32_t f_write_sin_alinear; /* f_write que terminan a mitad de un sector */
+    uint32_t sectores_leidos;
+    uint32_t sectores_escritos;
+    uint32_t escrituras_disco;       /* Llamadas a disk_write */
+    uint32_t escrituras_multibloque; /* disk_write de más de un sector (CMD25) */
+} FatfsSim_Contadores;
+
+extern FatfsSim_Contadores fatfs_sim;
+
+/* Borra archivos, directorios y contadores: queda una tarjeta vacía y montada */
+void fatfs_sim_reset(void);
+/* Pone en cero sólo los contadores */
+void fatfs_sim_reset_contadores(void);
+/* La próxima llamada a f_write (o f_sync) devuelve res sin escribir */
+void fatfs_sim_fallar_escritura(FRESULT res);
+void fatfs_sim_fallar_sync(FRESULT res);
+
+/* Contenido actual del archivo (NULL si no existe) */
+const uint8_t * fatfs_sim_contenido(const char * ruta, uint32_t * largo);
+/* Tamaño registrado en la entrada de directorio: lo que sobrevive a un corte de energía */
+uint32_t fatfs_sim_tamano_directorio(const char * ruta);
+bool fatfs_sim_existe_directorio(const char * ruta);
+/* Archivos abiertos en este momento */
+int fatfs_sim_abiertos(void);
+
+#endif
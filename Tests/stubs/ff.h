@@ -0,0 +1,88 @@
+#ifndef _FATFS
+#define _FATFS
+/* Doble de FatFs R0.12 para pruebas en host: misma API que el ff.h real, con los archivos en
+ * memoria (ver fatfs_sim.c). Configuración igual a FATFS/Target/ffconf.h. */
+#include <stdint.h>
+
+#define _MAX_SS  512
+#define _FS_TINY 1
+#define _FS_LOCK 6
+
+typedef unsigned int UINT;
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef DWORD FSIZE_t;
+typedef char TCHAR;
+
+typedef enum {
+    FR_OK = 0,
+    FR_DISK_ERR,
+    FR_INT_ERR,
+    FR_NOT_READY,
+    FR_NO_FILE,
+    FR_NO_PATH,
+    FR_INVALID_NAME,
+    FR_DENIED,
+    FR_EXIST,
+    FR_INVALID_OBJECT,
+    FR_WRITE_PROTECTED,
+    FR_INVALID_DRIVE,
+    FR_NOT_ENABLED,
+    FR_NO_FILESYSTEM,
+    FR_MKFS_ABORTED,
+    FR_TIMEOUT,
+    FR_LOCKED,
+    FR_NOT_ENOUGH_CORE,
+    FR_TOO_MANY_OPEN_FILES,
+    FR_INVALID_PARAMETER
+} FRESULT;
+
+typedef struct {
+    int montado;
+} FATFS;
+
+typedef struct {
+    int id;          /* Índice del archivo en el doble (-1 = cerrado) */
+    FSIZE_t objsize; /* Tamaño del archivo */
+} _FDID;
+
+typedef struct {
+    _FDID obj;
+    BYTE flag;
+    BYTE err;
+    FSIZE_t fptr;
+} FIL;
+
+typedef struct {
+    FSIZE_t fsize;
+    WORD fdate;
+    WORD ftime;
+    BYTE fattrib;
+    TCHAR fname[13];
+} FILINFO;
+
+#define FA_READ          0x01
+#define FA_WRITE         0x02
+#define FA_OPEN_EXISTING 0x00
+#define FA_CREATE_NEW    0x04
+#define FA_CREATE_ALWAYS 0x08
+#define FA_OPEN_ALWAYS   0x10
+#define FA_OPEN_APPEND   0x30
+
+#define AM_DIR 0x10
+
+#define f_size(fp) ((fp)->obj.objsize)
+#define f_tell(fp) ((fp)->fptr)
+
+FRESULT f_mount(FATFS * fs, const TCHAR * path, BYTE opt);
+FRESULT f_open(FIL * fp, const TCHAR * path, BYTE mode);
+FRESULT f_close(FIL * fp);
+FRESULT f_read(FIL * fp, void * buff, UINT btr, UINT * br);
+FRESULT f_write(FIL * fp, const void * buff, UINT btw, UINT * bw);
+FRESULT f_lseek(FIL * fp, FSIZE_t ofs);
+FRESULT f_sync(FIL * fp);
+FRESULT f_mkdir(const TCHAR * path);
+FRESULT f_stat(const TCHAR * path, FILINFO * fno);
+
+#endif
@@ -1,5 +1,8 @@
 #ifndef RTC_DS3231_FOR_STM32_HAL_H_
 #define RTC_DS3231_FOR_STM32_HAL_H_
+#include <stdbool.h>
 #include <stdint.h>
 typedef struct {uint8_t seconds;uint8_t minutes;uint8_t hours;uint8_t day;uint8_t month;uint16_t year;} DS3231_DateTime;
+typedef struct {unsigned char hour; unsigned char min; unsigned char sec; unsigned char day; unsigned char month; unsigned short year;} ds3231_time_t;
+bool ds3231_get_datetime(ds3231_time_t* dt);
 #endif
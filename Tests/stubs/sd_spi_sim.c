@@ -0,0 +1,422 @@
+#include "sd_spi_sim.h"
+#include <string.h>
+
+SdSim_Contadores sd_sim;
+GPIO_TypeDef sd_sim_gpiob;
+
+/* === Tarjeta ================================================================================ */
+
+extern SPI_HandleTypeDef hspi1;
+
+static uint8_t memoria[SD_SIM_SECTORES][512];
+static uint32_t reloj_us;
+static uint32_t limite_prescaler;
+static int seleccionada;
+static int inactiva;     /* R1 "in idle state" hasta que ACMD41 termina la inicialización */
+static int intentos_acmd41;
+static int app_cmd;
+
+/* Bytes que la tarjeta pone en MISO, en orden */
+static uint8_t salida[1024];
+static size_t salida_ini, salida_fin;
+static uint32_t ocupado; /* Bytes 0x00 después de una escritura */
+
+static uint8_t comando[6];
+static size_t comando_len;
+
+static int lectura_multiple;
+static uint32_t sector_lectura;
+
+static enum { MODO_COMANDO, MODO_ESCRITURA_UNICA, MODO_ESCRITURA_MULTIPLE } modo;
+static uint8_t bloque[514];
+static size_t bloque_len;
+static int recibiendo_bloque;
+static uint32_t sector_escritura;
+
+static const uint8_t csd[16] = {0x40, 0x0E, 0x00, 0x32, 0x5B, 0x59, 0x00, 0x00,
+                                0x1D, 0x9F, 0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01};
+static const uint8_t cid[16] = {0x03, 'S', 'D', 'S', 'C', '3', '2', 'G',
+                                0x80, 0x12, 0x34, 0x56, 0x78, 0x01, 0x6A, 0x01};
+
+static void encolar(uint8_t b) {
+    if (salida_fin < sizeof(salida)) {
+        salida[salida_fin++] = b;
+    }
+}
+
+static int demasiado_rapido(void) {
+    return hspi1.Init.BaudRatePrescaler < limite_prescaler;
+}
+
+static uint16_t crc16(const uint8_t * datos, size_t n) {
+    uint16_t crc = 0;
+    while (n--) {
+        crc ^= (uint16_t)(*datos++) << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void encolar_bloque(const uint8_t * datos, size_t n) {
+    uint16_t crc = crc16(datos, n);
+    size_t inicio;
+
+    encolar(0xFF); // Tiempo de acceso
+    encolar(0xFE);
+    inicio = salida_fin;
+    for (size_t i = 0; i < n; i++) {
+        encolar(datos[i]);
+    }
+    encolar((uint8_t)(crc >> 8)); // La tarjeta lo envía aunque no verifique el del host
+    encolar((uint8_t)crc);
+    if (demasiado_rapido()) {
+        salida[inicio + n / 2] ^= 0x10;
+        sd_sim.bloques_corruptos++;
+    }
+}
+
+static void vaciar_salida(void) {
+    salida_ini = salida_fin = 0;
+}
+
+static void ejecutar(uint8_t indice, uint32_t arg) {
+    int era_app = app_cmd;
+    app_cmd = 0;
+    sd_sim.comandos++;
+    vaciar_salida();
+
+    if (indice == 12) {
+        lectura_multiple = 0;
+        encolar(0xFF); // Byte de relleno
+        encolar(0x00);
+        ocupado = 4;
+        return;
+    }
+
+    encolar(0xFF); // NCR
+    switch (indice) {
+    case 0:
+        inactiva = 1;
+        intentos_acmd41 = 0;
+        modo = MODO_COMANDO;
+        lectura_multiple = 0;
+        encolar(0x01);
+        break;
+    case 8:
+        encolar(0x01);
+        encolar(0x00);
+        encolar(0x00);
+        encolar((uint8_t)(arg >> 8));
+        encolar((uint8_t)arg);
+        break;
+    case 55:
+        app_cmd = 1;
+        encolar((uint8_t)inactiva);
+        break;
+    case 41:
+        if (era_app && ++intentos_acmd41 >= 2) {
+            inactiva = 0;
+        }
+        encolar(era_app ? (uint8_t)inactiva : 0x04);
+        break;
+    case 58:
+        encolar((uint8_t)inactiva);
+        encolar(0xC0); // Encendida, CCS: direccionamiento por bloques
+        encolar(0xFF);
+        encolar(0x80);
+        encolar(0x00);
+        break;
+    case 9:
+        encolar(0x00);
+        encolar_bloque(csd, sizeof(csd));
+        break;
+    case 10:
+        encolar(0x00);
+        encolar_bloque(cid, sizeof(cid));
+        break;
+    case 16:
+    case 23:
+        encolar(0x00);
+        break;
+    case 17:
+        encolar(0x00);
+        encolar_bloque(memoria[arg % SD_SIM_SECTORES], 512);
+        break;
+    case 18:
+        encolar(0x00);
+        lectura_multiple = 1;
+        sector_lectura = arg;
+        break;
+    case 24:
+    case 25:
+        encolar(0x00);
+        modo = (indice == 24) ? MODO_ESCRITURA_UNICA : MODO_ESCRITURA_MULTIPLE;
+        sector_escritura = arg;
+        recibiendo_bloque = 0;
+        break;
+    default:
+        encolar(0x04); // Comando ilegal
+        break;
+    }
+}
+
+static void recibir_datos(uint8_t b) {
+    if (!recibiendo_bloque) {
+        if (modo == MODO_ESCRITURA_MULTIPLE && b == 0xFD) {
+            modo = MODO_COMANDO; // Stop Tran
+            encolar(0xFF);
+            ocupado = 16;
+        } else if ((modo == MODO_ESCRITURA_UNICA && b == 0xFE) ||
+                   (modo == MODO_ESCRITURA_MULTIPLE && b == 0xFC)) {
+            recibiendo_bloque = 1;
+            bloque_len = 0;
+        }
+        return;
+    }
+
+    bloque[bloque_len++] = b;
+    if (bloque_len < sizeof(bloque)) {
+        return;
+    }
+    if (demasiado_rapido()) {
+        bloque[100] ^= 0x01;
+        sd_sim.bloques_corruptos++;
+    }
+    memcpy(memoria[sector_escritura % SD_SIM_SECTORES], bloque, 512);
+    sector_escritura++;
+    recibiendo_bloque = 0;
+    if (modo == MODO_ESCRITURA_UNICA) {
+        modo = MODO_COMANDO;
+    }
+    vaciar_salida();
+    encolar(0xFF);
+    encolar(0xE5); // Datos aceptados
+    ocupado = 64;
+}
+
+static void avanzar(uint32_t us) {
+    uint32_t antes = reloj_us / 10000u;
+    reloj_us += us;
+    for (uint32_t t = antes; t < reloj_us / 10000u; t++) {
+        if (Timer1 > 0) {
+            Timer1--;
+        }
+        if (Timer2 > 0) {
+            Timer2--;
+        }
+    }
+}
+
+/* Un ciclo de 8 bits del bus: devuelve MISO y procesa MOSI */
+static uint8_t intercambiar(uint8_t mosi) {
+    uint8_t miso = 0xFF;
+
+    // 8 bits a PCLK2 / 2^(BR + 1): 1 us por byte con el prescaler 2
+    avanzar(1u << (hspi1.Init.BaudRatePrescaler >> SPI_CR1_BR_Pos));
+    sd_sim.bytes++;
+    if (!seleccionada) {
+        return 0xFF;
+    }
+
+    if (salida_ini == salida_fin && ocupado == 0 && lectura_multiple) {
+        vaciar_salida();
+        encolar(0xFF); // Separación entre bloques
+        encolar_bloque(memoria[sector_lectura++ % SD_SIM_SECTORES], 512);
+    }
+    if (salida_ini < salida_fin) {
+        miso = salida[salida_ini++];
+    } else if (ocupado > 0) {
+        ocupado--;
+        miso = 0x00;
+    }
+
+    if (modo != MODO_COMANDO) {
+        recibir_datos(mosi);
+    } else if (comando_len > 0 || (mosi & 0xC0) == 0x40) {
+        comando[comando_len++] = mosi;
+        if (comando_len == sizeof(comando)) {
+            comando_len = 0;
+            ejecutar(comando[0] & 0x3F, (uint32_t)comando[1] << 24 | (uint32_t)comando[2] << 16 |
+                                            (uint32_t)comando[3] << 8 | comando[4]);
+        }
+    }
+    return miso;
+}
+
+/* === SPI y DMA ============================================================================== */
+
+static struct {
+    SPI_HandleTypeDef * hspi;
+    const uint8_t * tx;
+    uint8_t * rx;
+    uint16_t n;
+    int activa;
+} dma;
+static SdSim_FallaDma falla_dma;
+
+void sd_sim_reset(void) {
+    memset(memoria, 0, sizeof(memoria));
+    memset(&dma, 0, sizeof(dma));
+    reloj_us = 0;
+    seleccionada = 0;
+    inactiva = 1;
+    intentos_acmd41 = 0;
+    app_cmd = 0;
+    vaciar_salida();
+    ocupado = 0;
+    comando_len = 0;
+    lectura_multiple = 0;
+    modo = MODO_COMANDO;
+    recibiendo_bloque = 0;
+    falla_dma = SD_SIM_DMA_OK;
+    limite_prescaler = SPI_BAUDRATEPRESCALER_2;
+    sd_sim_reset_contadores();
+}
+
+void sd_sim_reset_contadores(void) {
+    memset(&sd_sim, 0, sizeof(sd_sim));
+}
+
+uint8_t * sd_sim_sector(uint32_t sector) {
+    return memoria[sector % SD_SIM_SECTORES];
+}
+
+void sd_sim_fallar_dma(SdSim_FallaDma falla) {
+    falla_dma = falla;
+}
+
+void sd_sim_limite_prescaler(uint32_t prescaler) {
+    limite_prescaler = prescaler;
+}
+
+uint32_t sd_sim_us(void) {
+    return reloj_us;
+}
+
+uint32_t HAL_GetTick(void) {
+    return reloj_us / 1000u;
+}
+
+void HAL_Delay(uint32_t ms) {
+    avanzar(ms * 1000u);
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void) {
+    return SD_SIM_PCLK2_HZ;
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef * hspi) {
+    (void)hspi;
+    sd_sim.cambios_prescaler++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_DeInit(SPI_HandleTypeDef * hspi) {
+    (void)hspi;
+    return HAL_OK;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef * GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    if (GPIOx == SD_CS_GPIO_Port && GPIO_Pin == SD_CS_Pin) {
+        seleccionada = (PinState == GPIO_PIN_RESET);
+        if (!seleccionada) {
+            // Sin CS la tarjeta suelta MISO: se pierde lo que quedaba por enviar
+            vaciar_salida();
+            lectura_multiple = 0;
+            comando_len = 0;
+        }
+    }
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef * hspi, uint8_t * pData, uint16_t Size,
+                                   uint32_t Timeout) {
+    (void)hspi;
+    (void)Timeout;
+    if (dma.activa) {
+        return HAL_BUSY;
+    }
+    sd_sim.llamadas_bloqueantes++;
+    for (uint16_t i = 0; i < Size; i++) {
+        intercambiar(pData[i]);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef * hspi, uint8_t * pTxData,
+                                          uint8_t * pRxData, uint16_t Size, uint32_t Timeout) {
+    (void)hspi;
+    (void)Timeout;
+    if (dma.activa) {
+        return HAL_BUSY;
+    }
+    sd_sim.llamadas_bloqueantes++;
+    for (uint16_t i = 0; i < Size; i++) {
+        pRxData[i] = intercambiar(pTxData[i]);
+    }
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef iniciar_dma(SPI_HandleTypeDef * hspi, const uint8_t * tx, uint8_t * rx,
+                                     uint16_t n) {
+    if (dma.activa) {
+        return HAL_BUSY;
+    }
+    sd_sim.llamadas_dma++;
+    dma.hspi = hspi;
+    dma.tx = tx;
+    dma.rx = rx;
+    dma.n = n;
+    dma.activa = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef * hspi, uint8_t * pData, uint16_t Size) {
+    return iniciar_dma(hspi, pData, NULL, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef * hspi, uint8_t * pTxData,
+                                              uint8_t * pRxData, uint16_t Size) {
+    return iniciar_dma(hspi, pTxData, pRxData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef * hspi) {
+    (void)hspi;
+    dma.activa = 0;
+    if (falla_dma == SD_SIM_DMA_COLGADO) {
+        falla_dma = SD_SIM_DMA_OK;
+    }
+    return HAL_OK;
+}
+
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef * hspi) {
+    (void)hspi;
+    sd_sim.consultas_estado++;
+    return dma.activa ? HAL_SPI_STATE_BUSY : HAL_SPI_STATE_READY;
+}
+
+void __WFI(void) {
+    if (!dma.activa || falla_dma == SD_SIM_DMA_COLGADO) {
+        avanzar(1000); // Despierta con el SysTick siguiente
+        return;
+    }
+
+    for (uint16_t i = 0; i < dma.n; i++) {
+        uint8_t b = intercambiar(dma.tx[i]);
+        if (dma.rx != NULL) {
+            dma.rx[i] = b;
+        }
+    }
+    sd_sim.bytes_dma += dma.n;
+    dma.activa = 0;
+
+    if (falla_dma == SD_SIM_DMA_ERROR) {
+        falla_dma = SD_SIM_DMA_OK;
+        HAL_SPI_ErrorCallback(dma.hspi);
+    } else if (dma.rx != NULL) {
+        HAL_SPI_TxRxCpltCallback(dma.hspi);
+    } else {
+        HAL_SPI_TxCpltCallback(dma.hspi);
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef SD_SPI_SIM_H
+#define SD_SPI_SIM_H
+/* Doble de SPI1 + microSD SDHC para pruebas en host de fatfs_sd.c (ver sd_spi_sim.c).
+ *
+ * La tarjeta responde byte a byte como en el modo SPI: NCR antes de cada R1, token 0xFE antes de
+ * los datos, respuesta de datos 0x05 y bytes de ocupado después de cada escritura, y lectura
+ * múltiple continua hasta CMD12, con el CRC16 de cada bloque. Cada byte en el bus avanza el reloj
+ * virtual de HAL_GetTick según el prescaler (1 us con SPI_BAUDRATEPRESCALER_2 y PCLK2 de 16 MHz),
+ * y cada 10 ms decrementa Timer1/Timer2 como el SysTick. Las transferencias DMA terminan dentro
+ * de __WFI(), como lo haría la interrupción. */
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+#define SD_SIM_SECTORES 64
+
+#define SPI_CR1_BR_Pos            3u
+#define SPI_CR1_BR_0              (1u << SPI_CR1_BR_Pos)
+#define SPI_BAUDRATEPRESCALER_2   0x00u
+#define SPI_BAUDRATEPRESCALER_4   0x08u
+#define SPI_BAUDRATEPRESCALER_8   0x10u
+#define SPI_BAUDRATEPRESCALER_16  0x18u
+#define SPI_BAUDRATEPRESCALER_32  0x20u
+#define SPI_BAUDRATEPRESCALER_64  0x28u
+#define SPI_BAUDRATEPRESCALER_128 0x30u
+#define SPI_BAUDRATEPRESCALER_256 0x38u
+
+#define SD_SIM_PCLK2_HZ 16000000u
+
+typedef struct {
+    uint32_t BaudRatePrescaler;
+} SPI_InitTypeDef;
+
+typedef struct {
+    int id;
+    SPI_InitTypeDef Init;
+} SPI_HandleTypeDef;
+
+typedef enum {
+    HAL_SPI_STATE_RESET = 0,
+    HAL_SPI_STATE_READY,
+    HAL_SPI_STATE_BUSY
+} HAL_SPI_StateTypeDef;
+
+extern GPIO_TypeDef sd_sim_gpiob;
+#define SD_CS_GPIO_Port (&sd_sim_gpiob)
+#define SD_CS_Pin       0x0001u
+
+/* Intrínsecos de CMSIS: __WFI() completa la transferencia DMA pendiente */
+void __WFI(void);
+#define __disable_irq() ((void)0)
+#define __enable_irq()  ((void)0)
+
+/* Contadores de 10 ms del programa (los define el runner, como stm32f4xx_it.c) */
+extern volatile uint8_t Timer1, Timer2;
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef * hspi);
+HAL_StatusTypeDef HAL_SPI_DeInit(SPI_HandleTypeDef * hspi);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef * hspi, uint8_t * pData, uint16_t Size,
+                                   uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef * hspi, uint8_t * pTxData,
+                                          uint8_t * pRxData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef * hspi, uint8_t * pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef * hspi, uint8_t * pTxData,
+                                              uint8_t * pRxData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef * hspi);
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef * hspi);
+void HAL_GPIO_WritePin(GPIO_TypeDef * GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+/* Callbacks implementados por el código bajo prueba */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef * hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef * hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef * hspi);
+
+typedef struct {
+    uint32_t llamadas_bloqueantes; /* HAL_SPI_Transmit / HAL_SPI_TransmitReceive */
+    uint32_t llamadas_dma;         /* HAL_SPI_Transmit_DMA / HAL_SPI_TransmitReceive_DMA */
+    uint32_t consultas_estado;     /* HAL_SPI_GetState */
+    uint32_t bytes;                /* Todos los bytes en el bus */
+    uint32_t bytes_dma;
+    uint32_t comandos;
+    uint32_t cambios_prescaler; /* HAL_SPI_Init */
+    uint32_t bloques_corruptos; /* Bloques dañados por un reloj más rápido que el límite */
+} SdSim_Contadores;
+
+/* Fallas de la próxima transferencia DMA */
+typedef enum { SD_SIM_DMA_OK = 0, SD_SIM_DMA_ERROR, SD_SIM_DMA_COLGADO } SdSim_FallaDma;
+
+extern SdSim_Contadores sd_sim;
+
+/* Tarjeta apagada y vacía, contadores y reloj en cero */
+void sd_sim_reset(void);
+void sd_sim_reset_contadores(void);
+/* Contenido de un sector de la tarjeta */
+uint8_t * sd_sim_sector(uint32_t sector);
+void sd_sim_fallar_dma(SdSim_FallaDma falla);
+/* Prescaler más rápido que soportan la tarjeta y el cableado: con uno menor se daña un byte de
+ * cada bloque de datos, en las dos direcciones */
+void sd_sim_limite_prescaler(uint32_t prescaler);
+/* Tiempo virtual transcurrido en microsegundos */
+uint32_t sd_sim_us(void);
+
+#endif
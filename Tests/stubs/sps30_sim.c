@@ -0,0 +1,122 @@
+#include <string.h>
+#include "sps30_sim.h"
+
+#define CMD_START 0x00
+#define CMD_STOP  0x01
+#define CMD_READ  0x03
+
+Sps30SimEstado sps30_sim[SPS30_SIM_MAX];
+bool sps30_sim_exigir_inicio = false;
+
+void sps30_sim_reset(void) {
+    memset(sps30_sim, 0, sizeof(sps30_sim));
+    sps30_sim_exigir_inicio = false;
+}
+
+float sps30_sim_valor(int id, int k) {
+    return id * 10.0f + k;
+}
+
+uint16_t sps30_sim_construir_frame(uint8_t cmd, uint8_t state, const uint8_t * datos, uint8_t len,
+                                   uint8_t * out) {
+    uint8_t crudo[64] = {0x00, cmd, state, len};
+    uint8_t suma = 0;
+    uint16_t n = 0;
+
+    if (len > 0)
+        memcpy(&crudo[4], datos, len);
+    for (int i = 0; i < 4 + len; i++)
+        suma += crudo[i];
+    crudo[4 + len] = (uint8_t)~suma;
+
+    out[n++] = 0x7E;
+    for (int i = 0; i < 5 + len; i++) {
+        uint8_t b = crudo[i];
+        if (b == 0x7E || b == 0x7D || b == 0x11 || b == 0x13) {
+            out[n++] = 0x7D;
+            out[n++] = b ^ 0x20;
+        } else {
+            out[n++] = b;
+        }
+    }
+    out[n++] = 0x7E;
+    return n;
+}
+
+static void float_a_bytes(float v, uint8_t * out) {
+    uint8_t tmp[4];
+    memcpy(tmp, &v, 4);
+    for (int i = 0; i < 4; i++)
+        out[i] = tmp[3 - i];
+}
+
+static void u16_a_bytes(uint16_t v, uint8_t * out) {
+    out[0] = (uint8_t)(v >> 8);
+    out[1] = (uint8_t)v;
+}
+
+void sps30_sim_responder(UART_HandleTypeDef * huart, const uint8_t * cmd, uint16_t len) {
+    uint8_t datos[40];
+    uint8_t lon;
+    uint8_t frame[128];
+    uint16_t n;
+    Sps30SimEstado * s;
+
+    if (huart->id <= 0 || huart->id >= SPS30_SIM_MAX || len < 3)
+        return;
+    s = &sps30_sim[huart->id];
+    if (s->mudo)
+        return;
+
+    uint32_t ahora_ms = uart_double_now_us() / 1000;
+    uint32_t muestra = 0;
+    switch (cmd[2]) {
+    case CMD_READ:
+        if (s->midiendo && ahora_ms - s->inicio_ms >= SPS30_SIM_PRIMER_DATO_MS)
+            muestra = 1 + (ahora_ms - s->inicio_ms - SPS30_SIM_PRIMER_DATO_MS) /
+                              SPS30_SIM_PERIODO_MS;
+        if (!sps30_sim_exigir_inicio || muestra > s->ultima_muestra) {
+            if (s->formato == 0x05) {
+                for (int k = 0; k < 10; k++)
+                    u16_a_bytes((uint16_t)sps30_sim_valor(huart->id, k), &datos[2 * k]);
+                lon = 20;
+            } else {
+                for (int k = 0; k < 10; k++)
+                    float_a_bytes(sps30_sim_valor(huart->id, k), &datos[4 * k]);
+                lon = 40;
+            }
+            n = sps30_sim_construir_frame(cmd[2], 0x00, datos, lon, frame);
+            if (s->corromper > 0) {
+                s->corromper--;
+                frame[n - 2] ^= 0x01; /* Checksum inválido */
+            } else {
+                s->lecturas++;
+                if (muestra > 0)
+                    s->ultima_muestra = muestra;
+            }
+        } else {
+            n = sps30_sim_construir_frame(cmd[2], 0x00, NULL, 0, frame); /* Sin datos nuevos */
+        }
+        break;
+    case CMD_START:
+        if (s->estado_start != 0) {
+            n = sps30_sim_construir_frame(cmd[2], s->estado_start, NULL, 0, frame);
+            break;
+        }
+        s->midiendo = true;
+        s->inicio_ms = ahora_ms;
+        s->ultima_muestra = 0;
+        s->starts++;
+        s->formato = (len >= 6) ? cmd[5] : 0x03;
+        n = sps30_sim_construir_frame(cmd[2], 0x00, NULL, 0, frame);
+        break;
+    case CMD_STOP:
+        s->midiendo = false;
+        n = sps30_sim_construir_frame(cmd[2], 0x00, NULL, 0, frame);
+        break;
+    default:
+        n = sps30_sim_construir_frame(cmd[2], 0x00, NULL, 0, frame);
+        break;
+    }
+    uart_double_responder(huart, frame, n, SPS30_SIM_LATENCIA_US);
+}
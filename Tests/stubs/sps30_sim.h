@@ -0,0 +1,38 @@
+#ifndef SPS30_SIM_H
+#define SPS30_SIM_H
+/* Simulador de SPS30 para el doble de UART: responde READ/START/STOP con frames SHDLC reales */
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_double.h"
+
+#define SPS30_SIM_MAX             4
+#define SPS30_SIM_LATENCIA_US     5000 /* Tiempo de respuesta tras recibir un comando */
+#define SPS30_SIM_PRIMER_DATO_MS  1000 /* Primer dato disponible tras START_MEASUREMENT */
+#define SPS30_SIM_PERIODO_MS      1000 /* Un dato nuevo por período mientras está midiendo */
+
+typedef struct {
+    bool mudo;              /* No responde */
+    int corromper;          /* Cantidad de próximas respuestas READ con checksum inválido */
+    bool midiendo;
+    uint32_t inicio_ms;     /* Momento del último START */
+    uint32_t ultima_muestra; /* Muestra ya entregada desde el START (con exigir_inicio) */
+    uint32_t lecturas;      /* READ respondidos con datos */
+    uint32_t starts;
+    uint8_t formato;        /* Formato pedido en START: 0x03 float (por defecto), 0x05 uint16 */
+    uint8_t estado_start;   /* State de la respuesta a START; distinto de 0 rechaza el comando */
+} Sps30SimEstado;
+
+/* Estado por id de UART (UART_HandleTypeDef.id) */
+extern Sps30SimEstado sps30_sim[SPS30_SIM_MAX];
+/* Si es false, READ siempre devuelve datos aunque no se haya enviado START. Si es true, cada
+ * muestra se entrega una sola vez: un READ antes del próximo período responde sin datos */
+extern bool sps30_sim_exigir_inicio;
+
+void sps30_sim_reset(void);
+void sps30_sim_responder(UART_HandleTypeDef * huart, const uint8_t * cmd, uint16_t len);
+uint16_t sps30_sim_construir_frame(uint8_t cmd, uint8_t state, const uint8_t * datos, uint8_t len,
+                                   uint8_t * out);
+/* Valor simulado del float k (0..9) para la UART id */
+float sps30_sim_valor(int id, int k);
+
+#endif
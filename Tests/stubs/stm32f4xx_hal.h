@@ -0,0 +1,120 @@
+#ifndef STM32F4XX_HAL_H
+#define STM32F4XX_HAL_H
+/* Doble de la HAL para pruebas en host: UART, tick, retardos (ver uart_double.c) y tipos GPIO */
+#include <stdint.h>
+
+typedef enum { HAL_OK = 0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+
+/* Estado de transmisión (gState) con los valores de la HAL */
+typedef enum { HAL_UART_STATE_READY = 0x20, HAL_UART_STATE_BUSY_TX = 0x21 } HAL_UART_StateTypeDef;
+
+/* Puerto GPIO: sólo su identidad (los handles de DHT22 y el CS de la microSD lo guardan) */
+typedef struct {
+    int id;
+} GPIO_TypeDef;
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+typedef enum { HAL_UNLOCKED = 0, HAL_LOCKED } HAL_LockTypeDef;
+
+/* Registros que uart_log_flush() maneja sin la HAL, con los bits del STM32F4 */
+typedef struct {
+    volatile uint32_t SR;
+    volatile uint32_t DR; /* El doble lo deja en UART_DOUBLE_DR_LIBRE cuando toma el byte */
+    volatile uint32_t CR1;
+    volatile uint32_t CR3;
+} USART_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t NDTR;
+} DMA_Stream_TypeDef;
+
+typedef enum {
+    HAL_DMA_STATE_RESET = 0,
+    HAL_DMA_STATE_READY,
+    HAL_DMA_STATE_BUSY,
+} HAL_DMA_StateTypeDef;
+
+typedef struct {
+    DMA_Stream_TypeDef * Instance;
+    HAL_DMA_StateTypeDef State;
+    HAL_LockTypeDef Lock;
+} DMA_HandleTypeDef;
+
+#define USART_SR_TC     (1u << 6)
+#define USART_SR_TXE    (1u << 7)
+#define USART_CR1_TCIE  (1u << 6)
+#define USART_CR1_TXEIE (1u << 7)
+#define USART_CR3_DMAT  (1u << 7)
+#define UART_FLAG_TC    USART_SR_TC
+#define UART_FLAG_TXE   USART_SR_TXE
+
+#define DMA_SxCR_EN (1u << 0)
+#define DMA_IT_DME  (1u << 1)
+#define DMA_IT_TE   (1u << 2)
+#define DMA_IT_HT   (1u << 3)
+#define DMA_IT_TC   (1u << 4)
+
+#define CLEAR_BIT(REG, BIT)           ((REG) &= ~(BIT))
+#define __HAL_UNLOCK(h)               ((h)->Lock = HAL_UNLOCKED)
+#define __HAL_DMA_DISABLE(h)          ((h)->Instance->CR &= ~DMA_SxCR_EN)
+#define __HAL_DMA_DISABLE_IT(h, it)   ((h)->Instance->CR &= ~(it))
+#define __HAL_DMA_GET_COUNTER(h)      ((h)->Instance->NDTR)
+/* Como la HAL lee SR; el doble aprovecha la lectura para tomar el byte escrito en DR */
+#define __HAL_UART_GET_FLAG(h, flag)  ((uart_double_sr(h) & (flag)) == (flag))
+
+typedef struct __UART_HandleTypeDef {
+    int id;
+    /* Recepción DMA circular simulada */
+    uint8_t * dma_buf;
+    uint16_t dma_size;
+    uint16_t dma_pos;
+    int dma_activo;
+    int idle_pendiente;
+    /* Respuesta programada del dispositivo remoto */
+    uint8_t resp[256];
+    uint16_t resp_len;
+    uint16_t resp_entregados;
+    uint32_t resp_inicio_us;
+    /* Transmisión DMA simulada: termina tras UART_DOUBLE_BYTE_US por byte */
+    const uint8_t * tx_dma_datos;
+    uint16_t tx_dma_len;
+    uint32_t tx_dma_inicio_us;
+    int tx_dma_activo;
+    HAL_UART_StateTypeDef gState; /* BUSY_TX mientras hay una transmisión DMA */
+    /* Registros y DMA de transmisión simulados (uart_double_iniciar() los conecta) */
+    USART_TypeDef * Instance;
+    DMA_HandleTypeDef * hdmatx;
+    USART_TypeDef usart_regs;
+    DMA_Stream_TypeDef dma_tx_regs;
+    DMA_HandleTypeDef hdma_tx;
+    int tx_trabado; /* 1 = la línea no avanza: TXE y TC nunca se activan */
+    /* Captura opcional de todo lo transmitido (bloqueante o DMA) */
+    uint8_t * tx_captura;
+    uint32_t tx_captura_max;
+    uint32_t tx_captura_len;
+    /* Contadores */
+    uint32_t tx_bytes;
+    uint32_t rx_eventos;
+} UART_HandleTypeDef;
+
+uint32_t uart_double_sr(struct __UART_HandleTypeDef * huart);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t ms);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef * huart, const uint8_t * data,
+                                    uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef * huart, uint8_t * data, uint16_t size,
+                                   uint32_t timeout);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef * huart, uint8_t * data,
+                                               uint16_t size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef * huart, const uint8_t * data,
+                                        uint16_t size);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef * huart);
+
+/* Callbacks implementados por el código bajo prueba */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef * huart, uint16_t Size);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef * huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef * huart); /* Opcional (débil en el doble) */
+
+#endif
@@ -1,7 +1,15 @@
 #include "time_rtc.h"
+#include <stdio.h>
 #include <string.h>
 static ds3231_time_t current_time = {12,0,0,16,6,2025};
 
+/* La hora cacheada es la real; lee el DS3231 del stub cuando éste cambia de hora */
+#include "../../APIs/Src/base_tiempo.c"
+
+uint32_t HAL_GetTick(void){
+    return 0; // el tiempo sólo avanza con stub_set_time() y stub_advance_seconds()
+}
+
 void time_rtc_GetFormattedDateTime(char *buffer, size_t len){
     snprintf(buffer, len, "%04d-%02d-%02d %02d:%02d:%02d", current_time.year, current_time.month,
              current_time.day, current_time.hour, current_time.min, current_time.sec);
@@ -16,11 +24,11 @@ bool ds3231_get_datetime(ds3231_time_t* dt){
 
 void stub_set_time(unsigned char hour, unsigned char min, unsigned char sec){
     current_time.hour = hour; current_time.min = min; current_time.sec = sec;
+    base_tiempo_resincronizar();
 }
 
 void stub_advance_seconds(unsigned int s){
-    current_time.sec += s;
-    while(current_time.sec >= 60){ current_time.sec -= 60; current_time.min++; }
-    while(current_time.min >= 60){ current_time.min -= 60; current_time.hour++; }
-    while(current_time.hour >= 24){ current_time.hour -= 24; }
+    // Pasa de día, mes y año como el DS3231
+    base_tiempo_desde_segundos(base_tiempo_a_segundos(&current_time) + s, &current_time);
+    base_tiempo_resincronizar();
 }
@@ -2,9 +2,8 @@
 #define TIME_RTC_H
 #include <stddef.h>
 #include <stdbool.h>
-typedef struct {unsigned char hour; unsigned char min; unsigned char sec; unsigned char day; unsigned char month; unsigned short year;} ds3231_time_t;
+#include "rtc_ds3231_for_stm32_hal.h"
 void time_rtc_GetFormattedDateTime(char *buffer, size_t len);
-bool ds3231_get_datetime(ds3231_time_t* dt);
 void stub_set_time(unsigned char hour, unsigned char min, unsigned char sec);
 void stub_advance_seconds(unsigned int s);
 #endif
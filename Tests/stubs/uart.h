@@ -1,7 +1,12 @@
 #ifndef UART_H
 #define UART_H
+#include <stdint.h>
 #include <stdio.h>
 static inline void uart_print(const char *format, ...) {
     (void)format;
 }
+static inline void uart_write_bytes(const uint8_t *datos, uint16_t n) {
+    (void)datos;
+    (void)n;
+}
 #endif
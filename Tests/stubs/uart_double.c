@@ -0,0 +1,291 @@
+/* Doble de UART con DMA circular y detección de línea ociosa, con reloj simulado en µs.
+ * Los bytes de la respuesta programada llegan uno cada UART_DOUBLE_BYTE_US; los eventos de
+ * mitad/fin de buffer y de línea ociosa invocan HAL_UARTEx_RxEventCallback como la HAL real. */
+#include <string.h>
+#include "uart_double.h"
+
+#define MAX_UARTS 8
+
+static uint32_t ahora_us = 0;
+static UART_HandleTypeDef * uarts[MAX_UARTS];
+static int num_uarts = 0;
+static UartDoubleResponder responder_actual = NULL;
+
+/* Conecta los registros simulados al handle; las pruebas suelen ponerlo en cero con memset */
+static void conectar(UART_HandleTypeDef * h) {
+    if (h->Instance != NULL)
+        return;
+    h->Instance = &h->usart_regs;
+    h->Instance->DR = UART_DOUBLE_DR_LIBRE;
+    h->hdmatx = &h->hdma_tx;
+    h->hdmatx->Instance = &h->dma_tx_regs;
+    h->hdmatx->State = HAL_DMA_STATE_READY;
+}
+
+static void registrar(UART_HandleTypeDef * h) {
+    conectar(h);
+    for (int i = 0; i < num_uarts; i++) {
+        if (uarts[i] == h)
+            return;
+    }
+    if (num_uarts < MAX_UARTS)
+        uarts[num_uarts++] = h;
+}
+
+static uint32_t llegada_us(UART_HandleTypeDef * h, uint16_t k) {
+    return h->resp_inicio_us + (uint32_t)(k + 1) * UART_DOUBLE_BYTE_US;
+}
+
+/* Entrega al buffer DMA los bytes cuya hora de llegada ya pasó y genera los eventos HAL */
+static void entregar(UART_HandleTypeDef * h) {
+    if (!h->dma_activo)
+        return; /* Sin DMA los bytes quedan para HAL_UART_Receive */
+    while (h->resp_entregados < h->resp_len && llegada_us(h, h->resp_entregados) <= ahora_us) {
+        uint8_t byte = h->resp[h->resp_entregados++];
+        h->dma_buf[h->dma_pos++] = byte;
+        h->idle_pendiente = 1;
+        if (h->dma_pos == h->dma_size / 2) {
+            h->rx_eventos++;
+            HAL_UARTEx_RxEventCallback(h, h->dma_pos);
+        } else if (h->dma_pos == h->dma_size) {
+            h->dma_pos = 0;
+            h->idle_pendiente = 0;
+            h->rx_eventos++;
+            HAL_UARTEx_RxEventCallback(h, h->dma_size);
+        }
+    }
+    /* Línea ociosa: un tiempo de byte sin actividad tras el último byte recibido */
+    if (h->idle_pendiente && h->resp_entregados > 0 &&
+        ahora_us >= llegada_us(h, h->resp_entregados - 1) + UART_DOUBLE_BYTE_US) {
+        h->idle_pendiente = 0;
+        if (h->dma_pos != 0) {
+            h->rx_eventos++;
+            HAL_UARTEx_RxEventCallback(h, h->dma_pos);
+        }
+    }
+}
+
+static void capturar(UART_HandleTypeDef * h, const uint8_t * data, uint32_t n) {
+    h->tx_bytes += n;
+    for (uint32_t i = 0; i < n && h->tx_captura != NULL && h->tx_captura_len < h->tx_captura_max;
+         i++)
+        h->tx_captura[h->tx_captura_len++] = data[i];
+}
+
+/* Como la HAL real: por defecto nadie atiende el fin de transmisión */
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef * huart) {
+    (void)huart;
+}
+
+/* uart_callbacks.c reparte los eventos a cada módulo; las pruebas que no incluyen alguno de
+ * ellos usan estas versiones vacías */
+__attribute__((weak)) void uart_log_error(UART_HandleTypeDef * huart) {
+    (void)huart;
+}
+
+__attribute__((weak)) void uart_log_tx_completo(UART_HandleTypeDef * huart) {
+    (void)huart;
+}
+
+__attribute__((weak)) void sps30_multi_rx_evento(UART_HandleTypeDef * huart, uint16_t size) {
+    (void)huart;
+    (void)size;
+}
+
+__attribute__((weak)) void sps30_multi_error(UART_HandleTypeDef * huart) {
+    (void)huart;
+}
+
+/* Deja el DMA de transmisión detenido y libre, como al terminar o abortar en la HAL */
+static void liberar_dma_tx(UART_HandleTypeDef * h) {
+    h->tx_dma_activo = 0;
+    h->hdmatx->Instance->CR &= ~DMA_SxCR_EN;
+    h->hdmatx->State = HAL_DMA_STATE_READY;
+    h->hdmatx->Lock = HAL_UNLOCKED;
+}
+
+/* Si el código apagó el stream a mano (EN en cero), salen los bytes que ya había tomado el DMA:
+ * los que NDTR ya no cuenta. */
+static void detener_si_apagado(UART_HandleTypeDef * h) {
+    if (!h->tx_dma_activo || (h->hdmatx->Instance->CR & DMA_SxCR_EN))
+        return;
+    capturar(h, h->tx_dma_datos, h->tx_dma_len - h->hdmatx->Instance->NDTR);
+    liberar_dma_tx(h);
+}
+
+/* Completa la transmisión DMA en curso cuando pasó el tiempo de todos sus bytes. Los bytes se
+ * leen recién al terminar: si el código los pisa mientras el DMA está en vuelo, se nota. */
+static void transmitir(UART_HandleTypeDef * h) {
+    detener_si_apagado(h);
+    if (!h->tx_dma_activo || h->tx_trabado)
+        return;
+    uint32_t enviados = (ahora_us - h->tx_dma_inicio_us) / UART_DOUBLE_BYTE_US;
+    if (enviados < h->tx_dma_len) {
+        h->hdmatx->Instance->NDTR = h->tx_dma_len - enviados;
+        return;
+    }
+    h->hdmatx->Instance->NDTR = 0;
+    liberar_dma_tx(h);
+    h->gState = HAL_UART_STATE_READY;
+    capturar(h, h->tx_dma_datos, h->tx_dma_len);
+    HAL_UART_TxCpltCallback(h);
+}
+
+void uart_double_avanzar_us(uint32_t us) {
+    uint32_t fin = ahora_us + us;
+    /* Se avanza en pasos de un byte para que los eventos salgan en orden */
+    while (ahora_us < fin) {
+        uint32_t paso = (fin - ahora_us) < UART_DOUBLE_BYTE_US ? (fin - ahora_us)
+                                                               : UART_DOUBLE_BYTE_US;
+        ahora_us += paso;
+        for (int i = 0; i < num_uarts; i++) {
+            entregar(uarts[i]);
+            transmitir(uarts[i]);
+        }
+    }
+}
+
+uint32_t uart_double_now_us(void) {
+    return ahora_us;
+}
+
+void uart_double_iniciar(UART_HandleTypeDef * huart) {
+    huart->Instance = NULL;
+    registrar(huart);
+}
+
+uint32_t uart_double_sr(UART_HandleTypeDef * huart) {
+    conectar(huart);
+    detener_si_apagado(huart);
+    if (huart->tx_trabado)
+        return 0;
+    /* El reloj no avanza: quien hace polling de SR suele tener las interrupciones apagadas */
+    if (huart->Instance->DR != UART_DOUBLE_DR_LIBRE) {
+        uint8_t byte = (uint8_t)huart->Instance->DR;
+        capturar(huart, &byte, 1);
+        huart->Instance->DR = UART_DOUBLE_DR_LIBRE;
+    }
+    return USART_SR_TXE | USART_SR_TC;
+}
+
+void uart_double_reset(void) {
+    ahora_us = 0;
+    num_uarts = 0;
+    responder_actual = NULL;
+}
+
+void uart_double_set_responder(UartDoubleResponder responder) {
+    responder_actual = responder;
+}
+
+void uart_double_responder(UART_HandleTypeDef * huart, const uint8_t * data, uint16_t len,
+                           uint32_t latencia_us) {
+    registrar(huart);
+    if (len > sizeof(huart->resp))
+        len = sizeof(huart->resp);
+    memcpy(huart->resp, data, len);
+    huart->resp_len = len;
+    huart->resp_entregados = 0;
+    huart->resp_inicio_us = ahora_us + latencia_us;
+}
+
+void uart_double_error(UART_HandleTypeDef * huart) {
+    /* Igual que la HAL ante un overrun en modo DMA: aborta la recepción y avisa */
+    huart->dma_activo = 0;
+    HAL_UART_ErrorCallback(huart);
+}
+
+void uart_double_error_tx(UART_HandleTypeDef * huart) {
+    /* Igual que la HAL ante un error del DMA de transmisión: corta la transferencia y avisa */
+    HAL_UART_AbortTransmit(huart);
+    HAL_UART_ErrorCallback(huart);
+}
+
+uint32_t HAL_GetTick(void) {
+    uart_double_avanzar_us(UART_DOUBLE_PASO_US);
+    return ahora_us / 1000;
+}
+
+void HAL_Delay(uint32_t ms) {
+    uart_double_avanzar_us(ms * 1000);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef * huart, const uint8_t * data,
+                                    uint16_t size, uint32_t timeout) {
+    (void)timeout;
+    registrar(huart);
+    uart_double_avanzar_us((uint32_t)size * UART_DOUBLE_BYTE_US);
+    capturar(huart, data, size);
+    if (responder_actual != NULL)
+        responder_actual(huart, data, size);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef * huart, uint8_t * data, uint16_t size,
+                                   uint32_t timeout) {
+    uint32_t limite = ahora_us + timeout * 1000;
+    registrar(huart);
+    if (huart->dma_activo)
+        return HAL_BUSY;
+    for (uint16_t i = 0; i < size; i++) {
+        if (huart->resp_entregados >= huart->resp_len ||
+            llegada_us(huart, huart->resp_entregados) > limite) {
+            if (ahora_us < limite)
+                uart_double_avanzar_us(limite - ahora_us);
+            return HAL_TIMEOUT;
+        }
+        uint32_t llegada = llegada_us(huart, huart->resp_entregados);
+        if (llegada > ahora_us)
+            uart_double_avanzar_us(llegada - ahora_us);
+        data[i] = huart->resp[huart->resp_entregados++];
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef * huart, uint8_t * data,
+                                               uint16_t size) {
+    if (huart->dma_activo)
+        return HAL_BUSY;
+    registrar(huart);
+    huart->dma_buf = data;
+    huart->dma_size = size;
+    huart->dma_pos = 0;
+    huart->idle_pendiente = 0;
+    huart->dma_activo = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef * huart, const uint8_t * data,
+                                        uint16_t size) {
+    registrar(huart);
+    /* HAL_DMA_Start_IT() rechaza el stream si quedó tomado por una transferencia anterior */
+    if (huart->tx_dma_activo || huart->hdmatx->State != HAL_DMA_STATE_READY ||
+        huart->hdmatx->Lock == HAL_LOCKED)
+        return HAL_BUSY;
+    huart->hdmatx->Lock = HAL_LOCKED;
+    huart->hdmatx->State = HAL_DMA_STATE_BUSY;
+    huart->hdmatx->Instance->NDTR = size;
+    huart->hdmatx->Instance->CR = DMA_SxCR_EN | DMA_IT_TC | DMA_IT_TE | DMA_IT_DME;
+    huart->Instance->CR3 |= USART_CR3_DMAT;
+    huart->tx_dma_datos = data;
+    huart->tx_dma_len = size;
+    huart->tx_dma_inicio_us = ahora_us;
+    huart->tx_dma_activo = 1;
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef * huart) {
+    conectar(huart);
+    if (huart->tx_dma_activo) {
+        /* Los bytes que ya salieron por la línea quedan transmitidos */
+        uint32_t enviados = (ahora_us - huart->tx_dma_inicio_us) / UART_DOUBLE_BYTE_US;
+        if (enviados > huart->tx_dma_len)
+            enviados = huart->tx_dma_len;
+        capturar(huart, huart->tx_dma_datos, enviados);
+        liberar_dma_tx(huart);
+    }
+    huart->Instance->CR3 &= ~USART_CR3_DMAT;
+    huart->gState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
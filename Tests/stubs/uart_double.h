@@ -0,0 +1,27 @@
+#ifndef UART_DOUBLE_H
+#define UART_DOUBLE_H
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+#define UART_DOUBLE_BYTE_US 87 /* Un byte a 115200 baudios (8N1) */
+#define UART_DOUBLE_PASO_US 10 /* Avance del reloj simulado por cada HAL_GetTick() */
+#define UART_DOUBLE_DR_LIBRE 0x100u /* DR sin byte pendiente (no es un byte válido) */
+
+/**
+ * Función que simula al dispositivo remoto: recibe el comando transmitido y puede programar una
+ * respuesta con uart_double_responder().
+ */
+typedef void (*UartDoubleResponder)(UART_HandleTypeDef * huart, const uint8_t * cmd,
+                                    uint16_t len);
+
+void uart_double_reset(void);
+void uart_double_iniciar(UART_HandleTypeDef * huart);
+void uart_double_set_responder(UartDoubleResponder responder);
+void uart_double_responder(UART_HandleTypeDef * huart, const uint8_t * data, uint16_t len,
+                           uint32_t latencia_us);
+void uart_double_error(UART_HandleTypeDef * huart);
+void uart_double_error_tx(UART_HandleTypeDef * huart);
+uint32_t uart_double_now_us(void);
+void uart_double_avanzar_us(uint32_t us);
+
+#endif
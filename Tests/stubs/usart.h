@@ -1,4 +1,4 @@
 #ifndef USART_H
 #define USART_H
-typedef struct {} UART_HandleTypeDef;
+#include "stm32f4xx_hal.h"
 #endif
@@ -0,0 +1,16 @@
+import subprocess
+
+def build_and_run():
+    # El ParticulateDataAnalyzer.h real (con MPStatistics) antes que el de Tests/stubs
+    compile_cmd = [
+        'gcc','-O2','-Wall','-I','APIs/Inc','-I','APIs/Config','-I','Tests/stubs',
+        'Tests/analizador_runner.c','-lm',
+        '-o','Tests/analizador_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/analizador_runner'], capture_output=True, text=True)
+
+def test_estadisticas_una_pasada():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
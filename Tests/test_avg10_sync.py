@@ -2,10 +2,10 @@ import subprocess
 
 def build_and_run():
     compile_cmd = [
-        'gcc','-I','Tests/stubs','-I','APIs/Inc',
-        'Tests/avg10_sync_runner.c',
-        'Tests/stubs/time_rtc.c','Tests/stubs/microSD_utils.c','Tests/stubs/fatfs_stub.c',
-        '-o','Tests/avg10_sync_runner'
+        'gcc','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/avg10_sync_runner.c','APIs/Src/estadistica_online.c','APIs/Src/punto_fijo.c',
+        'Tests/stubs/time_rtc.c','Tests/stubs/microSD_utils.c','Tests/stubs/fatfs_sim.c',
+        '-lm','-o','Tests/avg10_sync_runner'
     ]
     subprocess.check_call(compile_cmd)
     return subprocess.run(['Tests/avg10_sync_runner'], capture_output=True, text=True)
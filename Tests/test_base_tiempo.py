@@ -0,0 +1,15 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-Wall','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/base_tiempo_runner.c',
+        '-o','Tests/base_tiempo_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/base_tiempo_runner'], capture_output=True, text=True)
+
+def test_hora_cacheada_con_deriva_y_resincronizacion():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,15 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-Wall','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/dht22_captura_runner.c',
+        '-o','Tests/dht22_captura_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/dht22_captura_runner'], capture_output=True, text=True)
+
+def test_decodifica_tramas_capturadas_por_flancos():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,15 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-Wall','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/fatfs_sd_runner.c','Tests/stubs/sd_spi_sim.c',
+        '-o','Tests/fatfs_sd_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/fatfs_sd_runner'], capture_output=True, text=True)
+
+def test_fatfs_sd_bloques_por_dma():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
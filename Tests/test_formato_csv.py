@@ -0,0 +1,15 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-Wall','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/formato_csv_runner.c','-lm',
+        '-o','Tests/formato_csv_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/formato_csv_runner'], capture_output=True, text=True)
+
+def test_linea_identica_a_snprintf():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,48 @@
+import subprocess
+
+import pytest
+
+NIVELES = ['ERROR', 'WARN', 'INFO', 'DEBUG', 'TRACE']
+FLAGS = ['-Wall', '-Werror', '-I', 'Tests/stubs', '-I', 'APIs/Inc', '-I', 'APIs/Config']
+
+
+def definir(nivel):
+    return [] if nivel is None else ['-DLOG_NIVEL_PRUEBA=LOG_NIVEL_' + nivel]
+
+
+def build_and_run(nivel):
+    compile_cmd = ['gcc', '-O2'] + FLAGS + definir(nivel) + [
+        'Tests/log_niveles_runner.c', '-o', 'Tests/log_niveles_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/log_niveles_runner'], capture_output=True, text=True)
+
+
+def cadenas_en_objeto(nivel, optimizacion):
+    objeto = 'Tests/log_niveles_runner.o'
+    subprocess.check_call(['gcc', optimizacion, '-c'] + FLAGS + definir(nivel) +
+                          ['Tests/log_niveles_runner.c', '-o', objeto])
+    with open(objeto, 'rb') as f:
+        contenido = f.read()
+    return [n for n in NIVELES if ('CADENA_NIVEL_%s ' % n).encode() in contenido]
+
+
+@pytest.mark.parametrize('nivel', ['NINGUNO'] + NIVELES)
+def test_umbral_por_modulo(nivel):
+    res = build_and_run(nivel)
+    assert res.returncode == 0, res.stdout + res.stderr
+    assert 'PASS' in res.stdout
+
+
+def test_produccion_solo_errores():
+    res = build_and_run(None)
+    assert res.returncode == 0, res.stdout + res.stderr
+    assert 'NIVEL 1' in res.stdout
+
+
+@pytest.mark.parametrize('optimizacion', ['-O0', '-Os'])
+def test_mensajes_deshabilitados_fuera_del_binario(optimizacion):
+    assert cadenas_en_objeto('NINGUNO', optimizacion) == []
+    assert cadenas_en_objeto(None, optimizacion) == ['ERROR']
+    assert cadenas_en_objeto('INFO', optimizacion) == ['ERROR', 'WARN', 'INFO']
+    assert cadenas_en_objeto('TRACE', optimizacion) == NIVELES
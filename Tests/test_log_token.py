@@ -0,0 +1,51 @@
+import importlib.util
+import subprocess
+
+spec = importlib.util.spec_from_file_location('log_tokens', 'tools/log_tokens.py')
+log_tokens = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(log_tokens)
+
+
+def build_and_run(tmp_path):
+    compile_cmd = [
+        'gcc', '-O2', '-Wall', '-I', 'Tests/stubs', '-I', 'APIs/Inc', '-I', 'APIs/Config',
+        'Tests/log_token_runner.c', '-o', 'Tests/log_token_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    captura = tmp_path / 'captura.bin'
+    esperado = tmp_path / 'esperado.txt'
+    res = subprocess.run(['Tests/log_token_runner', str(captura), str(esperado)],
+                         capture_output=True, text=True)
+    assert res.returncode == 0, res.stdout + res.stderr
+    assert 'PASS' in res.stdout
+    return captura.read_bytes(), esperado.read_bytes().decode('utf-8')
+
+
+def test_decodifica_la_captura(tmp_path):
+    captura, esperado = build_and_run(tmp_path)
+
+    # Tabla exportada a CSV, como en el paso posterior a la compilación
+    tabla_csv = tmp_path / 'log_tokens.csv'
+    log_tokens.main(['tabla', 'Tests/log_token_runner', '-o', str(tabla_csv)])
+    tabla = log_tokens.cargar_tabla(str(tabla_csv))
+    assert tabla == log_tokens.tabla_desde_elf('Tests/log_token_runner')
+
+    assert log_tokens.decodificar(captura, tabla) == esperado
+
+    # Byte a byte, como llega del puerto serie
+    dec = log_tokens.Decodificador(tabla)
+    texto = ''.join(dec.alimentar(captura[i:i + 1]) for i in range(len(captura)))
+    texto += dec.alimentar(b'', final=True)
+    assert texto == esperado and dec.invalidos == 0
+
+
+def test_resincroniza_tras_perdida(tmp_path):
+    captura, esperado = build_and_run(tmp_path)
+    tabla = log_tokens.tabla_desde_elf('Tests/log_token_runner')
+
+    # Se pierden bytes en medio del primer registro: el resto se decodifica igual
+    dec = log_tokens.Decodificador(tabla)
+    texto = dec.alimentar(captura[:10] + captura[30:], final=True)
+    segunda_linea = esperado.split('\n', 1)[1]
+    assert texto.endswith(segunda_linea)
+    assert dec.invalidos >= 1
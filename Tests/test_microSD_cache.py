@@ -0,0 +1,15 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-Wall','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/microSD_cache_runner.c','Tests/stubs/fatfs_sim.c',
+        '-o','Tests/microSD_cache_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/microSD_cache_runner'], capture_output=True, text=True)
+
+def test_microSD_cache_agrupa_escrituras():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,16 @@
+import subprocess
+
+def build():
+    exe = 'Tests/punto_fijo_runner'
+    compile_cmd = [
+        'gcc','-O2','-Wall','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/punto_fijo_runner.c','-lm',
+        '-o',exe
+    ]
+    subprocess.check_call(compile_cmd)
+    return exe
+
+def test_texto_igual_que_printf():
+    res = subprocess.run([build()], capture_output=True, text=True)
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
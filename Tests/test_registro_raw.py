@@ -0,0 +1,56 @@
+import importlib.util
+import subprocess
+
+spec = importlib.util.spec_from_file_location('raw_bin_a_csv', 'tools/raw_bin_a_csv.py')
+raw_bin_a_csv = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(raw_bin_a_csv)
+
+
+def build_and_run(tmp_path):
+    compile_cmd = [
+        'gcc', '-O2', '-Wall', '-I', 'Tests/stubs', '-I', 'APIs/Inc', '-I', 'APIs/Config',
+        'Tests/registro_raw_runner.c', '-lm', '-o', 'Tests/registro_raw_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    res = subprocess.run(['Tests/registro_raw_runner', str(tmp_path)],
+                         capture_output=True, text=True)
+    assert res.returncode == 0, res.stdout + res.stderr
+    assert 'PASS' in res.stdout
+
+
+def test_csv_identico_al_del_equipo(tmp_path):
+    build_and_run(tmp_path)
+    for nombre in ('RAW_01_20261016', 'RAW_03_20261016'):
+        binario = (tmp_path / (nombre + '.BIN')).read_bytes()
+        esperado = (tmp_path / (nombre + '.esperado')).read_bytes()
+        assert raw_bin_a_csv.convertir(binario) == esperado
+
+    # El binario ocupa menos de un tercio que el CSV
+    binario = (tmp_path / 'RAW_01_20261016.BIN').stat().st_size
+    assert binario * 3 < (tmp_path / 'RAW_01_20261016.esperado').stat().st_size
+
+
+def test_encabezado_completo_con_campos_al_maximo(tmp_path):
+    build_and_run(tmp_path)
+    esperado = (tmp_path / 'RAW_03_20261016.esperado').read_bytes()
+    encabezado = esperado.split(b'\n2026-', 1)[0] + b'\n'
+    assert encabezado.endswith(b'tamano_tipico\n') and len(encabezado) < 511
+
+
+def test_linea_de_comandos(tmp_path):
+    build_and_run(tmp_path)
+    salida = tmp_path / 'csv'
+    assert raw_bin_a_csv.main([str(tmp_path), '-o', str(salida)]) == 0
+    assert (salida / 'RAW_01_20261016.CSV').read_bytes() == \
+        (tmp_path / 'RAW_01_20261016.esperado').read_bytes()
+
+
+def test_valores_no_representables_y_registro_cortado(tmp_path):
+    build_and_run(tmp_path)
+    binario = (tmp_path / 'INVALIDOS.BIN').read_bytes()
+    lineas = raw_bin_a_csv.convertir(binario + binario[-10:]).decode().splitlines()
+    datos = [l.split(',') for l in lineas if not l.startswith('#')]
+    assert len(datos) == 10  # El registro incompleto del final no se exporta
+    for columnas in datos:
+        # pm1.0 NaN, pm10 7000, hum_amb 4000, temp_cam -4000, nc0.5 negativo, tamaño infinito
+        assert [columnas[i] for i in (2, 5, 7, 8, 10, 15)] == ['nan'] * 6
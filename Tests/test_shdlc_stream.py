@@ -0,0 +1,15 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-I','Tests/stubs','-I','APIs/Inc',
+        'Tests/shdlc_stream_runner.c',
+        '-o','Tests/shdlc_stream_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/shdlc_stream_runner'], capture_output=True, text=True)
+
+def test_shdlc_stream_decoder():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,18 @@
+import subprocess
+
+def build_and_run():
+    base_cmd = [
+        'gcc','-O1','-g','-I','Tests/stubs','-I','APIs/Inc',
+        'Tests/shdlc_validate_runner.c',
+        '-o','Tests/shdlc_validate_runner'
+    ]
+    # Con sanitizers si el compilador los soporta: el fuzz debe correr sin accesos inválidos
+    sanitizers = ['-fsanitize=address,undefined','-fno-sanitize-recover=all']
+    if subprocess.run(base_cmd + sanitizers, capture_output=True).returncode != 0:
+        subprocess.check_call(base_cmd)
+    return subprocess.run(['Tests/shdlc_validate_runner'], capture_output=True, text=True)
+
+def test_shdlc_validate_fuzz():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,16 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/sps30_continuo_runner.c',
+        'Tests/stubs/uart_double.c','Tests/stubs/sps30_sim.c',
+        '-o','Tests/sps30_continuo_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/sps30_continuo_runner'], capture_output=True, text=True)
+
+def test_sps30_modo_continuo():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,16 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/sps30_formato_runner.c',
+        'Tests/stubs/uart_double.c','Tests/stubs/sps30_sim.c',
+        '-o','Tests/sps30_formato_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/sps30_formato_runner'], capture_output=True, text=True)
+
+def test_sps30_formato_uint16():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
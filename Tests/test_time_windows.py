@@ -2,8 +2,9 @@ import subprocess
 
 def build_and_run():
     compile_cmd = [
-        'gcc','-I','Tests/stubs','-I','APIs/Inc','Tests/data_logger_time_runner.c',
-        'Tests/stubs/time_rtc.c','Tests/stubs/microSD_utils.c','Tests/stubs/fatfs_stub.c','-o','Tests/data_logger_time_runner'
+        'gcc','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config','Tests/data_logger_time_runner.c',
+        'APIs/Src/estadistica_online.c','APIs/Src/punto_fijo.c','APIs/Src/formato_csv.c',
+        'Tests/stubs/time_rtc.c','Tests/stubs/microSD_utils.c','Tests/stubs/fatfs_sim.c','-lm','-o','Tests/data_logger_time_runner'
     ]
     subprocess.check_call(compile_cmd)
     return subprocess.run(['Tests/data_logger_time_runner'], capture_output=True, text=True)
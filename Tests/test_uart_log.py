@@ -0,0 +1,15 @@
+import subprocess
+
+def build_and_run():
+    compile_cmd = [
+        'gcc','-O2','-I','Tests/stubs','-I','APIs/Inc','-I','APIs/Config',
+        'Tests/uart_log_runner.c','Tests/stubs/uart_double.c',
+        '-o','Tests/uart_log_runner'
+    ]
+    subprocess.check_call(compile_cmd)
+    return subprocess.run(['Tests/uart_log_runner'], capture_output=True, text=True)
+
+def test_uart_log_cola_dma():
+    res = build_and_run()
+    assert res.returncode == 0, res.stdout+res.stderr
+    assert 'PASS' in res.stdout
@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#define UNIT_TESTING
+#include "stubs/uart_double.h"
+#include "../APIs/Src/uart_log.c"
+#include "../APIs/Src/uart_callbacks.c"
+
+static UART_HandleTypeDef huart3 = {.id = 7};
+static uint8_t salida[4 * UART_LOG_BUFFER_SIZE];
+
+static int fallas = 0;
+static volatile uint32_t sumidero;
+
+#define CHECK(cond, msg)                                                                           \
+    do {                                                                                           \
+        if (!(cond)) {                                                                             \
+            printf("FAIL %s\n", msg);                                                              \
+            fallas++;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+static void preparar(UartLog_Politica politica) {
+    uart_double_reset();
+    memset(&huart3, 0, sizeof(huart3));
+    huart3.id = 7;
+    huart3.tx_captura = salida;
+    huart3.tx_captura_max = sizeof(salida);
+    uart_double_iniciar(&huart3);
+    uart_log_init(&huart3, politica);
+}
+
+static uint16_t escribir(const char * texto) {
+    return uart_log_escribir((const uint8_t *)texto, (uint16_t)strlen(texto));
+}
+
+/* Avanza el reloj simulado hasta que el DMA vacía la cola */
+static void drenar(void) {
+    for (int i = 0; i < 1000 && uart_log_pendientes() > 0; i++) {
+        uart_double_avanzar_us(UART_LOG_TRAMO_DMA * UART_DOUBLE_BYTE_US);
+    }
+}
+
+static bool salida_es(const char * esperado) {
+    return huart3.tx_captura_len == strlen(esperado) &&
+           memcmp(salida, esperado, huart3.tx_captura_len) == 0;
+}
+
+static void test_no_bloquea(void) {
+    preparar(UART_LOG_DESCARTAR_NUEVOS);
+
+    uint32_t t0 = uart_double_now_us();
+    CHECK(escribir("[INFO] Temp: 23.4 C, Hum: 51.0%\r\n") == 33, "escribir: encola");
+    CHECK(uart_double_now_us() == t0, "escribir: no espera la linea serie");
+    CHECK(huart3.tx_dma_activo && uart_log_pendientes() == 33, "escribir: DMA iniciado");
+
+    /* Mensajes mientras el DMA transmite: se encolan detrás, en orden */
+    escribir("uno\r\n");
+    escribir("dos\r\n");
+    drenar();
+    CHECK(salida_es("[INFO] Temp: 23.4 C, Hum: 51.0%\r\nuno\r\ndos\r\n"), "orden: salida");
+    CHECK(uart_log_descartados() == 0 && !huart3.tx_dma_activo, "orden: sin perdidas");
+}
+
+static void test_vuelta_del_ring(void) {
+    char linea[64];
+    char esperado[sizeof(salida)];
+    size_t n = 0;
+
+    preparar(UART_LOG_DESCARTAR_NUEVOS);
+    /* Varias veces la capacidad de la cola, drenando de a poco: el ring da la vuelta */
+    for (int k = 0; k < 200; k++) {
+        int len = snprintf(linea, sizeof(linea), "linea %03d %.*s\r\n", k, k % 23,
+                           "abcdefghijklmnopqrstuvw");
+        CHECK(uart_log_escribir((const uint8_t *)linea, (uint16_t)len) == len, "vuelta: encola");
+        memcpy(&esperado[n], linea, (size_t)len);
+        n += (size_t)len;
+        uart_double_avanzar_us(40 * UART_DOUBLE_BYTE_US);
+    }
+    drenar();
+    CHECK(n > 2 * UART_LOG_BUFFER_SIZE, "vuelta: volumen");
+    CHECK(huart3.tx_captura_len == n && memcmp(salida, esperado, n) == 0, "vuelta: salida");
+}
+
+static void test_descartar_nuevos(void) {
+    char linea[64];
+    uint32_t encolados = 0;
+    uint32_t perdidos = 0;
+
+    preparar(UART_LOG_DESCARTAR_NUEVOS);
+    /* Sin avanzar el reloj el DMA no libera nada: la cola se llena */
+    for (int k = 0; k < 100; k++) {
+        int len = snprintf(linea, sizeof(linea), "mensaje %02d de prueba\r\n", k);
+        uint16_t r = uart_log_escribir((const uint8_t *)linea, (uint16_t)len);
+        CHECK(r == 0 || r == len, "nuevos: mensaje entero o nada");
+        encolados += r;
+        perdidos += (r == 0) ? (uint32_t)len : 0;
+    }
+    CHECK(perdidos > 0 && uart_log_descartados() == perdidos, "nuevos: contador");
+    drenar();
+    CHECK(huart3.tx_captura_len == encolados, "nuevos: salida");
+    CHECK(memcmp(salida, "mensaje 00 de prueba\r\n", 22) == 0,
+          "nuevos: se conservan los primeros");
+}
+
+static void test_descartar_antiguos(void) {
+    char linea[64];
+
+    preparar(UART_LOG_DESCARTAR_ANTIGUOS);
+    for (int k = 0; k < 100; k++) {
+        int len = snprintf(linea, sizeof(linea), "mensaje %02d de prueba\r\n", k);
+        CHECK(uart_log_escribir((const uint8_t *)linea, (uint16_t)len) == len,
+              "antiguos: siempre encola");
+    }
+    CHECK(uart_log_descartados() > 0, "antiguos: contador");
+    drenar();
+
+    /* El primer tramo ya estaba en el DMA; después se retoma en el comienzo de una línea */
+    CHECK(memcmp(salida, "mensaje 00 de prueba\r\n", 22) == 0,
+          "antiguos: tramo en vuelo intacto");
+    CHECK(huart3.tx_captura_len >= 22 &&
+              memcmp(&salida[huart3.tx_captura_len - 22], "mensaje 99 de prueba\r\n", 22) == 0,
+          "antiguos: se conserva el ultimo");
+    CHECK(huart3.tx_captura_len + uart_log_descartados() == 100 * 22, "antiguos: balance");
+
+    int lineas_enteras = 1;
+    for (uint32_t i = UART_LOG_TRAMO_DMA; i + 22 <= huart3.tx_captura_len; i++) {
+        /* Después del tramo en vuelo toda línea empieza con "mensaje" */
+        if (salida[i - 1] == '\n' && memcmp(&salida[i], "mensaje", 7) != 0) {
+            lineas_enteras = 0;
+        }
+    }
+    CHECK(lineas_enteras, "antiguos: lineas enteras");
+}
+
+static void test_flush(void) {
+    preparar(UART_LOG_DESCARTAR_NUEVOS);
+    escribir("antes de la falla\r\n");
+    escribir("ultimo mensaje\r\n");
+    uart_double_avanzar_us(5 * UART_DOUBLE_BYTE_US); /* El DMA alcanzó a sacar 5 bytes */
+
+    uart_log_flush();
+    CHECK(uart_log_pendientes() == 0 && !huart3.tx_dma_activo, "flush: cola vacia");
+    /* Del tramo detenido sólo se envía lo que el DMA no había tomado: nada sale repetido */
+    CHECK(salida_es("antes de la falla\r\nultimo mensaje\r\n"), "flush: salida");
+    CHECK(huart3.hdmatx->State == HAL_DMA_STATE_READY && huart3.hdmatx->Lock == HAL_UNLOCKED &&
+              huart3.gState == HAL_UART_STATE_READY,
+          "flush: DMA y UART libres");
+    escribir("despues\r\n");
+    drenar();
+    CHECK(salida_es("antes de la falla\r\nultimo mensaje\r\ndespues\r\n"),
+          "flush: el DMA vuelve a arrancar");
+
+    /* UART trabada (TXE nunca se activa): el vaciado vuelve y cuenta lo que no salió */
+    preparar(UART_LOG_DESCARTAR_NUEVOS);
+    escribir("trabada\r\n");
+    escribir("cola\r\n");
+    huart3.tx_trabado = 1;
+    uart_log_flush();
+    CHECK(uart_log_pendientes() == 0 && uart_log_descartados() == 15 && huart3.tx_captura_len == 0,
+          "flush: UART trabada");
+
+    /* Sin cola activa no hace nada */
+    uart_log = NULL;
+    uart_log_flush();
+    CHECK(uart_log_escribir((const uint8_t *)"x", 1) == 0 && !uart_log_activo(), "inactivo");
+}
+
+static void test_error_dma(void) {
+    static UART_HandleTypeDef huart5 = {.id = 5};
+
+    preparar(UART_LOG_DESCARTAR_NUEVOS);
+    escribir("tramo cortado\r\n");
+    uart_double_avanzar_us(5 * UART_DOUBLE_BYTE_US);
+    escribir("sigue\r\n");
+
+    /* Error del DMA de transmisión: la HAL corta la transferencia y avisa */
+    uart_double_error_tx(&huart3);
+    CHECK(uart_log_descartados() == 15 && huart3.tx_dma_activo, "error: tramo perdido, DMA sigue");
+    drenar();
+    CHECK(salida_es("tramosigue\r\n"), "error: la cola sigue drenando");
+
+    /* Un error de otra UART no toca la cola */
+    escribir("otra\r\n");
+    HAL_UART_ErrorCallback(&huart5);
+    drenar();
+    CHECK(uart_log_descartados() == 15 && salida_es("tramosigue\r\notra\r\n"), "error: otra UART");
+
+    /* Error sin cortar la transmisión (overrun de recepción): el tramo sigue en vuelo */
+    escribir("sin corte\r\n");
+    HAL_UART_ErrorCallback(&huart3);
+    drenar();
+    CHECK(uart_log_descartados() == 15 && salida_es("tramosigue\r\notra\r\nsin corte\r\n"),
+          "error: sin corte de la transmision");
+}
+
+static double segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void bench(void) {
+    const char * linea = "[INFO] SPS30 ID 2: PM2.5 = 12.34 ug/m3\r\n";
+    uint16_t len = (uint16_t)strlen(linea);
+    const int iteraciones = 200000;
+
+    /* Tiempo de línea serie que el lazo deja de esperar, por mensaje */
+    preparar(UART_LOG_DESCARTAR_NUEVOS);
+    uint32_t t0 = uart_double_now_us();
+    HAL_UART_Transmit(&huart3, (const uint8_t *)linea, len, 100);
+    uint32_t bloqueante = uart_double_now_us() - t0;
+    t0 = uart_double_now_us();
+    uart_log_escribir((const uint8_t *)linea, len);
+    uint32_t en_cola = uart_double_now_us() - t0;
+    printf("BENCH %u bytes: bloqueante %u us de UART, en cola %u us\n", len, bloqueante, en_cola);
+    CHECK(en_cola == 0 && bloqueante >= (uint32_t)len * UART_DOUBLE_BYTE_US, "bench: bloqueo");
+
+    /* Costo de CPU de encolar (la cola se vacía de a tramos para no descartar) */
+    huart3.tx_captura = NULL;
+    double c0 = segundos();
+    for (int k = 0; k < iteraciones; k++) {
+        uart_log_escribir((const uint8_t *)linea, len);
+        if ((k & 31) == 0) {
+            uart_double_avanzar_us(40 * len * UART_DOUBLE_BYTE_US);
+        }
+        sumidero += uart_log_pendientes();
+    }
+    double c1 = segundos();
+    printf("BENCH encolar: %.1f ns por mensaje, %u bytes descartados\n",
+           (c1 - c0) * 1e9 / iteraciones, uart_log_descartados());
+}
+
+int main(void) {
+    test_no_bloquea();
+    test_vuelta_del_ring();
+    test_descartar_nuevos();
+    test_descartar_antiguos();
+    test_flush();
+    test_error_dma();
+    bench();
+
+    if (fallas == 0) {
+        printf("PASS\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""Decodificador del log binario (LOG_TOKENIZADO, ver APIs/Inc/log_token.h).
+
+La tabla de formatos sale de la sección `log_fmt` del ELF que genera el enlazador: el
+identificador de cada mensaje es el desplazamiento de su cadena de formato en esa sección.
+
+    # Después de compilar: exportar la tabla junto al binario
+    python3 tools/log_tokens.py tabla Debug/Tesis_SPS30.elf -o Debug/log_tokens.csv
+
+    # Decodificar una captura (o '-' para leer de la entrada estándar, p. ej. del puerto serie)
+    python3 tools/log_tokens.py decodificar --tabla Debug/log_tokens.csv captura.bin
+    python3 tools/log_tokens.py decodificar --elf Debug/Tesis_SPS30.elf - < /dev/ttyACM0
+
+El texto que no está dentro de un registro (uart_print directo) pasa sin cambios.
+"""
+
+import argparse
+import codecs
+import csv
+import re
+import struct
+import sys
+
+SECCION = 'log_fmt'
+MARCA = 0xFF
+FIN = 0x0A
+
+ESPECIFICADOR = re.compile(
+    r'%(?P<flags>[-+ #0]*)(?P<ancho>\*|\d+)?(?:\.(?P<prec>\*|\d+))?'
+    r'(?:hh|h|ll|l|L|z|j|t)?(?P<conv>[diouxXeEfFgGcs%])')
+
+
+# === Tabla de formatos ========================================================================
+
+def leer_seccion_elf(ruta, nombre=SECCION):
+    """Devuelve el contenido de una sección de un ELF little endian de 32 o 64 bits."""
+    with open(ruta, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[5] != 1:
+        raise ValueError('%s no es un ELF little endian' % ruta)
+
+    if elf[4] == 1:  # ELF32
+        shoff, = struct.unpack_from('<I', elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x2E)
+        formato, campos = '<IIIIII', (0, 4, 5)
+    else:  # ELF64
+        shoff, = struct.unpack_from('<Q', elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x3A)
+        formato, campos = '<IIQQQQ', (0, 4, 5)
+
+    def seccion(i):
+        valores = struct.unpack_from(formato, elf, shoff + i * shentsize)
+        return [valores[c] for c in campos]  # nombre, offset, tamaño
+
+    _, str_off, _ = seccion(shstrndx)
+    for i in range(shnum):
+        nombre_off, off, tam = seccion(i)
+        fin = elf.index(b'\0', str_off + nombre_off)
+        if elf[str_off + nombre_off:fin].decode() == nombre:
+            return elf[off:off + tam]
+    raise ValueError('%s no tiene la sección %s (¿compilado sin LOG_TOKENIZADO?)' % (ruta, nombre))
+
+
+def tabla_desde_seccion(datos):
+    """Cada cadena de la sección empieza tras un '\\0' (o relleno de alineación)."""
+    tabla = {}
+    i = 0
+    while i < len(datos):
+        if datos[i] == 0:
+            i += 1
+            continue
+        fin = datos.index(b'\0', i)
+        tabla[i] = datos[i:fin].decode('utf-8', errors='replace')
+        i = fin + 1
+    return tabla
+
+
+def tabla_desde_elf(ruta):
+    return tabla_desde_seccion(leer_seccion_elf(ruta))
+
+
+def guardar_tabla(tabla, ruta):
+    with open(ruta, 'w', newline='', encoding='utf-8') as f:
+        escritor = csv.writer(f)
+        escritor.writerow(['id', 'formato'])
+        for ident in sorted(tabla):
+            escritor.writerow([ident, tabla[ident]])
+
+
+def cargar_tabla(ruta):
+    with open(ruta, newline='', encoding='utf-8') as f:
+        return {int(fila['id']): fila['formato'] for fila in csv.DictReader(f)}
+
+
+# === Decodificación de registros ==============================================================
+
+class Argumentos:
+    """Lee los argumentos de un registro en el orden en que los pide el formato."""
+
+    def __init__(self, datos):
+        self.datos = datos
+        self.pos = 0
+
+    def entero(self):
+        valor = 0
+        corrimiento = 0
+        while True:
+            if self.pos >= len(self.datos) or corrimiento > 28:
+                raise IndexError
+            byte = self.datos[self.pos]
+            self.pos += 1
+            valor |= (byte & 0x7F) << corrimiento
+            corrimiento += 7
+            if not byte & 0x80:
+                return (valor >> 1) ^ -(valor & 1)  # zigzag
+
+    def real(self):
+        if self.pos + 4 > len(self.datos):
+            raise IndexError
+        valor, = struct.unpack_from('<f', self.datos, self.pos)
+        self.pos += 4
+        return valor
+
+    def cadena(self):
+        fin = self.datos.index(b'\0', self.pos)  # ValueError si el registro se truncó
+        valor = self.datos[self.pos:fin].decode('utf-8', errors='replace')
+        self.pos = fin + 1
+        return valor
+
+
+def formatear(formato, datos):
+    """Aplica el formato printf a los argumentos binarios; los que faltan se muestran como '?'."""
+    args = Argumentos(datos)
+    faltan = [False]
+
+    def convertir(m):
+        conv = m.group('conv')
+        if conv == '%':
+            return '%'
+        if faltan[0]:
+            return '?'
+        try:
+            ancho = m.group('ancho') or ''
+            if ancho == '*':
+                ancho = str(args.entero())
+            prec = m.group('prec')
+            if prec == '*':
+                prec = str(args.entero())
+            spec = '%' + m.group('flags') + ancho + ('.' + prec if prec is not None else '')
+
+            if conv in 'di':
+                return (spec + 'd') % args.entero()
+            if conv in 'ouxX':
+                return (spec + ('d' if conv == 'u' else conv)) % (args.entero() & 0xFFFFFFFF)
+            if conv == 'c':
+                return (spec + 'c') % chr(args.entero() & 0xFF)
+            if conv == 's':
+                return (spec + 's') % args.cadena()
+            return (spec + conv) % args.real()
+        except (IndexError, ValueError):
+            faltan[0] = True
+            return '?'
+
+    return ESPECIFICADOR.sub(convertir, formato)
+
+
+class Decodificador:
+    """Decodificación incremental: admite la captura en trozos arbitrarios."""
+
+    def __init__(self, tabla):
+        self.tabla = tabla
+        self.pendiente = b''
+        self.texto = codecs.getincrementaldecoder('utf-8')(errors='replace')
+        self.registros = 0
+        self.invalidos = 0
+
+    def alimentar(self, datos, final=False):
+        self.pendiente += datos
+        salida = []
+        i = 0
+        datos = self.pendiente
+
+        while i < len(datos):
+            marca = datos.find(bytes([MARCA]), i)
+            if marca < 0:
+                salida.append(self.texto.decode(datos[i:]))
+                i = len(datos)
+                break
+            salida.append(self.texto.decode(datos[i:marca]))
+            i = marca
+
+            if i + 4 > len(datos) or i + 4 + datos[i + 1] + 1 > len(datos):
+                if final:
+                    self.invalidos += 1
+                    i = len(datos)
+                break  # Registro incompleto: se espera el resto
+
+            largo = datos[i + 1]
+            ident = datos[i + 2] | (datos[i + 3] << 8)
+            fin = i + 4 + largo
+            if datos[fin] != FIN or ident not in self.tabla:
+                # Basura o registro cortado: se resincroniza en la marca siguiente
+                self.invalidos += 1
+                i += 1
+                continue
+
+            salida.append(formatear(self.tabla[ident], datos[i + 4:fin]))
+            self.registros += 1
+            i = fin + 1
+
+        self.pendiente = datos[i:]
+        if final:
+            salida.append(self.texto.decode(b'', final=True))
+        return ''.join(salida)
+
+
+def decodificar(datos, tabla):
+    return Decodificador(tabla).alimentar(datos, final=True)
+
+
+# === Línea de comandos ========================================================================
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    sub = parser.add_subparsers(dest='comando', required=True)
+
+    p_tabla = sub.add_parser('tabla', help='Exporta la tabla de formatos de un ELF a CSV')
+    p_tabla.add_argument('elf')
+    p_tabla.add_argument('-o', '--salida', default='log_tokens.csv')
+
+    p_dec = sub.add_parser('decodificar', help='Convierte una captura binaria en texto')
+    origen = p_dec.add_mutually_exclusive_group(required=True)
+    origen.add_argument('--tabla', help='CSV generado con el comando tabla')
+    origen.add_argument('--elf', help='ELF del firmware que generó la captura')
+    p_dec.add_argument('captura', help="Archivo capturado del puerto serie, o '-'")
+
+    args = parser.parse_args(argv)
+
+    if args.comando == 'tabla':
+        tabla = tabla_desde_elf(args.elf)
+        guardar_tabla(tabla, args.salida)
+        print('%d formatos -> %s' % (len(tabla), args.salida))
+        return 0
+
+    tabla = cargar_tabla(args.tabla) if args.tabla else tabla_desde_elf(args.elf)
+    dec = Decodificador(tabla)
+    entrada = sys.stdin.buffer if args.captura == '-' else open(args.captura, 'rb')
+    with entrada:
+        while True:
+            bloque = entrada.read1(4096) if hasattr(entrada, 'read1') else entrada.read(4096)
+            if not bloque:
+                break
+            sys.stdout.write(dec.alimentar(bloque))
+            sys.stdout.flush()
+    sys.stdout.write(dec.alimentar(b'', final=True))
+    if dec.invalidos:
+        print('[%d registros invalidos]' % dec.invalidos, file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
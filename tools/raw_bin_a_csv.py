@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Exporta los archivos RAW binarios (REGISTRO_RAW_BINARIO, ver APIs/Inc/registro_raw.h) a CSV.
+
+El CSV resultante es el que escribía el equipo en RAW_<ID>_YYYYMMDD.CSV, byte por byte: el
+encabezado `#` sale del serial, la ubicación y las coordenadas del encabezado binario, y cada
+línea se arma con el esquema de campos que lleva el archivo.
+
+    # Un archivo: deja RAW_01_20261016.CSV al lado del .BIN
+    python3 tools/raw_bin_a_csv.py /media/sd/2026/10/16/RAW_01_20261016.BIN
+
+    # Toda la tarjeta, con los CSV en otra carpeta (misma estructura YYYY/MM/DD)
+    python3 tools/raw_bin_a_csv.py /media/sd -o datos_csv
+
+    # A la salida estándar
+    python3 tools/raw_bin_a_csv.py RAW_01_20261016.BIN -o -
+
+Los valores que el equipo no pudo representar (NaN, fuera de rango) se exportan como "nan".
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIA = b'SPS30RAW'
+VERSION = 1
+INICIO_ESQUEMA = 160
+TAM_CAMPO = 16
+TAM_NOMBRE = 13
+
+TIPO_U8, TIPO_U16, TIPO_I16 = 1, 2, 3
+INVALIDO = {TIPO_U8: None, TIPO_U16: 0xFFFF, TIPO_I16: 0x7FFF}
+MENOS_CERO = -0x8000
+
+CAMPOS_HORA = ('hora', 'minuto', 'segundo')
+
+# Mismo texto que registro_raw_encabezado_csv(), que llena un buffer de 512 bytes
+ENCABEZADO_CSV = (
+    '# Sensor ID: %d\n'
+    '# Serial: %s\n'
+    '# Ubicación: %s\n'
+    '# Coordenadas: %s\n'
+    '# Unidades:\n'
+    '#  - PM1.0, PM2.5, PM4.0, PM10 en ug/m3\n'
+    '#  - Temp_amb y Temp_cam en °C\n'
+    '#  - Hum_amb y Hum_cam en %%RH\n'
+    '#  - NC0.5, NC1.0, NC2.5, NC4.0, NC10 en #/cm3\n'
+    '#  - Tamaño típico en um\n'
+    '# Formato:\n'
+    '#  timestamp, sensor_id, pm1.0, pm2.5, pm4.0, pm10, temp_amb, hum_amb, temp_cam, '
+    'hum_cam, nc0.5, nc1.0, nc2.5, nc4.0, nc10, tamano_tipico\n').encode('utf-8')
+TAM_BUFFER_ENCABEZADO = 512
+
+
+class FormatoInvalido(ValueError):
+    pass
+
+
+def _cadena(datos, inicio, tam):
+    return datos[inicio:inicio + tam].split(b'\0', 1)[0]
+
+
+def leer_encabezado(datos):
+    """Devuelve un diccionario con los campos del encabezado binario."""
+    if len(datos) < 20 or datos[:8] != MAGIA:
+        raise FormatoInvalido('no es un archivo RAW binario')
+    version, tam_encabezado, tam_registro, n_campos, sensor_id, anio, mes, dia = \
+        struct.unpack_from('<HHHBBHBB', datos, 8)
+    if version != VERSION:
+        raise FormatoInvalido('versión %d no soportada' % version)
+    if len(datos) < tam_encabezado:
+        raise FormatoInvalido('encabezado incompleto')
+
+    esquema = []
+    for i in range(n_campos):
+        base = INICIO_ESQUEMA + i * TAM_CAMPO
+        nombre = _cadena(datos, base, TAM_NOMBRE).decode('ascii')
+        tipo, decimales, desplazamiento = datos[base + TAM_NOMBRE:base + TAM_NOMBRE + 3]
+        if tipo not in INVALIDO:
+            raise FormatoInvalido('tipo %d del campo %s' % (tipo, nombre))
+        esquema.append((nombre, tipo, decimales, desplazamiento))
+
+    return {
+        'version': version,
+        'tam_encabezado': tam_encabezado,
+        'tam_registro': tam_registro,
+        'sensor_id': sensor_id,
+        'fecha': (anio, mes, dia),
+        'serial': _cadena(datos, 20, 40),
+        'ubicacion': _cadena(datos, 60, 64),
+        'coordenadas': _cadena(datos, 124, 32),
+        'esquema': esquema,
+    }
+
+
+def encabezado_csv(enc):
+    """Encabezado `#` del CSV, truncado como lo hacía snprintf en el equipo."""
+    texto = ENCABEZADO_CSV % (enc['sensor_id'], enc['serial'], enc['ubicacion'],
+                              enc['coordenadas'])
+    return texto[:TAM_BUFFER_ENCABEZADO - 1]
+
+
+def _leer_campo(registro, tipo, desplazamiento):
+    if tipo == TIPO_U8:
+        return registro[desplazamiento]
+    formato = '<H' if tipo == TIPO_U16 else '<h'
+    return struct.unpack_from(formato, registro, desplazamiento)[0]
+
+
+def formatear(valor, tipo, decimales):
+    """Texto del campo igual al de printf: "%d" sin decimales, "%.Nf" con N decimales."""
+    if valor == INVALIDO[tipo]:
+        return 'nan'
+    if decimales == 0:
+        return '%d' % valor
+    if tipo == TIPO_I16 and valor == MENOS_CERO:
+        return '-0.' + '0' * decimales
+    escala = 10 ** decimales
+    signo = '-' if valor < 0 else ''
+    entero, fraccion = divmod(abs(valor), escala)
+    return '%s%d.%0*d' % (signo, entero, decimales, fraccion)
+
+
+def convertir(datos):
+    """Convierte el contenido de un archivo .BIN en el contenido del CSV equivalente."""
+    enc = leer_encabezado(datos)
+    anio, mes, dia = enc['fecha']
+    hora = [c for c in enc['esquema'] if c[0] in CAMPOS_HORA]
+    valores = [c for c in enc['esquema'] if c[0] not in CAMPOS_HORA]
+    if [c[0] for c in hora] != list(CAMPOS_HORA):
+        raise FormatoInvalido('el esquema no tiene hora, minuto y segundo')
+
+    salida = [encabezado_csv(enc)]
+    tam = enc['tam_registro']
+    # Un registro incompleto al final (corte de energía durante la escritura) se descarta
+    for inicio in range(enc['tam_encabezado'], len(datos) - tam + 1, tam):
+        registro = datos[inicio:inicio + tam]
+        h, m, s = (_leer_campo(registro, c[1], c[3]) for c in hora)
+        columnas = ['%04u-%02u-%02uT%02u:%02u:%02uZ' % (anio, mes, dia, h, m, s)]
+        columnas += [formatear(_leer_campo(registro, tipo, desp), tipo, dec)
+                     for _, tipo, dec, desp in valores]
+        salida.append((','.join(columnas) + '\n').encode('ascii'))
+    return b''.join(salida)
+
+
+def _archivos(rutas):
+    for ruta in rutas:
+        if os.path.isdir(ruta):
+            for base, _, nombres in sorted(os.walk(ruta)):
+                for nombre in sorted(nombres):
+                    if nombre.upper().endswith('.BIN'):
+                        yield ruta, os.path.join(base, nombre)
+        else:
+            yield os.path.dirname(ruta), ruta
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('rutas', nargs='+', help='archivos .BIN o carpetas a recorrer')
+    ap.add_argument('-o', '--salida',
+                    help="carpeta de salida (por defecto junto a cada .BIN), o '-'")
+    args = ap.parse_args(argv)
+
+    errores = 0
+    for raiz, ruta in _archivos(args.rutas):
+        with open(ruta, 'rb') as f:
+            datos = f.read()
+        try:
+            csv = convertir(datos)
+        except FormatoInvalido as e:
+            print('%s: %s' % (ruta, e), file=sys.stderr)
+            errores += 1
+            continue
+
+        if args.salida == '-':
+            sys.stdout.buffer.write(csv)
+            continue
+        destino = os.path.splitext(ruta)[0] + '.CSV'
+        if args.salida:
+            destino = os.path.join(args.salida, os.path.relpath(destino, raiz or '.'))
+            os.makedirs(os.path.dirname(destino), exist_ok=True)
+        with open(destino, 'wb') as f:
+            f.write(csv)
+    return 1 if errores else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())